@@ -11,6 +11,8 @@ function(add_engine_dependencies target_name)
 		add_dependencies(${target_name} bsfD3D11RenderAPI)
 	elseif(RENDER_API_MODULE MATCHES "Vulkan")
 		add_dependencies(${target_name} bsfVulkanRenderAPI)
+	elseif(RENDER_API_MODULE MATCHES "Null")
+		add_dependencies(${target_name} bsfNullRenderAPI)
 	else()
 		add_dependencies(${target_name} bsfGLRenderAPI)
 	endif()
@@ -38,20 +38,19 @@ namespace bs
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
+		if(mEvaluationTask != nullptr)
 		{
-			Lock lock(mMutex);
-
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			mEvaluationTask->wait();
+			mEvaluationTask = nullptr;
+		}
 
-			// Advance the buffers (last write buffer becomes read buffer)
-			if(mSwapBuffers)
-			{
-				mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
-				mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+		// Advance the buffers (last write buffer becomes read buffer)
+		if(mSwapBuffers)
+		{
+			mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+			mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 
-				mSwapBuffers = false;
-			}
+			mSwapBuffers = false;
 		}
 
 		if(mPaused)
@@ -101,8 +100,12 @@ namespace bs
 
 		// Prepare the write buffer
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		mProxyBoneOffsets.resize(mProxies.size());
+		for (UINT32 i = 0; i < (UINT32)mProxies.size(); i++)
 		{
+			mProxyBoneOffsets[i] = totalNumBones;
+
+			const SPtr<AnimationProxy>& anim = mProxies[i];
 			if (anim->skeleton != nullptr)
 				totalNumBones += anim->skeleton->getNumBones();
 		}
@@ -112,45 +115,26 @@ namespace bs
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
-		// Queue animation evaluation tasks
+		// Evaluate animations in parallel
+		const auto evaluateAnimWorker = [this](UINT32 idx)
 		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
-		}
+			UINT32 boneIdx = mProxyBoneOffsets[idx];
+			evaluateAnimation(mProxies[idx].get(), boneIdx);
+		};
 
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		const auto evaluateAllWorker = [this, evaluateAnimWorker]()
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
-			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
+			TaskScheduler::instance().parallelFor(0, (UINT32)mProxies.size(), 0, evaluateAnimWorker);
+		};
 
-				Lock lock(mMutex);
-				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-				}
-
-				mWorkerDoneSignal.notify_one();
-			};
-
-			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
-			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+		if(async)
+		{
+			mEvaluationTask = Task::create("AnimWorker", evaluateAllWorker);
+			TaskScheduler::instance().addTask(mEvaluationTask);
 		}
-
-		// Wait for tasks to complete
-		if(!async)
+		else
 		{
-			{
-				Lock lock(mMutex);
-
-				while (mNumActiveWorkers > 0)
-					mWorkerDoneSignal.wait(lock);
-			}
+			evaluateAllWorker();
 
 			// Trigger events and update attachments (for the data we just evaluated)
 			for (auto& anim : mAnimations)
@@ -130,13 +130,14 @@ namespace bs
 		Vector<ConvexVolume> mCullFrustums;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
+		Vector<UINT32> mProxyBoneOffsets;
+
 		UINT32 mPoseReadBufferIdx;
 		UINT32 mPoseWriteBufferIdx;
 		
-		Signal mWorkerDoneSignal;
+		SPtr<Task> mEvaluationTask;
 		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
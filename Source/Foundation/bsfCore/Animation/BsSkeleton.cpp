@@ -13,7 +13,7 @@ namespace bs
 		const UINT32 overridesPerBone = individualOverride ? 3 : 1;
 
 		UINT32 elementSize = sizeof(Vector3) * 2 + sizeof(Quaternion) + sizeof(bool) * overridesPerBone;
-		UINT8* buffer = (UINT8*)bs_alloc(elementSize * numBones);
+		UINT8* buffer = (UINT8*)bs_alloc(elementSize * numBones, MemoryCategory::Animation);
 
 		positions = (Vector3*)buffer;
 		buffer += sizeof(Vector3) * numBones;
@@ -30,7 +30,7 @@ namespace bs
 	LocalSkeletonPose::LocalSkeletonPose(UINT32 numPos, UINT32 numRot, UINT32 numScale)
 	{
 		UINT32 bufferSize = sizeof(Vector3) * numPos + sizeof(Quaternion) * numRot + sizeof(Vector3) * numScale;
-		UINT8* buffer = (UINT8*)bs_alloc(bufferSize);
+		UINT8* buffer = (UINT8*)bs_alloc(bufferSize, MemoryCategory::Animation);
 
 		positions = (Vector3*)buffer;
 		buffer += sizeof(Vector3) * numPos;
@@ -73,8 +73,10 @@ namespace bs
 	}
 
 	Skeleton::Skeleton(BONE_DESC* bones, UINT32 numBones)
-		: mNumBones(numBones), mBoneTransforms(bs_newN<Transform>(numBones)), mInvBindPoses(bs_newN<Matrix4>(numBones))
-		, mBoneInfo(bs_newN<SkeletonBoneInfo>(numBones))
+		: mNumBones(numBones)
+		, mBoneTransforms(bs_newN<Transform>(numBones, MemoryCategory::Animation))
+		, mInvBindPoses(bs_newN<Matrix4>(numBones, MemoryCategory::Animation))
+		, mBoneInfo(bs_newN<SkeletonBoneInfo>(numBones, MemoryCategory::Animation))
 	{
 		for(UINT32 i = 0; i < numBones; i++)
 		{
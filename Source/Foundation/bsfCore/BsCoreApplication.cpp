@@ -54,6 +54,9 @@ namespace bs
 	{
 		// Ensure all errors are reported properly
 		CrashHandler::startUp();
+
+		if(desc.reportMemoryLeaks)
+			MemoryCounter::setLeakTrackingEnabled(true);
 	}
 
 	CoreApplication::~CoreApplication()
@@ -118,6 +121,9 @@ namespace bs
 		MemStack::endThread();
 		Platform::_shutDown();
 
+		if(mStartUpDesc.reportMemoryLeaks)
+			MemoryCounter::reportLeaks();
+
 		CrashHandler::shutDown();
 	}
 
@@ -148,6 +154,10 @@ namespace bs
 		GpuProgramManager::startUp();
 		RenderStateManager::startUp();
 		ct::GpuProgramManager::startUp();
+
+		if (!mStartUpDesc.shaderCacheFolder.isEmpty())
+			ct::GpuProgramManager::instance().setBytecodeCacheFolder(mStartUpDesc.shaderCacheFolder);
+
 		RenderAPIManager::startUp();
 
 		mPrimaryWindow = RenderAPIManager::instance().initialize(mStartUpDesc.renderAPI, mStartUpDesc.primaryWindowDesc);
@@ -179,6 +189,9 @@ namespace bs
 	{
 		mRunMainLoop = true;
 
+		PerFrameData perFrameData;
+		buildFrameJobGraph(perFrameData);
+
 		while(mRunMainLoop)
 		{
 			// Limit FPS if needed
@@ -240,31 +253,7 @@ namespace bs
 				}
 			}
 
-			PROFILE_CALL(gSceneManager()._update(), "Scene update");
-			gAudio()._update();
-			gPhysics().update();
-
-			// Update plugins
-			for (auto& pluginUpdateFunc : mPluginUpdateFunctions)
-				pluginUpdateFunc.second();
-
-			postUpdate();
-
-			PerFrameData perFrameData;
-
-			// Evaluate animation after scene and plugin updates because the renderer will just now be displaying the
-			// animation we sent on the previous frame, and we want the scene information to match to what is displayed.
-			perFrameData.animation = AnimationManager::instance().update();
-			perFrameData.particles = ParticleManager::instance().update(*perFrameData.animation);
-
-			// Send out resource events in case any were loaded/destroyed/modified
-			ResourceListenerManager::instance().update();
-
-			// Trigger any renderer task callbacks (should be done before scene object update, or core sync, so objects have
-			// a chance to respond to the callback).
-			RendererManager::instance().getActive()->update();
-
-			gSceneManager()._updateCoreObjectTransforms();
+			mFrameJobGraph.execute();
 			PROFILE_CALL(RendererManager::instance().getActive()->renderAll(perFrameData), "Render");
 
 			// Core and sim thread run in lockstep. This will result in a larger input latency than if I was 
@@ -311,6 +300,103 @@ namespace bs
 				TaskScheduler::instance().removeWorker();
 			}
 		}
+
+		// Jobs reference the per-frame data local to this method
+		mFrameJobGraph.clear();
+	}
+
+	void CoreApplication::buildFrameJobGraph(PerFrameData& perFrameData)
+	{
+		// Data accessed by the frame stages. Stages that touch the same data execute in the order they are added below,
+		// while the rest are allowed to overlap.
+		const StringID SCENE = "Scene";
+		const StringID AUDIO = "Audio";
+		const StringID PHYSICS = "Physics";
+		const StringID ANIMATION = "Animation";
+		const StringID ANIMATION_DATA = "AnimationData";
+		const StringID PARTICLES = "Particles";
+		const StringID RESOURCES = "Resources";
+		const StringID RENDERER = "Renderer";
+
+		// Stages running user code (components, plugins, callbacks) can touch anything
+		const Vector<StringID> anyData = { SCENE, AUDIO, PHYSICS, ANIMATION, ANIMATION_DATA, PARTICLES, RESOURCES, RENDERER };
+
+		mFrameJobGraph.clear();
+
+		JOB_DESC sceneUpdate;
+		sceneUpdate.name = "Scene update";
+		sceneUpdate.worker = []() { PROFILE_CALL(gSceneManager()._update(), "Scene update"); };
+		sceneUpdate.writes = anyData;
+		mFrameJobGraph.addJob(sceneUpdate);
+
+		JOB_DESC physicsUpdate;
+		physicsUpdate.name = "Physics update";
+		physicsUpdate.worker = []() { gPhysics().update(); };
+		physicsUpdate.writes = { PHYSICS, SCENE };
+		mFrameJobGraph.addJob(physicsUpdate);
+
+		JOB_DESC pluginUpdate;
+		pluginUpdate.name = "Plugin update";
+		pluginUpdate.worker = [this]()
+		{
+			for (auto& pluginUpdateFunc : mPluginUpdateFunctions)
+				pluginUpdateFunc.second();
+
+			postUpdate();
+		};
+		pluginUpdate.writes = anyData;
+		mFrameJobGraph.addJob(pluginUpdate);
+
+		// Evaluate animation after scene and plugin updates because the renderer will just now be displaying the
+		// animation we sent on the previous frame, and we want the scene information to match to what is displayed.
+		// Animation events trigger user callbacks.
+		JOB_DESC animationUpdate;
+		animationUpdate.name = "Animation update";
+		animationUpdate.worker = [&perFrameData]() { perFrameData.animation = AnimationManager::instance().update(); };
+		animationUpdate.writes = anyData;
+		mFrameJobGraph.addJob(animationUpdate);
+
+		// Audio only touches its own sources and listeners, so let it run alongside the stages below
+		JOB_DESC audioUpdate;
+		audioUpdate.name = "Audio update";
+		audioUpdate.worker = []() { gAudio()._update(); };
+		audioUpdate.writes = { AUDIO };
+		audioUpdate.callingThreadOnly = false;
+		mFrameJobGraph.addJob(audioUpdate);
+
+		JOB_DESC particleUpdate;
+		particleUpdate.name = "Particle update";
+		particleUpdate.worker = [&perFrameData]()
+		{
+			perFrameData.particles = ParticleManager::instance().update(*perFrameData.animation);
+		};
+		// Evolvers query the physics scene (gravity, collisions) and particle systems read their scene object transforms
+		particleUpdate.reads = { ANIMATION_DATA, PHYSICS, SCENE };
+		particleUpdate.writes = { PARTICLES };
+		particleUpdate.callingThreadOnly = false;
+		mFrameJobGraph.addJob(particleUpdate);
+
+		// Send out resource events in case any were loaded/destroyed/modified
+		JOB_DESC resourceListenerUpdate;
+		resourceListenerUpdate.name = "Resource listener update";
+		resourceListenerUpdate.worker = []() { ResourceListenerManager::instance().update(); };
+		resourceListenerUpdate.writes = { RESOURCES, SCENE, AUDIO, PHYSICS, ANIMATION, RENDERER };
+		mFrameJobGraph.addJob(resourceListenerUpdate);
+
+		// Trigger any renderer task callbacks (should be done before scene object update, or core sync, so objects have
+		// a chance to respond to the callback). Callbacks are user code.
+		JOB_DESC rendererUpdate;
+		rendererUpdate.name = "Renderer update";
+		rendererUpdate.worker = []() { RendererManager::instance().getActive()->update(); };
+		rendererUpdate.writes = anyData;
+		mFrameJobGraph.addJob(rendererUpdate);
+
+		JOB_DESC transformUpdate;
+		transformUpdate.name = "Core object transform update";
+		transformUpdate.worker = []() { gSceneManager()._updateCoreObjectTransforms(); };
+		transformUpdate.reads = { SCENE };
+		transformUpdate.writes = { PARTICLES, RENDERER };
+		mFrameJobGraph.addJob(transformUpdate);
 	}
 
 	void CoreApplication::preUpdate()
@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "RenderAPI/BsRenderWindow.h"
 #include "Utility/BsEvent.h"
+#include "Threading/BsJobGraph.h"
 
 namespace bs
 {
@@ -23,9 +24,22 @@ namespace bs
 		String input; /**< Name of the input plugin to use. */
 		bool scripting = false; /**< True to load the scripting system. */
 
+		/**
+		 * True to record every allocation made while the application is running, and log those that were never freed
+		 * on shutdown. Significantly slows down allocation, so it should only be enabled when debugging. Requires memory
+		 * tracking to be enabled in the build (BS_MEMORY_TRACKING).
+		 */
+		bool reportMemoryLeaks = false;
+
 		RENDER_WINDOW_DESC primaryWindowDesc; /**< Describes the window to create during start-up. */
 
 		Vector<String> importers; /**< A list of importer plugins to load. */
+
+		/**
+		 * Folder to store compiled GPU program bytecode in, allowing unchanged programs to be loaded from the folder
+		 * instead of being recompiled. Leave empty to disable the cache.
+		 */
+		Path shaderCacheFolder;
 	};
 
 	/**
@@ -70,6 +84,12 @@ namespace bs
 		 */
 		ThreadId getSimThreadId() const { return mSimThreadId; }
 
+		/** 
+		 * Returns timing information about the simulation stages executed during the last frame, including which of
+		 * them were on the critical path. 
+		 */
+		const JobGraphTimeline& getFrameTimeline() const { return mFrameJobGraph.getLastTimeline(); }
+
 		/**	Returns true if the application is running in an editor, false if standalone. */
 		virtual bool isEditor() const { return false; }
 
@@ -103,6 +123,12 @@ namespace bs
 		virtual SPtr<IShaderIncludeHandler> getShaderIncludeHandler() const;
 
 	private:
+		/** 
+		 * Populates the job graph with the simulation stages executed every frame. Data that needs to be passed to the
+		 * renderer will be written to @p perFrameData.
+		 */
+		void buildFrameJobGraph(PerFrameData& perFrameData);
+
 		/**	Called when the frame finishes rendering. */
 		void frameRenderingFinishedCallback();
 
@@ -125,6 +151,7 @@ namespace bs
 		DynLib* mRendererPlugin;
 
 		Map<DynLib*, UpdatePluginFunc> mPluginUpdateFunctions;
+		JobGraph mFrameJobGraph;
 
 		bool mIsFrameRenderingFinished;
 		Mutex mFrameRenderingFinishedMutex;
@@ -256,6 +256,7 @@ namespace bs
 	class GpuParamBlock;
 	class GpuParamBlockBuffer;
 	class GpuParams;
+	class ParamID;
 	struct GpuParamDesc;
 	struct GpuParamDataDesc;
 	struct GpuParamObjectDesc;
@@ -340,6 +341,7 @@ namespace bs
 	class MaterialParams;
 	template <class T> class TAnimationCurve;
 	struct AnimationCurves;
+	struct PerFrameData;
 	class Skeleton;
 	class Animation;
 	class GpuParamsSet;
@@ -384,6 +386,8 @@ namespace bs
 	class SceneObject;
 	class Component;
 	class SceneManager;
+	class SceneTransformSystem;
+	class PrefabInstantiation;
 	// RTTI
 	class MeshRTTI;
 	// Desc structs
@@ -435,6 +439,8 @@ namespace bs
 		class VertexDeclaration;
 		class GpuBuffer;
 		class GpuParamBlockBuffer;
+		class GpuParamBlockAllocator;
+		class GpuProgramBytecodeCache;
 		class GpuParams;
 		class Shader;
 		class Viewport;
@@ -83,6 +83,8 @@ set(BS_CORE_INC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.h"
 	"bsfCore/Scene/BsTransform.h"
 	"bsfCore/Scene/BsSceneActor.h"
+	"bsfCore/Scene/BsSceneTransformSystem.h"
+	"bsfCore/Scene/BsPrefabInstantiation.h"
 )
 
 set(BS_CORE_INC_INPUT
@@ -145,9 +147,12 @@ set(BS_CORE_INC_RENDERAPI
 	"bsfCore/RenderAPI/BsIndexBuffer.h"
 	"bsfCore/RenderAPI/BsHardwareBuffer.h"
 	"bsfCore/RenderAPI/BsGpuProgram.h"
+	"bsfCore/RenderAPI/BsGpuProgramBytecodeCache.h"
 	"bsfCore/RenderAPI/BsGpuParams.h"
 	"bsfCore/RenderAPI/BsGpuParamDesc.h"
+	"bsfCore/RenderAPI/BsParamID.h"
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.h"
+	"bsfCore/RenderAPI/BsGpuParamBlockAllocator.h"
 	"bsfCore/RenderAPI/BsGpuParam.h"
 	"bsfCore/RenderAPI/BsGpuBuffer.h"
 	"bsfCore/RenderAPI/BsEventQuery.h"
@@ -466,8 +471,10 @@ set(BS_CORE_SRC_RENDERAPI
 	"bsfCore/RenderAPI/BsGpuBuffer.cpp"
 	"bsfCore/RenderAPI/BsGpuParam.cpp"
 	"bsfCore/RenderAPI/BsGpuParamBlockBuffer.cpp"
+	"bsfCore/RenderAPI/BsGpuParamBlockAllocator.cpp"
 	"bsfCore/RenderAPI/BsGpuParams.cpp"
 	"bsfCore/RenderAPI/BsGpuProgram.cpp"
+	"bsfCore/RenderAPI/BsGpuProgramBytecodeCache.cpp"
 	"bsfCore/RenderAPI/BsIndexBuffer.cpp"
 	"bsfCore/RenderAPI/BsOcclusionQuery.cpp"
 	"bsfCore/RenderAPI/BsRasterizerState.cpp"
@@ -489,6 +496,7 @@ set(BS_CORE_SRC_RENDERAPI
 	"bsfCore/RenderAPI/BsGpuPipelineParamInfo.cpp"
 	"bsfCore/RenderAPI/BsVertexDataDesc.cpp"
 	"bsfCore/RenderAPI/BsGpuParamDesc.cpp"
+	"bsfCore/RenderAPI/BsParamID.cpp"
 )
 
 set(BS_CORE_SRC_RENDERAPI_MANAGERS
@@ -544,6 +552,8 @@ set(BS_CORE_SRC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.cpp"
 	"bsfCore/Scene/BsTransform.cpp"
 	"bsfCore/Scene/BsSceneActor.cpp"
+	"bsfCore/Scene/BsSceneTransformSystem.cpp"
+	"bsfCore/Scene/BsPrefabInstantiation.cpp"
 )
 
 set(BS_CORE_INC_AUDIO
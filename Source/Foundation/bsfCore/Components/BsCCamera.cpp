@@ -27,10 +27,10 @@ namespace bs
 
 	ConvexVolume CCamera::getWorldFrustum() const
 	{
-		const Vector<Plane>& frustumPlanes = getFrustum().getPlanes();
+		const auto& frustumPlanes = getFrustum().getPlanes();
 		Matrix4 worldMatrix = SO()->getWorldMatrix();
 
-		Vector<Plane> worldPlanes(frustumPlanes.size());
+		SmallVector<Plane, 6> worldPlanes(frustumPlanes.size());
 		UINT32 i = 0;
 		for (auto& plane : frustumPlanes)
 		{
@@ -57,6 +57,14 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Layers,pr:getter)
 		UINT64 getLayer() const { return mInternal->getLayer(); }
 
+		/** @copydoc Renderable::setIsOccluder */
+		BS_SCRIPT_EXPORT(n:IsOccluder,pr:setter)
+		void setIsOccluder(bool occluder) { mInternal->setIsOccluder(occluder); }
+
+		/** @copydoc Renderable::getIsOccluder */
+		BS_SCRIPT_EXPORT(n:IsOccluder,pr:getter)
+		bool getIsOccluder() const { return mInternal->getIsOccluder(); }
+
 		/**	Gets world bounds of the mesh rendered by this object. */
 		BS_SCRIPT_EXPORT(n:Bounds,pr:getter)
 		Bounds getBounds() const;
@@ -7,155 +7,336 @@
 
 namespace bs
 {
-#if BS_DEBUG_MODE
+	/** Block of memory that queued commands are allocated from. */
+	struct CommandQueueBlock
+	{
+		/** Offset from the start of the block at which the command data starts. */
+		static constexpr UINT32 DATA_OFFSET = 64;
+
+		/** Size of the command data in the block, in bytes. */
+		static constexpr UINT32 DATA_SIZE = CommandQueueBase::BLOCK_SIZE - DATA_OFFSET;
+
+		/**
+		 * Maximum offset at which a command can end. The remaining space is reserved so that an end-of-block marker
+		 * can always be written.
+		 */
+		static constexpr UINT32 CAPACITY = DATA_SIZE - QueuedCommand::getHeaderSize();
+
+		/** Returns the memory commands are stored in. */
+		UINT8* getData() { return (UINT8*)this + DATA_OFFSET; }
+
+		/** Offset at which the next command will be allocated. Might go past the capacity when the block is full. */
+		std::atomic<UINT32> writeOffset{0};
+
+		/** Block that commands continue in, once this block is full. */
+		std::atomic<CommandQueueBlock*> next{nullptr};
+	};
+
+	static_assert(sizeof(CommandQueueBlock) <= CommandQueueBlock::DATA_OFFSET, "Command queue block header too large.");
+	static_assert(QueuedCommand::getHeaderSize() + QueuedCommand::getAsyncOpSize() + QueuedCommand::MAX_INLINE_SIZE <= 
+		CommandQueueBlock::CAPACITY, "Command queue block too small.");
+
+	constexpr UINT32 QueuedCommand::ALIGNMENT;
+	constexpr UINT32 QueuedCommand::MAX_INLINE_SIZE;
+	constexpr UINT32 CommandQueueBase::BLOCK_SIZE;
+	constexpr UINT32 CommandQueueBlock::DATA_OFFSET;
+	constexpr UINT32 CommandQueueBlock::DATA_SIZE;
+	constexpr UINT32 CommandQueueBlock::CAPACITY;
+
 	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId), mMaxDebugIdx(0)
+		:mMyThreadId(threadId)
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
 
+		CommandQueueBlock* block = allocateBlock();
+		mTail.store(block);
+		mReadBlock = block;
+		mLastFlush.block = block;
+
+#if BS_DEBUG_MODE
 		{
 			Lock lock(CommandQueueBreakpointMutex);
 
 			mCommandQueueIdx = MaxCommandQueueIdx++;
 		}
-	}
-#else
-	CommandQueueBase::CommandQueueBase(ThreadId threadId)
-		:mMyThreadId(threadId)
-	{
-		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
-		mCommands = bs_new<bs::Queue<QueuedCommand>>();
-	}
 #endif
+	}
 
 	CommandQueueBase::~CommandQueueBase()
 	{
-		if(mCommands != nullptr)
-			bs_delete(mCommands);
+		const auto freeBlock = [](CommandQueueBlock* block)
+		{
+			block->~CommandQueueBlock();
+			bs_free_aligned16(block);
+		};
 
-		while(!mEmptyCommandQueues.empty())
+		// Release any commands that were never played back
+		CommandQueueBlock* tail = mTail.load();
+		const UINT32 tailEnd = std::min(tail->writeOffset.load(), CommandQueueBlock::CAPACITY);
+
+		while(mReadBlock != tail || mReadOffset != tailEnd)
 		{
-			bs_delete(mEmptyCommandQueues.top());
-			mEmptyCommandQueues.pop();
+			QueuedCommand* command = getCommand(mReadBlock, mReadOffset);
+			if(command == nullptr)
+			{
+				CommandQueueBlock* next = mReadBlock->next.load();
+				freeBlock(mReadBlock);
+
+				mReadBlock = next;
+				mReadOffset = 0;
+				continue;
+			}
+
+			command->destroy(command->getCallable());
+
+			if(command->returnsValue)
+				command->getAsyncOp()->~AsyncOp();
+
+			mReadOffset += command->size;
 		}
+
+		freeBlock(tail);
+
+		for(auto& block : mRetiredBlocks)
+			freeBlock(block);
+
+		for(auto& block : mFreeBlocks)
+			freeBlock(block);
 	}
 
-	AsyncOp CommandQueueBase::queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
+	QueuedCommand* CommandQueueBase::allocateCommand(UINT32 callableSize, bool returnsValue, bool notifyWhenComplete, 
+		UINT32 callbackId)
 	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
+		UINT32 size = QueuedCommand::getHeaderSize() + callableSize;
+		if(returnsValue)
+			size += QueuedCommand::getAsyncOpSize();
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, mAsyncOpSyncData, _notifyWhenComplete, _callbackId);
-#endif
+		size = (size + QueuedCommand::ALIGNMENT - 1) & ~(QueuedCommand::ALIGNMENT - 1);
 
-		mCommands->push(newCommand);
+		// Blocks are not recycled while there are active writers, ensuring the block we retrieve below stays valid
+		mNumActiveWriters.fetch_add(1);
 
-#if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
-#endif
+		UINT8* commandData;
+		while(true)
+		{
+			CommandQueueBlock* block = mTail.load();
+			const UINT32 offset = block->writeOffset.fetch_add(size);
 
-		return newCommand.asyncOp;
-	}
+			if(offset + size <= CommandQueueBlock::CAPACITY)
+			{
+				commandData = block->getData() + offset;
+				break;
+			}
 
-	void CommandQueueBase::queue(std::function<void()> commandCallback, bool _notifyWhenComplete, UINT32 _callbackId)
-	{
-#if BS_DEBUG_MODE
-		breakIfNeeded(mCommandQueueIdx, mMaxDebugIdx);
+			if(offset <= CommandQueueBlock::CAPACITY)
+			{
+				// We're the first command that didn't fit, mark the end of the block and continue in a new one
+				CommandQueueBlock* newBlock = allocateBlock();
+				block->next.store(newBlock, std::memory_order_release);
 
-		QueuedCommand newCommand(commandCallback, mMaxDebugIdx++, _notifyWhenComplete, _callbackId);
-#else
-		QueuedCommand newCommand(commandCallback, _notifyWhenComplete, _callbackId);
+				QueuedCommand* marker = new (block->getData() + offset) QueuedCommand;
+				marker->size = 0;
+				marker->state.store(QueuedCommand::State_EndOfBlock, std::memory_order_release);
+
+				mTail.store(newBlock);
+			}
+			else
+			{
+				// Another thread is moving the queue to a new block, wait until it's done
+				while(mTail.load() == block)
+					std::this_thread::yield();
+			}
+		}
+
+		// Note: Command memory is zeroed, so the command state is already State_Writing
+		QueuedCommand* command = new (commandData) QueuedCommand;
+		command->size = size;
+		command->callbackId = callbackId;
+		command->returnsValue = returnsValue;
+		command->notifyWhenComplete = notifyWhenComplete;
+		command->isCanceled = false;
+
+#if BS_DEBUG_MODE
+		command->debugId = mMaxDebugIdx.fetch_add(1, std::memory_order_relaxed);
+		breakIfNeeded(mCommandQueueIdx, command->debugId);
 #endif
 
-		mCommands->push(newCommand);
+		return command;
+	}
+
+	void CommandQueueBase::commitCommand(QueuedCommand* command)
+	{
+		command->state.store(QueuedCommand::State_Ready, std::memory_order_release);
+		mNumActiveWriters.fetch_sub(1);
 
 #if BS_FORCE_SINGLETHREADED_RENDERING
-		Queue<QueuedCommand>* commands = flush();
-		playback(commands);
+		playback(flush());
 #endif
 	}
 
-	bs::Queue<QueuedCommand>* CommandQueueBase::flush()
+	CommandQueueBlock* CommandQueueBase::allocateBlock()
 	{
-		bs::Queue<QueuedCommand>* oldCommands = mCommands;
-
-		if(!mEmptyCommandQueues.empty())
+		CommandQueueBlock* block = nullptr;
 		{
-			mCommands = mEmptyCommandQueues.top();
-			mEmptyCommandQueues.pop();
+			ScopedSpinLock lock(mFreeBlocksLock);
+
+			if(!mFreeBlocks.empty())
+			{
+				block = mFreeBlocks.back();
+				mFreeBlocks.pop_back();
+			}
 		}
-		else
+
+		if(block == nullptr)
 		{
-			mCommands = bs_new<bs::Queue<QueuedCommand>>();
+			block = new (bs_alloc_aligned16(BLOCK_SIZE)) CommandQueueBlock();
+			memset(block->getData(), 0, CommandQueueBlock::DATA_SIZE);
 		}
 
-		return oldCommands;
+		block->next.store(nullptr, std::memory_order_relaxed);
+		block->writeOffset.store(0, std::memory_order_relaxed);
+
+		return block;
 	}
 
-	void CommandQueueBase::playbackWithNotify(bs::Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback)
+	void CommandQueueBase::recycleRetiredBlocks()
 	{
-		THROW_IF_NOT_CORE_THREAD;
+		if(mRetiredBlocks.empty())
+			return;
 
-		if(commands == nullptr)
+		// A thread that started queuing a command before the block was retired could still be referencing it. We'll try
+		// again on next playback.
+		if(mNumActiveWriters.load() != 0)
 			return;
 
-		while(!commands->empty())
-		{
-			QueuedCommand& command = commands->front();
+		// New commands can be allocated at any offset, make sure no stale command state remains
+		for(auto& block : mRetiredBlocks)
+			memset(block->getData(), 0, CommandQueueBlock::DATA_SIZE);
 
-			if(command.returnsValue)
-			{
-				AsyncOp& op = command.asyncOp;
-				command.callbackWithReturnValue(op);
+		ScopedSpinLock lock(mFreeBlocksLock);
+		mFreeBlocks.insert(mFreeBlocks.end(), mRetiredBlocks.begin(), mRetiredBlocks.end());
+		mRetiredBlocks.clear();
+	}
 
-				if(!command.asyncOp.hasCompleted())
-				{
-					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
-						"Make sure to complete the operation before returning from the command callback method.");
-					command.asyncOp._completeOperation(nullptr);
-				}
-			}
-			else
+	QueuedCommand* CommandQueueBase::getCommand(CommandQueueBlock* block, UINT32 offset)
+	{
+		QueuedCommand* command = (QueuedCommand*)(block->getData() + offset);
+
+		// Space for the command might have been reserved but the writer thread didn't yet finish writing it
+		UINT32 state;
+		while((state = command->state.load(std::memory_order_acquire)) == QueuedCommand::State_Writing)
+			std::this_thread::yield();
+
+		if(state == QueuedCommand::State_EndOfBlock)
+			return nullptr;
+
+		return command;
+	}
+
+	CommandQueueBatch CommandQueueBase::flush()
+	{
+		CommandQueueBlock* block = mTail.load();
+
+		mLastFlush.block = block;
+		mLastFlush.offset = std::min(block->writeOffset.load(), CommandQueueBlock::CAPACITY);
+
+		return mLastFlush;
+	}
+
+	void CommandQueueBase::playbackWithNotify(const CommandQueueBatch& commands, std::function<void(UINT32)> notifyCallback)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		while(mReadBlock != commands.block || mReadOffset != commands.offset)
+		{
+			QueuedCommand* command = getCommand(mReadBlock, mReadOffset);
+			if(command == nullptr)
 			{
-				command.callback();
+				// Reached the end of the block. If the batch ends in this block, the rest of the commands are in the
+				// next batch.
+				if(mReadBlock == commands.block)
+					break;
+
+				CommandQueueBlock* next = mReadBlock->next.load(std::memory_order_acquire);
+				mRetiredBlocks.push_back(mReadBlock);
+
+				mReadBlock = next;
+				mReadOffset = 0;
+				continue;
 			}
 
-			if(command.notifyWhenComplete && notifyCallback != nullptr)
+			if(!command->isCanceled)
 			{
-				notifyCallback(command.callbackId);
+				if(command->returnsValue)
+				{
+					AsyncOp& op = *command->getAsyncOp();
+					command->execute(command->getCallable(), &op);
+
+					if(!op.hasCompleted())
+					{
+						LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+							"Make sure to complete the operation before returning from the command callback method.");
+						op._completeOperation(nullptr);
+					}
+				}
+				else
+					command->execute(command->getCallable(), nullptr);
+
+				if(command->notifyWhenComplete && notifyCallback != nullptr)
+					notifyCallback(command->callbackId);
 			}
 
-			commands->pop();
+			command->destroy(command->getCallable());
+
+			if(command->returnsValue)
+				command->getAsyncOp()->~AsyncOp();
+
+			mReadOffset += command->size;
 		}
 
-		mEmptyCommandQueues.push(commands);
+		recycleRetiredBlocks();
 	}
 
-	void CommandQueueBase::playback(bs::Queue<QueuedCommand>* commands)
+	void CommandQueueBase::playback(const CommandQueueBatch& commands)
 	{
 		playbackWithNotify(commands, std::function<void(UINT32)>());
 	}
 
 	void CommandQueueBase::cancelAll()
 	{
-		bs::Queue<QueuedCommand>* commands = flush();
+		CommandQueueBatch start = mLastFlush;
+		CommandQueueBatch end = flush();
 
-		while(!commands->empty())
-			commands->pop();
+		// Commands get released when the read position moves past them during the next playback
+		CommandQueueBlock* block = start.block;
+		UINT32 offset = start.offset;
+		while(block != end.block || offset != end.offset)
+		{
+			// Flush positions are clamped to the block capacity, in which case the commands continue in the next block
+			QueuedCommand* command = nullptr;
+			if(offset != CommandQueueBlock::CAPACITY)
+				command = getCommand(block, offset);
+
+			if(command == nullptr)
+			{
+				if(block == end.block)
+					break;
 
-		mEmptyCommandQueues.push(commands);
+				block = block->next.load(std::memory_order_acquire);
+				offset = 0;
+				continue;
+			}
+
+			command->isCanceled = true;
+			offset += command->size;
+		}
 	}
 
 	bool CommandQueueBase::isEmpty()
 	{
-		if(mCommands != nullptr && mCommands->size() > 0)
-			return false;
+		CommandQueueBlock* block = mTail.load();
 
-		return true;
+		return block == mLastFlush.block && block->writeOffset.load() == mLastFlush.offset;
 	}
 
 	void CommandQueueBase::throwInvalidThreadException(const String& message) const
@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Threading/BsAsyncOp.h"
+#include "Threading/BsSpinLock.h"
 #include <functional>
 
 namespace bs
@@ -19,127 +20,176 @@ namespace bs
 	class CommandQueueNoSync
 	{
 	public:
-		CommandQueueNoSync() {}
-		virtual ~CommandQueueNoSync() {}
-
 		bool isValidThread(ThreadId ownerThread) const
 		{
 			return BS_THREAD_CURRENT_ID == ownerThread;
 		}
-
-		void lock() { };
-		void unlock() { }
 	};
 
 	/**
-	 * Command queue policy that provides synchonization. Should be used with command queues that are used on multiple 
-	 * threads.
+	 * Command queue policy that allows the queue to be used on multiple threads. Queueing commands is lock-free so no
+	 * additional synchronization is required.
 	 */
 	class CommandQueueSync
 	{
 	public:
-		CommandQueueSync()
-			:mLock(mCommandQueueMutex, std::defer_lock)
-		{ }
-		virtual ~CommandQueueSync() {}
-
 		bool isValidThread(ThreadId ownerThread) const
 		{
 			return true;
 		}
+	};
+
+	struct CommandQueueBlock;
+
+	/**
+	 * Header of a single command stored in the command queue. The header is immediately followed by an AsyncOp (for
+	 * commands that return a value), and then by the callable object of the command. Callable objects that are too large
+	 * are allocated on the heap, in which case only the pointer to the object is stored after the header.
+	 */
+	struct QueuedCommand
+	{
+		/** Alignment of each command in the queue, in bytes. */
+		static constexpr UINT32 ALIGNMENT = 16;
+
+		/** Maximum size of a callable object that will be stored inline in the queue, in bytes. */
+		static constexpr UINT32 MAX_INLINE_SIZE = 256;
 
-		void lock() 
+		/** Possible states of the command. */
+		enum State
 		{
-			mLock.lock();
+			/** Space for the command was reserved, but the command wasn't yet fully written. */
+			State_Writing,
+			/** Command was fully written and can be executed. */
+			State_Ready,
+			/** Not an actual command, signals that the rest of the block is unused and commands continue in the next block. */
+			State_EndOfBlock
 		};
 
-		void unlock()
+		/** Executes the callable object stored in the command. */
+		void (*execute)(void* callable, AsyncOp* asyncOp);
+
+		/** Destroys the callable object stored in the command. */
+		void (*destroy)(void* callable);
+
+		UINT32 size; /**< Size of the command in bytes, including the header. */
+		UINT32 callbackId;
+#if BS_DEBUG_MODE
+		UINT32 debugId;
+#endif
+		bool returnsValue;
+		bool notifyWhenComplete;
+		bool isCanceled;
+		std::atomic<UINT32> state;
+
+		/** Returns the size of the command header, in bytes. */
+		static constexpr UINT32 getHeaderSize()
 		{
-			mLock.unlock();
+			return (sizeof(QueuedCommand) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
 		}
 
-	private:
-		Mutex mCommandQueueMutex;
-		Lock mLock;
+		/** Returns the size of the storage for the AsyncOp of commands that return a value, in bytes. */
+		static constexpr UINT32 getAsyncOpSize()
+		{
+			return (sizeof(AsyncOp) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		}
+
+		/** Returns the async operation of the command. Only valid if the command returns a value. */
+		AsyncOp* getAsyncOp()
+		{
+			return (AsyncOp*)((UINT8*)this + getHeaderSize());
+		}
+
+		/** Returns the memory in which the command's callable object is stored. */
+		void* getCallable()
+		{
+			return (UINT8*)this + getHeaderSize() + (returnsValue ? getAsyncOpSize() : 0);
+		}
 	};
 
 	/**
-	 * Represents a single queued command in the command list. Contains all the data for executing the command and checking 
-	 * up on the command status.
+	 * Stores a callable object of type @p T within a QueuedCommand. Objects small enough are stored inline, while others
+	 * are allocated on the heap.
 	 */
-	struct QueuedCommand
+	template<class T, bool INLINE = sizeof(T) <= QueuedCommand::MAX_INLINE_SIZE && alignof(T) <= QueuedCommand::ALIGNMENT>
+	struct QueuedCommandStorage
 	{
-#if BS_DEBUG_MODE
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, UINT32 _debugId, const SPtr<AsyncOpSyncData>& asyncOpSyncData,
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: debugId(_debugId), callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true)
-			, callbackId(_callbackId), notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		/** Number of bytes required for storing the callable object. */
+		static constexpr UINT32 SIZE = sizeof(T);
 
-		QueuedCommand(std::function<void()> _callback, UINT32 _debugId, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			:debugId(_debugId), callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		template<class U>
+		static void construct(void* storage, U&& callable)
+		{
+			new (storage) T(std::forward<U>(callable));
+		}
 
-		UINT32 debugId;
-#else
-		QueuedCommand(std::function<void(AsyncOp&)> _callback, const SPtr<AsyncOpSyncData>& asyncOpSyncData, 
-			bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: callbackWithReturnValue(_callback), asyncOp(asyncOpSyncData), returnsValue(true), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
+		static void execute(void* storage, AsyncOp* asyncOp)
+		{
+			(*(T*)storage)();
+		}
 
-		QueuedCommand(std::function<void()> _callback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
-			: callback(_callback), asyncOp(AsyncOpEmpty()), returnsValue(false), callbackId(_callbackId)
-			, notifyWhenComplete(_notifyWhenComplete)
-		{ }
-#endif
+		static void executeReturn(void* storage, AsyncOp* asyncOp)
+		{
+			(*(T*)storage)(*asyncOp);
+		}
 
-		~QueuedCommand()
-		{ }
+		static void destroy(void* storage)
+		{
+			((T*)storage)->~T();
+		}
+	};
+
+	/** @copydoc QueuedCommandStorage */
+	template<class T>
+	struct QueuedCommandStorage<T, false>
+	{
+		/** @copydoc QueuedCommandStorage::SIZE */
+		static constexpr UINT32 SIZE = sizeof(T*);
 
-		QueuedCommand(const QueuedCommand& source)
+		template<class U>
+		static void construct(void* storage, U&& callable)
 		{
-			callback = source.callback;
-			callbackWithReturnValue = source.callbackWithReturnValue;
-			asyncOp = source.asyncOp;
-			returnsValue = source.returnsValue;
-			callbackId = source.callbackId;
-			notifyWhenComplete = source.notifyWhenComplete;
+			*(T**)storage = bs_new<T>(std::forward<U>(callable));
+		}
 
-#if BS_DEBUG_MODE
-			debugId = source.debugId;
-#endif
+		static void execute(void* storage, AsyncOp* asyncOp)
+		{
+			(**(T**)storage)();
 		}
 
-		QueuedCommand& operator=(const QueuedCommand& rhs)
+		static void executeReturn(void* storage, AsyncOp* asyncOp)
 		{
-			callback = rhs.callback;
-			callbackWithReturnValue = rhs.callbackWithReturnValue;
-			asyncOp = rhs.asyncOp;
-			returnsValue = rhs.returnsValue;
-			callbackId = rhs.callbackId;
-			notifyWhenComplete = rhs.notifyWhenComplete;
-			
-#if BS_DEBUG_MODE
-			debugId = rhs.debugId;
-#endif
+			(**(T**)storage)(*asyncOp);
+		}
 
-			return *this;
+		static void destroy(void* storage)
+		{
+			bs_delete(*(T**)storage);
 		}
+	};
 
-		std::function<void()> callback;
-		std::function<void(AsyncOp&)> callbackWithReturnValue;
-		AsyncOp asyncOp;
-		bool returnsValue;
-		UINT32 callbackId;
-		bool notifyWhenComplete;
+	/**
+	 * Marks the end of a set of commands returned by CommandQueueBase::flush(). Must be passed to
+	 * CommandQueueBase::playback() in order to execute the commands.
+	 */
+	struct CommandQueueBatch
+	{
+		CommandQueueBlock* block = nullptr;
+		UINT32 offset = 0;
 	};
 
-	/** Manages a list of commands that can be queued for later execution on the core thread. */
+	/**
+	 * Manages a list of commands that can be queued for later execution on the core thread.
+	 *
+	 * Commands are stored in a ring of fixed size memory blocks, which are recycled once all the commands in them are
+	 * executed. Queuing a command is lock-free and can be done from multiple threads at once, while the commands must
+	 * be flushed and played back from a single thread.
+	 */
 	class BS_CORE_EXPORT CommandQueueBase
 	{
 	public:
+		/** Size of a single block of memory that commands are allocated from, in bytes. */
+		static constexpr UINT32 BLOCK_SIZE = 64 * 1024;
+
 		/**
 		 * Constructor.
 		 *
@@ -157,16 +207,17 @@ namespace bs
 		ThreadId getThreadId() const { return mMyThreadId; }
 
 		/**
-		 * Executes all provided commands one by one in order. To get the commands you should call flush().
+		 * Executes all commands up to the end of the provided batch, one by one in order. To get the batch you should call
+		 * flush(). Batches must be played back in the order they were flushed.
 		 *
-		 * @param[in]	commands			Commands to execute.
+		 * @param[in]	commands			Batch of commands to execute.
 		 * @param[in]	notifyCallback  	Callback that will be called if a command that has @p notifyOnComplete flag set.
 		 * 									The callback will receive @p callbackId of the command.
 		 */
-		void playbackWithNotify(Queue<QueuedCommand>* commands, std::function<void(UINT32)> notifyCallback);
+		void playbackWithNotify(const CommandQueueBatch& commands, std::function<void(UINT32)> notifyCallback);
 
-		/** Executes all provided commands one by one in order. To get the commands you should call flush(). */
-		void playback(Queue<QueuedCommand>* commands);
+		/** Executes all commands in the provided batch one by one in order. To get the batch you should call flush(). */
+		void playback(const CommandQueueBatch& commands);
 
 		/**
 		 * Allows you to set a breakpoint that will trigger when the specified command is executed.		
@@ -201,7 +252,22 @@ namespace bs
 		 * Callback method also needs to call AsyncOp::markAsResolved once it is done processing. (If it doesn't it will 
 		 * still be called automatically, but the return value will default to nullptr)
 		 */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class T>
+		AsyncOp queueReturn(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef QueuedCommandStorage<typename std::decay<T>::type> Storage;
+
+			QueuedCommand* command = allocateCommand(Storage::SIZE, true, _notifyWhenComplete, _callbackId);
+			Storage::construct(command->getCallable(), std::forward<T>(commandCallback));
+			command->execute = &Storage::executeReturn;
+			command->destroy = &Storage::destroy;
+
+			AsyncOp* asyncOp = new (command->getAsyncOp()) AsyncOp(mAsyncOpSyncData);
+			AsyncOp output = *asyncOp;
+
+			commitCommand(command);
+			return output;
+		}
 
 		/**
 		 * Queue up a new command to execute. Make sure the provided function has all of its parameters properly bound. 
@@ -214,18 +280,32 @@ namespace bs
 		 * @param[in]	_callbackId		   	(optional) Identifier for the callback so you can then later find
 		 * 									it if needed.
 		 */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0);
+		template<class T>
+		void queue(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		{
+			typedef QueuedCommandStorage<typename std::decay<T>::type> Storage;
+
+			QueuedCommand* command = allocateCommand(Storage::SIZE, false, _notifyWhenComplete, _callbackId);
+			Storage::construct(command->getCallable(), std::forward<T>(commandCallback));
+			command->execute = &Storage::execute;
+			command->destroy = &Storage::destroy;
+
+			commitCommand(command);
+		}
 
 		/**
-		 * Returns a copy of all queued commands and makes room for new ones. Must be called from the thread that created 
-		 * the command queue. Returned commands must be passed to playback() method.
+		 * Returns a batch containing all commands queued since the last flush. Must be called from a single thread at a
+		 * time. Returned batch must be passed to playback() method.
 		 */
-		Queue<QueuedCommand>* flush();
+		CommandQueueBatch flush();
 
-		/** Cancels all currently queued commands. */
+		/**
+		 * Cancels all commands queued since the last flush. Canceled commands will be released without executing on
+		 * the next playback. Must not be called while other threads are queuing commands.
+		 */
 		void cancelAll();
 
-		/**	Returns true if no commands are queued. */
+		/**	Returns true if no commands were queued since the last flush. */
 		bool isEmpty();
 
 	protected:
@@ -236,8 +316,37 @@ namespace bs
 		void throwInvalidThreadException(const String& message) const;
 
 	private:
-		Queue<QueuedCommand>* mCommands;
-		Stack<Queue<QueuedCommand>*> mEmptyCommandQueues; /**< List of empty queues for reuse. */
+		/**
+		 * Reserves memory for a new command with a payload of the specified size and initializes its header. The command
+		 * must be committed by calling commitCommand() once its payload is written.
+		 */
+		QueuedCommand* allocateCommand(UINT32 callableSize, bool returnsValue, bool notifyWhenComplete, UINT32 callbackId);
+
+		/** Marks the command as ready for execution. */
+		void commitCommand(QueuedCommand* command);
+
+		/** Retrieves an empty block from the pool, or allocates a new one if the pool is empty. */
+		CommandQueueBlock* allocateBlock();
+
+		/** Moves blocks that were fully played back into the pool, if no other thread could be accessing them. */
+		void recycleRetiredBlocks();
+
+		/**
+		 * Returns the command at the specified position, waiting until it is fully written. Returns null if the command
+		 * marks the end of the block.
+		 */
+		static QueuedCommand* getCommand(CommandQueueBlock* block, UINT32 offset);
+
+		std::atomic<CommandQueueBlock*> mTail; /**< Block new commands are being allocated from. */
+		std::atomic<UINT32> mNumActiveWriters{0}; /**< Number of threads currently in the process of queueing a command. */
+
+		CommandQueueBlock* mReadBlock; /**< Block containing the next command to play back. */
+		UINT32 mReadOffset = 0; /**< Offset of the next command to play back. */
+		CommandQueueBatch mLastFlush; /**< End of the last batch returned by flush(). */
+
+		Vector<CommandQueueBlock*> mRetiredBlocks; /**< Fully played back blocks, waiting to be returned to the pool. */
+		Vector<CommandQueueBlock*> mFreeBlocks;
+		SpinLock mFreeBlocksLock;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 		ThreadId mMyThreadId;
@@ -269,9 +378,9 @@ namespace bs
 			inline size_t operator()(const QueueBreakpoint& v) const;
 		};
 
-		UINT32 mMaxDebugIdx;
+		std::atomic<UINT32> mMaxDebugIdx{0};
 		UINT32 mCommandQueueIdx;
-		
+
 		static UINT32 MaxCommandQueueIdx;
 		static UnorderedSet<QueueBreakpoint, QueueBreakpoint::HashFunction, QueueBreakpoint::EqualFunction> SetBreakpoints;
 		static Mutex CommandQueueBreakpointMutex;
@@ -300,7 +409,8 @@ namespace bs
 		{ }
 
 		/** @copydoc CommandQueueBase::queueReturn */
-		AsyncOp queueReturn(std::function<void(AsyncOp&)> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class T>
+		AsyncOp queueReturn(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -309,15 +419,12 @@ namespace bs
 #endif
 #endif
 
-			this->lock();
-			AsyncOp asyncOp = CommandQueueBase::queueReturn(commandCallback, _notifyWhenComplete, _callbackId);
-			this->unlock();
-
-			return asyncOp;
+			return CommandQueueBase::queueReturn(std::forward<T>(commandCallback), _notifyWhenComplete, _callbackId);
 		}
 
 		/** @copydoc CommandQueueBase::queue */
-		void queue(std::function<void()> commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
+		template<class T>
+		void queue(T&& commandCallback, bool _notifyWhenComplete = false, UINT32 _callbackId = 0)
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -326,13 +433,11 @@ namespace bs
 #endif
 #endif
 
-			this->lock();
-			CommandQueueBase::queue(commandCallback, _notifyWhenComplete, _callbackId);
-			this->unlock();
+			CommandQueueBase::queue(std::forward<T>(commandCallback), _notifyWhenComplete, _callbackId);
 		}
 
 		/** @copydoc CommandQueueBase::flush */
-		bs::Queue<QueuedCommand>* flush()
+		CommandQueueBatch flush()
 		{
 #if BS_DEBUG_MODE
 #if BS_THREAD_SUPPORT != 0
@@ -341,11 +446,7 @@ namespace bs
 #endif
 #endif
 
-			this->lock();
-			bs::Queue<QueuedCommand>* commands = CommandQueueBase::flush();
-			this->unlock();
-
-			return commands;
+			return CommandQueueBase::flush();
 		}
 
 		/** @copydoc CommandQueueBase::cancelAll */
@@ -358,9 +459,7 @@ namespace bs
 #endif
 #endif
 
-			this->lock();
 			CommandQueueBase::cancelAll();
-			this->unlock();
 		}
 
 		/** @copydoc CommandQueueBase::isEmpty */
@@ -373,11 +472,7 @@ namespace bs
 #endif
 #endif
 
-			this->lock();
-			bool empty = CommandQueueBase::isEmpty();
-			this->unlock();
-
-			return empty;
+			return CommandQueueBase::isEmpty();
 		}
 	};
 
@@ -129,7 +129,7 @@ namespace bs
 
 	void CoreObject::queueInitializeGpuCommand(const SPtr<ct::CoreObject>& obj)
 	{
-		std::function<void()> func = std::bind(&ct::CoreObject::initialize, obj.get());
+		std::function<void()> func = std::bind(&ct::CoreObject::_initializeIfScheduled, obj.get());
 
 		CoreThread::instance().queueCommand(std::bind(&CoreObject::executeGpuCommand, obj, func), CTQF_InternalQueue);
 	}
@@ -55,5 +55,13 @@ namespace bs
 	{
 		mThis = ptrThis;
 	}
+
+	void CoreObject::_initializeIfScheduled()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!isInitialized() && isScheduledToBeInitialized())
+			initialize();
+	}
 	}
 }
\ No newline at end of file
@@ -51,6 +51,15 @@ namespace bs
 		 */
 		void _setThisPtr(SPtr<CoreObject> ptrThis);
 
+		/**
+		 * Initializes the object if it is scheduled for initialization, but the core thread didn't yet execute the
+		 * queued initialization command. Allows the core thread to immediately use objects that other threads created
+		 * while it was waiting on them. The queued command does nothing if the object was already initialized.
+		 *
+		 * @note	Core thread only.
+		 */
+		void _initializeIfScheduled();
+
 		/** @} */
 
 	protected:
@@ -17,7 +17,6 @@ namespace bs
 		, mCoreThreadShutdown(false)
 		, mCoreThreadStarted(false)
 		, mCommandQueue(nullptr)
-		, mMaxCommandNotifyId(0)
 	{
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
 		{
@@ -93,10 +92,13 @@ namespace bs
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			CommandQueueBatch commands;
 			{
 				Lock lock(mCommandQueueMutex);
 
+				// Queuing commands doesn't lock the mutex, so let the queuing threads know they need to wake us up
+				mIsCoreThreadWaiting = true;
+
 				while(mCommandQueue->isEmpty())
 				{
 					if(mCoreThreadShutdown)
@@ -110,6 +112,7 @@ namespace bs
 					TaskScheduler::instance().removeWorker();
 				}
 
+				mIsCoreThreadWaiting = false;
 				commands = mCommandQueue->flush();
 			}
 
@@ -183,67 +186,17 @@ namespace bs
 		getQueue()->submitToCoreThread(blockUntilComplete);
 	}
 
-	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
+	void CoreThread::notifyCommandQueued()
 	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+		if(!mIsCoreThreadWaiting)
+			return;
 
-		if (!flags.isSet(CTQF_InternalQueue))
-			return getQueue()->queueReturnCommand(commandCallback);
-		else
+		// Lock to ensure the core thread either didn't yet check for new commands, or is already waiting on the signal
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			AsyncOp op;
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
-				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-
-			return op;
+			Lock lock(mCommandQueueMutex);
 		}
-	}
 
-	void CoreThread::queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags)
-	{
-		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
-
-		if (!flags.isSet(CTQF_InternalQueue))
-			getQueue()->queueCommand(commandCallback);
-		else
-		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
-
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
-				}
-				else
-					mCommandQueue->queue(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
-		}
+		mCommandReadyCondition.notify_all();
 	}
 
 	void CoreThread::update()
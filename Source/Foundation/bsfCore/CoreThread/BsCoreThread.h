@@ -88,7 +88,7 @@ namespace bs
 		/**
 		 * Queues a new command that will be added to the command queue. Command returns a value.
 		 * 		
-		 * @param[in]	commandCallback		Command to queue.
+		 * @param[in]	commandCallback		Command to queue. Any callable object accepting an AsyncOp& parameter.
 		 * @param[in]	flags				Flags that further control command submission.
 		 * @return							Structure that can be used to check if the command completed execution,
 		 *									and to retrieve the return value once it has.
@@ -96,18 +96,66 @@ namespace bs
 		 * @see		CommandQueue::queueReturn()
 		 * @note	Thread safe
 		 */
-		AsyncOp queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class T>
+		AsyncOp queueReturnCommand(T&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+				return getQueue()->queueReturnCommand(std::forward<T>(commandCallback));
+
+			AsyncOp op;
+			if (flags.isSet(CTQF_BlockUntilComplete))
+			{
+				const UINT32 commandId = mMaxCommandNotifyId.fetch_add(1);
+				op = mCommandQueue->queueReturn(std::forward<T>(commandCallback), true, commandId);
+
+				notifyCommandQueued();
+				blockUntilCommandCompleted(commandId);
+			}
+			else
+			{
+				op = mCommandQueue->queueReturn(std::forward<T>(commandCallback));
+				notifyCommandQueued();
+			}
+
+			return op;
+		}
 
 		/**
 		 * Queues a new command that will be added to the global command queue. 
 		 * 	
-		 * @param[in]	commandCallback		Command to queue.
+		 * @param[in]	commandCallback		Command to queue. Any callable object with no parameters.
 		 * @param[in]	flags				Flags that further control command submission.
 		 *
 		 * @see		CommandQueue::queue()
 		 * @note	Thread safe
 		 */
-		void queueCommand(std::function<void()> commandCallback, CoreThreadQueueFlags flags = CTQF_Default);
+		template<class T>
+		void queueCommand(T&& commandCallback, CoreThreadQueueFlags flags = CTQF_Default)
+		{
+			assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
+
+			if (!flags.isSet(CTQF_InternalQueue))
+			{
+				getQueue()->queueCommand(std::forward<T>(commandCallback));
+				return;
+			}
+
+			if (flags.isSet(CTQF_BlockUntilComplete))
+			{
+				const UINT32 commandId = mMaxCommandNotifyId.fetch_add(1);
+				mCommandQueue->queue(std::forward<T>(commandCallback), true, commandId);
+
+				notifyCommandQueued();
+				blockUntilCommandCompleted(commandId);
+			}
+			else
+			{
+				mCommandQueue->queue(std::forward<T>(commandCallback));
+				notifyCommandQueued();
+			}
+		}
 
 		/**
 		 * Called once every frame.
@@ -167,8 +215,9 @@ namespace bs
 		Signal mCoreThreadStartedCondition;
 
 		CommandQueue<CommandQueueSync>* mCommandQueue;
+		std::atomic<bool> mIsCoreThreadWaiting{false}; /**< True if core thread might be waiting for new commands. */
 
-		UINT32 mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
+		std::atomic<UINT32> mMaxCommandNotifyId{0}; /**< ID that will be assigned to the next command with a notifier callback. */
 		Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
 
 		/** Starts the core thread worker method. Should only be called once. */
@@ -183,6 +232,9 @@ namespace bs
 		/** Creates or retrieves a queue for the calling thread. */
 		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
 
+		/** Wakes up the core thread if it's waiting for commands on the internal command queue. */
+		void notifyCommandQueued();
+
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID 
 		 * actually exists, otherwise this will block forever.
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Managers/BsGpuProgramManager.h"
 #include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
 
 namespace bs
 {
@@ -92,6 +93,9 @@ namespace bs
 	GpuProgramManager::~GpuProgramManager()
 	{
 		bs_delete((NullProgramFactory*)mNullFactory);
+
+		if (mBytecodeCache)
+			bs_delete(mBytecodeCache);
 	}
 
 	void GpuProgramManager::addFactory(const String& language, GpuProgramFactory* factory)
@@ -146,7 +150,33 @@ namespace bs
 	SPtr<GpuProgramBytecode> GpuProgramManager::compileBytecode(const GPU_PROGRAM_DESC& desc)
 	{
 		GpuProgramFactory* factory = getFactory(desc.language);
-		return factory->compileBytecode(desc);
+
+		const String compilerId = factory->getCompilerId();
+		if (mBytecodeCache == nullptr || compilerId.empty())
+			return factory->compileBytecode(desc);
+
+		const UINT32 compilerVersion = factory->getCompilerVersion();
+		const UINT32 compilerFlags = factory->getCompilerFlags();
+		SPtr<GpuProgramBytecode> bytecode = mBytecodeCache->find(desc, compilerId, compilerVersion, compilerFlags);
+		if (bytecode != nullptr)
+			return bytecode;
+
+		bytecode = factory->compileBytecode(desc);
+		mBytecodeCache->store(desc, compilerId, compilerVersion, compilerFlags, bytecode);
+
+		return bytecode;
+	}
+
+	void GpuProgramManager::setBytecodeCacheFolder(const Path& folder)
+	{
+		if (mBytecodeCache)
+		{
+			bs_delete(mBytecodeCache);
+			mBytecodeCache = nullptr;
+		}
+
+		if (!folder.isEmpty())
+			mBytecodeCache = bs_new<GpuProgramBytecodeCache>(folder);
 	}
 	}
 }
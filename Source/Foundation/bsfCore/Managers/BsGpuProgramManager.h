@@ -49,6 +49,24 @@ namespace bs
 
 		/** @copydoc GpuProgram::compileBytecode */
 		virtual SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) = 0;
+
+		/** 
+		 * Returns the identifier of the compiler used by compileBytecode(). Bytecode compiled by this factory is only
+		 * stored in the bytecode cache if the identifier is not empty.
+		 */
+		virtual String getCompilerId() const { return StringUtil::BLANK; }
+
+		/** 
+		 * Returns the version of the compiler used by compileBytecode(). Cached bytecode compiled by a different version
+		 * of the compiler is not used.
+		 */
+		virtual UINT32 getCompilerVersion() const { return 0; }
+
+		/** 
+		 * Returns compiler specific flags used by compileBytecode() that affect the generated bytecode, such as debug
+		 * information or optimization level. Cached bytecode compiled with different flags is not used.
+		 */
+		virtual UINT32 getCompilerFlags() const { return 0; }
 	};
 
 	/**
@@ -81,9 +99,24 @@ namespace bs
 		/** @copydoc GpuProgram::create */
 		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
-		/** @copydoc GpuProgram::compileBytecode */
+		/** 
+		 * @copydoc GpuProgram::compileBytecode 
+		 *
+		 * @note	If a bytecode cache is enabled, the bytecode is retrieved from the cache when available, and newly
+		 *			compiled bytecode is stored in the cache. Thread safe.
+		 */
 		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc);
 
+		/** 
+		 * Enables a persistent cache of compiled GPU program bytecode, stored in the provided folder. Programs compiled
+		 * through compileBytecode() are then only compiled the first time, and loaded from the cache afterwards. Provide
+		 * an empty path to disable the cache. Must not be called while programs are being compiled on other threads.
+		 */
+		void setBytecodeCacheFolder(const Path& folder);
+
+		/** Returns the persistent bytecode cache, or null if the cache is not enabled. */
+		GpuProgramBytecodeCache* getBytecodeCache() const { return mBytecodeCache; }
+
 	protected:
 		friend class bs::GpuProgram;
 
@@ -102,6 +135,7 @@ namespace bs
 
 		UnorderedMap<String, GpuProgramFactory*> mFactories;
 		GpuProgramFactory* mNullFactory; /**< Factory for dealing with GPU programs that can't be created. */
+		GpuProgramBytecodeCache* mBytecodeCache = nullptr;
 	};
 	}
 	/** @} */
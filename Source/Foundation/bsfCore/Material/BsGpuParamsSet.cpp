@@ -828,6 +828,12 @@ namespace bs
 		return -1;
 	}
 
+	template<bool Core>
+	UINT32 TGpuParamsSet<Core>::getParamBlockBufferIndex(const ParamID& id) const
+	{
+		return mBlockIdLookup.find(id, [this, &id]() { return getParamBlockBufferIndex(id.getName()); });
+	}
+
 	template<bool Core>
 	void TGpuParamsSet<Core>::setParamBlockBuffer(UINT32 index, const ParamBlockPtrType& paramBlock,
 												  bool ignoreInUpdate)
@@ -880,6 +886,21 @@ namespace bs
 		setParamBlockBuffer(bufferIdx, paramBlock, ignoreInUpdate);
 	}
 
+	template<bool Core>
+	void TGpuParamsSet<Core>::setParamBlockBuffer(const ParamID& id, const ParamBlockPtrType& paramBlock, 
+		bool ignoreInUpdate)
+	{
+		UINT32 bufferIdx = getParamBlockBufferIndex(id);
+		if(bufferIdx == (UINT32)-1)
+		{
+			LOGERR("Cannot set parameter block buffer with the name \"" + String(id.c_str()) + 
+				"\". Buffer name not found. ");
+			return;
+		}
+
+		setParamBlockBuffer(bufferIdx, paramBlock, ignoreInUpdate);
+	}
+
 	template<bool Core>
 	void TGpuParamsSet<Core>::update(const SPtr<MaterialParamsType>& params, float t, bool updateAll)
 	{
@@ -123,6 +123,12 @@ namespace bs
 		 */
 		UINT32 getParamBlockBufferIndex(const String& name) const;
 
+		/** 
+		 * Equivalent to getParamBlockBufferIndex(const String&), except the buffer is looked up using a pre-hashed
+		 * identifier instead of a string name.
+		 */
+		UINT32 getParamBlockBufferIndex(const ParamID& id) const;
+
 		/**
 		 * Assign a parameter block buffer with the specified index to all the relevant child GpuParams.
 		 *
@@ -155,6 +161,12 @@ namespace bs
 		 */
 		void setParamBlockBuffer(const String& name, const ParamBlockPtrType& paramBlock, bool ignoreInUpdate = false);
 
+		/**
+		 * Equivalent to setParamBlockBuffer(const String&, const ParamBlockPtrType&, bool), except the buffer is looked
+		 * up using a pre-hashed identifier instead of a string name.
+		 */
+		void setParamBlockBuffer(const ParamID& id, const ParamBlockPtrType& paramBlock, bool ignoreInUpdate = false);
+
 		/** Returns the number of passes the set contains the parameters for. */
 		UINT32 getNumPasses() const { return (UINT32)mPassParams.size(); }
 
@@ -176,6 +188,7 @@ namespace bs
 
 		Vector<SPtr<GpuParamsType>> mPassParams;
 		Vector<BlockInfo> mBlocks;
+		ParamIDLookup mBlockIdLookup;
 		Vector<DataParamInfo> mDataParamInfos;
 		PassParamInfo* mPassParamInfos;
 
@@ -213,6 +213,30 @@ namespace bs
 		return TMaterialParamSampState<Core>(name, getMaterialPtr(this));
 	}
 
+	template<bool Core>
+	TMaterialParamTexture<Core> TMaterial<Core>::getParamTexture(const ParamID& id) const
+	{
+		throwIfNotInitialized();
+
+		return TMaterialParamTexture<Core>(id, getMaterialPtr(this));
+	}
+
+	template<bool Core>
+	TMaterialParamBuffer<Core> TMaterial<Core>::getParamBuffer(const ParamID& id) const
+	{
+		throwIfNotInitialized();
+
+		return TMaterialParamBuffer<Core>(id, getMaterialPtr(this));
+	}
+
+	template<bool Core>
+	TMaterialParamSampState<Core> TMaterial<Core>::getParamSamplerState(const ParamID& id) const
+	{
+		throwIfNotInitialized();
+
+		return TMaterialParamSampState<Core>(id, getMaterialPtr(this));
+	}
+
 	template<bool Core>
 	void TMaterial<Core>::initializeTechniques(bool allVariations, const ShaderVariation& variation)
 	{
@@ -373,6 +397,15 @@ namespace bs
 		output = TMaterialDataParam<T, Core>(name, getMaterialPtr(this));
 	}
 
+	template <bool Core>
+	template <typename T>
+	void TMaterial<Core>::getParam(const ParamID& id, TMaterialDataParam<T, Core>& output) const
+	{
+		throwIfNotInitialized();
+
+		output = TMaterialDataParam<T, Core>(id, getMaterialPtr(this));
+	}
+
 	template<bool Core>
 	void TMaterial<Core>::throwIfNotInitialized() const
 	{
@@ -428,6 +461,43 @@ namespace bs
 	template BS_CORE_EXPORT void TMaterial<true>::getParam(const String&, TMaterialDataParam<Matrix4x2, true>&) const;
 	template BS_CORE_EXPORT void TMaterial<true>::getParam(const String&, TMaterialDataParam<Matrix4x3, true>&) const;
 
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<float, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<int, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Color, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector2, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector3, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector4, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector2I, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector3I, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Vector4I, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix2, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix2x3, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix2x4, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix3, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix3x2, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix3x4, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix4, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix4x2, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<false>::getParam(const ParamID&, TMaterialDataParam<Matrix4x3, false>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<float, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<int, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Color, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector2, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector3, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector4, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector2I, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector3I, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Vector4I, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix2, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix2x3, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix2x4, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix3, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix3x2, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix3x4, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix4, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix4x2, true>&) const;
+	template BS_CORE_EXPORT void TMaterial<true>::getParam(const ParamID&, TMaterialDataParam<Matrix4x3, true>&) const;
+
 	Material::Material()
 		:mLoadFlags(Load_None)
 	{ }
@@ -430,6 +430,89 @@ namespace bs
 			return data;
 		}
 
+		/** 
+		 * @name Parameter access by identifier
+		 * Equivalents of the set* and get* methods above that look up the parameter using a pre-hashed identifier instead
+		 * of a string name. Identifiers should be created once and re-used, in which case the lookup doesn't need to hash
+		 * or compare any strings.
+		 * @{
+		 */
+
+		/** @copydoc setFloat(const String&, float, UINT32) */
+		void setFloat(const ParamID& id, float value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setColor(const String&, const Color&, UINT32) */
+		void setColor(const ParamID& id, const Color& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setVec2(const String&, const Vector2&, UINT32) */
+		void setVec2(const ParamID& id, const Vector2& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setVec3(const String&, const Vector3&, UINT32) */
+		void setVec3(const ParamID& id, const Vector3& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setVec4(const String&, const Vector4&, UINT32) */
+		void setVec4(const ParamID& id, const Vector4& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setMat3(const String&, const Matrix3&, UINT32) */
+		void setMat3(const ParamID& id, const Matrix3& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setMat4(const String&, const Matrix4&, UINT32) */
+		void setMat4(const ParamID& id, const Matrix4& value, UINT32 arrayIdx = 0) { setDataParam(id, value, arrayIdx); }
+
+		/** @copydoc setTexture(const String&, const TextureType&, const TextureSurface&) */
+		void setTexture(const ParamID& id, const TextureType& value, const TextureSurface& surface = TextureSurface::COMPLETE)
+		{
+			return getParamTexture(id).set(value, surface);
+		}
+
+		/** @copydoc setBuffer(const String&, const BufferType&) */
+		void setBuffer(const ParamID& id, const BufferType& value) { return getParamBuffer(id).set(value); }
+
+		/** @copydoc setSamplerState(const String&, const SamplerStateType&) */
+		void setSamplerState(const ParamID& id, const SamplerStateType& value) { return getParamSamplerState(id).set(value); }
+
+		/** @copydoc getFloat(const String&, UINT32) const */
+		float getFloat(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<float>(id, arrayIdx); }
+
+		/** @copydoc getColor(const String&, UINT32) const */
+		Color getColor(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Color>(id, arrayIdx); }
+
+		/** @copydoc getVec2(const String&, UINT32) const */
+		Vector2 getVec2(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Vector2>(id, arrayIdx); }
+
+		/** @copydoc getVec3(const String&, UINT32) const */
+		Vector3 getVec3(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Vector3>(id, arrayIdx); }
+
+		/** @copydoc getVec4(const String&, UINT32) const */
+		Vector4 getVec4(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Vector4>(id, arrayIdx); }
+
+		/** @copydoc getMat3(const String&, UINT32) const */
+		Matrix3 getMat3(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Matrix3>(id, arrayIdx); }
+
+		/** @copydoc getMat4(const String&, UINT32) const */
+		Matrix4 getMat4(const ParamID& id, UINT32 arrayIdx = 0) const { return getDataParam<Matrix4>(id, arrayIdx); }
+
+		/** @copydoc getTexture(const String&) const */
+		TextureType getTexture(const ParamID& id) const { return getParamTexture(id).get(); }
+
+		/** @copydoc getSamplerState(const String&) const */
+		SamplerStateType getSamplerState(const ParamID& id) const { return getParamSamplerState(id).get(); }
+
+		/** @copydoc getParamTexture(const String&) const */
+		TMaterialParamTexture<Core> getParamTexture(const ParamID& id) const;
+
+		/** @copydoc getParamBuffer(const String&) const */
+		TMaterialParamBuffer<Core> getParamBuffer(const ParamID& id) const;
+
+		/** @copydoc getParamSamplerState(const String&) const */
+		TMaterialParamSampState<Core> getParamSamplerState(const ParamID& id) const;
+
+		/** @copydoc getParam(const String&, TMaterialDataParam<T, Core>&) const */
+		template <typename T>
+		void getParam(const ParamID& id, TMaterialDataParam<T, Core>& output) const;
+
+		/** @} */
+
 		/**
 		 * Returns a handle that allows you to assign a constant value to a floating point parameter. This handle 
 		 * may be used for more efficiently getting/setting GPU parameter values than calling 
@@ -685,6 +768,26 @@ namespace bs
 
 		/** @} */
 	protected:
+		/** Assigns a value to the data parameter with the specified identifier. */
+		template <typename T>
+		void setDataParam(const ParamID& id, const T& value, UINT32 arrayIdx)
+		{
+			TMaterialDataParam<T, Core> param;
+			getParam(id, param);
+
+			param.set(value, arrayIdx);
+		}
+
+		/** Returns a value of the data parameter with the specified identifier. */
+		template <typename T>
+		T getDataParam(const ParamID& id, UINT32 arrayIdx) const
+		{
+			TMaterialDataParam<T, Core> param;
+			getParam(id, param);
+
+			return param.get(arrayIdx);
+		}
+
 		/**
 		 * Assigns a value from a raw buffer to the parameter with the specified name. Buffer must be of sizeof(T) * 
 		 * numElements size and initialized.
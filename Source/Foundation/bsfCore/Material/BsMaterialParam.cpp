@@ -33,6 +33,31 @@ namespace bs
 		}
 	}
 
+	template<int DATA_TYPE, bool Core>
+	TMaterialDataCommon<DATA_TYPE, Core>::TMaterialDataCommon(const ParamID& id, const MaterialPtrType& material)
+		:mParamIndex(0), mArraySize(0), mMaterial(nullptr)
+	{
+		if(material != nullptr)
+		{
+			SPtr<MaterialParamsType> params = material->_getInternalParams();
+
+			UINT32 paramIndex;
+			auto result = params->getParamIndex(id, MaterialParams::ParamType::Data, (GpuParamDataType)DATA_TYPE, 0, 
+				paramIndex);
+
+			if (result == MaterialParams::GetParamResult::Success)
+			{
+				const MaterialParams::ParamData* data = params->getParamData(paramIndex);
+
+				mMaterial = material;
+				mParamIndex = paramIndex;
+				mArraySize = data->arraySize;
+			}
+			else
+				params->reportGetParamError(result, id, 0);
+		}
+	}
+
 	template<class T, bool Core>
 	void TMaterialDataParam<T, Core>::set(const T& value, UINT32 arrayIdx) const
 	{
@@ -200,6 +225,27 @@ namespace bs
 		}
 	}
 
+	template<bool Core>
+	TMaterialParamTexture<Core>::TMaterialParamTexture(const ParamID& id, const MaterialPtrType& material)
+		:mParamIndex(0), mMaterial(nullptr)
+	{
+		if (material != nullptr)
+		{
+			SPtr<MaterialParamsType> params = material->_getInternalParams();
+
+			UINT32 paramIndex;
+			auto result = params->getParamIndex(id, MaterialParams::ParamType::Texture, GPDT_UNKNOWN, 0, paramIndex);
+
+			if (result == MaterialParams::GetParamResult::Success)
+			{
+				mMaterial = material;
+				mParamIndex = paramIndex;
+			}
+			else
+				params->reportGetParamError(result, id, 0);
+		}
+	}
+
 	template<bool Core>
 	void TMaterialParamTexture<Core>::set(const TextureType& texture, const TextureSurface& surface) const
 	{
@@ -370,6 +416,27 @@ namespace bs
 		}
 	}
 
+	template<bool Core>
+	TMaterialParamBuffer<Core>::TMaterialParamBuffer(const ParamID& id, const MaterialPtrType& material)
+		:mParamIndex(0), mMaterial(nullptr)
+	{
+		if (material != nullptr)
+		{
+			SPtr<MaterialParamsType> params = material->_getInternalParams();
+
+			UINT32 paramIndex;
+			auto result = params->getParamIndex(id, MaterialParams::ParamType::Buffer, GPDT_UNKNOWN, 0, paramIndex);
+
+			if (result == MaterialParams::GetParamResult::Success)
+			{
+				mMaterial = material;
+				mParamIndex = paramIndex;
+			}
+			else
+				params->reportGetParamError(result, id, 0);
+		}
+	}
+
 	template<bool Core>
 	void TMaterialParamBuffer<Core>::set(const BufferType& buffer) const
 	{
@@ -419,6 +486,27 @@ namespace bs
 		}
 	}
 
+	template<bool Core>
+	TMaterialParamSampState<Core>::TMaterialParamSampState(const ParamID& id, const MaterialPtrType& material)
+		:mParamIndex(0), mMaterial(nullptr)
+	{
+		if (material != nullptr)
+		{
+			SPtr<MaterialParamsType> params = material->_getInternalParams();
+
+			UINT32 paramIndex;
+			auto result = params->getParamIndex(id, MaterialParams::ParamType::Sampler, GPDT_UNKNOWN, 0, paramIndex);
+
+			if (result == MaterialParams::GetParamResult::Success)
+			{
+				mMaterial = material;
+				mParamIndex = paramIndex;
+			}
+			else
+				params->reportGetParamError(result, id, 0);
+		}
+	}
+
 	template<bool Core>
 	void TMaterialParamSampState<Core>::set(const SamplerStateType& sampState) const
 	{
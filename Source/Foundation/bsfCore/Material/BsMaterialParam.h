@@ -41,6 +41,7 @@ namespace bs
 	public:
 		TMaterialDataCommon() = default;
 		TMaterialDataCommon(const String& name, const MaterialPtrType& material);
+		TMaterialDataCommon(const ParamID& id, const MaterialPtrType& material);
 
 		/** Checks if param is initialized. */
 		bool operator==(const std::nullptr_t& nullval) const
@@ -146,6 +147,7 @@ namespace bs
 
 	public:
 		TMaterialParamTexture(const String& name, const MaterialPtrType& material);
+		TMaterialParamTexture(const ParamID& id, const MaterialPtrType& material);
 		TMaterialParamTexture() { }
 
 		/** @copydoc GpuParamTexture::set */
@@ -234,6 +236,7 @@ namespace bs
 
 	public:
 		TMaterialParamBuffer(const String& name, const MaterialPtrType& material);
+		TMaterialParamBuffer(const ParamID& id, const MaterialPtrType& material);
 		TMaterialParamBuffer() { }
 
 		/** @copydoc GpuParamBuffer::set */
@@ -263,6 +266,7 @@ namespace bs
 
 	public:
 		TMaterialParamSampState(const String& name, const MaterialPtrType& material);
+		TMaterialParamSampState(const ParamID& id, const MaterialPtrType& material);
 		TMaterialParamSampState() { }
 
 		/** @copydoc GpuParamSampState::set */
@@ -207,37 +207,64 @@ namespace bs
 		return iterFind->second;
 	}
 
+	UINT32 MaterialParamsBase::getParamIndex(const ParamID& id) const
+	{
+		return mParamIdLookup.find(id, [this, &id]() { return getParamIndex(id.getName()); });
+	}
+
 	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamIndex(const String& name, ParamType type,
 		GpuParamDataType dataType, UINT32 arrayIdx, UINT32& output) const
 	{
-		auto iterFind = mParamLookup.find(name);
-		if (iterFind == mParamLookup.end())
+		UINT32 index = getParamIndex(name);
+		if (index == (UINT32)-1)
 			return GetParamResult::NotFound;
 
-		UINT32 index = iterFind->second;
-		const ParamData& param = mParams[index];
-		
-		if (param.type != type || (type == ParamType::Data && param.dataType != dataType))
-			return GetParamResult::InvalidType;
+		GetParamResult result = validateParam(mParams[index], type, dataType, arrayIdx);
+		if (result == GetParamResult::Success)
+			output = index;
 
-		if (arrayIdx >= param.arraySize)
-			return GetParamResult::IndexOutOfBounds;
+		return result;
+	}
 
-		output = index;
-		return GetParamResult::Success;
+	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamIndex(const ParamID& id, ParamType type,
+		GpuParamDataType dataType, UINT32 arrayIdx, UINT32& output) const
+	{
+		UINT32 index = getParamIndex(id);
+		if (index == (UINT32)-1)
+			return GetParamResult::NotFound;
+
+		GetParamResult result = validateParam(mParams[index], type, dataType, arrayIdx);
+		if (result == GetParamResult::Success)
+			output = index;
+
+		return result;
 	}
 
 	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamData(const String& name, ParamType type, 
 		GpuParamDataType dataType, UINT32 arrayIdx, const ParamData** output) const
 	{
-		auto iterFind = mParamLookup.find(name);
-		if (iterFind == mParamLookup.end())
+		UINT32 index = getParamIndex(name);
+		if (index == (UINT32)-1)
 			return GetParamResult::NotFound;
 
-		UINT32 index = iterFind->second;
-		const ParamData& param = mParams[index];
-		*output = &param;
+		*output = &mParams[index];
+		return validateParam(mParams[index], type, dataType, arrayIdx);
+	}
+
+	MaterialParamsBase::GetParamResult MaterialParamsBase::getParamData(const ParamID& id, ParamType type, 
+		GpuParamDataType dataType, UINT32 arrayIdx, const ParamData** output) const
+	{
+		UINT32 index = getParamIndex(id);
+		if (index == (UINT32)-1)
+			return GetParamResult::NotFound;
 
+		*output = &mParams[index];
+		return validateParam(mParams[index], type, dataType, arrayIdx);
+	}
+
+	MaterialParamsBase::GetParamResult MaterialParamsBase::validateParam(const ParamData& param, ParamType type, 
+		GpuParamDataType dataType, UINT32 arrayIdx) const
+	{
 		if (param.type != type || (type == ParamType::Data && param.dataType != dataType))
 			return GetParamResult::InvalidType;
 
@@ -558,6 +585,90 @@ namespace bs
 		setSamplerState(*param, value);
 	}
 
+	template<bool Core>
+	void TMaterialParams<Core>::getTexture(const ParamID& id, TextureType& value, TextureSurface& surface) const
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		getTexture(*param, value, surface);
+	}
+
+	template<bool Core>
+	void TMaterialParams<Core>::setTexture(const ParamID& id, const TextureType& value, const TextureSurface& surface)
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Texture, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		setTexture(*param, value, surface);
+	}
+
+	template<bool Core>
+	void TMaterialParams<Core>::getBuffer(const ParamID& id, BufferType& value) const
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Buffer, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		getBuffer(*param, value);
+	}
+
+	template<bool Core>
+	void TMaterialParams<Core>::setBuffer(const ParamID& id, const BufferType& value)
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Buffer, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		setBuffer(*param, value);
+	}
+
+	template<bool Core>
+	void TMaterialParams<Core>::getSamplerState(const ParamID& id, SamplerType& value) const
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Sampler, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		getSamplerState(*param, value);
+	}
+
+	template<bool Core>
+	void TMaterialParams<Core>::setSamplerState(const ParamID& id, const SamplerType& value)
+	{
+		const ParamData* param = nullptr;
+		GetParamResult result = getParamData(id, ParamType::Sampler, GPDT_UNKNOWN, 0, &param);
+		if (result != GetParamResult::Success)
+		{
+			reportGetParamError(result, id, 0);
+			return;
+		}
+
+		setSamplerState(*param, value);
+	}
+
 	template<bool Core>
 	void TMaterialParams<Core>::getStructData(const ParamData& param, void* value, UINT32 size, UINT32 arrayIdx) const
 	{
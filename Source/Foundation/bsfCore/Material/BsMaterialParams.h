@@ -143,6 +143,46 @@ namespace bs
 			memcpy(&mDataParamsBuffer[paramInfo.offset], input, sizeof(paramTypeSize));
 		}
 
+		/**
+		 * Equivalent to getDataParam(const String&, UINT32, T&) except the parameter is looked up using a pre-hashed
+		 * identifier instead of a string name.
+		 */
+		template <typename T>
+		void getDataParam(const ParamID& id, UINT32 arrayIdx, T& output) const
+		{
+			GpuParamDataType dataType = (GpuParamDataType)TGpuDataParamInfo<T>::TypeId;
+
+			const ParamData* param = nullptr;
+			auto result = getParamData(id, ParamType::Data, dataType, arrayIdx, &param);
+			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, id, arrayIdx);
+				return;
+			}
+
+			getDataParam(*param, arrayIdx, output);
+		}
+
+		/**
+		 * Equivalent to setDataParam(const String&, UINT32, const T&) except the parameter is looked up using a
+		 * pre-hashed identifier instead of a string name.
+		 */
+		template <typename T>
+		void setDataParam(const ParamID& id, UINT32 arrayIdx, const T& input) const
+		{
+			GpuParamDataType dataType = (GpuParamDataType)TGpuDataParamInfo<T>::TypeId;
+
+			const ParamData* param = nullptr;
+			auto result = getParamData(id, ParamType::Data, dataType, arrayIdx, &param);
+			if (result != GetParamResult::Success)
+			{
+				reportGetParamError(result, id, arrayIdx);
+				return;
+			}
+
+			setDataParam(*param, arrayIdx, input);
+		}
+
 		/**
 		 * Returns the animation curve assigned to a shader data parameter with the specified name at the specified array
 		 * index. If the parameter name, index or type is not valid a warning will be logged and output value will not be 
@@ -221,6 +261,12 @@ namespace bs
 		 */
 		UINT32 getParamIndex(const String& name) const;
 
+		/** 
+		 * Equivalent to getParamIndex(const String&) except the parameter is looked up using a pre-hashed identifier
+		 * instead of a string name.
+		 */
+		UINT32 getParamIndex(const ParamID& id) const;
+
 		/** 
 		 * Returns an index of the parameter with the specified name. Index can be used in a call to getParamData(UINT32) to
 		 * get the actual parameter data.
@@ -237,6 +283,13 @@ namespace bs
 		GetParamResult getParamIndex(const String& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
 			UINT32& output) const;
 
+		/** 
+		 * Equivalent to getParamIndex(const String&, ParamType, GpuParamDataType, UINT32, UINT32&) except the parameter
+		 * is looked up using a pre-hashed identifier instead of a string name.
+		 */
+		GetParamResult getParamIndex(const ParamID& id, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
+			UINT32& output) const;
+
 		/**
 		 * Returns data about a parameter and reports an error if there is a type or size mismatch, or if the parameter
 		 * does exist.
@@ -255,6 +308,13 @@ namespace bs
 		GetParamResult getParamData(const String& name, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
 			const ParamData** output) const;
 
+		/**
+		 * Equivalent to getParamData(const String&, ParamType, GpuParamDataType, UINT32, const ParamData**) except the
+		 * parameter is looked up using a pre-hashed identifier instead of a string name.
+		 */
+		GetParamResult getParamData(const ParamID& id, ParamType type, GpuParamDataType dataType, UINT32 arrayIdx,
+			const ParamData** output) const;
+
 		/**
 		 * Returns information about a parameter at the specified global index, as retrieved by getParamIndex(). 
 		 */
@@ -272,6 +332,12 @@ namespace bs
 		 */
 		void reportGetParamError(GetParamResult errorCode, const String& name, UINT32 arrayIdx) const;
 
+		/** @copydoc reportGetParamError(GetParamResult, const String&, UINT32) const */
+		void reportGetParamError(GetParamResult errorCode, const ParamID& id, UINT32 arrayIdx) const
+		{
+			reportGetParamError(errorCode, String(id.c_str()), arrayIdx);
+		}
+
 		/**
 		 * Equivalent to getDataParam(const String&, UINT32, T&) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
@@ -392,9 +458,14 @@ namespace bs
 		UINT64 getParamVersion() const { return mParamVersion; }
 
 	protected:
+		/** Checks if the parameter matches the requested type and array index. */
+		GetParamResult validateParam(const ParamData& param, ParamType type, GpuParamDataType dataType, 
+			UINT32 arrayIdx) const;
+
 		const static UINT32 STATIC_BUFFER_SIZE = 256;
 
 		UnorderedMap<String, UINT32> mParamLookup;
+		ParamIDLookup mParamIdLookup;
 		Vector<ParamData> mParams;
 
 		DataParamInfo* mDataParams = nullptr;
@@ -582,6 +653,19 @@ namespace bs
 		void setTexture(const String& name, const TextureType& value, 
 						const TextureSurface& surface = TextureSurface::COMPLETE);
 
+		/**
+		 * Equivalent to getTexture(const String&, TextureType&, TextureSurface&) except the parameter is looked up using
+		 * a pre-hashed identifier instead of a string name.
+		 */
+		void getTexture(const ParamID& id, TextureType& value, TextureSurface& surface) const;
+
+		/**
+		 * Equivalent to setTexture(const String&, const TextureType&, const TextureSurface&) except the parameter is
+		 * looked up using a pre-hashed identifier instead of a string name.
+		 */
+		void setTexture(const ParamID& id, const TextureType& value, 
+						const TextureSurface& surface = TextureSurface::COMPLETE);
+
 		/**
 		 * Returns the value of a shader texture parameter with the specified name as a sprite texture. If the parameter
 		 * name or type is not valid a warning will be logged and output value will not be retrieved. If the assigned
@@ -639,6 +723,18 @@ namespace bs
 		 */
 		void setBuffer(const String& name, const BufferType& value);
 
+		/**
+		 * Equivalent to getBuffer(const String&, BufferType&) except the parameter is looked up using a pre-hashed
+		 * identifier instead of a string name.
+		 */
+		void getBuffer(const ParamID& id, BufferType& value) const;
+
+		/**
+		 * Equivalent to setBuffer(const String&, const BufferType&) except the parameter is looked up using a pre-hashed
+		 * identifier instead of a string name.
+		 */
+		void setBuffer(const ParamID& id, const BufferType& value);
+
 		/**
 		 * Sets the value of a shader sampler state parameter with the specified name. If the parameter name or type is not
 		 * valid a warning will be logged and output value will not be set.
@@ -657,6 +753,18 @@ namespace bs
 		 */
 		void setSamplerState(const String& name, const SamplerType& value);
 
+		/**
+		 * Equivalent to getSamplerState(const String&, SamplerType&) except the parameter is looked up using a pre-hashed
+		 * identifier instead of a string name.
+		 */
+		void getSamplerState(const ParamID& id, SamplerType& value) const;
+
+		/**
+		 * Equivalent to setSamplerState(const String&, const SamplerType&) except the parameter is looked up using a
+		 * pre-hashed identifier instead of a string name.
+		 */
+		void setSamplerState(const ParamID& id, const SamplerType& value);
+
 		/**
 		 * Equivalent to getStructData(const String&, UINT32, void*, UINT32) except it uses the internal parameter reference
 		 * directly, avoiding the name lookup. Caller must guarantee the parameter reference is valid and belongs to this
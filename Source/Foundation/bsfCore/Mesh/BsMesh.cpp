@@ -271,6 +271,7 @@ namespace bs
 		: MeshBase(desc.numVertices, desc.numIndices, desc.subMeshes), mVertexData(nullptr), mIndexBuffer(nullptr)
 		, mVertexDesc(desc.vertexDesc), mUsage(desc.usage), mIndexType(desc.indexType), mDeviceMask(deviceMask)
 		, mTempInitialMeshData(initialMeshData), mSkeleton(desc.skeleton), mMorphShapes(desc.morphShapes)
+		, mDataVersion(0)
 
 	{ }
 
@@ -457,6 +458,8 @@ namespace bs
 
 		if (performUpdateBounds)
 			updateBounds(meshData);
+
+		mDataVersion++;
 	}
 
 	void Mesh::readData(MeshData& meshData, UINT32 deviceIdx, UINT32 queueIdx)
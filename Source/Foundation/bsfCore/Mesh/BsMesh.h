@@ -295,6 +295,12 @@ namespace bs
 		/** Returns an object containing all shapes used for morph animation, if any are available. */
 		SPtr<MorphShapes> getMorphShapes() const { return mMorphShapes; }
 
+		/**
+		 * Returns a counter that increments every time new data is written to the mesh. Allows systems that cache data
+		 * derived from the mesh contents to detect when it needs to be rebuilt.
+		 */
+		UINT32 getDataVersion() const { return mDataVersion; }
+
 		/**
 		 * Updates the current mesh with the provided data.
 		 *
@@ -392,6 +398,7 @@ namespace bs
 		SPtr<MeshData> mTempInitialMeshData;
 		SPtr<Skeleton> mSkeleton; // Immutable
 		SPtr<MorphShapes> mMorphShapes; // Immutable
+		UINT32 mDataVersion;
 	};
 
 	/** @} */
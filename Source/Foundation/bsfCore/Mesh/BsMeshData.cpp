@@ -15,13 +15,14 @@
 namespace bs
 {
 	MeshData::MeshData(UINT32 numVertices, UINT32 numIndexes, const SPtr<VertexDataDesc>& vertexData, IndexType indexType)
-	   :mNumVertices(numVertices), mNumIndices(numIndexes), mIndexType(indexType), mVertexData(vertexData)
+	   :GpuResourceData(MemoryCategory::Mesh), mNumVertices(numVertices), mNumIndices(numIndexes), mIndexType(indexType)
+	   , mVertexData(vertexData)
 	{
 		allocateInternalBuffer();
 	}
 
 	MeshData::MeshData()
-		:mNumVertices(0), mNumIndices(0), mIndexType(IT_32BIT)
+		:GpuResourceData(MemoryCategory::Mesh), mNumVertices(0), mNumIndices(0), mIndexType(IT_32BIT)
 	{ }
 
 	MeshData::~MeshData()
@@ -350,87 +350,67 @@ namespace bs
 		simulationData.cpuData.clear();
 		simulationData.gpuData.clear();
 
-		// Queue evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mSystems.size();
-		}
-
 		float timeDelta = gTime().getFrameDelta();
 
 		ParticleSimulationDataPool& simDataPool = m->simDataPool[mWriteBufferIdx];
 		simDataPool.clear();
 
-		for (auto& system : mSystems)
+		// Evaluate all systems in parallel
+		mSystemList.assign(mSystems.begin(), mSystems.end());
+
+		const auto evaluateWorker = [this, timeDelta, &animData, &simDataPool, &simulationData](UINT32 idx)
 		{
-			const auto evaluateWorker = [this, timeDelta, system, &animData, &simDataPool, &simulationData]()
+			ParticleSystem* system = mSystemList[idx];
+
+			// Advance the simulation
+			system->_simulate(timeDelta, &animData);
+
+			ParticleCPUSimulationData* simulationDataCPU = nullptr;
+			ParticleGPUSimulationData* simulationDataGPU = nullptr;
+			if(system->mParticleSet)
 			{
-				// Advance the simulation
-				system->_simulate(timeDelta, &animData);
+				// Generate simulation data to transfer to the core thread
+				const UINT32 numParticles = system->mParticleSet->getParticleCount();
 
-				ParticleCPUSimulationData* simulationDataCPU = nullptr;
-				ParticleGPUSimulationData* simulationDataGPU = nullptr;
-				if(system->mParticleSet)
+				if(system->getSettings().gpuSimulation)
 				{
-					// Generate simulation data to transfer to the core thread
-					const UINT32 numParticles = system->mParticleSet->getParticleCount();
-
-					if(system->getSettings().gpuSimulation)
-					{
-						simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
-					}
-					else
-					{
-						simulationDataCPU = simDataPool.allocCPU(*system->mParticleSet);
-						simulationDataCPU->numParticles = numParticles;
-						simulationDataCPU->bounds = system->_calculateBounds();
-
-						// If using a camera-independant sorting mode, sort the particles right away
-						const ParticleSystemSettings& settings = system->getSettings();
-						switch (settings.sortMode)
-						{
-						default:
-						case ParticleSortMode::None: // No sort, just point the indices back to themselves
-							for (UINT32 i = 0; i < numParticles; i++)
-								simulationDataCPU->indices[i] = i;
-							break;
-						case ParticleSortMode::OldToYoung:
-						case ParticleSortMode::YoungToOld:
-							sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
-							break;
-						case ParticleSortMode::Distance: break;
-						}
-					}
+					simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
 				}
-
+				else
 				{
-					Lock lock(mMutex);
+					simulationDataCPU = simDataPool.allocCPU(*system->mParticleSet);
+					simulationDataCPU->numParticles = numParticles;
+					simulationDataCPU->bounds = system->_calculateBounds();
 
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-
-					if(simulationDataCPU)
-						simulationData.cpuData[system->mId] = simulationDataCPU;
-					else if(simulationDataGPU)
-						simulationData.gpuData[system->mId] = simulationDataGPU;
+					// If using a camera-independant sorting mode, sort the particles right away
+					const ParticleSystemSettings& settings = system->getSettings();
+					switch (settings.sortMode)
+					{
+					default:
+					case ParticleSortMode::None: // No sort, just point the indices back to themselves
+						for (UINT32 i = 0; i < numParticles; i++)
+							simulationDataCPU->indices[i] = i;
+						break;
+					case ParticleSortMode::OldToYoung:
+					case ParticleSortMode::YoungToOld:
+						sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
+						break;
+					case ParticleSortMode::Distance: break;
+					}
 				}
+			}
 
-				mWorkerDoneSignal.notify_one();
-			};
-
-			SPtr<Task> task = Task::create("ParticleWorker", evaluateWorker);
-			TaskScheduler::instance().addTask(task);
-		}
+			{
+				Lock lock(mMutex);
 
-		// Wait for tasks to complete
-		TaskScheduler::instance().addWorker(); // Make the current core available for work (since this thread waits)
-		{
-			Lock lock(mMutex);
+				if(simulationDataCPU)
+					simulationData.cpuData[system->mId] = simulationDataCPU;
+				else if(simulationDataGPU)
+					simulationData.gpuData[system->mId] = simulationDataGPU;
+			}
+		};
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
-		}
-		TaskScheduler::instance().removeWorker();
+		TaskScheduler::instance().parallelFor(0, (UINT32)mSystemList.size(), 0, evaluateWorker);
 
 		mSwapBuffers = true;
 
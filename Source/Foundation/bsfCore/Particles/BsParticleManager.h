@@ -134,13 +134,13 @@ namespace bs
 		// Worker threads
 		ParticleSimulationData mSimulationData[CoreThread::NUM_SYNC_BUFFERS];
 
+		Vector<ParticleSystem*> mSystemList;
+
 		UINT32 mReadBufferIdx = 1;
 		UINT32 mWriteBufferIdx = 0;
 		
-		Signal mWorkerDoneSignal;
 		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
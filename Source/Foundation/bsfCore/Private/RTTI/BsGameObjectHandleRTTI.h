@@ -27,7 +27,7 @@ namespace bs
 			return invalidId;
 		}
 
-		void setInstanceId(GameObjectHandleBase* obj, UINT64& value) { mOriginalInstanceId = value; } 
+		void setInstanceId(GameObjectHandleBase* obj, UINT64& value) { getOriginalInstanceId() = value; } 
 
 	public:
 		GameObjectHandleRTTI()
@@ -38,7 +38,7 @@ namespace bs
 		void onDeserializationEnded(IReflectable* obj, const UnorderedMap<String, UINT64>& params) override
 		{
 			GameObjectHandleBase* gameObjectHandle = static_cast<GameObjectHandleBase*>(obj);
-			GameObjectManager::instance().registerUnresolvedHandle(mOriginalInstanceId, *gameObjectHandle);
+			GameObjectManager::instance().registerUnresolvedHandle(getOriginalInstanceId(), *gameObjectHandle);
 		}
 
 		const String& getRTTIName() override
@@ -60,7 +60,11 @@ namespace bs
 		}
 
 	private:
-		UINT64 mOriginalInstanceId;
+		/** 
+		 * Returns the original ID of the handle currently being deserialized. Thread local, as handles can be
+		 * deserialized on multiple threads at once.
+		 */
+		static UINT64& getOriginalInstanceId();
 	};
 
 	/** @} */
@@ -25,6 +25,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(messages, 3)
 			BS_RTTI_MEMBER_PLAIN(compilerId, 4)
 			BS_RTTI_MEMBER_PLAIN(compilerVersion, 5)
+			BS_RTTI_MEMBER_PLAIN(compilerFlags, 6)
 		BS_END_RTTI_MEMBERS
 
 	public:
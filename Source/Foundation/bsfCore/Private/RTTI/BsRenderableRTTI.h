@@ -23,6 +23,7 @@ namespace bs
 			BS_RTTI_MEMBER_REFL(mMesh, 3)
 			BS_RTTI_MEMBER_PLAIN(mLayer, 4)
 			BS_RTTI_MEMBER_REFL_ARRAY(mMaterials, 5)
+			BS_RTTI_MEMBER_PLAIN(mIsOccluder, 6)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -24,7 +24,7 @@ namespace bs
 			obj->mNumBones = size;
 
 			assert(obj->mInvBindPoses == nullptr);
-			obj->mInvBindPoses = bs_newN<Matrix4>(size);
+			obj->mInvBindPoses = bs_newN<Matrix4>(size, MemoryCategory::Animation);
 		}
 
 		SkeletonBoneInfo& getBoneInfo(Skeleton* obj, UINT32 idx) { return obj->mBoneInfo[idx]; }
@@ -35,7 +35,7 @@ namespace bs
 			obj->mNumBones = size;
 
 			assert(obj->mBoneInfo == nullptr);
-			obj->mBoneInfo = bs_newN<SkeletonBoneInfo>(size);
+			obj->mBoneInfo = bs_newN<SkeletonBoneInfo>(size, MemoryCategory::Animation);
 		}
 
 		Transform& getBoneTransform(Skeleton* obj, UINT32 idx) { return obj->mBoneTransforms[idx]; }
@@ -46,7 +46,7 @@ namespace bs
 			obj->mNumBones = size;
 
 			assert(obj->mBoneTransforms == nullptr);
-			obj->mBoneTransforms = bs_newN<Transform>(size);
+			obj->mBoneTransforms = bs_newN<Transform>(size, MemoryCategory::Animation);
 		}
 
 		UINT32 getNumBones(Skeleton* obj) { return obj->mNumBones; }
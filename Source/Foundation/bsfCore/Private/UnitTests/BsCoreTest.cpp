@@ -3,7 +3,21 @@
 #include "Testing/BsConsoleTestOutput.h"
 #include "Testing/BsTestSuite.h"
 #include "Animation/BsAnimationCurve.h"
+#include "CoreThread/BsCoreObjectManager.h"
 #include "Particles/BsParticleDistribution.h"
+#include "Private/RTTI/BsGameObjectRTTI.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "Reflection/BsRTTIType.h"
+#include "Resources/BsResources.h"
+#include "Scene/BsComponent.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsPrefab.h"
+#include "Scene/BsPrefabInstantiation.h"
+#include "Scene/BsSceneActor.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsThreadPool.h"
 
 namespace bs
 {
@@ -17,20 +31,209 @@ namespace bs
 		return acceleration * time;
 	}
 
+	/**
+	 * Component that appends a value to a log when updated. Components with the @p Parallel parameter set are updated
+	 * on worker threads and append to the log through SceneManager::deferUntilSync(). 
+	 */
+	template<UINT32 TypeId, bool Parallel>
+	class TestUpdateComponent : public Component
+	{
+	public:
+		TestUpdateComponent(const HSceneObject& parent, UINT32 value, Vector<UINT32>* log)
+			:Component(parent), mValue(value), mLog(log)
+		{
+			setFlag(ComponentFlag::ThreadSafeUpdate, Parallel);
+		}
+
+		void update() override
+		{
+			if (Parallel)
+			{
+				const UINT32 value = mValue;
+				Vector<UINT32>* log = mLog;
+
+				gSceneManager().deferUntilSync([value, log]() { log->push_back(value); });
+			}
+			else
+				mLog->push_back(mValue);
+
+			if (onUpdate)
+				onUpdate();
+		}
+
+		/** Optional callback triggered after the value is logged. */
+		std::function<void()> onUpdate;
+
+	private:
+		UINT32 mValue = 0;
+		Vector<UINT32>* mLog = nullptr;
+
+	public:
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	template<UINT32 TypeId, bool Parallel>
+	class TestUpdateComponentRTTI 
+		: public RTTIType<TestUpdateComponent<TypeId, Parallel>, Component, TestUpdateComponentRTTI<TypeId, Parallel>>
+	{
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "TestUpdateComponent" + toString(TypeId);
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TypeId;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return nullptr;
+		}
+	};
+
+	template<UINT32 TypeId, bool Parallel>
+	RTTITypeBase* TestUpdateComponent<TypeId, Parallel>::getRTTIStatic()
+	{
+		return TestUpdateComponentRTTI<TypeId, Parallel>::instance();
+	}
+
+	typedef TestUpdateComponent<90000, false> TestUpdateComponentA;
+	typedef TestUpdateComponent<90001, false> TestUpdateComponentB;
+	typedef TestUpdateComponent<90002, true> TestParallelUpdateComponent;
+
+	/**
+	 * Component that counts the transform change notifications it receives, as well as notifications received by any
+	 * component of this type outside of the sim thread. Can be saved in a prefab.
+	 */
+	class TestTransformComponent : public Component
+	{
+	public:
+		TestTransformComponent() // Serialization only
+		{
+			setNotifyFlags((TransformChangedFlags)(TCF_Transform | TCF_Parent));
+		}
+
+		TestTransformComponent(const HSceneObject& parent)
+			:Component(parent)
+		{
+			setNotifyFlags((TransformChangedFlags)(TCF_Transform | TCF_Parent));
+		}
+
+		void onTransformChanged(TransformChangedFlags flags) override
+		{
+			if (BS_THREAD_CURRENT_ID != simThreadId)
+				numOffThreadNotifications++;
+			else
+				numNotifications++;
+		}
+
+		UINT32 numNotifications = 0;
+
+		static ThreadId simThreadId;
+		static std::atomic<UINT32> numOffThreadNotifications;
+
+	public:
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override { return getRTTIStatic(); }
+	};
+
+	ThreadId TestTransformComponent::simThreadId;
+	std::atomic<UINT32> TestTransformComponent::numOffThreadNotifications{0};
+
+	class TestTransformComponentRTTI : public RTTIType<TestTransformComponent, Component, TestTransformComponentRTTI>
+	{
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "TestTransformComponent";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return 90003;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return GameObjectRTTI::createGameObject<TestTransformComponent>();
+		}
+	};
+
+	RTTITypeBase* TestTransformComponent::getRTTIStatic()
+	{
+		return TestTransformComponentRTTI::instance();
+	}
+
+	/** Scene actor that counts how many times the scene manager synced it with its scene object. */
+	class TestSceneActor : public SceneActor
+	{
+	public:
+		void _updateState(const SceneObject& so, bool force) override
+		{
+			numSyncs++;
+			SceneActor::_updateState(so, force);
+		}
+
+		UINT32 numSyncs = 0;
+	};
+
 	class CoreTestSuite : public TestSuite
 	{
 	public:
 		CoreTestSuite();
+		void startUp() override;
+		void shutDown() override;
 
 	private:
 		void testAnimCurveIntegration();
 		void testLookupTable();
+		void testParamBlockDirtyRange();
+		void testComponentUpdateOrder();
+		void testDeferUntilSync();
+		void testGameObjectSlotMap();
+		void testPrefabInstantiation();
+		void testSceneTransformSystem();
+		void testActorSync();
+		void testPrefabTransformNotify();
 	};
 
 	CoreTestSuite::CoreTestSuite()
 	{
 		BS_ADD_TEST(CoreTestSuite::testAnimCurveIntegration);
 		BS_ADD_TEST(CoreTestSuite::testLookupTable);
+		BS_ADD_TEST(CoreTestSuite::testParamBlockDirtyRange);
+		BS_ADD_TEST(CoreTestSuite::testComponentUpdateOrder);
+		BS_ADD_TEST(CoreTestSuite::testDeferUntilSync);
+		BS_ADD_TEST(CoreTestSuite::testGameObjectSlotMap);
+		BS_ADD_TEST(CoreTestSuite::testPrefabInstantiation);
+		BS_ADD_TEST(CoreTestSuite::testSceneTransformSystem);
+		BS_ADD_TEST(CoreTestSuite::testActorSync);
+		BS_ADD_TEST(CoreTestSuite::testPrefabTransformNotify);
+	}
+
+	void CoreTestSuite::startUp()
+	{
+		ThreadPool::startUp<TThreadPool<>>(4);
+		TaskScheduler::startUp();
+		CoreObjectManager::startUp();
+		GameObjectManager::startUp();
+		Resources::startUp();
+		SceneManager::startUp();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		SceneManager::shutDown();
+		Resources::shutDown();
+		GameObjectManager::shutDown();
+		CoreObjectManager::shutDown();
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
 	}
 
 	void CoreTestSuite::testAnimCurveIntegration()
@@ -143,6 +346,525 @@ namespace bs
 				BS_TEST_ASSERT(Math::approxEquals(valueLookup[j], valueCurve[j], EPSILON));
 		}
 	}
+
+	void CoreTestSuite::testParamBlockDirtyRange()
+	{
+		UINT32 offset, size;
+
+		// Regular buffers are always uploaded whole
+		ct::GpuParamBlockDirtyRange regular(1024);
+		BS_TEST_ASSERT(!regular.isDirty());
+
+		regular.markDirty(256, 64);
+		BS_TEST_ASSERT(regular.isDirty());
+		BS_TEST_ASSERT(regular.consume(offset, size) == BWT_DISCARD);
+		BS_TEST_ASSERT(offset == 0 && size == 1024);
+		BS_TEST_ASSERT(!regular.isDirty());
+
+		// First upload of an append-only buffer discards, and only covers the written range
+		ct::GpuParamBlockDirtyRange append(64 * 1024);
+		append.setAppendOnly(true);
+
+		append.markDirty(0, 256);
+		append.markDirty(256, 256);
+		BS_TEST_ASSERT(append.consume(offset, size) == BWT_DISCARD);
+		BS_TEST_ASSERT(offset == 0 && size == 512);
+
+		// Further appends upload only the new range, without touching the uploaded one
+		append.markDirty(512, 128);
+		append.markDirty(768, 64);
+		BS_TEST_ASSERT(append.consume(offset, size) == BTW_NO_OVERWRITE);
+		BS_TEST_ASSERT(offset == 512 && size == 320);
+
+		// Modifying an uploaded range must discard, and re-upload everything uploaded so far
+		append.markDirty(128, 16);
+		BS_TEST_ASSERT(append.consume(offset, size) == BWT_DISCARD);
+		BS_TEST_ASSERT(offset == 0 && size == 832);
+
+		// After a restart the previous contents are no longer needed, but may still be used by the GPU
+		append.restartAppend();
+		append.markDirty(0, 64);
+		BS_TEST_ASSERT(append.consume(offset, size) == BWT_DISCARD);
+		BS_TEST_ASSERT(offset == 0 && size == 64);
+
+		append.markDirty(64, 64);
+		BS_TEST_ASSERT(append.consume(offset, size) == BTW_NO_OVERWRITE);
+		BS_TEST_ASSERT(offset == 64 && size == 64);
+
+		// Clearing drops pending changes without uploading
+		append.markDirty(128, 64);
+		append.clear();
+		BS_TEST_ASSERT(!append.isDirty());
+	}
+
+	void CoreTestSuite::testComponentUpdateOrder()
+	{
+		Vector<UINT32> log;
+
+		HSceneObject so = SceneObject::create("UpdateOrder");
+		GameObjectHandle<TestUpdateComponentB> compB = so->addComponent<TestUpdateComponentB>(2, &log);
+		so->addComponent<TestUpdateComponentA>(1, &log);
+
+		// Types with the same order are updated by type id, regardless of creation order
+		gSceneManager()._update();
+		BS_TEST_ASSERT(log == Vector<UINT32>({ 1, 2 }));
+
+		gSceneManager().setComponentUpdateOrder<TestUpdateComponentB>(-1);
+
+		log.clear();
+		gSceneManager()._update();
+		BS_TEST_ASSERT(log == Vector<UINT32>({ 2, 1 }));
+
+		// Changing the order during an update applies on the next update, and all components still update exactly once
+		compB->onUpdate = []()
+		{
+			gSceneManager().setComponentUpdateOrder<TestUpdateComponentA>(-2);
+		};
+
+		log.clear();
+		gSceneManager()._update();
+		BS_TEST_ASSERT(log == Vector<UINT32>({ 2, 1 }));
+
+		log.clear();
+		gSceneManager()._update();
+		BS_TEST_ASSERT(log == Vector<UINT32>({ 1, 2 }));
+
+		so->destroy(true);
+		gSceneManager().setComponentUpdateOrder<TestUpdateComponentA>(0);
+		gSceneManager().setComponentUpdateOrder<TestUpdateComponentB>(0);
+	}
+
+	void CoreTestSuite::testDeferUntilSync()
+	{
+		static constexpr UINT32 NUM_COMPONENTS = 256;
+		Vector<UINT32> log;
+
+		// Outside of a parallel update callbacks execute immediately
+		gSceneManager().deferUntilSync([&log]() { log.push_back(0); });
+		BS_TEST_ASSERT(log.size() == 1);
+
+		HSceneObject so = SceneObject::create("DeferUntilSync");
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+			so->addComponent<TestParallelUpdateComponent>(i, &log);
+
+		// Serial components ordered after the parallel ones must observe all of their deferred changes
+		gSceneManager().setComponentUpdateOrder<TestUpdateComponentA>(1);
+		so->addComponent<TestUpdateComponentA>(NUM_COMPONENTS, &log);
+
+		for (UINT32 frame = 0; frame < 2; frame++)
+		{
+			log.clear();
+			gSceneManager()._update();
+
+			// Deferred changes are applied in the order a serial update would have made them
+			BS_TEST_ASSERT(log.size() == NUM_COMPONENTS + 1);
+			for (UINT32 i = 0; i < (UINT32)log.size(); i++)
+				BS_TEST_ASSERT(log[i] == i);
+		}
+
+		so->destroy(true);
+		gSceneManager().setComponentUpdateOrder<TestUpdateComponentA>(0);
+	}
+
+	void CoreTestSuite::testGameObjectSlotMap()
+	{
+		GameObjectManager& manager = GameObjectManager::instance();
+
+		// Slot of a destroyed object is reused, but under a different generation
+		HSceneObject so1 = SceneObject::create("SlotMap1");
+		const UINT64 id1 = so1->getInstanceId();
+		GameObjectInstanceDataPtr instanceData1 = so1->_getInstanceData();
+		BS_TEST_ASSERT(manager.objectExists(id1));
+
+		so1->destroy(true);
+		BS_TEST_ASSERT(!manager.objectExists(id1));
+
+		HSceneObject so2 = SceneObject::create("SlotMap2");
+		const UINT64 id2 = so2->getInstanceId();
+		BS_TEST_ASSERT((id2 & 0xFFFFFFFF) == (id1 & 0xFFFFFFFF));
+		BS_TEST_ASSERT(id2 != id1);
+
+		// Stale IDs must not resolve to the new object in the same slot
+		GameObjectHandleBase object;
+		BS_TEST_ASSERT(!manager.objectExists(id1));
+		BS_TEST_ASSERT(!manager.tryGetObject(id1, object));
+		BS_TEST_ASSERT(manager.getObject(id1)._getHandleData() == nullptr);
+		BS_TEST_ASSERT(manager.getObject(id2).get() == so2.get());
+
+		// Taking over the ID of a destroyed object moves the object out of the slot map
+		so2->_setInstanceData(instanceData1);
+		BS_TEST_ASSERT(so2->getInstanceId() == id1);
+		BS_TEST_ASSERT(manager.objectExists(id1));
+		BS_TEST_ASSERT(!manager.objectExists(id2));
+		BS_TEST_ASSERT(manager.getObject(id1).get() == so2.get());
+
+		// The freed slot is reused without affecting the remapped object
+		HSceneObject so3 = SceneObject::create("SlotMap3");
+		const UINT64 id3 = so3->getInstanceId();
+		BS_TEST_ASSERT((id3 & 0xFFFFFFFF) == (id2 & 0xFFFFFFFF));
+		BS_TEST_ASSERT(id3 != id1 && id3 != id2);
+		BS_TEST_ASSERT(manager.getObject(id1).get() == so2.get());
+		BS_TEST_ASSERT(manager.getObject(id3).get() == so3.get());
+
+		so2->destroy(true);
+		BS_TEST_ASSERT(!manager.objectExists(id1));
+		BS_TEST_ASSERT(manager.objectExists(id3));
+
+		// Objects queued multiple times, or destroyed along with their parent, are only destroyed once
+		UnorderedMap<UINT64, UINT32> numDestroyed;
+		HEvent destroyedConn = manager.onDestroyed.connect([&numDestroyed](const HGameObject& obj)
+		{
+			numDestroyed[obj->getInstanceId()]++;
+		});
+
+		HSceneObject parent = SceneObject::create("SlotMapParent");
+		HSceneObject child = SceneObject::create("SlotMapChild");
+		child->setParent(parent);
+
+		const UINT64 parentId = parent->getInstanceId();
+		const UINT64 childId = child->getInstanceId();
+
+		parent->destroy();
+		manager.queueForDestroy(child);
+		so3->destroy();
+		manager.queueForDestroy(so3);
+
+		manager.destroyQueuedObjects();
+		destroyedConn.disconnect();
+
+		BS_TEST_ASSERT(numDestroyed.size() == 3);
+		BS_TEST_ASSERT(numDestroyed[parentId] == 1);
+		BS_TEST_ASSERT(numDestroyed[childId] == 1);
+		BS_TEST_ASSERT(numDestroyed[id3] == 1);
+		BS_TEST_ASSERT(!manager.objectExists(parentId));
+		BS_TEST_ASSERT(!manager.objectExists(childId));
+		BS_TEST_ASSERT(!manager.objectExists(id3));
+	}
+
+	void CoreTestSuite::testPrefabInstantiation()
+	{
+		static constexpr UINT32 NUM_CHILDREN = 8;
+		static constexpr UINT32 NUM_OBJECTS = NUM_CHILDREN + 1;
+		static constexpr UINT32 MAX_FRAMES = 10000;
+
+		HSceneObject source = SceneObject::create("PrefabRoot");
+		for (UINT32 i = 0; i < NUM_CHILDREN; i++)
+		{
+			HSceneObject child = SceneObject::create("PrefabChild" + toString(i));
+			child->setParent(source);
+		}
+
+		HPrefab prefab = Prefab::create(source, false);
+		source->destroy(true);
+
+		Vector<UINT32> completed;
+		HSceneObject completedRoots[2];
+
+		SPtr<PrefabInstantiation> instantiations[2];
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			instantiations[i] = prefab->instantiateAsync();
+			instantiations[i]->onCompleted.connect([i, &completed, &completedRoots](const HSceneObject& root)
+			{
+				completed.push_back(i);
+				completedRoots[i] = root;
+			});
+		}
+
+		// With no budget each frame performs a single step of the oldest instantiation
+		const UINT32 oldBudget = gSceneManager().getPrefabInstantiationBudget();
+		gSceneManager().setPrefabInstantiationBudget(0);
+
+		float lastProgress[2] = { 0.0f, 0.0f };
+		UINT32 numSteps[2] = { 0, 0 };
+		for (UINT32 frame = 0; frame < MAX_FRAMES; frame++)
+		{
+			if (instantiations[0]->isComplete() && instantiations[1]->isComplete())
+				break;
+
+			PrefabInstantiationState oldStates[2];
+			for (UINT32 i = 0; i < 2; i++)
+				oldStates[i] = instantiations[i]->getState();
+
+			gSceneManager()._update();
+
+			for (UINT32 i = 0; i < 2; i++)
+			{
+				const float progress = instantiations[i]->getProgress();
+				BS_TEST_ASSERT(progress >= lastProgress[i]);
+				lastProgress[i] = progress;
+
+				if (oldStates[i] != PrefabInstantiationState::Cloning)
+					numSteps[i]++;
+
+				// Objects cannot be accessed until registered with the GameObjectManager
+				const PrefabInstantiationState state = instantiations[i]->getState();
+				if (state == PrefabInstantiationState::Cloning || state == PrefabInstantiationState::Registering)
+					BS_TEST_ASSERT(instantiations[i]->getRoot() == nullptr);
+			}
+
+			// Later instantiation doesn't progress until the earlier one completes
+			if (!instantiations[0]->isComplete())
+				BS_TEST_ASSERT(instantiations[1]->getProgress() == 0.0f);
+
+			if (instantiations[0]->getState() == PrefabInstantiationState::Cloning)
+				BS_THREAD_SLEEP(1);
+		}
+
+		gSceneManager().setPrefabInstantiationBudget(oldBudget);
+
+		// Every object is registered, instantiated and initialized in a separate step
+		BS_TEST_ASSERT(instantiations[0]->isComplete() && instantiations[1]->isComplete());
+		BS_TEST_ASSERT(numSteps[0] >= NUM_OBJECTS * 3);
+		BS_TEST_ASSERT(completed == Vector<UINT32>({ 0, 1 }));
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			BS_TEST_ASSERT(lastProgress[i] == 1.0f);
+
+			HSceneObject root = instantiations[i]->getRoot();
+			BS_TEST_ASSERT(root != nullptr && root == completedRoots[i]);
+
+			if (root == nullptr)
+				continue;
+
+			BS_TEST_ASSERT(!root->hasFlag(SOF_DontInstantiate));
+			BS_TEST_ASSERT(root->getParent() == gSceneManager().getRootNode());
+			BS_TEST_ASSERT(GameObjectManager::instance().getObject(root->getInstanceId()).get() == root.get());
+			BS_TEST_ASSERT(root->getNumChildren() == NUM_CHILDREN);
+
+			for (UINT32 j = 0; j < root->getNumChildren(); j++)
+			{
+				HSceneObject child = root->getChild(j);
+
+				BS_TEST_ASSERT(child->getName() == "PrefabChild" + toString(j));
+				BS_TEST_ASSERT(!child->hasFlag(SOF_DontInstantiate));
+				BS_TEST_ASSERT(GameObjectManager::instance().getObject(child->getInstanceId()).get() == child.get());
+			}
+
+			root->destroy(true);
+		}
+	}
+
+	void CoreTestSuite::testSceneTransformSystem()
+	{
+		static constexpr float EPSILON = 0.0001f;
+		static constexpr UINT32 NUM_CHILDREN = 4;
+
+		gSceneManager().setTransformSystemEnabled(true);
+
+		// Four levels deep hierarchy, with each object offset, rotated and scaled relative to its parent
+		HSceneObject root = SceneObject::create("TransformRoot");
+		root->setPosition(Vector3(1.0f, 2.0f, 3.0f));
+
+		Vector<HSceneObject> objects = { root };
+		auto createChild = [&objects](const HSceneObject& parent, const String& name)
+		{
+			const float offset = (float)objects.size();
+
+			HSceneObject child = SceneObject::create(name);
+			child->setParent(parent);
+			child->setPosition(Vector3(offset, 1.0f, -offset));
+			child->setRotation(Quaternion(Vector3::UNIT_Y, Degree(offset * 10.0f)));
+			child->setScale(Vector3(1.0f, 1.0f + offset * 0.1f, 1.0f));
+
+			objects.push_back(child);
+			return child;
+		};
+
+		HSceneObject children[NUM_CHILDREN];
+		HSceneObject grandchildren[NUM_CHILDREN];
+		HSceneObject leaves[NUM_CHILDREN];
+		for (UINT32 i = 0; i < NUM_CHILDREN; i++)
+		{
+			children[i] = createChild(root, "TransformChild" + toString(i));
+			grandchildren[i] = createChild(children[i], "TransformGrandchild" + toString(i));
+			leaves[i] = createChild(grandchildren[i], "TransformLeaf" + toString(i));
+		}
+
+		// Updates the transform system, then compares its results against the results of the lazy path
+		auto checkTransforms = [this, &root, &objects]()
+		{
+			gSceneManager()._updateCoreObjectTransforms();
+
+			Vector<Transform> batchedTfrms;
+			Vector<Matrix4> batchedMatrices;
+			for (auto& entry : objects)
+			{
+				batchedTfrms.push_back(entry->getTransform());
+				batchedMatrices.push_back(entry->getWorldMatrix());
+			}
+
+			// Without the system, invalidating the root transform forces all objects to recompute their transforms
+			gSceneManager().setTransformSystemEnabled(false);
+			root->setPosition(root->getLocalTransform().getPosition());
+
+			for (UINT32 i = 0; i < (UINT32)objects.size(); i++)
+			{
+				const Transform& tfrm = objects[i]->getTransform();
+				BS_TEST_ASSERT(Math::approxEquals(batchedTfrms[i].getPosition(), tfrm.getPosition(), EPSILON));
+				BS_TEST_ASSERT(Math::approxEquals(batchedTfrms[i].getRotation(), tfrm.getRotation(), EPSILON));
+				BS_TEST_ASSERT(Math::approxEquals(batchedTfrms[i].getScale(), tfrm.getScale(), EPSILON));
+
+				const Matrix4& matrix = objects[i]->getWorldMatrix();
+				for (UINT32 row = 0; row < 4; row++)
+					BS_TEST_ASSERT(Math::approxEquals(batchedMatrices[i][row], matrix[row], EPSILON));
+			}
+
+			// Re-enabling registers the hierarchy again, so following modifications are tracked incrementally
+			gSceneManager().setTransformSystemEnabled(true);
+		};
+
+		checkTransforms();
+
+		// Reparent to a shallower level, and move a subtree to a deeper level
+		leaves[0]->setParent(root);
+		children[1]->setParent(grandchildren[0]);
+		checkTransforms();
+
+		// Moving a parent must update all of its descendants
+		root->setPosition(Vector3(-5.0f, 0.0f, 2.0f));
+		children[0]->setRotation(Quaternion(Vector3::UNIT_X, Degree(45.0f)));
+		checkTransforms();
+
+		// Destroy a subtree, and modify the objects that remain
+		children[2]->destroy(true);
+		objects.erase(std::remove_if(objects.begin(), objects.end(),
+			[](const HSceneObject& entry) { return entry.isDestroyed(); }), objects.end());
+
+		grandchildren[3]->setPosition(Vector3(0.0f, -3.0f, 0.0f));
+		checkTransforms();
+
+		root->destroy(true);
+		gSceneManager().setTransformSystemEnabled(false);
+	}
+
+	void CoreTestSuite::testActorSync()
+	{
+		static constexpr float EPSILON = 0.0001f;
+
+		HSceneObject parent = SceneObject::create("ActorSyncParent");
+		HSceneObject child = SceneObject::create("ActorSyncChild");
+		child->setParent(parent);
+		child->setPosition(Vector3(0.0f, 1.0f, 0.0f));
+
+		HSceneObject other = SceneObject::create("ActorSyncOther");
+
+		SPtr<TestSceneActor> childActor = bs_shared_ptr_new<TestSceneActor>();
+		SPtr<TestSceneActor> otherActor = bs_shared_ptr_new<TestSceneActor>();
+
+		// Actors receive the current state of the object once bound
+		gSceneManager()._bindActor(childActor, child);
+		gSceneManager()._bindActor(otherActor, other);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(childActor->numSyncs == 1);
+		BS_TEST_ASSERT(otherActor->numSyncs == 1);
+		BS_TEST_ASSERT(Math::approxEquals(childActor->getTransform().getPosition(), Vector3(0.0f, 1.0f, 0.0f),
+			EPSILON));
+
+		// Moving the parent syncs the actors bound to its children, but not the unrelated actor
+		parent->setPosition(Vector3(5.0f, 0.0f, 0.0f));
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(childActor->numSyncs == 2);
+		BS_TEST_ASSERT(otherActor->numSyncs == 1);
+		BS_TEST_ASSERT(Math::approxEquals(childActor->getTransform().getPosition(), Vector3(5.0f, 1.0f, 0.0f),
+			EPSILON));
+
+		// Active state is propagated through the hierarchy
+		parent->setActive(false);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(childActor->numSyncs == 3);
+		BS_TEST_ASSERT(!childActor->getActive());
+
+		parent->setActive(true);
+		child->setMobility(ObjectMobility::Static);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(childActor->numSyncs == 4);
+		BS_TEST_ASSERT(childActor->getActive());
+		BS_TEST_ASSERT(childActor->getMobility() == ObjectMobility::Static);
+
+		// Nothing changed since the last sync
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(childActor->numSyncs == 4);
+		BS_TEST_ASSERT(otherActor->numSyncs == 1);
+
+		gSceneManager()._unbindActor(childActor);
+		gSceneManager()._unbindActor(otherActor);
+
+		parent->destroy(true);
+		other->destroy(true);
+	}
+
+	void CoreTestSuite::testPrefabTransformNotify()
+	{
+		static constexpr UINT32 MAX_FRAMES = 10000;
+
+		TestTransformComponent::simThreadId = BS_THREAD_CURRENT_ID;
+
+		HSceneObject source = SceneObject::create("NotifyPrefabRoot");
+		source->addComponent<TestTransformComponent>();
+
+		HSceneObject sourceChild = SceneObject::create("NotifyPrefabChild");
+		sourceChild->setParent(source);
+		sourceChild->addComponent<TestTransformComponent>();
+
+		HPrefab prefab = Prefab::create(source, false);
+		source->destroy(true);
+
+		// Components only receive notifications while the scene is running
+		BS_TEST_ASSERT(gSceneManager().isRunning());
+		TestTransformComponent::numOffThreadNotifications = 0;
+
+		SPtr<PrefabInstantiation> instantiation = prefab->instantiateAsync();
+
+		// Perform a single step per frame, until the cloned objects are registered
+		const UINT32 oldBudget = gSceneManager().getPrefabInstantiationBudget();
+		gSceneManager().setPrefabInstantiationBudget(0);
+
+		for (UINT32 frame = 0; frame < MAX_FRAMES; frame++)
+		{
+			const PrefabInstantiationState state = instantiation->getState();
+			if (state != PrefabInstantiationState::Cloning && state != PrefabInstantiationState::Registering)
+				break;
+
+			gSceneManager()._update();
+
+			if (instantiation->getState() == PrefabInstantiationState::Cloning)
+				BS_THREAD_SLEEP(1);
+		}
+
+		gSceneManager().setPrefabInstantiationBudget(oldBudget);
+		BS_TEST_ASSERT(instantiation->getState() == PrefabInstantiationState::Instantiating);
+
+		// Deserializing the clone doesn't notify any components
+		HSceneObject root = instantiation->getRoot();
+		BS_TEST_ASSERT(root != nullptr && root->getNumChildren() == 1);
+
+		if (root == nullptr || root->getNumChildren() != 1)
+			return;
+
+		HSceneObject child = root->getChild(0);
+		GameObjectHandle<TestTransformComponent> rootComponent = root->getComponent<TestTransformComponent>();
+		GameObjectHandle<TestTransformComponent> childComponent = child->getComponent<TestTransformComponent>();
+
+		BS_TEST_ASSERT(TestTransformComponent::numOffThreadNotifications == 0);
+		BS_TEST_ASSERT(rootComponent->numNotifications == 0);
+		BS_TEST_ASSERT(childComponent->numNotifications == 0);
+
+		// Components in the entire hierarchy are notified on the sim thread, once the clone is added to the scene
+		instantiation->complete();
+
+		BS_TEST_ASSERT(TestTransformComponent::numOffThreadNotifications == 0);
+		BS_TEST_ASSERT(rootComponent->numNotifications > 0);
+		BS_TEST_ASSERT(childComponent->numNotifications > 0);
+
+		root->destroy(true);
+	}
 }
 
 using namespace bs;
@@ -155,4 +877,4 @@ int main()
 	tests->run(testOutput);
 
 	return 0;
-}
\ No newline at end of file
+}
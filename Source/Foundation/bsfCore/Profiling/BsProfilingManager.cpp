@@ -13,6 +13,9 @@ namespace bs
 	{
 		mSavedSimReports = bs_newN<ProfilerReport, ProfilerAlloc>(NUM_SAVED_FRAMES);
 		mSavedCoreReports = bs_newN<ProfilerReport, ProfilerAlloc>(NUM_SAVED_FRAMES);
+
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+			mLastMemoryStats[i] = MemoryCounter::getCategoryStats((MemoryCategory)i);
 	}
 
 	ProfilingManager::~ProfilingManager()
@@ -27,10 +30,30 @@ namespace bs
 	void ProfilingManager::_update()
 	{
 #if BS_PROFILING_ENABLED
-		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		ProfilerReport& report = mSavedSimReports[mNextSimReportIdx];
+		report.cpuReport = gProfilerCPU().generateReport();
 
 		gProfilerCPU().reset();
 
+		const float elapsedSeconds = mMemoryReportTimer.getMicroseconds() * 1e-6f;
+		const float invElapsedSeconds = elapsedSeconds > 0.0f ? 1.0f / elapsedSeconds : 0.0f;
+		mMemoryReportTimer.reset();
+
+		for(UINT32 i = 0; i < (UINT32)MemoryCategory::Count; i++)
+		{
+			const MemoryCategoryStats stats = MemoryCounter::getCategoryStats((MemoryCategory)i);
+			const MemoryCategoryStats& lastStats = mLastMemoryStats[i];
+
+			MemoryCategoryReport& categoryReport = report.memoryReport.categories[i];
+			categoryReport.liveBytes = stats.liveBytes;
+			categoryReport.peakBytes = stats.peakBytes;
+			categoryReport.bytesAllocatedPerSecond =
+				(stats.totalAllocatedBytes - lastStats.totalAllocatedBytes) * invElapsedSeconds;
+			categoryReport.allocsPerSecond = (stats.numAllocs - lastStats.numAllocs) * invElapsedSeconds;
+
+			mLastMemoryStats[i] = stats;
+		}
+
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
 #endif
 	}
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Profiling/BsProfilerCPU.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -12,10 +13,35 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Memory usage of a single memory category during a profiling session. */
+	struct MemoryCategoryReport
+	{
+		/** Number of bytes allocated at the end of the session. */
+		UINT64 liveBytes = 0;
+
+		/** Highest number of bytes allocated at the same time, since the application started. */
+		UINT64 peakBytes = 0;
+
+		/** Number of bytes allocated per second during the session. */
+		float bytesAllocatedPerSecond = 0.0f;
+
+		/** Number of allocations made per second during the session. */
+		float allocsPerSecond = 0.0f;
+	};
+
+	/** Contains memory usage statistics for a profiling session, for all memory categories. */
+	struct MemoryProfilerReport
+	{
+		MemoryCategoryReport categories[(UINT32)MemoryCategory::Count];
+	};
+
 	/**	Contains data about a profiling session. */
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/** Memory usage statistics. Only provided in sim thread reports, as memory usage is tracked globally. */
+		MemoryProfilerReport memoryReport;
 	};
 
 	/**	Type of thread used by the profiler. */
@@ -26,7 +52,8 @@ namespace bs
 	};
 
 	/**
-	 * Tracks CPU profiling information with each frame for sim and core threads.
+	 * Tracks CPU profiling information with each frame for sim and core threads, as well as memory usage of each
+	 * MemoryCategory.
 	 *
 	 * @note	Sim thread only unless specified otherwise.
 	 */
@@ -68,6 +95,9 @@ namespace bs
 		ProfilerReport* mSavedCoreReports;
 		UINT32 mNextCoreReportIdx;
 
+		MemoryCategoryStats mLastMemoryStats[(UINT32)MemoryCategory::Count];
+		Timer mMemoryReportTimer;
+
 		mutable Mutex mSync;
 	};
 
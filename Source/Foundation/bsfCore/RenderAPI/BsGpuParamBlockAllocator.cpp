@@ -0,0 +1,70 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "RenderAPI/BsGpuParamBlockAllocator.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "Math/BsMath.h"
+
+namespace bs { namespace ct
+{
+	GpuParamBlockAllocator::GpuParamBlockAllocator(UINT32 pageSize)
+		:mPageSize(pageSize)
+	{
+		mAlignment = RenderAPI::instance().getCapabilities(0).getParamBlockOffsetAlignment();
+	}
+
+	GpuParamBlockAllocator::~GpuParamBlockAllocator()
+	{
+		reset();
+	}
+
+	void GpuParamBlockAllocator::allocate(const SPtr<GpuParamBlockBuffer>& buffer)
+	{
+		const UINT32 size = buffer->getSize();
+		if (!isSupported() || size > mPageSize)
+		{
+			buffer->flushToGPU();
+			return;
+		}
+
+		const UINT32 alignedSize = Math::divideAndRoundUp(size, mAlignment) * mAlignment;
+		while (mActivePage < (UINT32)mPages.size() && (mPages[mActivePage].used + alignedSize) > mPageSize)
+			mActivePage++;
+
+		if (mActivePage == (UINT32)mPages.size())
+		{
+			Page page;
+			page.buffer = GpuParamBlockBuffer::create(mPageSize);
+			page.buffer->_setAppendOnly(true);
+
+			mPages.push_back(page);
+		}
+
+		Page& page = mPages[mActivePage];
+		buffer->_setStorage(page.buffer, page.used);
+		page.used += alignedSize;
+
+		mAllocated.push_back(buffer);
+	}
+
+	void GpuParamBlockAllocator::flush()
+	{
+		for (UINT32 i = 0; i <= mActivePage && i < (UINT32)mPages.size(); i++)
+			mPages[i].buffer->flushToGPU();
+	}
+
+	void GpuParamBlockAllocator::reset()
+	{
+		for (auto& entry : mAllocated)
+			entry->_setStorage(nullptr, 0);
+
+		for (auto& entry : mPages)
+		{
+			entry.used = 0;
+			entry.buffer->_restartAppend();
+		}
+
+		mAllocated.clear();
+		mActivePage = 0;
+	}
+}}
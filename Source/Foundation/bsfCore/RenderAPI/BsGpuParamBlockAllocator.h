@@ -0,0 +1,75 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Sub-allocates the contents of many small GPU param block buffers out of a few large ones. Each time a buffer is
+	 * allocated its contents are copied into a region of a large buffer. Only the regions written since the previous
+	 * upload are uploaded when the large buffer is flushed or first bound. This turns many small uploads (e.g.
+	 * per-object constants) into a handful of large ones, without re-uploading regions shared by multiple views.
+	 *
+	 * Allocations are linear and only valid until the allocator is reset, which is expected to happen once per frame.
+	 * A buffer whose contents change within a frame must be allocated again, which assigns it a new region and leaves
+	 * the region used by previously issued draws intact.
+	 *
+	 * If the render API cannot bind param blocks at an offset, allocation falls back to flushing the buffer on its own.
+	 *
+	 * @note	Core thread only.
+	 */
+	class BS_CORE_EXPORT GpuParamBlockAllocator
+	{
+	public:
+		/** 
+		 * @param[in]	pageSize	Size of the large buffers that the param blocks are sub-allocated from, in bytes.
+		 */
+		GpuParamBlockAllocator(UINT32 pageSize = 64 * 1024);
+		~GpuParamBlockAllocator();
+
+		/**
+		 * Assigns a region of storage to the provided buffer and copies its current contents into it. Buffers larger than
+		 * the page size, or all buffers if sub-allocation isn't supported, are flushed on their own instead.
+		 */
+		void allocate(const SPtr<GpuParamBlockBuffer>& buffer);
+
+		/** 
+		 * Uploads any storage written to since the last flush. This normally happens automatically when a sub-allocated
+		 * buffer gets bound, but calling this after all allocations for a set of draws are done guarantees a single
+		 * upload per page.
+		 */
+		void flush();
+
+		/** 
+		 * Releases all allocations, returning the buffers to their own storage, and makes the storage available for
+		 * new allocations. 
+		 */
+		void reset();
+
+		/** Checks can the active render API bind param blocks at an offset, which is required for sub-allocation. */
+		bool isSupported() const { return mAlignment > 0; }
+
+	private:
+		/** Large buffer that param blocks get sub-allocated from. */
+		struct Page
+		{
+			SPtr<GpuParamBlockBuffer> buffer;
+			UINT32 used = 0;
+		};
+
+		UINT32 mPageSize;
+		UINT32 mAlignment;
+
+		Vector<Page> mPages;
+		UINT32 mActivePage = 0;
+		Vector<SPtr<GpuParamBlockBuffer>> mAllocated;
+	};
+
+	/** @} */
+}}
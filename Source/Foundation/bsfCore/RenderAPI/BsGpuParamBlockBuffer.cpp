@@ -92,8 +92,53 @@ namespace bs
 
 	namespace ct
 	{
+	GpuParamBlockDirtyRange::GpuParamBlockDirtyRange(UINT32 size)
+		:mSize(size), mStart(size)
+	{ }
+
+	void GpuParamBlockDirtyRange::markDirty(UINT32 offset, UINT32 size)
+	{
+		mStart = std::min(mStart, offset);
+		mEnd = std::max(mEnd, offset + size);
+	}
+
+	BufferWriteType GpuParamBlockDirtyRange::consume(UINT32& offset, UINT32& size)
+	{
+		assert(isDirty());
+
+		BufferWriteType writeType;
+		if (!mAppendOnly)
+		{
+			offset = 0;
+			size = mSize;
+			writeType = BWT_DISCARD;
+		}
+		else if (mUploadedEnd > 0 && mStart >= mUploadedEnd)
+		{
+			// Only data past the uploaded ranges changed, so ranges used by issued draws can be left as is
+			offset = mStart;
+			size = mEnd - mStart;
+			writeType = BTW_NO_OVERWRITE;
+
+			mUploadedEnd = mEnd;
+		}
+		else
+		{
+			// First upload since a restart, or an uploaded range was modified. Discard the buffer and upload everything
+			// written since the restart.
+			offset = 0;
+			size = std::max(mEnd, mUploadedEnd);
+			writeType = BWT_DISCARD;
+
+			mUploadedEnd = size;
+		}
+
+		clear();
+		return writeType;
+	}
+
 	GpuParamBlockBuffer::GpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask)
-		:mUsage(usage), mSize(size), mCachedData(nullptr), mGPUBufferDirty(false)
+		:mUsage(usage), mSize(size), mCachedData(nullptr), mDirtyRange(size)
 	{
 		if (mSize > 0)
 		{
@@ -129,7 +174,7 @@ namespace bs
 #endif
 
 		memcpy(mCachedData + offset, data, size);
-		mGPUBufferDirty = true;
+		mDirtyRange.markDirty(offset, size);
 	}
 
 	void GpuParamBlockBuffer::read(UINT32 offset, void* data, UINT32 size)
@@ -158,25 +203,73 @@ namespace bs
 #endif
 
 		memset(mCachedData + offset, 0, size);
-		mGPUBufferDirty = true;
+		mDirtyRange.markDirty(offset, size);
 	}
 
 	void GpuParamBlockBuffer::flushToGPU(UINT32 queueIdx)
 	{
-		if (mGPUBufferDirty)
+		if (!mDirtyRange.isDirty())
 		{
-			writeToGPU(mCachedData, queueIdx);
-			mGPUBufferDirty = false;
+			if (mStorage != nullptr)
+				mStorage->flushToGPU(queueIdx);
+
+			return;
 		}
+
+		UINT32 offset, size;
+		const BufferWriteType writeType = mDirtyRange.consume(offset, size);
+
+		if (mStorage != nullptr)
+		{
+			// Storage uploads only the range that changed, along with any other buffers written to it since
+			mStorage->write(mStorageOffset, mCachedData, mSize);
+			mStorage->flushToGPU(queueIdx);
+			return;
+		}
+
+		mBuffer->writeData(offset, size, mCachedData + offset, writeType, queueIdx);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
 
 	void GpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
 	{
+		if (mStorage != nullptr)
+		{
+			mStorage->write(mStorageOffset, data, mSize);
+			mStorage->flushToGPU(queueIdx);
+			return;
+		}
+
 		mBuffer->writeData(0, mSize, data, BWT_DISCARD, queueIdx);
 
 		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
 	}
 
+	void GpuParamBlockBuffer::_setStorage(const SPtr<GpuParamBlockBuffer>& storage, UINT32 offset)
+	{
+#if BS_DEBUG_MODE
+		if (storage != nullptr && (offset + mSize) > storage->getSize())
+		{
+			BS_EXCEPT(InvalidParametersException, "Wanted range is out of storage buffer bounds. " \
+				"Available range: 0 .. " + toString(storage->getSize()) + ". " \
+				"Wanted range: " + toString(offset) + " .. " + toString(offset + mSize) + ".");
+		}
+#endif
+
+		mStorage = storage;
+		mStorageOffset = storage != nullptr ? offset : 0;
+
+		if (mStorage != nullptr)
+		{
+			// Upload is deferred until the storage buffer is flushed, so all buffers sharing it get uploaded together
+			mStorage->write(mStorageOffset, mCachedData, mSize);
+			mDirtyRange.clear();
+		}
+		else
+			mDirtyRange.markDirty(0, mSize);
+	}
+
 	void GpuParamBlockBuffer::syncToCore(const CoreSyncData& data)
 	{
 		assert(mSize == data.getBufferSize());
@@ -80,6 +80,56 @@ namespace bs
 	 *  @{
 	 */
 
+	/**
+	 * Tracks the range of a GPU param block buffer written to since it was last uploaded, and determines how the next
+	 * upload should be performed.
+	 *
+	 * By default every upload rewrites the entire buffer and discards its previous contents. In append-only mode,
+	 * used for buffers that other param blocks are sub-allocated from, data is only ever added past the ranges already
+	 * in use by issued draws. Uploads then only copy the newly written range, without discarding the rest. Modifying
+	 * a range that was already uploaded falls back to discarding the buffer.
+	 */
+	class BS_CORE_EXPORT GpuParamBlockDirtyRange
+	{
+	public:
+		GpuParamBlockDirtyRange(UINT32 size);
+
+		/** Marks the specified range as modified, in bytes. */
+		void markDirty(UINT32 offset, UINT32 size);
+
+		/** Checks if any part of the buffer was modified since the last upload. */
+		bool isDirty() const { return mEnd > mStart; }
+
+		/** Marks the entire buffer as clean, without uploading it. */
+		void clear() { mStart = mSize; mEnd = 0; }
+
+		/** Enables or disables the append-only mode. */
+		void setAppendOnly(bool enable) { mAppendOnly = enable; mUploadedEnd = 0; }
+
+		/**
+		 * Notifies the tracker that previously uploaded ranges may still be in use by the GPU, but their contents are
+		 * no longer needed. The next upload will discard the buffer. Only relevant in append-only mode.
+		 */
+		void restartAppend() { mUploadedEnd = 0; }
+
+		/**
+		 * Returns the range of the buffer to upload and the type of the write to perform, and marks the buffer as
+		 * clean. Must only be called if the buffer is dirty.
+		 *
+		 * @param[out]	offset	Offset of the range to upload, in bytes.
+		 * @param[out]	size	Size of the range to upload, in bytes.
+		 * @return				Write type to use for the upload.
+		 */
+		BufferWriteType consume(UINT32& offset, UINT32& size);
+
+	private:
+		UINT32 mSize;
+		UINT32 mStart;
+		UINT32 mEnd = 0;
+		UINT32 mUploadedEnd = 0;
+		bool mAppendOnly = false;
+	};
+
 	/**
 	 * Core thread version of a bs::GpuParamBlockBuffer.
 	 *
@@ -136,6 +186,45 @@ namespace bs
 		static SPtr<GpuParamBlockBuffer> create(UINT32 size, GpuBufferUsage usage = GBU_DYNAMIC,
 			GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Redirects the contents of this buffer into a region of another, larger, buffer. The current cached contents are
+		 * copied into @p storage, but not uploaded until @p storage is flushed. While redirected the buffer's own GPU
+		 * storage is not used. Instead, flushToGPU() copies the cached contents into @p storage and flushes it, and the
+		 * render API binds the region of @p storage when this buffer is bound. Only valid if the render API supports
+		 * binding param blocks at an offset (see RenderAPICapabilities::getParamBlockOffsetAlignment()).
+		 *
+		 * @param[in]	storage		Buffer to store the contents in. Provide null to revert to the buffer's own storage.
+		 * @param[in]	offset		Offset into @p storage at which to store the contents, in bytes.
+		 */
+		void _setStorage(const SPtr<GpuParamBlockBuffer>& storage, UINT32 offset);
+
+		/** 
+		 * Returns the buffer whose GPU storage holds the contents of this buffer. This is the buffer itself unless it
+		 * was redirected through _setStorage().
+		 */
+		const GpuParamBlockBuffer* _getStorage() const { return mStorage != nullptr ? mStorage.get() : this; }
+
+		/** Returns the offset into the buffer returned by _getStorage() at which the contents start, in bytes. */
+		UINT32 _getStorageOffset() const { return mStorageOffset; }
+
+		/**
+		 * Marks the buffer as append-only, meaning ranges used by draws already issued are never modified until
+		 * _restartAppend() is called. Flushing then only uploads the newly written range. Used for buffers that other
+		 * buffers are redirected to through _setStorage().
+		 */
+		void _setAppendOnly(bool enable) { mDirtyRange.setAppendOnly(enable); }
+
+		/**
+		 * Notifies an append-only buffer that all of its current contents are no longer needed. The next flush will
+		 * discard the buffer, so any draws still using the old contents remain unaffected.
+		 */
+		void _restartAppend() { mDirtyRange.restartAppend(); }
+
+		/** @} */
 	protected:
 		friend class HardwareBufferManager;
 
@@ -151,7 +240,10 @@ namespace bs
 		UINT32 mSize;
 
 		UINT8* mCachedData;
-		bool mGPUBufferDirty;
+		GpuParamBlockDirtyRange mDirtyRange;
+
+		SPtr<GpuParamBlockBuffer> mStorage;
+		UINT32 mStorageOffset = 0;
 	};
 
 	/** @} */
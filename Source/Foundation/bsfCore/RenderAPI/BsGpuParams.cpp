@@ -272,6 +272,36 @@ namespace bs
 		}
 	}
 
+	template<bool Core>
+	void TGpuParams<Core>::setParamBlockBuffer(GpuProgramType type, const ParamID& id, 
+		const ParamsBufferType& paramBlockBuffer)
+	{
+		const GpuParamBinding* bindings = mParamInfo->getParamBlockBindings(id);
+		if (bindings == nullptr || bindings[type].slot == (UINT32)-1)
+		{
+			LOGWRN("Cannot find parameter block with the name: '" + String(id.c_str()) + "'");
+			return;
+		}
+
+		setParamBlockBuffer(bindings[type].set, bindings[type].slot, paramBlockBuffer);
+	}
+
+	template<bool Core>
+	void TGpuParams<Core>::setParamBlockBuffer(const ParamID& id, const ParamsBufferType& paramBlockBuffer)
+	{
+		const GpuParamBinding* bindings = mParamInfo->getParamBlockBindings(id);
+		if (bindings == nullptr)
+			return;
+
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			if (bindings[i].slot == (UINT32)-1)
+				continue;
+
+			setParamBlockBuffer(bindings[i].set, bindings[i].slot, paramBlockBuffer);
+		}
+	}
+
 	template<bool Core>
 	template<class T> 
 	void TGpuParams<Core>::getParam(GpuProgramType type, const String& name, TGpuDataParam<T, Core>& output) const
@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "RenderAPI/BsGpuParam.h"
+#include "RenderAPI/BsParamID.h"
 #include "CoreThread/BsCoreObject.h"
 #include "Resources/BsIResourceListener.h"
 #include "Math/BsMatrixNxM.h"
@@ -190,6 +191,18 @@ namespace bs
 		 */
 		void setParamBlockBuffer(const String& name, const ParamsBufferType& paramBlockBuffer);
 
+		/**
+		 * Equivalent to setParamBlockBuffer(GpuProgramType, const String&, const ParamsBufferType&), except the buffer is
+		 * looked up using a pre-hashed identifier instead of a string name.
+		 */
+		void setParamBlockBuffer(GpuProgramType type, const ParamID& id, const ParamsBufferType& paramBlockBuffer);
+
+		/**
+		 * Equivalent to setParamBlockBuffer(const String&, const ParamsBufferType&), except the buffer is looked up using
+		 * a pre-hashed identifier instead of a string name.
+		 */
+		void setParamBlockBuffer(const ParamID& id, const ParamsBufferType& paramBlockBuffer);
+
 		/**
 		 * Sets the parameter buffer with the specified set/slot combination.Any following parameter reads or writes that are 
 		 * referencing that buffer will use the new buffer. Set/slot information for a specific buffer can be extracted
@@ -255,8 +255,35 @@ namespace bs
 			getBinding((GpuProgramType)i, type, name, bindings[i]);
 	}
 
+	const GpuParamBinding* GpuPipelineParamInfoBase::getParamBlockBindings(const ParamID& id) const
+	{
+		UINT32 index = mParamBlockLookup.find(id, [this, &id]()
+		{
+			ParamBlockBindings entry;
+
+			bool found = false;
+			for (UINT32 i = 0; i < GPT_COUNT; i++)
+			{
+				getBinding((GpuProgramType)i, ParamType::ParamBlock, id.getName(), entry.bindings[i]);
+
+				found |= entry.bindings[i].slot != (UINT32)-1;
+			}
+
+			if (!found)
+				return (UINT32)-1;
+
+			mParamBlockBindings.push_back(entry);
+			return (UINT32)mParamBlockBindings.size() - 1;
+		});
+
+		if (index == (UINT32)-1)
+			return nullptr;
+
+		return mParamBlockBindings[index].bindings;
+	}
+
 	void GpuPipelineParamInfoBase::getBinding(GpuProgramType progType, ParamType type, const String& name, 
-		GpuParamBinding &binding)
+		GpuParamBinding &binding) const
 	{
 		auto findBinding = [](auto& paramMap, const String& name, GpuParamBinding& binding)
 		{
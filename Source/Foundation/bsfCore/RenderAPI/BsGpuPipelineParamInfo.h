@@ -4,6 +4,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "CoreThread/BsCoreObject.h"
+#include "RenderAPI/BsParamID.h"
 #include "Allocators/BsGroupAlloc.h"
 
 namespace bs
@@ -69,7 +70,7 @@ namespace bs
 		 * Finds set/slot indices of a parameter with the specified name for the specified GPU program stage. Set/slot
 		 * indices are set to -1 if a stage doesn't have a block with the specified name.
 		 */
-		void getBinding(GpuProgramType progType, ParamType type, const String& name, GpuParamBinding &binding);
+		void getBinding(GpuProgramType progType, ParamType type, const String& name, GpuParamBinding &binding) const;
 
 		/**
 		 * Finds set/slot indices of a parameter with the specified name for every GPU program stage. Set/slot indices are
@@ -77,6 +78,13 @@ namespace bs
 		 */
 		void getBindings(ParamType type, const String& name, GpuParamBinding(&bindings)[GPT_COUNT]);
 
+		/**
+		 * Finds set/slot indices of a parameter block with the specified identifier, for every GPU program stage. Returns
+		 * an array of GPT_COUNT entries, with set/slot indices set to -1 for stages that don't use the block, or null if
+		 * no stage uses the block.
+		 */
+		const GpuParamBinding* getParamBlockBindings(const ParamID& id) const;
+
 		/** Returns descriptions of individual parameters for the specified GPU program type. */
 		const SPtr<GpuParamDesc>& getParamDesc(GpuProgramType type) const { return mParamDescs[(int)type]; }
 
@@ -96,8 +104,16 @@ namespace bs
 			UINT32 set;
 			UINT32 slot;
 		};
+
+		/** Bindings of a single parameter block across all GPU program stages. */
+		struct ParamBlockBindings
+		{
+			GpuParamBinding bindings[GPT_COUNT];
+		};
 		
 		std::array<SPtr<GpuParamDesc>, 6> mParamDescs;
+		ParamIDLookup mParamBlockLookup;
+		mutable Vector<ParamBlockBindings> mParamBlockBindings;
 
 		UINT32 mNumSets;
 		UINT32 mNumElements;
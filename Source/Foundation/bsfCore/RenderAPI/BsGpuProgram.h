@@ -133,6 +133,9 @@ namespace bs
 		/** Version of the compiler that compiled the bytecode. */
 		UINT32 compilerVersion = 0;
 
+		/** Compiler specific flags (e.g. debug information, optimization level) the bytecode was compiled with. */
+		UINT32 compilerFlags = 0;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
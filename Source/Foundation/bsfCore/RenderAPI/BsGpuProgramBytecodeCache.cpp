@@ -0,0 +1,128 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "RenderAPI/BsGpuProgramBytecodeCache.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Reflection/BsRTTIType.h"
+#include "Debug/BsDebug.h"
+
+namespace bs { namespace ct
+{
+	/** Extension of the files containing individual cache entries. */
+	static constexpr const char* ENTRY_EXTENSION = ".bytecode";
+
+	GpuProgramBytecodeCache::GpuProgramBytecodeCache(const Path& folder)
+		:mFolder(folder)
+	{
+		mFolder.makeAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		if (!FileSystem::exists(mFolder))
+			FileSystem::createDir(mFolder);
+	}
+
+	SPtr<GpuProgramBytecode> GpuProgramBytecodeCache::find(const GPU_PROGRAM_DESC& desc, const String& compilerId,
+		UINT32 compilerVersion, UINT32 compilerFlags)
+	{
+		const Path entryPath = getEntryPath(getKey(desc, compilerId, compilerVersion, compilerFlags));
+
+		SPtr<GpuProgramBytecode> bytecode;
+		if (FileSystem::isFile(entryPath))
+		{
+			FileDecoder fs(entryPath);
+			SPtr<IReflectable> entry = fs.decode();
+
+			if (entry != nullptr && rtti_is_of_type<GpuProgramBytecode>(entry))
+			{
+				bytecode = std::static_pointer_cast<GpuProgramBytecode>(entry);
+
+				// Guard against hash collisions and partially written entries
+				if (bytecode->compilerId != compilerId || bytecode->compilerVersion != compilerVersion ||
+					bytecode->compilerFlags != compilerFlags || bytecode->instructions.data == nullptr)
+				{
+					bytecode = nullptr;
+				}
+			}
+
+			if (bytecode == nullptr)
+				LOGWRN("Ignoring invalid GPU program bytecode cache entry: " + entryPath.toString());
+		}
+
+		Lock lock(mMutex);
+		if (bytecode != nullptr)
+			mStats.numHits++;
+		else
+			mStats.numMisses++;
+
+		return bytecode;
+	}
+
+	void GpuProgramBytecodeCache::store(const GPU_PROGRAM_DESC& desc, const String& compilerId, UINT32 compilerVersion,
+		UINT32 compilerFlags, const SPtr<GpuProgramBytecode>& bytecode)
+	{
+		if (bytecode == nullptr || bytecode->instructions.data == nullptr)
+			return;
+
+		const Path entryPath = getEntryPath(getKey(desc, compilerId, compilerVersion, compilerFlags));
+
+		// Write to a temporary file first, so other readers never see a partially written entry
+		Path tempPath = entryPath;
+		tempPath.setExtension(tempPath.getExtension() + ".tmp");
+
+		Lock lock(mMutex);
+		{
+			FileEncoder fs(tempPath);
+			fs.encode(bytecode.get());
+		}
+
+		FileSystem::move(tempPath, entryPath, true);
+		mStats.numWrites++;
+	}
+
+	void GpuProgramBytecodeCache::clear()
+	{
+		Lock lock(mMutex);
+
+		Vector<Path> files;
+		Vector<Path> directories;
+		FileSystem::getChildren(mFolder, files, directories);
+
+		for (auto& file : files)
+		{
+			if (file.getExtension() == ENTRY_EXTENSION)
+				FileSystem::remove(file);
+		}
+	}
+
+	GpuProgramBytecodeCacheStats GpuProgramBytecodeCache::getStats() const
+	{
+		Lock lock(mMutex);
+		return mStats;
+	}
+
+	void GpuProgramBytecodeCache::resetStats()
+	{
+		Lock lock(mMutex);
+		mStats = GpuProgramBytecodeCacheStats();
+	}
+
+	String GpuProgramBytecodeCache::getKey(const GPU_PROGRAM_DESC& desc, const String& compilerId,
+		UINT32 compilerVersion, UINT32 compilerFlags)
+	{
+		StringStream stream;
+		stream << compilerId << '\n'
+			<< compilerVersion << '\n'
+			<< compilerFlags << '\n'
+			<< desc.language << '\n'
+			<< (UINT32)desc.type << '\n'
+			<< desc.entryPoint << '\n'
+			<< desc.requiresAdjacency << '\n'
+			<< desc.source;
+
+		return md5(stream.str());
+	}
+
+	Path GpuProgramBytecodeCache::getEntryPath(const String& key) const
+	{
+		return mFolder + (key + ENTRY_EXTENSION);
+	}
+}}
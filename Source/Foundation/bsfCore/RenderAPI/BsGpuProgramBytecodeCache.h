@@ -0,0 +1,83 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "RenderAPI/BsGpuProgram.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/** Counts of operations performed by a GpuProgramBytecodeCache. */
+	struct GpuProgramBytecodeCacheStats
+	{
+		UINT32 numHits = 0; /**< Number of lookups that found valid bytecode in the cache. */
+		UINT32 numMisses = 0; /**< Number of lookups that required the program to be compiled. */
+		UINT32 numWrites = 0; /**< Number of compiled programs written to the cache. */
+	};
+
+	/**
+	 * Persistent cache of compiled GPU program bytecode. Each entry is stored in its own file in the cache folder, named
+	 * after a hash of everything that determines the compiler output: the program source (with includes and defines
+	 * already resolved), entry point, language, program type, and the identifier, version and flags of the compiler.
+	 * Any change to those results in a different entry, so outdated entries never get used and don't need to be
+	 * invalidated.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT GpuProgramBytecodeCache
+	{
+	public:
+		/**
+		 * Creates a cache that stores its entries in the provided folder. The folder is created if it doesn't exist.
+		 * Entries written by a previous cache using the same folder are re-used.
+		 */
+		GpuProgramBytecodeCache(const Path& folder);
+
+		/**
+		 * Attempts to find bytecode of a program matching the provided description, compiled by the specified compiler
+		 * using the specified flags. Returns null if no such program is in the cache.
+		 */
+		SPtr<GpuProgramBytecode> find(const GPU_PROGRAM_DESC& desc, const String& compilerId, UINT32 compilerVersion,
+			UINT32 compilerFlags);
+
+		/**
+		 * Stores bytecode of a program compiled from the provided description, by the specified compiler using the
+		 * specified flags. Bytecode of programs that failed to compile is not stored.
+		 */
+		void store(const GPU_PROGRAM_DESC& desc, const String& compilerId, UINT32 compilerVersion, UINT32 compilerFlags,
+			const SPtr<GpuProgramBytecode>& bytecode);
+
+		/** Removes all entries from the cache. */
+		void clear();
+
+		/** Returns the folder the cache entries are stored in. */
+		const Path& getFolder() const { return mFolder; }
+
+		/** Returns the counts of operations performed since the cache was created or resetStats() was called. */
+		GpuProgramBytecodeCacheStats getStats() const;
+
+		/** Resets all counts returned by getStats() to zero. */
+		void resetStats();
+
+		/** 
+		 * Generates a key that uniquely identifies bytecode of a program compiled by the specified compiler, using the
+		 * specified flags.
+		 */
+		static String getKey(const GPU_PROGRAM_DESC& desc, const String& compilerId, UINT32 compilerVersion,
+			UINT32 compilerFlags);
+
+	private:
+		/** Returns the path to the file the entry with the specified key is stored in. */
+		Path getEntryPath(const String& key) const;
+
+		Path mFolder;
+		GpuProgramBytecodeCacheStats mStats;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,38 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "RenderAPI/BsParamID.h"
+
+namespace bs
+{
+	/** Keeps track of all names that were assigned an identifier. */
+	struct ParamIDRegistry
+	{
+		Mutex mutex;
+		UnorderedMap<String, UINT32> ids;
+	};
+
+	/** 
+	 * Returns the global identifier registry. Constructed on first use since identifiers are commonly constructed during
+	 * static initialization.
+	 */
+	static ParamIDRegistry& getRegistry()
+	{
+		static ParamIDRegistry registry;
+		return registry;
+	}
+
+	UINT32 ParamID::registerName(const String& name)
+	{
+		ParamIDRegistry& registry = getRegistry();
+
+		Lock lock(registry.mutex);
+		auto iterFind = registry.ids.find(name);
+		if (iterFind != registry.ids.end())
+			return iterFind->second;
+
+		const auto id = (UINT32)registry.ids.size();
+		registry.ids[name] = id;
+
+		return id;
+	}
+}
@@ -0,0 +1,108 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup RenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Identifies a GPU program or material parameter by name. Each unique name is assigned a small sequential integer
+	 * on construction, which objects holding parameters use to index directly into their own lookup tables, rather
+	 * than hashing and comparing strings.
+	 *
+	 * Identifiers are meant to be constructed once (e.g. as static or member variables) and then re-used for every lookup.
+	 * Same names always map to the same identifier, regardless of which object the identifier is used with. Only names
+	 * used for constructing an identifier are ever registered.
+	 */
+	class BS_CORE_EXPORT ParamID
+	{
+	public:
+		ParamID() = default;
+
+		explicit ParamID(const char* name)
+			:mName(name), mId(registerName(mName))
+		{ }
+
+		explicit ParamID(const String& name)
+			:mName(name), mId(registerName(mName))
+		{ }
+
+		bool operator== (const ParamID& rhs) const { return mId == rhs.mId; }
+		bool operator!= (const ParamID& rhs) const { return mId != rhs.mId; }
+
+		/** 
+		 * Returns the unique integer identifier of the parameter name. Identifiers are allocated sequentially starting
+		 * from zero. Returns -1 for an empty identifier.
+		 */
+		UINT32 id() const { return mId; }
+
+		/** Returns the name of the parameter. */
+		const char* c_str() const { return mName.c_str(); }
+
+		/** Returns the name of the parameter. */
+		const String& getName() const { return mName; }
+
+	private:
+		/** Returns the identifier assigned to the provided name, assigning a new one if the name is seen first time. */
+		static UINT32 registerName(const String& name);
+
+		String mName;
+		UINT32 mId = (UINT32)-1;
+	};
+
+	/** @} */
+	/** @addtogroup RenderAPI-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Maps parameter identifiers to indices local to the object owning the lookup (e.g. a parameter index within a
+	 * single material). Each identifier is resolved the first time it is looked up, after which lookups are a direct
+	 * array access. The table only grows to the largest identifier looked up through it.
+	 *
+	 * @note	Not thread safe. Objects owning the lookup are expected to be accessed from a single thread.
+	 */
+	class ParamIDLookup
+	{
+	public:
+		/**
+		 * Returns the index mapped to the provided identifier, or -1 if the identifier is empty or doesn't exist in
+		 * the owning object. When an identifier is looked up for the first time @p resolve is called to find its index.
+		 * 
+		 * @param[in]	id		Identifier to look up.
+		 * @param[in]	resolve	Callable with no parameters that returns the index of the parameter, or -1 if it
+		 *						doesn't exist. Only called once per identifier.
+		 */
+		template<class T>
+		UINT32 find(const ParamID& id, T resolve) const
+		{
+			const UINT32 slot = id.id();
+			if (slot == (UINT32)-1)
+				return (UINT32)-1;
+
+			if (slot >= (UINT32)mIndices.size())
+				mIndices.resize(slot + 1, UNRESOLVED);
+
+			UINT32& index = mIndices[slot];
+			if (index == UNRESOLVED)
+				index = resolve();
+
+			return index;
+		}
+
+		/** Forgets all resolved identifiers. Must be called if the set of parameters in the owning object changes. */
+		void clear() { mIndices.clear(); }
+
+	private:
+		static constexpr UINT32 UNRESOLVED = (UINT32)-2;
+
+		mutable Vector<UINT32> mIndices;
+	};
+
+	/** @} */
+}
@@ -162,6 +162,15 @@ namespace bs
 			mNumCombinedUniformBlocks = num;
 		}
 
+		/**
+		 * Sets the alignment, in bytes, required for offsets at which GPU param block buffers can be bound. Zero means
+		 * param block buffers can only be bound in their entirety.
+		 */
+		void setParamBlockOffsetAlignment(UINT32 alignment)
+		{
+			mParamBlockOffsetAlignment = alignment;
+		}
+
 		/**	Sets maximum number of bound vertex buffers. */
 		void setMaxBoundVertexBuffers(UINT32 num)
 		{
@@ -222,6 +231,15 @@ namespace bs
 			return mNumCombinedUniformBlocks;
 		}
 
+		/**
+		 * Returns the alignment, in bytes, required for offsets at which GPU param block buffers can be bound. Zero means
+		 * param block buffers can only be bound in their entirety.
+		 */
+		UINT32 getParamBlockOffsetAlignment() const
+		{
+			return mParamBlockOffsetAlignment;
+		}
+
 		/** Returns the maximum number of vertex buffers that can be bound at once. */
 		UINT32 getMaxBoundVertexBuffers() const
 		{
@@ -328,6 +346,8 @@ namespace bs
 		Map<GpuProgramType, UINT16> mNumGpuParamBlocksPerStage;
 		// Total number of uniform blocks available
 		UINT16 mNumCombinedUniformBlocks = 0;
+		// Alignment of offsets at which uniform blocks can be bound, or zero if offsets are not supported
+		UINT32 mParamBlockOffsetAlignment = 0;
 		// The number of load-store texture unitss available per stage
 		Map<GpuProgramType, UINT16> mNumLoadStoreTextureUnitsPerStage;
 		// Total number of load-store texture units available
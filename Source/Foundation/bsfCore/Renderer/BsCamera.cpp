@@ -124,14 +124,14 @@ namespace bs
 
 	ConvexVolume CameraBase::getWorldFrustum() const
 	{
-		const Vector<Plane>& frustumPlanes = getFrustum().getPlanes();
+		const auto& frustumPlanes = getFrustum().getPlanes();
 
 		const Transform& tfrm = getTransform();
 
 		Matrix4 worldMatrix;
 		worldMatrix.setTRS(tfrm.getPosition(), tfrm.getRotation(), Vector3::ONE);
 
-		Vector<Plane> worldPlanes(frustumPlanes.size());
+		SmallVector<Plane, 6> worldPlanes(frustumPlanes.size());
 		UINT32 i = 0;
 		for (auto& plane : frustumPlanes)
 		{
@@ -51,11 +51,15 @@ namespace bs { namespace ct
 			if (matches(textureData->texture, desc))
 			{
 				textureData->mIsFree = false;
+				onResourceUsageChanged(textureData->mId, textureData->mMemorySize, true);
+
 				return textureData;
 			}
 		}
 
 		SPtr<PooledRenderTexture> newTextureData = bs_shared_ptr_new<PooledRenderTexture>(this);
+		newTextureData->mId = mNextId++;
+		newTextureData->mMemorySize = getMemorySize(desc);
 		_registerTexture(newTextureData);
 
 		TEXTURE_DESC texDesc;
@@ -97,6 +101,7 @@ namespace bs { namespace ct
 			newTextureData->renderTexture = RenderTexture::create(rtDesc);
 		}
 
+		onResourceUsageChanged(newTextureData->mId, newTextureData->mMemorySize, true);
 		return newTextureData;
 	}
 
@@ -115,11 +120,15 @@ namespace bs { namespace ct
 			if (matches(bufferData->buffer, desc))
 			{
 				bufferData->mIsFree = false;
+				onResourceUsageChanged(bufferData->mId, bufferData->mMemorySize, true);
+
 				return bufferData;
 			}
 		}
 
 		SPtr<PooledStorageBuffer> newBufferData = bs_shared_ptr_new<PooledStorageBuffer>(this);
+		newBufferData->mId = mNextId++;
+		newBufferData->mMemorySize = getMemorySize(desc);
 		_registerBuffer(newBufferData);
 
 		GPU_BUFFER_DESC bufferDesc;
@@ -131,19 +140,54 @@ namespace bs { namespace ct
 
 		newBufferData->buffer = GpuBuffer::create(bufferDesc);
 
+		onResourceUsageChanged(newBufferData->mId, newBufferData->mMemorySize, true);
 		return newBufferData;
 	}
 
 	void GpuResourcePool::release(const SPtr<PooledRenderTexture>& texture)
 	{
 		auto iterFind = mTextures.find(texture.get());
-		iterFind->second.lock()->mIsFree = true;
+		SPtr<PooledRenderTexture> textureData = iterFind->second.lock();
+
+		if (!textureData->mIsFree)
+		{
+			textureData->mIsFree = true;
+			onResourceUsageChanged(textureData->mId, textureData->mMemorySize, false);
+		}
 	}
 
 	void GpuResourcePool::release(const SPtr<PooledStorageBuffer>& buffer)
 	{
 		auto iterFind = mBuffers.find(buffer.get());
-		iterFind->second.lock()->mIsFree = true;
+		SPtr<PooledStorageBuffer> bufferData = iterFind->second.lock();
+
+		if (!bufferData->mIsFree)
+		{
+			bufferData->mIsFree = true;
+			onResourceUsageChanged(bufferData->mId, bufferData->mMemorySize, false);
+		}
+	}
+
+	void GpuResourcePool::startRecording()
+	{
+		mEvents.clear();
+		mIsRecording = true;
+	}
+
+	void GpuResourcePool::stopRecording()
+	{
+		mIsRecording = false;
+	}
+
+	void GpuResourcePool::onResourceUsageChanged(UINT32 id, UINT64 memorySize, bool acquired)
+	{
+		if (acquired)
+			mUsedMemory += memorySize;
+		else
+			mUsedMemory -= memorySize;
+
+		if (mIsRecording)
+			mEvents.push_back({ id, memorySize, acquired });
 	}
 
 	bool GpuResourcePool::matches(const SPtr<Texture>& texture, const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -189,23 +233,63 @@ namespace bs { namespace ct
 		return match;
 	}
 
+	UINT64 GpuResourcePool::getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc)
+	{
+		UINT32 numFaces = desc.type == TEX_TYPE_CUBE_MAP ? 6 : 1;
+		if (desc.type != TEX_TYPE_3D)
+			numFaces *= desc.arraySize;
+
+		UINT64 size = 0;
+		for (UINT32 i = 0; i <= desc.numMipLevels; i++)
+		{
+			UINT32 width = std::max(1U, desc.width >> i);
+			UINT32 height = std::max(1U, desc.height >> i);
+			UINT32 depth = std::max(1U, desc.depth >> i);
+
+			size += PixelUtil::getMemorySize(width, height, depth, desc.format);
+		}
+
+		return size * numFaces * std::max(1U, desc.numSamples);
+	}
+
+	UINT64 GpuResourcePool::getMemorySize(const POOLED_STORAGE_BUFFER_DESC& desc)
+	{
+		UINT32 elementSize = desc.elementSize;
+		if (desc.type == GBT_STANDARD)
+			elementSize = bs::GpuBuffer::getFormatSize(desc.format);
+
+		return (UINT64)elementSize * desc.numElements;
+	}
+
 	void GpuResourcePool::_registerTexture(const SPtr<PooledRenderTexture>& texture)
 	{
 		mTextures.insert(std::make_pair(texture.get(), texture));
+		mAllocatedMemory += texture->mMemorySize;
 	}
 
 	void GpuResourcePool::_unregisterTexture(PooledRenderTexture* texture)
 	{
+		// Resources can be destroyed without being released first
+		if (!texture->mIsFree)
+			onResourceUsageChanged(texture->mId, texture->mMemorySize, false);
+
+		mAllocatedMemory -= texture->mMemorySize;
 		mTextures.erase(texture);
 	}
 
 	void GpuResourcePool::_registerBuffer(const SPtr<PooledStorageBuffer>& buffer)
 	{
 		mBuffers.insert(std::make_pair(buffer.get(), buffer));
+		mAllocatedMemory += buffer->mMemorySize;
 	}
 
 	void GpuResourcePool::_unregisterBuffer(PooledStorageBuffer* buffer)
 	{
+		// Resources can be destroyed without being released first
+		if (!buffer->mIsFree)
+			onResourceUsageChanged(buffer->mId, buffer->mMemorySize, false);
+
+		mAllocatedMemory -= buffer->mMemorySize;
 		mBuffers.erase(buffer);
 	}
 
@@ -263,6 +347,20 @@ namespace bs { namespace ct
 		return desc;
 	}
 
+	bool POOLED_RENDER_TEXTURE_DESC::operator==(const POOLED_RENDER_TEXTURE_DESC& rhs) const
+	{
+		return type == rhs.type
+			&& format == rhs.format
+			&& width == rhs.width
+			&& height == rhs.height
+			&& depth == rhs.depth
+			&& numSamples == rhs.numSamples
+			&& flag == rhs.flag
+			&& hwGamma == rhs.hwGamma
+			&& arraySize == rhs.arraySize
+			&& numMipLevels == rhs.numMipLevels;
+	}
+
 	POOLED_STORAGE_BUFFER_DESC POOLED_STORAGE_BUFFER_DESC::createStandard(GpuBufferFormat format, UINT32 numElements,
 		GpuBufferUsage usage)
 	{
@@ -26,11 +26,19 @@ namespace bs { namespace ct
 		SPtr<Texture> texture;
 		SPtr<RenderTexture> renderTexture;
 
+		/** Returns an identifier that uniquely identifies this texture within the pool. */
+		UINT32 getId() const { return mId; }
+
+		/** Returns the approximate amount of GPU memory used by the texture, in bytes. */
+		UINT64 getMemorySize() const { return mMemorySize; }
+
 	private:
 		friend class GpuResourcePool;
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		UINT32 mId = 0;
+		UINT64 mMemorySize = 0;
 	};
 
 	/**	Contains data about a single storage buffer in the GPU resource pool. */
@@ -41,11 +49,27 @@ namespace bs { namespace ct
 
 		SPtr<GpuBuffer> buffer;
 
+		/** Returns an identifier that uniquely identifies this buffer within the pool. */
+		UINT32 getId() const { return mId; }
+
+		/** Returns the approximate amount of GPU memory used by the buffer, in bytes. */
+		UINT64 getMemorySize() const { return mMemorySize; }
+
 	private:
 		friend class GpuResourcePool;
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		UINT32 mId = 0;
+		UINT64 mMemorySize = 0;
+	};
+
+	/** Describes a resource being retrieved from, or returned to a GpuResourcePool. */
+	struct GpuResourcePoolEvent
+	{
+		UINT32 resourceId; /**< Identifier of the pooled texture or buffer, as returned by their getId() method. */
+		UINT64 memorySize; /**< Approximate amount of GPU memory used by the resource, in bytes. */
+		bool acquired; /**< True if the resource was retrieved from the pool, false if it was returned to it. */
 	};
 
 	/** 
@@ -93,10 +117,34 @@ namespace bs { namespace ct
 		 */
 		void release(const SPtr<PooledStorageBuffer>& buffer);
 
+		/**
+		 * Starts recording every retrieval and release of pooled resources. Any previously recorded events are
+		 * discarded.
+		 */
+		void startRecording();
+
+		/** Stops recording events started by startRecording(). Recorded events remain available until recording restarts. */
+		void stopRecording();
+
+		/** Returns events recorded since the last call to startRecording(), in the order they happened. */
+		const Vector<GpuResourcePoolEvent>& getRecordedEvents() const { return mEvents; }
+
+		/** Returns the approximate amount of GPU memory used by resources currently retrieved from the pool, in bytes. */
+		UINT64 getUsedMemory() const { return mUsedMemory; }
+
+		/** Returns the approximate amount of GPU memory used by all resources in the pool, in bytes. */
+		UINT64 getAllocatedMemory() const { return mAllocatedMemory; }
+
+		/** Returns the approximate amount of GPU memory required by a texture matching the provided descriptor. */
+		static UINT64 getMemorySize(const POOLED_RENDER_TEXTURE_DESC& desc);
+
 	private:
 		friend struct PooledRenderTexture;
 		friend struct PooledStorageBuffer;
 
+		/** Updates memory counters and records an event when a resource is retrieved from, or returned to the pool. */
+		void onResourceUsageChanged(UINT32 id, UINT64 memorySize, bool acquired);
+
 		/**	Registers a newly created render texture in the pool. */
 		void _registerTexture(const SPtr<PooledRenderTexture>& texture);
 
@@ -125,8 +173,18 @@ namespace bs { namespace ct
 		 */
 		static bool matches(const SPtr<GpuBuffer>& buffer, const POOLED_STORAGE_BUFFER_DESC& desc);
 
+		/** Returns the approximate amount of GPU memory required by a buffer matching the provided descriptor. */
+		static UINT64 getMemorySize(const POOLED_STORAGE_BUFFER_DESC& desc);
+
 		Map<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
 		Map<PooledStorageBuffer*, std::weak_ptr<PooledStorageBuffer>> mBuffers;
+
+		UINT32 mNextId = 0;
+		UINT64 mUsedMemory = 0;
+		UINT64 mAllocatedMemory = 0;
+
+		bool mIsRecording = false;
+		Vector<GpuResourcePoolEvent> mEvents;
 	};
 
 	/** Structure used for creating a new pooled render texture. */
@@ -177,6 +235,9 @@ namespace bs { namespace ct
 		static POOLED_RENDER_TEXTURE_DESC createCube(PixelFormat format, UINT32 width, UINT32 height,
 			INT32 usage = TU_STATIC, UINT32 arraySize = 1);
 
+		/** Checks if both descriptors describe the same kind of texture, meaning one texture can satisfy both. */
+		bool operator==(const POOLED_RENDER_TEXTURE_DESC& rhs) const;
+
 	private:
 		friend class GpuResourcePool;
 
@@ -26,8 +26,8 @@ namespace bs
 
 	template<bool Core>
 	TRenderable<Core>::TRenderable()
-		: mLayer(1), mUseOverrideBounds(false), mTfrmMatrix(BsIdentity), mTfrmMatrixNoScale(BsIdentity)
-		, mAnimType(RenderableAnimType::None)
+		: mLayer(1), mUseOverrideBounds(false), mIsOccluder(false), mTfrmMatrix(BsIdentity)
+		, mTfrmMatrixNoScale(BsIdentity), mAnimType(RenderableAnimType::None)
 	{
 		mMaterials.resize(1);
 	}
@@ -139,6 +139,16 @@ namespace bs
 		_markCoreDirty();
 	}
 
+	template<bool Core>
+	void TRenderable<Core>::setIsOccluder(bool occluder)
+	{
+		if (mIsOccluder == occluder)
+			return;
+
+		mIsOccluder = occluder;
+		_markCoreDirty();
+	}
+
 	template class TRenderable < false >;
 	template class TRenderable < true >;
 
@@ -300,6 +310,7 @@ namespace bs
 		// The most common case if only the transform changed, so we sync only transform related options
 		UINT32 numMaterials = 0;
 		UINT64 animationId = 0;
+		SPtr<MeshData> occluderData;
 		if(dirtyFlags != (UINT32)ActorDirtyFlag::Transform)
 		{
 			numMaterials = (UINT32)mMaterials.size();
@@ -309,6 +320,10 @@ namespace bs
 			else
 				animationId = (UINT64)-1;
 
+			// Occluders are rasterized on the CPU, so they need access to the cached mesh geometry
+			if (mIsOccluder && mMesh.isLoaded())
+				occluderData = mMesh->getCachedData();
+
 			size +=
 				rttiGetElemSize(mLayer) +
 				rttiGetElemSize(mOverrideBounds) +
@@ -317,6 +332,7 @@ namespace bs
 				rttiGetElemSize(animationId) +
 				rttiGetElemSize(mAnimType) +
 				sizeof(SPtr<ct::Mesh>) +
+				sizeof(SPtr<MeshData>) +
 				numMaterials * sizeof(SPtr<ct::Material>);
 		}
 
@@ -342,6 +358,9 @@ namespace bs
 
 			dataPtr += sizeof(SPtr<ct::Mesh>);
 
+			new (dataPtr) SPtr<MeshData>(occluderData);
+			dataPtr += sizeof(SPtr<MeshData>);
+
 			for (UINT32 i = 0; i < numMaterials; i++)
 			{
 				SPtr<ct::Material>* material = new (dataPtr)SPtr<ct::Material>();
@@ -629,6 +648,11 @@ namespace bs
 			mesh->~SPtr<Mesh>();
 			dataPtr += sizeof(SPtr<Mesh>);
 
+			SPtr<MeshData>* occluderData = (SPtr<MeshData>*)dataPtr;
+			mOccluderData = *occluderData;
+			occluderData->~SPtr<MeshData>();
+			dataPtr += sizeof(SPtr<MeshData>);
+
 			for (UINT32 i = 0; i < numMaterials; i++)
 			{
 				SPtr<Material>* material = (SPtr<Material>*)dataPtr;
@@ -95,6 +95,17 @@ namespace bs
 		 */
 		void setUseOverrideBounds(bool enable);
 
+		/**
+		 * Determines if the renderable acts as an occluder, hiding objects behind it during CPU occlusion culling. The
+		 * geometry of the mesh is used as is, so occluders should be large objects with simple meshes (e.g. walls or 
+		 * buildings). Only meshes created with the MU_CPUCACHED usage flag can be used as occluders, and animated 
+		 * renderables are never used as occluders. Disabled by default.
+		 */
+		void setIsOccluder(bool occluder);
+
+		/** @copydoc setIsOccluder() */
+		bool getIsOccluder() const { return mIsOccluder; }
+
 		/** @copydoc setLayer() */
 		UINT64 getLayer() const { return mLayer; }
 
@@ -132,6 +143,7 @@ namespace bs
 		UINT64 mLayer;
 		AABox mOverrideBounds;
 		bool mUseOverrideBounds;
+		bool mIsOccluder;
 		Matrix4 mTfrmMatrix;
 		Matrix4 mTfrmMatrixNoScale;
 		RenderableAnimType mAnimType;
@@ -266,6 +278,12 @@ namespace bs
 		/** Returns vertex declaration used for rendering meshes containing morph shape information. */
 		const SPtr<VertexDeclaration>& getMorphVertexDeclaration() const { return mMorphVertexDeclaration; }
 
+		/** 
+		 * Returns the CPU copy of the mesh geometry, used for rasterizing the renderable as an occluder. Null if the
+		 * renderable isn't an occluder, or if its mesh isn't cached on the CPU.
+		 */
+		const SPtr<MeshData>& getOccluderData() const { return mOccluderData; }
+
 	protected:
 		friend class bs::Renderable;
 
@@ -287,6 +305,7 @@ namespace bs
 		SPtr<GpuBuffer> mBoneMatrixBuffer;
 		SPtr<VertexBuffer> mMorphShapeBuffer;
 		SPtr<VertexDeclaration> mMorphVertexDeclaration;
+		SPtr<MeshData> mOccluderData;
 	};
 	}
 
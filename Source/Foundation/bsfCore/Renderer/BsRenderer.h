@@ -38,7 +38,7 @@ namespace bs
 	static const ShaderVariation& getVertexInputVariation()
 	{
 		static ShaderVariation variation = ShaderVariation(
-		Vector<ShaderVariation::Param>{
+		SmallVector<ShaderVariation::Param, 4>{
 			ShaderVariation::Param("SKINNED", skinned),
 			ShaderVariation::Param("MORPH", morph),
 		});
@@ -46,12 +46,26 @@ namespace bs
 		return variation;
 	}
 
+	/** Returns a specific deferred rendering shader variation. */
+	template<bool skinned, bool morph, bool instanced>
+	static const ShaderVariation& getDeferredRenderingVariation()
+	{
+		static ShaderVariation variation = ShaderVariation(
+		SmallVector<ShaderVariation::Param, 4>{
+			ShaderVariation::Param("SKINNED", skinned),
+			ShaderVariation::Param("MORPH", morph),
+			ShaderVariation::Param("INSTANCED", instanced),
+		});
+
+		return variation;
+	}
+
 	/** Returns a specific forward rendering shader variation. */
 	template<bool skinned, bool morph, bool clustered>
 	static const ShaderVariation& getForwardRenderingVariation()
 	{
 		static ShaderVariation variation = ShaderVariation(
-		Vector<ShaderVariation::Param>{
+		SmallVector<ShaderVariation::Param, 4>{
 			ShaderVariation::Param("SKINNED", skinned),
 			ShaderVariation::Param("MORPH", morph),
 			ShaderVariation::Param("CLUSTERED", clustered),
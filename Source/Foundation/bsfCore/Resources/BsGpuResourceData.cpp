@@ -7,8 +7,8 @@
 
 namespace bs
 {
-	GpuResourceData::GpuResourceData()
-		:mData(nullptr), mOwnsData(false), mLocked(false)
+	GpuResourceData::GpuResourceData(MemoryCategory category)
+		:mData(nullptr), mOwnsData(false), mLocked(false), mMemoryCategory(category)
 	{
 
 	}
@@ -18,6 +18,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mMemoryCategory = copy.mMemoryCategory;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -64,7 +65,7 @@ namespace bs
 
 		freeInternalBuffer();
 
-		mData = (UINT8*)bs_alloc(size);
+		mData = (UINT8*)bs_alloc(size, mMemoryCategory);
 		mOwnsData = true;
 	}
 
@@ -28,7 +28,12 @@ namespace bs
 	class BS_CORE_EXPORT GpuResourceData : public IReflectable
 	{
 	public:
-		GpuResourceData();
+		/**
+		 * Constructs a new empty resource data object.
+		 *
+		 * @param[in]	category	Memory category the internal buffer is accounted to.
+		 */
+		GpuResourceData(MemoryCategory category = MemoryCategory::General);
 		GpuResourceData(const GpuResourceData& copy);
 		virtual ~GpuResourceData();
 
@@ -86,6 +91,7 @@ namespace bs
 		UINT8* mData;
 		bool mOwnsData;
 		mutable bool mLocked;
+		MemoryCategory mMemoryCategory;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -20,7 +20,16 @@ namespace bs
 		 * Note that this flag must be specified on component creation, in its constructor and any later changes
 		 * to the flag could be ignored.
 		 */
-		AlwaysRun = 1 
+		AlwaysRun = 1,
+
+		/**
+		 * Signals that update() and fixedUpdate() of the component only modify state owned by the component, allowing
+		 * the scene manager to call them from worker threads, in parallel with other components of the same type that
+		 * have this flag set. Any changes to the scene structure (creating or destroying objects and components, changing
+		 * the hierarchy or activating objects) made from those methods must be queued through
+		 * SceneManager::deferUntilSync(). Off by default. Must be specified on component creation, in its constructor.
+		 */
+		ThreadSafeUpdate = 2
 	};
 
 	typedef Flags<ComponentFlag> ComponentFlags;
@@ -165,6 +174,12 @@ namespace bs
 		/** Returns an index that unique identifies a component with the SceneManager. */
 		UINT32 getSceneManagerId() const { return mSceneManagerId; }
 
+		/** Sets an index that identifies the component within its SceneManager update bucket. */
+		void setUpdateBucketId(UINT32 id) { mUpdateBucketId = id; }
+
+		/** Returns an index that identifies the component within its SceneManager update bucket. */
+		UINT32 getUpdateBucketId() const { return mUpdateBucketId; }
+
 		/**
 		 * Destroys this component.
 		 *
@@ -183,6 +198,7 @@ namespace bs
 		TransformChangedFlags mNotifyFlags = TCF_None;
 		ComponentFlags mFlags;
 		UINT32 mSceneManagerId = 0;
+		UINT32 mUpdateBucketId = 0;
 
 	private:
 		HSceneObject mParent;
@@ -52,6 +52,12 @@ namespace bs
 		}
 	}
 
+	UINT64& GameObjectHandleRTTI::getOriginalInstanceId()
+	{
+		static BS_THREADLOCAL UINT64 originalInstanceId = 0;
+		return originalInstanceId;
+	}
+
 	RTTITypeBase* GameObjectHandleBase::getRTTIStatic()
 	{
 		return GameObjectHandleRTTI::instance();
@@ -5,8 +5,22 @@
 
 namespace bs
 {
+	/** Returns the index of the slot encoded in an instance ID. */
+	static UINT32 getSlotIndex(UINT64 id) { return (UINT32)(id & 0xFFFFFFFF); }
+
+	/** Returns the generation of the slot encoded in an instance ID. */
+	static UINT32 getSlotGeneration(UINT64 id) { return (UINT32)(id >> 32); }
+
+	/** Creates an instance ID from a slot index and generation. */
+	static UINT64 makeInstanceId(UINT32 slotIdx, UINT32 generation) { return ((UINT64)generation << 32) | slotIdx; }
+
+	/** Generation used for temporary IDs of detached objects. Slots are retired before they reach it. */
+	static constexpr UINT32 DETACHED_GENERATION = 0xFFFFFFFF;
+
+	/** Objects output by the detached deserialization active on the current thread, if any. */
+	static BS_THREADLOCAL GameObjectManager::DetachedObjects* sDetachedObjects = nullptr;
+
 	GameObjectManager::GameObjectManager()
-		:mNextAvailableID(1), mIsDeserializationActive(false), mGODeserializationMode(GODM_UseNewIds | GODM_BreakExternal)
 	{
 
 	}
@@ -18,30 +32,26 @@ namespace bs
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const
 	{
-		auto iterFind = mObjects.find(id);
-
-		if (iterFind != mObjects.end())
-			return iterFind->second;
+		SPtr<GameObjectHandleData> handleData = findObject(id);
+		if (handleData != nullptr)
+			return GameObjectHandleBase(handleData);
 
 		return nullptr;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		auto iterFind = mObjects.find(id);
-
-		if (iterFind != mObjects.end())
-		{
-			object = iterFind->second;
-			return true;
-		}
+		SPtr<GameObjectHandleData> handleData = findObject(id);
+		if (handleData == nullptr)
+			return false;
 
-		return false;
+		object = GameObjectHandleBase(handleData);
+		return true;
 	}
 
 	bool GameObjectManager::objectExists(UINT64 id) const
 	{
-		return mObjects.find(id) != mObjects.end();
+		return findObject(id) != nullptr;
 	}
 
 	void GameObjectManager::remapId(UINT64 oldId, UINT64 newId)
@@ -49,8 +59,14 @@ namespace bs
 		if (oldId == newId)
 			return;
 
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		SPtr<GameObjectHandleData> handleData = findObject(oldId);
+		if (handleData == nullptr)
+			return;
+
+		// The new ID was generated for a different slot (or a different generation of the slot), so the object cannot
+		// stay in the slot map. This only happens when restoring IDs of destroyed objects, so it should be rare.
+		removeObject(oldId);
+		mRemappedObjects[newId] = handleData;
 	}
 
 	void GameObjectManager::queueForDestroy(const GameObjectHandleBase& object)
@@ -58,106 +74,296 @@ namespace bs
 		if (object.isDestroyed())
 			return;
 
-		UINT64 instanceId = object->getInstanceId();
-		mQueuedForDestroy[instanceId] = object;
+		mQueuedForDestroy.push_back(object);
 	}
 
 	void GameObjectManager::destroyQueuedObjects()
 	{
-		for (auto& objPair : mQueuedForDestroy)
-			objPair.second->destroyInternal(objPair.second, true);
+		// Note: Using indices as destruction callbacks might queue more objects
+		for (UINT32 i = 0; i < (UINT32)mQueuedForDestroy.size(); i++)
+		{
+			// Object might have been queued multiple times, or destroyed along with its parent
+			GameObjectHandleBase object = mQueuedForDestroy[i];
+			if (!object.isDestroyed())
+				object->destroyInternal(object, true);
+		}
 
 		mQueuedForDestroy.clear();
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object, UINT64 originalId)
 	{
-		object->initialize(object, mNextAvailableID);
-
 		// If deserialization is active we must ensure all handles pointing to the same object share GameObjectHandleData,
 		// so check if any handles referencing this object have been created. See ::registerUnresolvedHandle for
 		// further explanation.
-		if (mIsDeserializationActive)
+		DeserializationState& state = getDeserializationState();
+		if (state.isActive)
 		{
 			assert(originalId != 0 && "You must provide an original ID when registering a deserialized game object.");
 
-			auto iterFind = mUnresolvedHandleData.find(originalId);
-			if (iterFind != mUnresolvedHandleData.end())
-			{
-				GameObjectHandleBase handle;
-				handle.mData = iterFind->second;
-				handle._setHandleData(object);
-
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
+			SPtr<GameObjectHandleData> handleData;
 
-				return handle;
-			}
-			else
-			{
-				GameObjectHandleBase handle(object);
+			auto iterFind = state.unresolvedHandleData.find(originalId);
+			if (iterFind != state.unresolvedHandleData.end())
+				handleData = iterFind->second;
 
-				mObjects[mNextAvailableID] = handle;
-				mIdMapping[originalId] = mNextAvailableID;
-				mNextAvailableID++;
+			GameObjectHandleBase handle = addObject(object, handleData);
+			state.idMapping[originalId] = object->getInstanceId();
 
-				return handle;
-			}
+			return handle;
 		}
 
-		GameObjectHandleBase handle(object);
-		mObjects[mNextAvailableID] = handle;
-		mNextAvailableID++;
-
-		return handle;
+		return addObject(object, nullptr);
 	}
 
 	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
 	{
-		mObjects.erase(object->getInstanceId());
+		removeObject(object->getInstanceId());
 
 		onDestroyed(static_object_cast<GameObject>(object));
 		object.destroy();
 	}
 
+	GameObjectHandleBase GameObjectManager::addObject(const SPtr<GameObject>& object, 
+		SPtr<GameObjectHandleData> handleData)
+	{
+		DetachedObjects* detached = sDetachedObjects;
+		if (detached != nullptr)
+		{
+			// Temporary ID, replaced with a permanent one in registerDetachedObject()
+			object->initialize(object, makeInstanceId((UINT32)detached->mObjects.size(), DETACHED_GENERATION));
+
+			GameObjectHandleBase handle = createHandle(object, std::move(handleData));
+			detached->mObjects.push_back(handle);
+			detached->mObjectLookup[object->getInstanceId()] = handle.mData;
+
+			return handle;
+		}
+
+		const UINT32 slotIdx = allocateSlot();
+		ObjectSlot& slot = mSlots[slotIdx];
+		object->initialize(object, makeInstanceId(slotIdx, slot.generation));
+
+		GameObjectHandleBase handle = createHandle(object, std::move(handleData));
+		slot.handleData = handle.mData;
+
+		return handle;
+	}
+
+	GameObjectHandleBase GameObjectManager::createHandle(const SPtr<GameObject>& object, 
+		SPtr<GameObjectHandleData> handleData)
+	{
+		if (handleData == nullptr)
+			return GameObjectHandleBase(object);
+
+		GameObjectHandleBase handle(std::move(handleData));
+		handle._setHandleData(object);
+
+		return handle;
+	}
+
+	UINT32 GameObjectManager::allocateSlot()
+	{
+		if (!mFreeSlots.empty())
+		{
+			const UINT32 slotIdx = mFreeSlots.back();
+			mFreeSlots.pop_back();
+
+			return slotIdx;
+		}
+
+		mSlots.emplace_back();
+		return (UINT32)mSlots.size() - 1;
+	}
+
+	const GameObjectManager::ObjectSlot* GameObjectManager::findSlot(UINT64 id) const
+	{
+		const UINT32 slotIdx = getSlotIndex(id);
+		if (slotIdx >= (UINT32)mSlots.size())
+			return nullptr;
+
+		const ObjectSlot& slot = mSlots[slotIdx];
+		if (slot.generation != getSlotGeneration(id) || slot.handleData == nullptr)
+			return nullptr;
+
+		return &slot;
+	}
+
+	SPtr<GameObjectHandleData> GameObjectManager::findObject(UINT64 id) const
+	{
+		// Live objects cannot be safely accessed during detached deserialization, as it might be running on any thread
+		if (sDetachedObjects != nullptr)
+		{
+			auto iterFind = sDetachedObjects->mObjectLookup.find(id);
+			if (iterFind != sDetachedObjects->mObjectLookup.end())
+				return iterFind->second;
+
+			return nullptr;
+		}
+
+		const ObjectSlot* slot = findSlot(id);
+		if (slot != nullptr)
+			return slot->handleData;
+
+		if (!mRemappedObjects.empty())
+		{
+			auto iterFind = mRemappedObjects.find(id);
+			if (iterFind != mRemappedObjects.end())
+				return iterFind->second;
+		}
+
+		return nullptr;
+	}
+
+	void GameObjectManager::removeObject(UINT64 id)
+	{
+		// Objects that were never registered don't need to be removed
+		if (getSlotGeneration(id) == DETACHED_GENERATION)
+			return;
+
+		const UINT32 slotIdx = getSlotIndex(id);
+		if (findSlot(id) == nullptr)
+		{
+			mRemappedObjects.erase(id);
+			return;
+		}
+
+		ObjectSlot& slot = mSlots[slotIdx];
+		slot.handleData = nullptr;
+		slot.generation++;
+
+		// Once the generation reaches the one reserved for detached objects the slot can no longer produce unique IDs,
+		// so retire it
+		if (slot.generation != DETACHED_GENERATION)
+			mFreeSlots.push_back(slotIdx);
+	}
+
+	void GameObjectManager::startDetachedDeserialization(DetachedObjects& objects)
+	{
+		assert(sDetachedObjects == nullptr);
+
+		sDetachedObjects = &objects;
+	}
+
+	void GameObjectManager::endDetachedDeserialization()
+	{
+		assert(sDetachedObjects != nullptr && !sDetachedObjects->mState.isActive);
+
+		sDetachedObjects = nullptr;
+	}
+
+	bool GameObjectManager::isDetachedDeserializationActive() const
+	{
+		return sDetachedObjects != nullptr;
+	}
+
+	bool GameObjectManager::registerDetachedObject(DetachedObjects& objects)
+	{
+		assert(sDetachedObjects != &objects);
+
+		const auto numObjects = (UINT32)objects.mObjects.size();
+		if (objects.mNumRegistered < numObjects)
+		{
+			const GameObjectHandleBase& object = objects.mObjects[objects.mNumRegistered++];
+
+			// Object might have been destroyed before it was registered
+			if (!object.isDestroyed())
+			{
+				const UINT32 slotIdx = allocateSlot();
+				ObjectSlot& slot = mSlots[slotIdx];
+
+				object.mData->mPtr->mInstanceId = makeInstanceId(slotIdx, slot.generation);
+				slot.handleData = object.mData;
+			}
+
+			if (objects.mNumRegistered < numObjects)
+				return false;
+		}
+
+		// All objects have their final IDs, and handles pointing outside of them can be looked up
+		for (auto& entry : objects.mExternalHandles)
+		{
+			SPtr<GameObjectHandleData> handleData = findObject(entry.instanceId);
+
+			if (handleData != nullptr)
+				entry.handle._resolve(GameObjectHandleBase(handleData));
+			else
+			{
+				if ((entry.flags & GODM_KeepMissing) == 0)
+					entry.handle._resolve(nullptr);
+			}
+		}
+
+		for (auto iter = objects.mEndCallbacks.rbegin(); iter != objects.mEndCallbacks.rend(); ++iter)
+		{
+			(*iter)();
+		}
+
+		objects.mExternalHandles.clear();
+		objects.mEndCallbacks.clear();
+		objects.mObjectLookup.clear();
+
+		return true;
+	}
+
 	void GameObjectManager::startDeserialization()
 	{
-		assert(!mIsDeserializationActive);
+		DeserializationState& state = getDeserializationState();
+		assert(!state.isActive);
 
-		mIsDeserializationActive = true;
+		state.isActive = true;
 	}
 
 	void GameObjectManager::endDeserialization()
 	{
-		assert(mIsDeserializationActive);
+		DeserializationState& state = getDeserializationState();
+		assert(state.isActive);
 
-		for (auto& unresolvedHandle : mUnresolvedHandles)
-			resolveDeserializedHandle(unresolvedHandle, mGODeserializationMode);
+		for (auto& unresolvedHandle : state.unresolvedHandles)
+			resolveDeserializedHandle(unresolvedHandle, state.flags);
 
-		for (auto iter = mEndCallbacks.rbegin(); iter != mEndCallbacks.rend(); ++iter)
+		if (sDetachedObjects != nullptr)
 		{
-			(*iter)();
+			// Callbacks might rely on final object IDs, so delay them until the detached objects are registered
+			Vector<std::function<void()>>& endCallbacks = sDetachedObjects->mEndCallbacks;
+			endCallbacks.insert(endCallbacks.end(), state.endCallbacks.begin(), state.endCallbacks.end());
+		}
+		else
+		{
+			for (auto iter = state.endCallbacks.rbegin(); iter != state.endCallbacks.rend(); ++iter)
+			{
+				(*iter)();
+			}
 		}
 
-		mIsDeserializationActive = false;
-		mActiveDeserializedObject = nullptr;
-		mIdMapping.clear();
-		mUnresolvedHandles.clear();
-		mEndCallbacks.clear();
-		mUnresolvedHandleData.clear();
+		state.isActive = false;
+		state.idMapping.clear();
+		state.unresolvedHandles.clear();
+		state.endCallbacks.clear();
+		state.unresolvedHandleData.clear();
+	}
+
+	bool GameObjectManager::isGameObjectDeserializationActive() const
+	{
+		return getDeserializationState().isActive;
+	}
+
+	UINT32 GameObjectManager::getDeserializationFlags() const
+	{
+		return getDeserializationState().flags;
 	}
 
 	void GameObjectManager::resolveDeserializedHandle(UnresolvedHandle& data, UINT32 flags)
 	{
-		assert(mIsDeserializationActive);
+		DeserializationState& state = getDeserializationState();
+		assert(state.isActive);
 
 		UINT64 instanceId = data.originalInstanceId;
 
 		bool isInternalReference = false;
 
-		auto findIter = mIdMapping.find(instanceId);
-		if (findIter != mIdMapping.end())
+		auto findIter = state.idMapping.find(instanceId);
+		if (findIter != state.idMapping.end())
 		{
 			if ((flags & GODM_UseNewIds) != 0)
 				instanceId = findIter->second;
@@ -167,10 +373,17 @@ namespace bs
 
 		if (isInternalReference || (!isInternalReference && (flags & GODM_RestoreExternal) != 0))
 		{
-			auto findIterObj = mObjects.find(instanceId);
+			SPtr<GameObjectHandleData> handleData = findObject(instanceId);
+
+			// Handle points to an object outside of the detached set, which can only be found after registration
+			if (handleData == nullptr && sDetachedObjects != nullptr)
+			{
+				sDetachedObjects->mExternalHandles.push_back({ instanceId, data.handle, flags });
+				return;
+			}
 
-			if (findIterObj != mObjects.end())
-				data.handle._resolve(findIterObj->second);
+			if (handleData != nullptr)
+				data.handle._resolve(GameObjectHandleBase(handleData));
 			else
 			{
 				if ((flags & GODM_KeepMissing) == 0)
@@ -186,8 +399,10 @@ namespace bs
 
 	void GameObjectManager::registerUnresolvedHandle(UINT64 originalId, GameObjectHandleBase& object)
 	{
+		DeserializationState& state = getDeserializationState();
+
 #if BS_DEBUG_MODE
-		if (!mIsDeserializationActive)
+		if (!state.isActive)
 		{
 			BS_EXCEPT(InvalidStateException, "Unresolved handle queue only be modified while deserialization is active.");
 		}
@@ -202,13 +417,13 @@ namespace bs
 		bool foundHandleData = false;
 
 		// Search object that are currently being deserialized
-		auto iterFind = mIdMapping.find(originalId);
-		if (iterFind != mIdMapping.end())
+		auto iterFind = state.idMapping.find(originalId);
+		if (iterFind != state.idMapping.end())
 		{
-			auto iterFind2 = mObjects.find(iterFind->second);
-			if (iterFind2 != mObjects.end())
+			SPtr<GameObjectHandleData> handleData = findObject(iterFind->second);
+			if (handleData != nullptr)
 			{
-				object.mData = iterFind2->second.mData;
+				object.mData = handleData;
 				foundHandleData = true;
 			}
 		}
@@ -216,8 +431,8 @@ namespace bs
 		// Search previously deserialized handles
 		if (!foundHandleData)
 		{
-			auto iterFind = mUnresolvedHandleData.find(originalId);
-			if (iterFind != mUnresolvedHandleData.end())
+			auto iterFind = state.unresolvedHandleData.find(originalId);
+			if (iterFind != state.unresolvedHandleData.end())
 			{
 				object.mData = iterFind->second;
 				foundHandleData = true;
@@ -226,32 +441,52 @@ namespace bs
 
 		// If still not found, this is the first such handle so register its handle data
 		if (!foundHandleData)
-			mUnresolvedHandleData[originalId] = object.mData;
+			state.unresolvedHandleData[originalId] = object.mData;
 
-		mUnresolvedHandles.push_back({ originalId, object });
+		state.unresolvedHandles.push_back({ originalId, object });
 	}
 
 	void GameObjectManager::registerOnDeserializationEndCallback(std::function<void()> callback)
 	{
+		DeserializationState& state = getDeserializationState();
+
 #if BS_DEBUG_MODE
-		if (!mIsDeserializationActive)
+		if (!state.isActive)
 		{
 			BS_EXCEPT(InvalidStateException, "Callback queue only be modified while deserialization is active.");
 		}
 #endif
 
-		mEndCallbacks.push_back(callback);
+		state.endCallbacks.push_back(callback);
 	}
 
 	void GameObjectManager::setDeserializationMode(UINT32 gameObjectDeserializationMode)
 	{
+		DeserializationState& state = getDeserializationState();
+
 #if BS_DEBUG_MODE
-		if (mIsDeserializationActive)
+		if (state.isActive)
 		{
 			BS_EXCEPT(InvalidStateException, "Deserialization modes can not be modified when deserialization is not active.");
 		}
 #endif
 
-		mGODeserializationMode = gameObjectDeserializationMode;
+		state.flags = gameObjectDeserializationMode;
+	}
+
+	GameObjectManager::DeserializationState& GameObjectManager::getDeserializationState()
+	{
+		if (sDetachedObjects != nullptr)
+			return sDetachedObjects->mState;
+
+		return mDeserializationState;
+	}
+
+	const GameObjectManager::DeserializationState& GameObjectManager::getDeserializationState() const
+	{
+		if (sDetachedObjects != nullptr)
+			return sDetachedObjects->mState;
+
+		return mDeserializationState;
 	}
 }
\ No newline at end of file
@@ -32,6 +32,10 @@ namespace bs
 	/**
 	 * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
 	 *
+	 * Live objects are stored in a slot map. Instance IDs encode the index of the object's slot in the lower 32 bits, and
+	 * the generation of the slot in the upper 32 bits. The generation is incremented whenever an object is removed from
+	 * the slot, which ensures IDs of destroyed objects never match an object later stored in the same slot.
+	 *
 	 * @note	Sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
@@ -43,7 +47,57 @@ namespace bs
 			GameObjectHandleBase handle;
 		};
 
+		/** Entry in the slot map of live objects. */
+		struct ObjectSlot
+		{
+			SPtr<GameObjectHandleData> handleData; /**< Data of the handle to the object, or null if the slot is free. */
+			UINT32 generation = 1;
+		};
+
+		/** Handle pointing outside of a detached deserialization, resolved once the detached objects are registered. */
+		struct ExternalHandle
+		{
+			UINT64 instanceId;
+			GameObjectHandleBase handle;
+			UINT32 flags;
+		};
+
+		/** State of a single GameObject deserialization session. */
+		struct DeserializationState
+		{
+			bool isActive = false;
+			UINT32 flags = GODM_UseNewIds | GODM_BreakExternal;
+			UnorderedMap<UINT64, UINT64> idMapping;
+			UnorderedMap<UINT64, SPtr<GameObjectHandleData>> unresolvedHandleData;
+			Vector<UnresolvedHandle> unresolvedHandles;
+			Vector<std::function<void()>> endCallbacks;
+		};
+
 	public:
+		/** 
+		 * GameObjects deserialized while detached from the manager, waiting to be registered. See 
+		 * startDetachedDeserialization().
+		 */
+		class BS_CORE_EXPORT DetachedObjects
+		{
+		public:
+			/** Returns the number of deserialized objects. */
+			UINT32 getNumObjects() const { return (UINT32)mObjects.size(); }
+
+			/** Returns the number of objects registered through registerDetachedObject() so far. */
+			UINT32 getNumRegistered() const { return mNumRegistered; }
+
+		private:
+			friend class GameObjectManager;
+
+			DeserializationState mState;
+			Vector<GameObjectHandleBase> mObjects;
+			UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mObjectLookup;
+			Vector<ExternalHandle> mExternalHandles;
+			Vector<std::function<void()>> mEndCallbacks;
+			UINT32 mNumRegistered = 0;
+		};
+
 		GameObjectManager();
 		~GameObjectManager();
 
@@ -91,6 +145,37 @@ namespace bs
 		/**	Destroys any GameObjects that were queued for destruction. */
 		void destroyQueuedObjects();
 
+		/**
+		 * Makes any following GameObject deserialization on the calling thread detached from the manager, until
+		 * endDetachedDeserialization() is called. Detached deserialization doesn't access any live objects, and can
+		 * therefore be performed on any thread. Deserialized objects are assigned temporary IDs and stored in the
+		 * provided container, while handles between them are resolved as normal. The objects must be registered on
+		 * the sim thread through registerDetachedObject() before they can be used.
+		 *
+		 * @note	Thread safe.
+		 */
+		void startDetachedDeserialization(DetachedObjects& objects);
+
+		/** Ends detached deserialization started with startDetachedDeserialization(). */
+		void endDetachedDeserialization();
+
+		/**
+		 * Checks if detached deserialization started with startDetachedDeserialization() active on the calling thread.
+		 *
+		 * @note	Thread safe.
+		 */
+		bool isDetachedDeserializationActive() const;
+
+		/**
+		 * Registers the next object deserialized through detached deserialization, assigning it a permanent ID. Once
+		 * all of the objects are registered, resolves handles pointing to objects outside of the deserialized set and
+		 * triggers the delayed deserialization end callbacks.
+		 *
+		 * @param[in]	objects		Objects output by detached deserialization. Deserialization must have ended.
+		 * @return					True if all the objects have been registered.
+		 */
+		bool registerDetachedObject(DetachedObjects& objects);
+
 		/**	Triggered when a game object is being destroyed. */
 		Event<void(const HGameObject&)> onDestroyed;
 
@@ -111,7 +196,7 @@ namespace bs
 		void endDeserialization();
 
 		/**	Returns true if GameObject deserialization is currently in progress. */
-		bool isGameObjectDeserializationActive() const { return mIsDeserializationActive; }
+		bool isGameObjectDeserializationActive() const;
 
 		/**	Queues the specified handle and resolves it when deserialization ends. */
 		void registerUnresolvedHandle(UINT64 originalId, GameObjectHandleBase& object);
@@ -134,20 +219,45 @@ namespace bs
 		void resolveDeserializedHandle(UnresolvedHandle& data, UINT32 flags);
 
 		/**	Gets the currently active flags that control how are game object handles deserialized. */
-		UINT32 getDeserializationFlags() const { return mGODeserializationMode; }
+		UINT32 getDeserializationFlags() const;
 
 	private:
-		UINT64 mNextAvailableID; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
-		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
-
-		GameObject* mActiveDeserializedObject;
-		bool mIsDeserializationActive;
-		Map<UINT64, UINT64> mIdMapping;
-		Map<UINT64, SPtr<GameObjectHandleData>> mUnresolvedHandleData;
-		Vector<UnresolvedHandle> mUnresolvedHandles;
-		Vector<std::function<void()>> mEndCallbacks;
-		UINT32 mGODeserializationMode;
+		/** 
+		 * Initializes a newly registered object, assigning it an instance ID and storing it in a free slot, or in the
+		 * detached object list if detached deserialization is active.
+		 */
+		GameObjectHandleBase addObject(const SPtr<GameObject>& object, SPtr<GameObjectHandleData> handleData);
+
+		/** Creates a handle to a newly registered object, optionally reusing existing handle data. */
+		static GameObjectHandleBase createHandle(const SPtr<GameObject>& object, SPtr<GameObjectHandleData> handleData);
+
+		/** Finds a free slot, or creates a new one, and returns its index. */
+		UINT32 allocateSlot();
+
+		/** Returns the state of the deserialization session active on the calling thread. */
+		DeserializationState& getDeserializationState();
+
+		/** @copydoc getDeserializationState() */
+		const DeserializationState& getDeserializationState() const;
+
+		/** Returns the slot the object with the specified ID is stored in, or null if the ID doesn't refer to a slot. */
+		const ObjectSlot* findSlot(UINT64 id) const;
+
+		/** Returns the handle data of the object with the specified ID, or null if no such object exists. */
+		SPtr<GameObjectHandleData> findObject(UINT64 id) const;
+
+		/** Releases the slot of the object with the specified ID, or its remapped entry. */
+		void removeObject(UINT64 id);
+
+		Vector<ObjectSlot> mSlots;
+		Vector<UINT32> mFreeSlots;
+
+		/** Objects whose instance ID was changed through remapId(), and therefore don't match their slot. */
+		UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mRemappedObjects;
+
+		Vector<GameObjectHandleBase> mQueuedForDestroy;
+
+		DeserializationState mDeserializationState;
 	};
 
 	/** @} */
@@ -5,6 +5,8 @@
 #include "Resources/BsResources.h"
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsPrefabUtility.h"
+#include "Scene/BsPrefabInstantiation.h"
+#include "Scene/BsSceneManager.h"
 #include "BsCoreApplication.h"
 
 namespace bs
@@ -149,17 +151,51 @@ namespace bs
 		return clone;
 	}
 
+	SPtr<PrefabInstantiation> Prefab::instantiateAsync()
+	{
+#if BS_IS_BANSHEE3D
+		if (gCoreApplication().isEditor())
+		{
+			// Update any child prefab instances in case their prefabs changed
+			_updateChildInstances();
+		}
+#endif
+
+		// Same as _clone(), except the hierarchy is serialized on a worker thread, so prepare it here
+		prepareRootForClone();
+
+		SPtr<PrefabInstantiation> instantiation = 
+			PrefabInstantiation::_create(std::static_pointer_cast<Prefab>(getThisPtr()));
+		gSceneManager()._addPrefabInstantiation(instantiation);
+
+		return instantiation;
+	}
+
 	HSceneObject Prefab::_clone()
 	{
 		if (mRoot == nullptr)
 			return HSceneObject();
 
-		mRoot->mPrefabHash = mHash;
-		mRoot->mLinkId = -1;
-
+		prepareRootForClone();
 		return mRoot->clone(false);
 	}
 
+	void Prefab::prepareRootForClone()
+	{
+		if (mRoot == nullptr)
+			return;
+
+		if (mRoot->mPrefabHash != mHash)
+			mRoot->mPrefabHash = mHash;
+
+		if (mRoot->mLinkId != (UINT32)-1)
+			mRoot->mLinkId = -1;
+
+		// Internal hierarchy is never instantiated, so this is normally already set
+		if (!mRoot->hasFlag(SOF_DontInstantiate))
+			mRoot->_setFlags(SOF_DontInstantiate);
+	}
+
 	RTTITypeBase* Prefab::getRTTIStatic()
 	{
 		return PrefabRTTI::instance();
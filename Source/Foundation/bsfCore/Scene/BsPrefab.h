@@ -40,6 +40,17 @@ namespace bs
 		 */
 		HSceneObject instantiate();
 
+		/**
+		 * Starts an incremental instantiation of the prefab. Unlike instantiate(), which creates the entire hierarchy
+		 * immediately, the hierarchy is cloned on a worker thread, and its objects are then registered, instantiated and
+		 * initialized over multiple frames, within a per-frame time budget. Use this to avoid frame spikes when instantiating large
+		 * prefabs during gameplay. The instantiated hierarchy will be parented to world root.
+		 *
+		 * @return	Handle that can be used for tracking the progress of the instantiation, and retrieving the
+		 *			instantiated hierarchy once it completes.
+		 */
+		SPtr<PrefabInstantiation> instantiateAsync();
+
 		/**
 		 * Replaces the contents of this prefab with new contents from the provided object. Object will be automatically
 		 * linked to this prefab, and its previous prefab link (if any) will be broken.
@@ -92,6 +103,12 @@ namespace bs
 		/**	Creates an empty and uninitialized prefab. */
 		static SPtr<Prefab> createEmpty();
 
+		/** 
+		 * Assigns the values that clones of the prefab's root are expected to have, to the root. Only modifies the root
+		 * if the values changed, as asynchronous instantiations might be reading the hierarchy on worker threads.
+		 */
+		void prepareRootForClone();
+
 		HSceneObject mRoot;
 		UINT32 mHash;
 		UUID mUUID;
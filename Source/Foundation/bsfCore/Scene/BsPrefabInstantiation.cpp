@@ -0,0 +1,196 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsPrefabInstantiation.h"
+#include "Scene/BsPrefab.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+
+namespace bs
+{
+	PrefabInstantiation::PrefabInstantiation(const SPtr<Prefab>& prefab)
+		:mPrefab(prefab)
+	{ }
+
+	PrefabInstantiation::~PrefabInstantiation()
+	{
+		// Task references this object, so it must finish before the object goes away
+		if (mCloneTask != nullptr)
+			mCloneTask->wait();
+
+		// Clone that never made it into the scene has no owner, so release it here. Objects that weren't registered yet
+		// are released without affecting the GameObjectManager.
+		if (mRoot != nullptr && !mRoot.isDestroyed() && !mRoot->isInstantiated())
+			mRoot->destroy(true);
+	}
+
+	SPtr<PrefabInstantiation> PrefabInstantiation::_create(const SPtr<Prefab>& prefab)
+	{
+		SPtr<PrefabInstantiation> output = bs_shared_ptr<PrefabInstantiation>(
+			new (bs_alloc<PrefabInstantiation>()) PrefabInstantiation(prefab));
+
+		if (prefab->_getRoot() == nullptr)
+		{
+			output->mState = PrefabInstantiationState::Completed;
+			return output;
+		}
+
+		output->mCloneTask = Task::create("PrefabClone", std::bind(&PrefabInstantiation::createClone, output.get()));
+		TaskScheduler::instance().addTask(output->mCloneTask);
+
+		return output;
+	}
+
+	float PrefabInstantiation::getProgress() const
+	{
+		// Cloning counts as a single step, followed by one registration step per game object, and one instantiation and
+		// one initialization step per scene object
+		const UINT32 numRegisterSteps = mDetachedObjects.getNumObjects();
+		const auto numSteps = (float)(1 + numRegisterSteps + mObjects.size() * 2);
+
+		switch (mState)
+		{
+		case PrefabInstantiationState::Cloning:
+			return 0.0f;
+		case PrefabInstantiationState::Registering:
+			return (1 + mDetachedObjects.getNumRegistered()) / numSteps;
+		case PrefabInstantiationState::Instantiating:
+			return (1 + numRegisterSteps + mNextObject) / numSteps;
+		case PrefabInstantiationState::Initializing:
+			return (1 + numRegisterSteps + mObjects.size() + mNextObject) / numSteps;
+		default:
+			return 1.0f;
+		}
+	}
+
+	HSceneObject PrefabInstantiation::getRoot() const
+	{
+		// Handles to unregistered objects must not escape, as their IDs are temporary
+		if (mState == PrefabInstantiationState::Cloning || mState == PrefabInstantiationState::Registering)
+			return HSceneObject();
+
+		return mRoot;
+	}
+
+	void PrefabInstantiation::complete()
+	{
+		if (isComplete())
+			return;
+
+		if (mCloneTask != nullptr)
+			mCloneTask->wait();
+
+		_update(std::numeric_limits<UINT64>::max());
+	}
+
+	bool PrefabInstantiation::_update(UINT64 budget)
+	{
+		Timer timer;
+		while (true)
+		{
+			switch (mState)
+			{
+			case PrefabInstantiationState::Cloning:
+				if (!mCloneTask->isComplete())
+					return false;
+
+				mCloneTask = nullptr;
+
+				if (mRoot == nullptr)
+					finish();
+				else
+					mState = PrefabInstantiationState::Registering;
+				break;
+			case PrefabInstantiationState::Registering:
+				if (GameObjectManager::instance().registerDetachedObject(mDetachedObjects))
+					mState = PrefabInstantiationState::Instantiating;
+				break;
+			case PrefabInstantiationState::Instantiating:
+			{
+				// Objects are ordered so parents are always instantiated before their children. Components aren't
+				// notified of transform changes while the clone is deserialized, instead adding the root to the scene
+				// notifies components in the entire hierarchy, on the sim thread.
+				const HSceneObject& so = mObjects[mNextObject++];
+				if (!so.isDestroyed())
+					so->_instantiateObject();
+
+				if (mNextObject == (UINT32)mObjects.size())
+				{
+					mState = PrefabInstantiationState::Initializing;
+					mNextObject = 0;
+				}
+			}
+				break;
+			case PrefabInstantiationState::Initializing:
+			{
+				const HSceneObject& so = mObjects[mNextObject++];
+				if (!so.isDestroyed())
+					so->_notifyComponentsCreated();
+
+				if (mNextObject == (UINT32)mObjects.size())
+					finish();
+			}
+				break;
+			default:
+				break;
+			}
+
+			if (isComplete())
+				return true;
+
+			if (timer.getMicroseconds() >= budget)
+				return false;
+		}
+	}
+
+	void PrefabInstantiation::createClone()
+	{
+		MemorySerializer serializer;
+
+		UINT32 bufferSize = 0;
+		UINT8* buffer = serializer.encode(mPrefab->_getRoot().get(), bufferSize, (void*(*)(size_t))&bs_alloc);
+
+		// Objects are registered with the GameObjectManager later, on the sim thread
+		GameObjectManager& gameObjectManager = GameObjectManager::instance();
+		gameObjectManager.startDetachedDeserialization(mDetachedObjects);
+		gameObjectManager.setDeserializationMode(GODM_UseNewIds | GODM_RestoreExternal);
+
+		SPtr<SceneObject> cloneObj = std::static_pointer_cast<SceneObject>(serializer.decode(buffer, bufferSize));
+
+		gameObjectManager.endDetachedDeserialization();
+		bs_free(buffer);
+
+		if (cloneObj == nullptr)
+			return;
+
+		mRoot = cloneObj->getHandle();
+
+		// Depth first, same order as SceneObject::_instantiate()
+		Stack<HSceneObject> todo;
+		todo.push(mRoot);
+
+		while (!todo.empty())
+		{
+			HSceneObject current = todo.top();
+			todo.pop();
+
+			mObjects.push_back(current);
+
+			UINT32 numChildren = current->getNumChildren();
+			for (UINT32 i = numChildren; i > 0; i--)
+				todo.push(current->getChild(i - 1));
+		}
+	}
+
+	void PrefabInstantiation::finish()
+	{
+		mState = PrefabInstantiationState::Completed;
+		mObjects.clear();
+		mNextObject = 0;
+		mPrefab = nullptr;
+
+		onCompleted(mRoot);
+	}
+}
@@ -0,0 +1,110 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Scene/BsGameObject.h"
+#include "Scene/BsGameObjectManager.h"
+
+namespace bs
+{
+	class Task;
+
+	/** @addtogroup Scene
+	 *  @{
+	 */
+
+	/** Stages an incremental prefab instantiation goes through. */
+	enum class PrefabInstantiationState
+	{
+		Cloning, /**< Prefab hierarchy is being serialized and deserialized into a clone on a worker thread. */
+		Registering, /**< Cloned objects are being registered with the GameObjectManager, one by one. */
+		Instantiating, /**< Cloned scene objects are being registered with the scene, one by one. */
+		Initializing, /**< Creation events are being triggered on components of the cloned objects, one object at a time. */
+		Completed /**< All objects are instantiated and initialized. */
+	};
+
+	/**
+	 * Handle to a prefab instantiation started through Prefab::instantiateAsync(). The instantiation is performed in
+	 * steps: the clone of the prefab hierarchy is first created on a worker thread, after which its objects are
+	 * registered, instantiated and initialized on the sim thread, as part of the scene update, within the per-frame
+	 * time budget set by SceneManager::setPrefabInstantiationBudget().
+	 *
+	 * Objects are added to the scene one by one as they are instantiated, so a partially instantiated hierarchy might be
+	 * visible for a few frames. The prefab must not be modified until the instantiation finishes cloning.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT PrefabInstantiation
+	{
+	public:
+		~PrefabInstantiation();
+
+		/** Returns the stage the instantiation is currently in. */
+		PrefabInstantiationState getState() const { return mState; }
+
+		/** Checks has the instantiation finished. */
+		bool isComplete() const { return mState == PrefabInstantiationState::Completed; }
+
+		/** Returns the progress of the instantiation, in range [0, 1]. */
+		float getProgress() const;
+
+		/**
+		 * Returns the root of the instantiated hierarchy. Null until the cloned objects are registered, or if the
+		 * prefab is empty. Once the objects are registered the root can be accessed immediately, but objects in its
+		 * hierarchy might not be instantiated or initialized until the instantiation completes.
+		 */
+		HSceneObject getRoot() const;
+
+		/** Performs all remaining work immediately, blocking until the clone is finished if needed. */
+		void complete();
+
+		/** Triggered when the instantiation completes. Receives the root of the instantiated hierarchy. */
+		Event<void(const HSceneObject&)> onCompleted;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Creates a new instantiation of the provided prefab and starts cloning its hierarchy. The caller is expected to
+		 * register the instantiation with the SceneManager.
+		 */
+		static SPtr<PrefabInstantiation> _create(const SPtr<Prefab>& prefab);
+
+		/**
+		 * Performs instantiation steps until they run out or the time budget expires. At least one step is always
+		 * performed, unless the clone is still in progress on the worker thread. Each step registers, instantiates or
+		 * initializes a single object.
+		 *
+		 * @param[in]	budget		Time, in microseconds, the method is allowed to take.
+		 * @return					True if the instantiation completed.
+		 */
+		bool _update(UINT64 budget);
+
+		/** @} */
+	private:
+		PrefabInstantiation(const SPtr<Prefab>& prefab);
+
+		/** 
+		 * Serializes the prefab hierarchy and deserializes it into a new clone, without registering its objects.
+		 * Collects all scene objects in the clone. Executed on a worker thread.
+		 */
+		void createClone();
+
+		/** Marks the instantiation as completed and triggers the completion event. */
+		void finish();
+
+		SPtr<Prefab> mPrefab;
+		PrefabInstantiationState mState = PrefabInstantiationState::Cloning;
+
+		SPtr<Task> mCloneTask;
+		GameObjectManager::DetachedObjects mDetachedObjects;
+
+		HSceneObject mRoot;
+		Vector<HSceneObject> mObjects;
+		UINT32 mNextObject = 0;
+	};
+
+	/** @} */
+}
@@ -11,6 +11,10 @@
 #include "RenderAPI/BsRenderTarget.h"
 #include "Renderer/BsLightProbeVolume.h"
 #include "Scene/BsSceneActor.h"
+#include "Scene/BsSceneTransformSystem.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Scene/BsPrefabInstantiation.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -31,6 +35,12 @@ namespace bs
 		bool& val;
 	};
 
+	/** Bit set in the update bucket id of components in parallel buckets. */
+	static constexpr UINT32 PARALLEL_BUCKET_BIT = 0x80000000;
+
+	/** Index of the component being updated by the current thread, during a parallel update. */
+	static BS_THREADLOCAL UINT32 sUpdatingComponentIdx = 0;
+
 	SceneManager::SceneManager()
 	{
 		mRootNode = SceneObject::createInternal("SceneRoot");
@@ -38,8 +48,14 @@ namespace bs
 
 	SceneManager::~SceneManager()
 	{
+		// Releases any clones that haven't been added to the scene yet
+		mPrefabInstantiations.clear();
+
 		if (mRootNode != nullptr && !mRootNode.isDestroyed())
 			mRootNode->destroy(true);
+
+		if (mTransformSystem != nullptr)
+			bs_delete(mTransformSystem);
 	}
 
 	void SceneManager::clearScene(bool forceAll)
@@ -97,12 +113,51 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
+		_unbindActor(actor);
+
 		mBoundActors[actor.get()] = BoundActorData(actor, so);
+		mActorsPerSO.insert(std::make_pair(so.get(), actor.get()));
+		so->mNumBoundActors++;
+
+		// Make sure the actor receives the current state of the object
+		queueActorSync(*so);
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		auto iterFind = mBoundActors.find(actor.get());
+		if (iterFind == mBoundActors.end())
+			return;
+
+		const HSceneObject& so = iterFind->second.so;
+		if (!so.isDestroyed())
+		{
+			so->mNumBoundActors--;
+
+			auto range = mActorsPerSO.equal_range(so.get());
+			for (auto iter = range.first; iter != range.second; ++iter)
+			{
+				if (iter->second == actor.get())
+				{
+					mActorsPerSO.erase(iter);
+					break;
+				}
+			}
+		}
+		else
+		{
+			// Object is gone so it cannot be looked up, find the actor directly
+			for (auto iter = mActorsPerSO.begin(); iter != mActorsPerSO.end(); ++iter)
+			{
+				if (iter->second == actor.get())
+				{
+					mActorsPerSO.erase(iter);
+					break;
+				}
+			}
+		}
+
+		mBoundActors.erase(iterFind);
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
@@ -159,10 +214,53 @@ namespace bs
 		}
 	}
 
+	void SceneManager::setTransformSystemEnabled(bool enabled)
+	{
+		if (enabled == isTransformSystemEnabled())
+			return;
+
+		if (enabled)
+		{
+			mTransformSystem = bs_new<SceneTransformSystem>();
+
+			if (mRootNode != nullptr && !mRootNode.isDestroyed())
+				registerTransformHierarchy(*mRootNode);
+		}
+		else
+		{
+			bs_delete(mTransformSystem);
+			mTransformSystem = nullptr;
+		}
+	}
+
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+		if (mTransformSystem != nullptr)
+			mTransformSystem->update();
+
+		for (auto& entry : mActorSyncQueue)
+		{
+			if (entry.isDestroyed())
+				continue;
+
+			SceneObject* so = entry.get();
+			so->mActorSyncQueued = false;
+
+			auto range = mActorsPerSO.equal_range(so);
+			for (auto iter = range.first; iter != range.second; ++iter)
+				iter->second->_updateState(*so);
+		}
+
+		mActorSyncQueue.clear();
+	}
+
+	void SceneManager::queueActorSync(const SceneObject& so)
+	{
+		if (so.mActorSyncQueued)
+			return;
+
+		so.mActorSyncQueued = true;
+		mActorSyncQueue.push_back(so.mThisHandle);
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -411,6 +509,9 @@ namespace bs
 		list.push_back(component);
 
 		component->setSceneManagerId(encodeComponentId(idx, listType));
+
+		if(listType == ActiveList)
+			addToUpdateBucket(component);
 	}
 
 	void SceneManager::removeFromStateList(const HComponent& component)
@@ -429,6 +530,9 @@ namespace bs
 
 		assert(list[idx] == component);
 
+		if(listType == ActiveList)
+			removeFromUpdateBucket(component);
+
 		if (idx != lastIdx)
 		{
 			std::swap(list[idx], list[lastIdx]);
@@ -485,8 +589,163 @@ namespace bs
 		}
 
 		mStateChanges.clear();
+
+		if (mUpdateBucketsDirty)
+			sortUpdateBuckets();
+	}
+
+	void SceneManager::addToUpdateBucket(const HComponent& component)
+	{
+		const UINT32 rttiId = component->getRTTI()->getRTTIId();
+		const bool parallel = component->hasFlag(ComponentFlag::ThreadSafeUpdate);
+		const UINT64 key = getUpdateBucketKey(rttiId, parallel);
+
+		auto iterFind = mUpdateBucketLookup.find(key);
+		if(iterFind == mUpdateBucketLookup.end())
+		{
+			ComponentUpdateBucket bucket;
+			bucket.rttiId = rttiId;
+			bucket.parallel = parallel;
+			bucket.order = getComponentUpdateOrder(rttiId);
+
+			// Note: Sorting is delayed until the end of processStateChanges(), as buckets are often added in bulk
+			mUpdateBuckets.push_back(bucket);
+			mUpdateBucketsDirty = true;
+
+			iterFind = mUpdateBucketLookup.insert(std::make_pair(key, (UINT32)mUpdateBuckets.size() - 1)).first;
+		}
+
+		Vector<HComponent>& components = mUpdateBuckets[iterFind->second].components;
+
+		const auto idx = (UINT32)components.size();
+		components.push_back(component);
+
+		component->setUpdateBucketId(parallel ? (idx | PARALLEL_BUCKET_BIT) : idx);
+	}
+
+	void SceneManager::removeFromUpdateBucket(const HComponent& component)
+	{
+		const UINT32 bucketId = component->getUpdateBucketId();
+		const UINT32 idx = bucketId & ~PARALLEL_BUCKET_BIT;
+		const bool parallel = (bucketId & PARALLEL_BUCKET_BIT) != 0;
+
+		const UINT64 key = getUpdateBucketKey(component->getRTTI()->getRTTIId(), parallel);
+		Vector<HComponent>& components = mUpdateBuckets[mUpdateBucketLookup[key]].components;
+
+		assert(components[idx] == component);
+
+		const auto lastIdx = (UINT32)components.size() - 1;
+		if (idx != lastIdx)
+		{
+			std::swap(components[idx], components[lastIdx]);
+			components[idx]->setUpdateBucketId(parallel ? (idx | PARALLEL_BUCKET_BIT) : idx);
+		}
+
+		components.erase(components.end() - 1);
 	}
 
+	void SceneManager::sortUpdateBuckets()
+	{
+		std::sort(mUpdateBuckets.begin(), mUpdateBuckets.end(), 
+			[](const ComponentUpdateBucket& a, const ComponentUpdateBucket& b)
+		{
+			if (a.order != b.order)
+				return a.order < b.order;
+
+			if (a.rttiId != b.rttiId)
+				return a.rttiId < b.rttiId;
+
+			return a.parallel < b.parallel;
+		});
+
+		mUpdateBucketLookup.clear();
+		for (UINT32 i = 0; i < (UINT32)mUpdateBuckets.size(); i++)
+		{
+			const ComponentUpdateBucket& bucket = mUpdateBuckets[i];
+			mUpdateBucketLookup[getUpdateBucketKey(bucket.rttiId, bucket.parallel)] = i;
+		}
+
+		mUpdateBucketsDirty = false;
+	}
+
+	void SceneManager::setComponentUpdateOrder(UINT32 rttiId, INT32 order)
+	{
+		mComponentUpdateOrder[rttiId] = order;
+
+		// Note: This can be called from component callbacks while the buckets are being iterated over, so the buckets
+		// are re-sorted on the next call to processStateChanges() instead of right away
+		for (auto& entry : mUpdateBuckets)
+		{
+			if (entry.rttiId == rttiId)
+			{
+				entry.order = order;
+				mUpdateBucketsDirty = true;
+			}
+		}
+	}
+
+	INT32 SceneManager::getComponentUpdateOrder(UINT32 rttiId) const
+	{
+		auto iterFind = mComponentUpdateOrder.find(rttiId);
+		if (iterFind != mComponentUpdateOrder.end())
+			return iterFind->second;
+
+		return 0;
+	}
+
+	void SceneManager::deferUntilSync(std::function<void()> callback)
+	{
+		if (!mIsUpdatingInParallel)
+		{
+			callback();
+			return;
+		}
+
+		Lock lock(mDeferredChangesMutex);
+		mDeferredChanges.push_back({ sUpdatingComponentIdx, std::move(callback) });
+	}
+
+	void SceneManager::updateComponents(void (Component::*method)())
+	{
+		// Note: Buckets are only added or re-sorted by processStateChanges(), which cannot trigger during the update.
+		// Components can still be removed from a bucket if destroyed immediately, so use indices.
+		for (UINT32 i = 0; i < (UINT32)mUpdateBuckets.size(); i++)
+		{
+			if (!mUpdateBuckets[i].parallel)
+			{
+				for (UINT32 j = 0; j < (UINT32)mUpdateBuckets[i].components.size(); j++)
+					(mUpdateBuckets[i].components[j].get()->*method)();
+
+				continue;
+			}
+
+			// Bucket is not modified until the deferred changes are applied below, so it can be iterated over in place
+			const Vector<HComponent>& components = mUpdateBuckets[i].components;
+
+			mIsUpdatingInParallel = true;
+			TaskScheduler::instance().parallelFor(0, (UINT32)components.size(), 0, [&components, method](UINT32 idx)
+			{
+				sUpdatingComponentIdx = idx;
+				(components[idx].get()->*method)();
+			});
+			mIsUpdatingInParallel = false;
+
+			// Sync point: apply structural changes in the same order the components would have made them serially
+			std::stable_sort(mDeferredChanges.begin(), mDeferredChanges.end(), 
+				[](const DeferredChange& a, const DeferredChange& b) { return a.componentIdx < b.componentIdx; });
+
+			Vector<DeferredChange> deferredChanges;
+			std::swap(deferredChanges, mDeferredChanges);
+
+			for (auto& entry : deferredChanges)
+				entry.callback();
+		}
+	}
+
+	UINT64 SceneManager::getUpdateBucketKey(UINT32 rttiId, bool parallel)
+	{
+		return ((UINT64)rttiId << 1) | (parallel ? 1 : 0);
+	}
 
 	UINT32 SceneManager::encodeComponentId(UINT32 idx, UINT32 type)
 	{
@@ -508,14 +767,11 @@ namespace bs
 
 	void SceneManager::_update()
 	{
+		updatePrefabInstantiations();
 		processStateChanges();
 
-		// Note: Eventually perform updates based on component types and/or on component priority. Right now we just
-		// iterate in an undefined order, but it wouldn't be hard to change it.
-
 		ScopeToggle toggle(mDisableStateChange);
-		for (auto& entry : mActiveComponents)
-			entry->update();
+		updateComponents(&Component::update);
 
 		GameObjectManager::instance().destroyQueuedObjects();
 	}
@@ -525,14 +781,60 @@ namespace bs
 		processStateChanges();
 
 		ScopeToggle toggle(mDisableStateChange);
-		for (auto& entry : mActiveComponents)
-			entry->fixedUpdate();
+		updateComponents(&Component::fixedUpdate);
+	}
+
+	void SceneManager::_addPrefabInstantiation(const SPtr<PrefabInstantiation>& instantiation)
+	{
+		if (!instantiation->isComplete())
+			mPrefabInstantiations.push_back(instantiation);
+	}
+
+	void SceneManager::updatePrefabInstantiations()
+	{
+		if (mPrefabInstantiations.empty())
+			return;
+
+		// Note: Instantiation callbacks might start new instantiations, so use indices
+		Timer timer;
+		for (UINT32 i = 0; i < (UINT32)mPrefabInstantiations.size(); i++)
+		{
+			const UINT64 elapsed = timer.getMicroseconds();
+			if (i > 0 && elapsed >= mPrefabInstantiationBudget)
+				break;
+
+			const UINT64 remaining = elapsed < mPrefabInstantiationBudget ? mPrefabInstantiationBudget - elapsed : 0;
+
+			SPtr<PrefabInstantiation> instantiation = mPrefabInstantiations[i];
+			instantiation->_update(remaining);
+		}
+
+		// Instantiations can also be completed externally, through PrefabInstantiation::complete()
+		mPrefabInstantiations.erase(std::remove_if(mPrefabInstantiations.begin(), mPrefabInstantiations.end(),
+			[](const SPtr<PrefabInstantiation>& x) { return x->isComplete(); }), mPrefabInstantiations.end());
 	}
 
 	void SceneManager::registerNewSO(const HSceneObject& node)
 	{ 
 		if(mRootNode)
 			node->setParent(mRootNode);
+
+		registerTransform(*node);
+	}
+
+	void SceneManager::registerTransform(SceneObject& so)
+	{
+		if (mTransformSystem != nullptr)
+			mTransformSystem->registerObject(so);
+	}
+
+	void SceneManager::registerTransformHierarchy(SceneObject& so)
+	{
+		if (!mTransformSystem->registerObject(so))
+			return;
+
+		for (auto& child : so.mChildren)
+			registerTransformHierarchy(*child);
 	}
 
 	void SceneManager::onMainRenderTargetResized()
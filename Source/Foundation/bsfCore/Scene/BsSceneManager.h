@@ -93,9 +93,60 @@ namespace bs
 		 */
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
+		/**
+		 * Enables or disables the batched transform system. When enabled, transforms of all scene objects are mirrored
+		 * in contiguous arrays, and the world transforms of modified objects are recomputed once per frame in parallel,
+		 * instead of being computed on demand by walking up the hierarchy. Results returned by SceneObject are the same
+		 * either way. Useful for scenes with a large number of moving objects. Disabled by default.
+		 */
+		void setTransformSystemEnabled(bool enabled);
+
+		/** Checks is the batched transform system enabled. See setTransformSystemEnabled(). */
+		bool isTransformSystemEnabled() const { return mTransformSystem != nullptr; }
+
+		/**
+		 * Changes the order in which components of a certain type are updated, relative to components of other types.
+		 * Active components are grouped by type, and components with a lower order are updated before components with a
+		 * higher order. Types with the same order are updated in the order of their RTTI identifiers. Order of components
+		 * of the same type is undefined. All types have an order of zero by default. The new order is applied starting
+		 * with the next update.
+		 *
+		 * @param[in]	rttiId	RTTI identifier of the component type.
+		 * @param[in]	order	Order of the component type. 
+		 */
+		void setComponentUpdateOrder(UINT32 rttiId, INT32 order);
+
+		/** @copydoc setComponentUpdateOrder(UINT32, INT32) */
+		template<class T>
+		void setComponentUpdateOrder(INT32 order) { setComponentUpdateOrder(T::getRTTIStatic()->getRTTIId(), order); }
+
+		/** Returns the update order of a component type. See setComponentUpdateOrder(). */
+		INT32 getComponentUpdateOrder(UINT32 rttiId) const;
+
+		/**
+		 * Queues a callback to be executed once all components of the type currently being updated in parallel finish
+		 * updating. Components with the ComponentFlag::ThreadSafeUpdate flag must use this for any changes to the scene
+		 * structure made during their update. Callbacks are executed on the sim thread, in the same order as if the
+		 * components were updated serially. If called outside of a parallel update the callback is executed
+		 * immediately.
+		 *
+		 * @note	Thread safe.
+		 */
+		void deferUntilSync(std::function<void()> callback);
+
+		/**
+		 * Sets the maximum time, in microseconds, to spend each frame on instantiating prefabs started through
+		 * Prefab::instantiateAsync(). At least one step of the oldest pending instantiation is performed every frame,
+		 * regardless of the budget.
+		 */
+		void setPrefabInstantiationBudget(UINT32 microseconds) { mPrefabInstantiationBudget = microseconds; }
+
+		/** Returns the time budget set by setPrefabInstantiationBudget(). */
+		UINT32 getPrefabInstantiationBudget() const { return mPrefabInstantiationBudget; }
+
 		/** 
-		 * Binds a scene actor with a scene object. Every frame the scene object's transform will be monitored for
-		 * changes and those changes will be automatically transfered to the actor. 
+		 * Binds a scene actor with a scene object. Any changes to the scene object's transform, active state or mobility
+		 * will be automatically transfered to the actor on the next frame.
 		 */
 		void _bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so);
 
@@ -105,6 +156,12 @@ namespace bs
 		/** Returns a scene object bound to the provided actor, if any. */
 		HSceneObject _getActorSO(const SPtr<SceneActor>& actor) const;
 
+		/** Returns the batched transform system, or null if not enabled. */
+		SceneTransformSystem* _getTransformSystem() const { return mTransformSystem; }
+
+		/** Registers an incremental prefab instantiation, to be performed during the following scene updates. */
+		void _addPrefabInstantiation(const SPtr<PrefabInstantiation>& instantiation);
+
 		/**	Notifies the scene manager that a new camera was created. */
 		void _registerCamera(const SPtr<Camera>& camera);
 
@@ -120,7 +177,11 @@ namespace bs
 		/** Called at fixed time internals. Calls the fixed update method on all active components. */
 		void _fixedUpdate();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. If enabled, the batched
+		 * transform system is updated first. Only actors bound to scene objects that changed since the last call are
+		 * updated.
+		 */
 		void _updateCoreObjectTransforms();
 
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
@@ -148,6 +209,22 @@ namespace bs
 			Created, Activated, Deactivated, Destroyed
 		};
 
+		/** Active components of a single type, updated as a group. */
+		struct ComponentUpdateBucket
+		{
+			UINT32 rttiId;
+			bool parallel;
+			INT32 order;
+			Vector<HComponent> components;
+		};
+
+		/** Callback queued by deferUntilSync() during a parallel update. */
+		struct DeferredChange
+		{
+			UINT32 componentIdx;
+			std::function<void()> callback;
+		};
+
 		/** Describes a single component state change. */
 		struct ComponentStateChange
 		{
@@ -174,6 +251,19 @@ namespace bs
 		 */
 		void registerNewSO(const HSceneObject& node);
 
+		/** Registers a newly instantiated scene object with the batched transform system, if the system is enabled. */
+		void registerTransform(SceneObject& so);
+
+		/** Registers the provided scene object and all of its descendants with the batched transform system. */
+		void registerTransformHierarchy(SceneObject& so);
+
+		/**
+		 * Queues the actors bound to the provided scene object to be synced with the object's state on the next call
+		 * to _updateCoreObjectTransforms(). Called by the scene object whenever its transform, active state or mobility
+		 * changes.
+		 */
+		void queueActorSync(const SceneObject& so);
+
 		/**	Callback that is triggered when the main render target size is changed. */
 		void onMainRenderTargetResized();
 
@@ -189,6 +279,24 @@ namespace bs
 		/** Iterates over components that had their state modified and moves them to the appropriate state lists. */
 		void processStateChanges();
 
+		/** Adds an active component to the update bucket for its type, creating the bucket if needed. */
+		void addToUpdateBucket(const HComponent& component);
+
+		/** Removes a component from its update bucket. */
+		void removeFromUpdateBucket(const HComponent& component);
+
+		/** Sorts the update buckets by their order and type, and rebuilds the bucket lookup. */
+		void sortUpdateBuckets();
+
+		/** Calls the provided method on all active components, bucket by bucket. */
+		void updateComponents(void (Component::*method)());
+
+		/** Performs pending prefab instantiation steps, within the per-frame time budget. */
+		void updatePrefabInstantiations();
+
+		/** Returns the key identifying an update bucket in mUpdateBucketLookup. */
+		static UINT64 getUpdateBucketKey(UINT32 rttiId, bool parallel);
+
 		/** 
 		 * Encodes an index and a type into a single 32-bit integer. Top 2 bits represent the type, while the rest represent
 		 * the index.
@@ -205,6 +313,8 @@ namespace bs
 		HSceneObject mRootNode;
 
 		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		UnorderedMultimap<SceneObject*, SceneActor*> mActorsPerSO;
+		Vector<HSceneObject> mActorSyncQueue;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
@@ -218,9 +328,23 @@ namespace bs
 		SPtr<RenderTarget> mMainRT;
 		HEvent mMainRTResizedConn;
 
+		SceneTransformSystem* mTransformSystem = nullptr;
+
 		ComponentState mComponentState = ComponentState::Running;
 		bool mDisableStateChange = false;
 		Vector<ComponentStateChange> mStateChanges;
+
+		Vector<ComponentUpdateBucket> mUpdateBuckets;
+		UnorderedMap<UINT64, UINT32> mUpdateBucketLookup;
+		UnorderedMap<UINT32, INT32> mComponentUpdateOrder;
+		bool mUpdateBucketsDirty = false;
+
+		Vector<SPtr<PrefabInstantiation>> mPrefabInstantiations;
+		UINT32 mPrefabInstantiationBudget = 2000;
+
+		bool mIsUpdatingInParallel = false;
+		Vector<DeferredChange> mDeferredChanges;
+		Mutex mDeferredChangesMutex;
 	};
 
 	/**	Provides easy access to the SceneManager. */
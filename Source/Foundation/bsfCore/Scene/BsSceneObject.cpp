@@ -3,6 +3,7 @@
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsComponent.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneTransformSystem.h"
 #include "Error/BsException.h"
 #include "Debug/BsDebug.h"
 #include "Private/RTTI/BsSceneObjectRTTI.h"
@@ -16,8 +17,9 @@ namespace bs
 {
 	SceneObject::SceneObject(const String& name, UINT32 flags)
 		: GameObject(), mPrefabHash(0), mFlags(flags), mCachedLocalTfrm(Matrix4::IDENTITY)
-		, mCachedWorldTfrm(Matrix4::IDENTITY), mDirtyFlags(0xFFFFFFFF), mDirtyHash(0), mActiveSelf(true)
-		, mActiveHierarchy(true), mMobility(ObjectMobility::Movable)
+		, mCachedWorldTfrm(Matrix4::IDENTITY), mDirtyFlags(0xFFFFFFFF), mDirtyHash(0)
+		, mTransformSlot(SceneTransformSystem::INVALID_SLOT), mActiveSelf(true)
+		, mActiveHierarchy(true), mMobility(ObjectMobility::Movable), mNumBoundActors(0), mActorSyncQueued(false)
 	{
 		setName(name);
 	}
@@ -66,6 +68,9 @@ namespace bs
 	{
 		// Parent is our owner, so when his reference to us is removed, delete might be called.
 		// So make sure this is the last thing we do.
+		if (mTransformSlot != SceneTransformSystem::INVALID_SLOT)
+			gSceneManager()._getTransformSystem()->unregisterObject(*this);
+
 		if(mParent != nullptr)
 		{
 			if(!mParent.isDestroyed())
@@ -81,6 +86,9 @@ namespace bs
 	{
 		if (immediate)
 		{
+			if (mTransformSlot != SceneTransformSystem::INVALID_SLOT)
+				gSceneManager()._getTransformSystem()->unregisterObject(*this);
+
 			for (auto iter = mChildren.begin(); iter != mChildren.end(); ++iter)
 				(*iter)->destroyInternal(*iter, true);
 
@@ -199,13 +207,7 @@ namespace bs
 	{
 		std::function<void(SceneObject*)> instantiateRecursive = [&](SceneObject* obj)
 		{
-			obj->mFlags &= ~SOF_DontInstantiate;
-
-			if (obj->mParent == nullptr)
-				gSceneManager().registerNewSO(obj->mThisHandle);
-
-			for (auto& component : obj->mComponents)
-				component->_instantiate();
+			obj->_instantiateObject();
 
 			for (auto& child : obj->mChildren)
 			{
@@ -216,8 +218,7 @@ namespace bs
 
 		std::function<void(SceneObject*)> triggerEventsRecursive = [&](SceneObject* obj)
 		{
-			for (auto& component : obj->mComponents)
-				gSceneManager()._notifyComponentCreated(component, obj->getActive());
+			obj->_notifyComponentsCreated();
 
 			for (auto& child : obj->mChildren)
 			{
@@ -230,6 +231,25 @@ namespace bs
 		triggerEventsRecursive(this);
 	}
 
+	void SceneObject::_instantiateObject()
+	{
+		mFlags &= ~SOF_DontInstantiate;
+
+		if (mParent == nullptr)
+			gSceneManager().registerNewSO(mThisHandle);
+		else
+			gSceneManager().registerTransform(*this);
+
+		for (auto& component : mComponents)
+			component->_instantiate();
+	}
+
+	void SceneObject::_notifyComponentsCreated()
+	{
+		for (auto& component : mComponents)
+			gSceneManager()._notifyComponentCreated(component, getActive());
+	}
+
 	/************************************************************************/
 	/* 								Transform	                     		*/
 	/************************************************************************/
@@ -427,6 +447,11 @@ namespace bs
 
 	void SceneObject::notifyTransformChanged(TransformChangedFlags flags) const
 	{
+		// Objects deserialized detached from the GameObjectManager aren't part of the scene yet, and might be on a
+		// worker thread. Only mark their transforms dirty, components are notified once the objects are added to the
+		// scene.
+		const bool detached = GameObjectManager::instance().isDetachedDeserializationActive();
+
 		// If object is immovable, don't send transform changed events nor mark the transform dirty
 		TransformChangedFlags componentFlags = flags;
 		if (mMobility != ObjectMobility::Movable)
@@ -435,10 +460,19 @@ namespace bs
 		{
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
+
+			if (!detached)
+			{
+				if (mTransformSlot != SceneTransformSystem::INVALID_SLOT)
+					gSceneManager()._getTransformSystem()->notifyTransformChanged(*this);
+
+				if (mNumBoundActors > 0)
+					gSceneManager().queueActorSync(*this);
+			}
 		}
 
 		// Only send component flags if we haven't removed them all
-		if (componentFlags != 0)
+		if (componentFlags != 0 && !detached)
 		{
 			for (auto& entry : mComponents)
 			{
@@ -534,6 +568,9 @@ namespace bs
 
 			mParent = parent;
 
+			if (mTransformSlot != SceneTransformSystem::INVALID_SLOT)
+				gSceneManager()._getTransformSystem()->notifyParentChanged(*this);
+
 			if (keepWorldTransform)
 			{
 				mLocalTfrm = worldTfrm;
@@ -682,6 +719,9 @@ namespace bs
 		{
 			mActiveHierarchy = activeHierarchy;
 
+			if (mNumBoundActors > 0)
+				gSceneManager().queueActorSync(*this);
+
 			if (triggerEvents)
 			{
 				if (activeHierarchy)
@@ -717,6 +757,9 @@ namespace bs
 		{
 			mMobility = mobility;
 
+			if (mNumBoundActors > 0)
+				gSceneManager().queueActorSync(*this);
+
 			// If mobility changed to movable, update both the mobility flag and transform, otherwise just mobility
 			if (mMobility == ObjectMobility::Movable)
 				notifyTransformChanged((TransformChangedFlags)(TCF_Transform | TCF_Mobility));
@@ -729,8 +772,13 @@ namespace bs
 	{
 		bool isInstantiated = !hasFlag(SOF_DontInstantiate);
 
+		// Note: Flags are only modified if they need to change, as prefab hierarchies might be getting serialized by
+		// asynchronous instantiations on worker threads
 		if (!instantiate)
-			_setFlags(SOF_DontInstantiate);
+		{
+			if (isInstantiated)
+				_setFlags(SOF_DontInstantiate);
+		}
 		else
 			_unsetFlags(SOF_DontInstantiate);
 
@@ -745,7 +793,7 @@ namespace bs
 
 		if(isInstantiated)
 			_unsetFlags(SOF_DontInstantiate);
-		else
+		else if(instantiate)
 			_setFlags(SOF_DontInstantiate);
 
 		return cloneObj->mThisHandle;
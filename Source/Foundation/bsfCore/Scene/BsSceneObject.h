@@ -51,6 +51,8 @@ namespace bs
 		friend class Prefab;
 		friend class PrefabDiff;
 		friend class PrefabUtility;
+		friend class PrefabInstantiation;
+		friend class SceneTransformSystem;
 	public:
 		~SceneObject();
 
@@ -112,6 +114,20 @@ namespace bs
 		 */
 		void _instantiate(bool prefabOnly = false);
 
+		/**
+		 * Performs the first half of _instantiate() for this object only, without its children. Registers the object with
+		 * the scene and instantiates its components, but doesn't trigger any component events. Parent of the object
+		 * must be instantiated first.
+		 */
+		void _instantiateObject();
+
+		/**
+		 * Performs the second half of _instantiate() for this object only, without its children. Triggers the creation
+		 * events on all of its components. All objects in the hierarchy being instantiated should have had 
+		 * _instantiateObject() called on them first.
+		 */
+		void _notifyComponentsCreated();
+
 		/**
 		 * Clears the internally stored prefab diff. If this object is updated from prefab its instance specific changes 
 		 * will be lost.
@@ -313,6 +329,9 @@ namespace bs
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
 
+		/** Index of the object in the SceneTransformSystem, if the system is enabled and the object registered. */
+		UINT32 mTransformSlot;
+
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
 		 * 
@@ -446,6 +465,12 @@ namespace bs
 		bool mActiveHierarchy;
 		ObjectMobility mMobility;
 
+		/** Number of scene actors bound to this object through SceneManager::_bindActor(). */
+		UINT32 mNumBoundActors;
+
+		/** True if the object is queued for its bound actors to be synced with its state on the next frame. */
+		mutable bool mActorSyncQueued;
+
 		/**
 		 * Internal version of setParent() that allows you to set a null parent.
 		 *
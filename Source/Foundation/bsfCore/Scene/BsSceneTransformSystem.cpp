@@ -0,0 +1,276 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsSceneTransformSystem.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Number of objects on the same hierarchy level updated by a single task. Smaller levels are updated serially. */
+	static constexpr UINT32 OBJECTS_PER_TASK = 256;
+
+	SceneTransformSystem::~SceneTransformSystem()
+	{
+		for (auto& entry : mObjects)
+		{
+			if (entry != nullptr)
+				entry->mTransformSlot = INVALID_SLOT;
+		}
+	}
+
+	bool SceneTransformSystem::registerObject(SceneObject& so)
+	{
+		if (so.mTransformSlot != INVALID_SLOT)
+			return true;
+
+		if (!so.isInstantiated())
+			return false;
+
+		UINT32 parentSlot = INVALID_SLOT;
+		UINT32 depth = 0;
+		if (so.mParent != nullptr && !so.mParent.isDestroyed())
+		{
+			if (!registerObject(*so.mParent))
+				return false;
+
+			parentSlot = so.mParent->mTransformSlot;
+			depth = mDepths[parentSlot] + 1;
+		}
+
+		const UINT32 slot = (UINT32)mObjects.size();
+		so.mTransformSlot = slot;
+
+		mLocalTfrms.push_back(so.mLocalTfrm);
+		mWorldTfrms.push_back(so.mWorldTfrm);
+		mParents.push_back(parentSlot);
+		mDepths.push_back(depth);
+		mObjects.push_back(&so);
+		mIsDirty.push_back(false);
+
+		// Objects whose world transform was never computed are updated on the next update()
+		if (!so.isCachedWorldTfrmUpToDate())
+		{
+			mIsDirty[slot] = true;
+			mDirtySlots.push_back(slot);
+		}
+
+		// Appending keeps the arrays sorted as long as the object is no shallower than the last one
+		if (!mLayoutDirty)
+		{
+			if (depth + 1 < (UINT32)mLevelEnds.size())
+				mLayoutDirty = true;
+			else
+			{
+				if (depth == (UINT32)mLevelEnds.size())
+					mLevelEnds.push_back(slot);
+
+				mLevelEnds[depth] = slot + 1;
+			}
+		}
+
+		return true;
+	}
+
+	void SceneTransformSystem::unregisterObject(SceneObject& so)
+	{
+		const UINT32 slot = so.mTransformSlot;
+		if (slot == INVALID_SLOT)
+			return;
+
+		for (auto& child : so.mChildren)
+		{
+			if (!child.isDestroyed())
+				unregisterObject(*child);
+		}
+
+		so.mTransformSlot = INVALID_SLOT;
+		mObjects[slot] = nullptr;
+		mIsDirty[slot] = false;
+		mNumFreeSlots++;
+
+		// Free slots are skipped during update, only compact once they make up a significant portion of the arrays
+		if (mNumFreeSlots * 2 > (UINT32)mObjects.size())
+			mLayoutDirty = true;
+	}
+
+	void SceneTransformSystem::notifyTransformChanged(const SceneObject& so)
+	{
+		const UINT32 slot = so.mTransformSlot;
+		mLocalTfrms[slot] = so.mLocalTfrm;
+
+		if (!mIsDirty[slot])
+		{
+			mIsDirty[slot] = true;
+			mDirtySlots.push_back(slot);
+		}
+	}
+
+	void SceneTransformSystem::notifyParentChanged(SceneObject& so)
+	{
+		const UINT32 slot = so.mTransformSlot;
+
+		UINT32 parentSlot = INVALID_SLOT;
+		if (so.mParent != nullptr)
+		{
+			if (!registerObject(*so.mParent))
+			{
+				unregisterObject(so);
+				return;
+			}
+
+			parentSlot = so.mParent->mTransformSlot;
+		}
+
+		mParents[slot] = parentSlot;
+
+		const UINT32 depth = parentSlot != INVALID_SLOT ? mDepths[parentSlot] + 1 : 0;
+		if (mDepths[slot] != depth)
+		{
+			setDepth(so, depth);
+			mLayoutDirty = true;
+		}
+	}
+
+	void SceneTransformSystem::setDepth(SceneObject& so, UINT32 depth)
+	{
+		mDepths[so.mTransformSlot] = depth;
+
+		for (auto& child : so.mChildren)
+		{
+			if (child->mTransformSlot != INVALID_SLOT)
+				setDepth(*child, depth + 1);
+		}
+	}
+
+	void SceneTransformSystem::update()
+	{
+		if (mLayoutDirty)
+			rebuildLayout();
+
+		if (mDirtySlots.empty())
+			return;
+
+		// Since slots are sorted by depth, sorting the dirty slots groups them per hierarchy level, with parents always
+		// on earlier levels than their children
+		std::sort(mDirtySlots.begin(), mDirtySlots.end());
+
+		UINT32 levelStart = 0;
+		for (auto& levelEnd : mLevelEnds)
+		{
+			auto iterEnd = std::lower_bound(mDirtySlots.begin() + levelStart, mDirtySlots.end(), levelEnd);
+			const UINT32 dirtyEnd = (UINT32)(iterEnd - mDirtySlots.begin());
+
+			TaskScheduler::instance().parallelFor(levelStart, dirtyEnd, OBJECTS_PER_TASK, [this](UINT32 idx)
+			{
+				updateWorldTransform(mDirtySlots[idx]);
+			});
+
+			levelStart = dirtyEnd;
+			if (levelStart == (UINT32)mDirtySlots.size())
+				break;
+		}
+
+		mDirtySlots.clear();
+	}
+
+	void SceneTransformSystem::updateWorldTransform(UINT32 slot)
+	{
+		SceneObject* so = mObjects[slot];
+		if (so == nullptr)
+			return;
+
+		Transform& worldTfrm = mWorldTfrms[slot];
+		worldTfrm = mLocalTfrms[slot];
+
+		// Same as SceneObject::updateWorldTfrm(), parent transform is ignored when not movable
+		const UINT32 parentSlot = mParents[slot];
+		if (parentSlot != INVALID_SLOT && so->mMobility == ObjectMobility::Movable)
+			worldTfrm.makeWorld(mWorldTfrms[parentSlot]);
+
+		so->mWorldTfrm = worldTfrm;
+		so->mCachedWorldTfrm = worldTfrm.getMatrix();
+		so->mDirtyFlags &= ~SceneObject::DirtyFlags::WorldTfrmDirty;
+
+		mIsDirty[slot] = false;
+	}
+
+	void SceneTransformSystem::rebuildLayout()
+	{
+		const UINT32 numSlots = (UINT32)mObjects.size();
+
+		// Counting sort by depth, keeping the existing order of objects within a level
+		Vector<UINT32> levelStarts;
+		for (UINT32 i = 0; i < numSlots; i++)
+		{
+			if (mObjects[i] == nullptr)
+				continue;
+
+			const UINT32 depth = mDepths[i];
+			if (depth >= (UINT32)levelStarts.size())
+				levelStarts.resize(depth + 1, 0);
+
+			levelStarts[depth]++;
+		}
+
+		mLevelEnds.resize(levelStarts.size());
+
+		UINT32 numLive = 0;
+		for (UINT32 i = 0; i < (UINT32)levelStarts.size(); i++)
+		{
+			const UINT32 count = levelStarts[i];
+			levelStarts[i] = numLive;
+
+			numLive += count;
+			mLevelEnds[i] = numLive;
+		}
+
+		Vector<UINT32> remap(numSlots, INVALID_SLOT);
+		for (UINT32 i = 0; i < numSlots; i++)
+		{
+			if (mObjects[i] != nullptr)
+				remap[i] = levelStarts[mDepths[i]]++;
+		}
+
+		Vector<Transform> localTfrms(numLive);
+		Vector<Transform> worldTfrms(numLive);
+		Vector<UINT32> parents(numLive);
+		Vector<UINT32> depths(numLive);
+		Vector<SceneObject*> objects(numLive);
+		Vector<UINT8> isDirty(numLive);
+
+		for (UINT32 i = 0; i < numSlots; i++)
+		{
+			const UINT32 newSlot = remap[i];
+			if (newSlot == INVALID_SLOT)
+				continue;
+
+			localTfrms[newSlot] = mLocalTfrms[i];
+			worldTfrms[newSlot] = mWorldTfrms[i];
+			parents[newSlot] = mParents[i] != INVALID_SLOT ? remap[mParents[i]] : INVALID_SLOT;
+			depths[newSlot] = mDepths[i];
+			objects[newSlot] = mObjects[i];
+			isDirty[newSlot] = mIsDirty[i];
+
+			mObjects[i]->mTransformSlot = newSlot;
+		}
+
+		mLocalTfrms.swap(localTfrms);
+		mWorldTfrms.swap(worldTfrms);
+		mParents.swap(parents);
+		mDepths.swap(depths);
+		mObjects.swap(objects);
+		mIsDirty.swap(isDirty);
+
+		UINT32 numDirty = 0;
+		for (auto& entry : mDirtySlots)
+		{
+			const UINT32 newSlot = remap[entry];
+			if (newSlot != INVALID_SLOT)
+				mDirtySlots[numDirty++] = newSlot;
+		}
+
+		mDirtySlots.resize(numDirty);
+		mNumFreeSlots = 0;
+		mLayoutDirty = false;
+	}
+}
@@ -0,0 +1,86 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Scene/BsTransform.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Keeps the local and world transforms of all instantiated scene objects in contiguous arrays, sorted by the depth of
+	 * the objects in the scene hierarchy. Once per frame update() recomputes the world transforms of objects whose
+	 * transform changed, one hierarchy level at a time, with objects on the same level processed in parallel. Computed
+	 * transforms are written back to the scene objects, so SceneObject::getTransform() and similar don't need to walk
+	 * up the hierarchy for objects that weren't modified since the last update.
+	 *
+	 * Scene objects keep their own copy of the transforms and remain the authority on their values. Transforms that are
+	 * queried between a modification and the next update() are still computed lazily by the scene object itself.
+	 *
+	 * @note	Sim thread only.
+	 */
+	class BS_CORE_EXPORT SceneTransformSystem
+	{
+	public:
+		/** Slot index of scene objects not registered with the system. */
+		static constexpr UINT32 INVALID_SLOT = (UINT32)-1;
+
+		SceneTransformSystem() = default;
+		~SceneTransformSystem();
+
+		/**
+		 * Registers a scene object with the system. If the parent of the object isn't registered it is registered first.
+		 * Objects that aren't instantiated cannot be registered.
+		 *
+		 * @param[in]	so		Object to register.
+		 * @return				True if the object is registered, false otherwise.
+		 */
+		bool registerObject(SceneObject& so);
+
+		/** Unregisters a scene object, and all of its children, from the system. Does nothing if not registered. */
+		void unregisterObject(SceneObject& so);
+
+		/** Notifies the system that the local transform of a registered scene object changed. */
+		void notifyTransformChanged(const SceneObject& so);
+
+		/** Notifies the system that a registered scene object was assigned a new parent. */
+		void notifyParentChanged(SceneObject& so);
+
+		/** Recomputes the world transforms of all objects modified since the last call, and updates the scene objects. */
+		void update();
+
+		/** Returns the number of objects currently registered with the system. */
+		UINT32 getNumObjects() const { return (UINT32)mObjects.size() - mNumFreeSlots; }
+
+	private:
+		/** Sets the depth of a registered object, and updates the depths of all of its registered descendants. */
+		void setDepth(SceneObject& so, UINT32 depth);
+
+		/** Sorts the arrays by depth and removes the slots of unregistered objects. */
+		void rebuildLayout();
+
+		/** Recomputes the world transform of the object in the specified slot, and writes it back to the object. */
+		void updateWorldTransform(UINT32 slot);
+
+		// Per-slot data, with slots sorted by depth unless mLayoutDirty is set
+		Vector<Transform> mLocalTfrms;
+		Vector<Transform> mWorldTfrms;
+		Vector<UINT32> mParents;
+		Vector<UINT32> mDepths;
+		Vector<SceneObject*> mObjects;
+		Vector<UINT8> mIsDirty;
+
+		/** Index one past the last slot of each hierarchy level. */
+		Vector<UINT32> mLevelEnds;
+
+		Vector<UINT32> mDirtySlots;
+		UINT32 mNumFreeSlots = 0;
+		bool mLayoutDirty = false;
+	};
+
+	/** @} */
+}
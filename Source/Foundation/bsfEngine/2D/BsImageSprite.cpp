@@ -49,9 +49,9 @@ namespace bs
 				if(renderElem.uvs != nullptr) bs_deleteN(renderElem.uvs, oldVertexCount);
 				if(renderElem.indexes != nullptr) bs_deleteN(renderElem.indexes, oldIndexCount);
 
-				renderElem.vertices = bs_newN<Vector2>(newNumQuads * 4);
-				renderElem.uvs = bs_newN<Vector2>(newNumQuads * 4);
-				renderElem.indexes = bs_newN<UINT32>(newNumQuads * 6);
+				renderElem.vertices = bs_newN<Vector2>(newNumQuads * 4, MemoryCategory::GUI);
+				renderElem.uvs = bs_newN<Vector2>(newNumQuads * 4, MemoryCategory::GUI);
+				renderElem.indexes = bs_newN<UINT32>(newNumQuads * 6, MemoryCategory::GUI);
 				renderElem.numQuads = newNumQuads;
 			}
 
@@ -65,7 +65,7 @@ namespace bs
 		UINT32 depth;
 		UINT32 minDepth;
 		Rect2I bounds;
-		Vector<GUIGroupElement> elements;
+		SmallVector<GUIGroupElement, 4> elements;
 	};
 
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
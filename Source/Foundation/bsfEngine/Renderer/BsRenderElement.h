@@ -32,6 +32,13 @@ namespace bs { namespace ct
 
 		/** Renderer specific value that identifies the type of this renderable element. */
 		UINT32 type = 0;
+
+		/**
+		 * True if the element can be rendered together with other elements using the same mesh, sub-mesh, material and
+		 * technique, in a single instanced draw call. The renderer is responsible for providing per-instance data for
+		 * such draw calls. Only relevant for render queues with instancing enabled.
+		 */
+		bool instanceable = false;
 	};
 
 	/** @} */
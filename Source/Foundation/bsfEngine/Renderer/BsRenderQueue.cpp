@@ -6,8 +6,7 @@
 #include "Mesh/BsMesh.h"
 #include "Material/BsMaterial.h"
 #include "Renderer/BsRenderElement.h"
-
-using namespace std::placeholders;
+#include "Utility/BsRadixSort.h"
 
 namespace bs { namespace ct
 {
@@ -17,13 +16,63 @@ namespace bs { namespace ct
 
 	}
 
+	namespace
+	{
+		/** Converts a float into an unsigned integer whose ordering matches the ordering of the float values. */
+		UINT32 floatToSortableBits(float value)
+		{
+			UINT32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+		}
+
+		/** Returns a hash of the material used by the element, with well distributed high bits. */
+		UINT32 getMaterialHash(const RenderElement* element)
+		{
+			const UINT64 address = (UINT64)(uintptr_t)element->material.get();
+			return (UINT32)((address * 0x9E3779B97F4A7C15ULL) >> 32);
+		}
+
+		/** Helper used for packing fields into a sort key, starting with the most significant bits. */
+		class SortKeyWriter
+		{
+		public:
+			/** Appends the @p numBits least significant bits of @p value to the key. */
+			void write(UINT64 value, UINT32 numBits)
+			{
+				assert(numBits <= mFreeBits);
+
+				mFreeBits -= numBits;
+				mKey |= (value & ((1ULL << numBits) - 1)) << mFreeBits;
+			}
+
+			/** Same as write(), except that @p value is an identifier that must fit in the provided number of bits. */
+			void writeId(UINT32 value, UINT32 numBits)
+			{
+				assert(value < (1ULL << numBits) && "Identifier doesn't fit in the sort key.");
+				write(value, numBits);
+			}
+
+			/** Returns the packed key. */
+			UINT64 getKey() const { return mKey; }
+
+		private:
+			UINT64 mKey = 0;
+			UINT32 mFreeBits = 64;
+		};
+	}
+
 	void RenderQueue::clear()
 	{
 		mSortableElements.clear();
-		mSortableElementIdx.clear();
+		mSortKeys.clear();
+		mSortedElementIdx.clear();
 		mElements.clear();
 
 		mSortedRenderElements.clear();
+		mInstancedElements.clear();
+		mShaderSortIds.clear();
 	}
 
 	void RenderQueue::add(const RenderElement* element, float distFromCamera)
@@ -31,12 +80,18 @@ namespace bs { namespace ct
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
 
+		UINT32 elementIdx = (UINT32)mElements.size();
 		mElements.push_back(element);
 		
-		UINT32 queuePriority = shader->getQueuePriority();
+		INT32 queuePriority = shader->getQueuePriority();
 		QueueSortType sortType = shader->getQueueSortType();
-		UINT32 shaderId = shader->getId();
+
+		// Shader IDs are never reused and grow without bound, so remap them to a dense range that fits in the sort key
+		const auto shaderSortId = mShaderSortIds.insert(std::make_pair(shader->getId(), (UINT32)mShaderSortIds.size()));
+		UINT32 shaderId = shaderSortId.first->second;
+
 		bool separablePasses = shader->getAllowSeparablePasses();
+		UINT32 materialHash = getMaterialHash(element);
 
 		switch (sortType)
 		{
@@ -56,66 +111,72 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < numPasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
+			UINT32 idx = (UINT32)mSortableElements.size();
+			mSortedElementIdx.push_back(idx);
 
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
-			sortableElem.priority = queuePriority;
+			sortableElem.elementIdx = elementIdx;
 			sortableElem.shaderId = shaderId;
 			sortableElem.passIdx = i;
-			sortableElem.distFromCamera = distFromCamera;
+			sortableElem.separablePasses = separablePasses;
+
+			mSortKeys.push_back(encodeSortKey(queuePriority, shaderId, i, materialHash, distFromCamera));
 		}
 	}
 
 	void RenderQueue::sort()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
+		// Radix sort is stable, so elements with equal keys remain in the order they were added in
+		const UINT32 numSortableElements = (UINT32)mSortableElements.size();
+		mTempSortKeys.resize(numSortableElements);
+		mTempSortedElementIdx.resize(numSortableElements);
 
-		switch (mStateReductionMode)
-		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
-		}
-
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		RadixSort::sort(mSortKeys.data(), mSortedElementIdx.data(), numSortableElements, mTempSortKeys.data(),
+			mTempSortedElementIdx.data());
 
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
-		const RenderElement* renderElem = nullptr;
-		INT32 currentElementIdx = -1;
-		UINT32 numPassesInCurrentElement = 0;
-		bool separablePasses = true;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		UINT32 i = 0;
+		while (i < numSortableElements)
 		{
-			UINT32 idx = mSortableElementIdx[i];
+			const SortableElement& elem = mSortableElements[mSortedElementIdx[i]];
+			const RenderElement* renderElem = mElements[elem.elementIdx];
 
-			while (numPassesInCurrentElement == 0)
+			// Find consecutive elements that can be rendered along with this one in a single instanced draw call
+			UINT32 numInstances = 1;
+			if (mInstancing && renderElem->instanceable)
 			{
-				currentElementIdx++;
-				renderElem = mElements[currentElementIdx];
-				numPassesInCurrentElement = renderElem->material->getNumPasses();
-				separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
+				while (i + numInstances < numSortableElements &&
+					canInstance(elem, mSortableElements[mSortedElementIdx[i + numInstances]]))
+				{
+					numInstances++;
+				}
 			}
 
-			const SortableElement& elem = mSortableElements[idx];
-			if (separablePasses)
+			UINT32 firstInstance = 0;
+			if (numInstances > 1)
+			{
+				firstInstance = (UINT32)mInstancedElements.size();
+				for (UINT32 j = 0; j < numInstances; j++)
+				{
+					const SortableElement& instance = mSortableElements[mSortedElementIdx[i + j]];
+					mInstancedElements.push_back(mElements[instance.elementIdx]);
+				}
+			}
+
+			i += numInstances;
+
+			if (elem.separablePasses)
 			{
 				mSortedRenderElements.push_back(RenderQueueElement());
 
 				RenderQueueElement& sortedElem = mSortedRenderElements.back();
 				sortedElem.renderElem = renderElem;
 				sortedElem.passIdx = elem.passIdx;
+				sortedElem.numInstances = numInstances;
+				sortedElem.firstInstance = firstInstance;
 
 				if (prevShaderId != elem.shaderId || prevPassIdx != elem.passIdx)
 				{
@@ -125,12 +186,11 @@ namespace bs { namespace ct
 				}
 				else
 					sortedElem.applyPass = false;
-
-				numPassesInCurrentElement--;
 			}
 			else
 			{
-				for (UINT32 j = 0; j < numPassesInCurrentElement; j++)
+				UINT32 numPasses = renderElem->material->getNumPasses();
+				for (UINT32 j = 0; j < numPasses; j++)
 				{
 					mSortedRenderElements.push_back(RenderQueueElement());
 
@@ -138,70 +198,66 @@ namespace bs { namespace ct
 					sortedElem.renderElem = renderElem;
 					sortedElem.passIdx = j;
 					sortedElem.applyPass = true;
+					sortedElem.numInstances = numInstances;
+					sortedElem.firstInstance = firstInstance;
 
 					prevShaderId = elem.shaderId;
 					prevPassIdx = j;
 				}
-
-				numPassesInCurrentElement = 0;
-			}			
+			}
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	bool RenderQueue::canInstance(const SortableElement& a, const SortableElement& b) const
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
+		if (a.shaderId != b.shaderId || a.passIdx != b.passIdx || a.separablePasses != b.separablePasses)
+			return false;
 
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
+		const RenderElement* elemA = mElements[a.elementIdx];
+		const RenderElement* elemB = mElements[b.elementIdx];
 
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
+		if (!elemB->instanceable)
+			return false;
 
-		return isHigher > isLower;
+		return elemA->material == elemB->material && elemA->techniqueIdx == elemB->techniqueIdx &&
+			elemA->mesh == elemB->mesh && elemA->subMesh.indexOffset == elemB->subMesh.indexOffset &&
+			elemA->subMesh.indexCount == elemB->subMesh.indexCount && elemA->subMesh.drawOp == elemB->subMesh.drawOp;
 	}
 
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT64 RenderQueue::encodeSortKey(INT32 priority, UINT32 shaderId, UINT32 passIdx, UINT32 materialHash, 
+		float depth) const
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 4 |
-			(a.shaderId < b.shaderId) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
+		// Higher priorities need to end up with lower keys
+		const INT32 clampedPriority = Math::clamp(priority, (INT32)-32768, (INT32)32767);
+		const UINT32 priorityBits = (UINT32)(32767 - clampedPriority);
 
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 4 | 
-			(a.distFromCamera < b.distFromCamera) << 3 | 
-			(a.shaderId < b.shaderId) << 2 | 
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 4 |
-			(a.distFromCamera > b.distFromCamera) << 3 |
-			(a.shaderId > b.shaderId) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		const UINT32 depthBits = floatToSortableBits(depth);
+		const UINT32 clampedPassIdx = std::min(passIdx, 15U);
+
+		// Lower precision fields keep their most significant bits, except for identifiers which only need to be distinct
+		SortKeyWriter writer;
+		writer.write(priorityBits, 16);
+
+		switch (mStateReductionMode)
+		{
+		case StateReduction::None:
+			writer.write(depthBits, 32);
+			break;
+		case StateReduction::Material:
+			writer.writeId(shaderId, 16);
+			writer.write(clampedPassIdx, 4);
+			writer.write(materialHash >> 24, 8);
+			writer.write(depthBits >> 12, 20);
+			break;
+		case StateReduction::Distance:
+			writer.write(depthBits >> 8, 24);
+			writer.writeId(shaderId, 14);
+			writer.write(clampedPassIdx, 4);
+			writer.write(materialHash >> 26, 6);
+			break;
+		}
+
+		return writer.getKey();
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
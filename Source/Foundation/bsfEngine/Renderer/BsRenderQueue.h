@@ -28,6 +28,16 @@ namespace bs { namespace ct
 		const RenderElement* renderElem = nullptr;
 		UINT32 passIdx = 0;
 		bool applyPass = true;
+
+		/** 
+		 * Number of elements to render using a single instanced draw call. If larger than one, @p renderElem is the first
+		 * of the batched elements, and the full list can be retrieved through RenderQueue::getInstancedElements(), 
+		 * starting at @p firstInstance.
+		 */
+		UINT32 numInstances = 1;
+
+		/** Index of the first batched element in the list returned by RenderQueue::getInstancedElements(). */
+		UINT32 firstInstance = 0;
 	};
 
 	/**
@@ -40,11 +50,10 @@ namespace bs { namespace ct
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
-			INT32 priority;
-			float distFromCamera;
+			UINT32 elementIdx;
 			UINT32 shaderId;
 			UINT32 passIdx;
+			bool separablePasses;
 		};
 
 	public:
@@ -68,28 +77,53 @@ namespace bs { namespace ct
 		/** Returns a list of sorted render elements. Caller must ensure sort() is called before this method. */
 		const Vector<RenderQueueElement>& getSortedElements() const;
 
+		/** 
+		 * Returns a list of all elements batched into instanced draw calls, as referenced by RenderQueueElement::firstInstance
+		 * and RenderQueueElement::numInstances. Caller must ensure sort() is called before this method.
+		 */
+		const Vector<const RenderElement*>& getInstancedElements() const { return mInstancedElements; }
+
 		/**
 		 * Controls if and how a render queue groups renderable objects by material in order to reduce number of state 
 		 * changes.
 		 */
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
-	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Determines should consecutive sorted elements using the same mesh, sub-mesh, material and pass be grouped into 
+		 * instanced draw calls. Only elements marked as RenderElement::instanceable are grouped.
+		 */
+		void setInstancing(bool enabled) { mInstancing = enabled; }
 
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+	protected:
+		/**
+		 * Packs the properties relevant for sorting into a single key, laid out according to the active state reduction
+		 * mode. Elements with lower keys are rendered first.
+		 *
+		 * @param[in]	priority		Queue priority of the element's shader. Higher priorities are rendered first.
+		 * @param[in]	shaderId		Identifier of the element's shader, unique within this queue. Must fit in the
+		 *								number of bits the current state reduction mode reserves for it (14 or 16).
+		 * @param[in]	passIdx			Index of the material pass.
+		 * @param[in]	materialHash	Hash identifying the element's material, and therefore the textures it binds.
+		 * @param[in]	depth			Sort depth of the element, already negated for back to front sorting.
+		 */
+		UINT64 encodeSortKey(INT32 priority, UINT32 shaderId, UINT32 passIdx, UINT32 materialHash, float depth) const;
 
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** Checks can the two sortable elements be rendered together using a single instanced draw call. */
+		bool canInstance(const SortableElement& a, const SortableElement& b) const;
 
 		Vector<SortableElement> mSortableElements;
-		Vector<UINT32> mSortableElementIdx;
+		Vector<UINT64> mSortKeys;
+		Vector<UINT32> mSortedElementIdx;
+		Vector<UINT64> mTempSortKeys;
+		Vector<UINT32> mTempSortedElementIdx;
 		Vector<const RenderElement*> mElements;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
+		Vector<const RenderElement*> mInstancedElements;
+		UnorderedMap<UINT32, UINT32> mShaderSortIds; // Maps Shader::getId() to a dense index, in order of first use
 		StateReduction mStateReductionMode;
+		bool mInstancing = false;
 	};
 
 	/** @} */
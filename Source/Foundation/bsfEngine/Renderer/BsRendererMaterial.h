@@ -23,7 +23,7 @@
 	public:																	\
 	static void _initMetaData()												\
 	{																		\
-		bs::RendererMaterialManager::_registerMaterial(&mMetaData, path);	\
+		bs::RendererMaterialManager::_registerMaterial(&mMetaData, path, &_getInstance);	\
 	};																		\
 
 /** 
@@ -36,7 +36,7 @@
 	static void _initMetaData()												\
 	{																		\
 		_initDefines(mMetaData.defines);									\
-		bs::RendererMaterialManager::_registerMaterial(&mMetaData, path);	\
+		bs::RendererMaterialManager::_registerMaterial(&mMetaData, path, &_getInstance);	\
 	};																		\
 	static void _initDefines(ShaderDefines& defines);
 
@@ -55,8 +55,13 @@ namespace bs { namespace ct
 		SPtr<Shader> shader;
 		SPtr<Shader> overrideShader;
 		SmallVector<RendererMaterialBase*, 4> instances;
+		SmallVector<bool, 4> used;
 		ShaderVariations variations;
 		ShaderDefines defines;
+		bool variationsInitialized = false;
+
+		/** Returns an instance of the variation with the specified index, creating it if it doesn't exist. */
+		RendererMaterialBase* (*getInstance)(UINT32 varIdx) = nullptr;
 
 #if BS_PROFILING_ENABLED
 		ProfilerString profilerSampleName;
@@ -128,29 +133,36 @@ namespace bs { namespace ct
 
 		/** 
 		 * Retrieves an instance of this renderer material. If material has multiple variations the first available
-		 * variation will be returned. 
+		 * variation will be returned. The instance is created on first use.
 		 */
 		static T* get()
 		{
-			if(mMetaData.instances[0] == nullptr)
-			{
-				RendererMaterialBase* mat = bs_alloc<T>();
-				mat->_varIdx = 0;
-				new (mat) T();
-				
-				mMetaData.instances[0] = mat;
-			}
+			if(!mMetaData.variationsInitialized)
+				RendererMaterialManager::_initVariations(mMetaData);
 
-			return (T*)mMetaData.instances[0];
+			mMetaData.used[0] = true;
+			return (T*)_getInstance(0);
 		}
 
-		/** Retrieves an instance of a particular variation of this renderer material. */
+		/** Retrieves an instance of a particular variation of this renderer material. The instance is created on first use. */
 		static T* get(const ShaderVariation& variation)
 		{
+			if(!mMetaData.variationsInitialized)
+				RendererMaterialManager::_initVariations(mMetaData);
+
 			if(variation.getIdx() == (UINT32)-1)
 				variation.setIdx(mMetaData.variations.find(variation));
 
-			UINT32 varIdx = variation.getIdx();
+			mMetaData.used[variation.getIdx()] = true;
+			return (T*)_getInstance(variation.getIdx());
+		}
+
+		/** 
+		 * Retrieves an instance of the variation with the specified index, creating it if it doesn't exist. Variations
+		 * must be initialized before calling this method. Unlike get(), doesn't mark the variation as used.
+		 */
+		static RendererMaterialBase* _getInstance(UINT32 varIdx)
+		{
 			if(mMetaData.instances[varIdx] == nullptr)
 			{
 				RendererMaterialBase* mat = bs_alloc<T>();
@@ -160,7 +172,7 @@ namespace bs { namespace ct
 				mMetaData.instances[varIdx] = mat;
 			}
 
-			return (T*)mMetaData.instances[varIdx];
+			return mMetaData.instances[varIdx];
 		}
 
 		/** 
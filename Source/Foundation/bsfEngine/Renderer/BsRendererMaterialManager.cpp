@@ -5,66 +5,157 @@
 #include "Resources/BsBuiltinResources.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Material/BsShader.h"
+#include "Material/BsTechnique.h"
+#include "Image/BsTexture.h"
+#include "RenderAPI/BsSamplerState.h"
 
 namespace bs
 {
-	RendererMaterialManager::RendererMaterialManager()
+	RendererMaterialManager::~RendererMaterialManager()
+	{
+		gCoreThread().queueCommand(std::bind(&RendererMaterialManager::destroyOnCore));
+	}
+
+	void RendererMaterialManager::_registerMaterial(ct::RendererMaterialMetaData* metaData, const char* shaderPath,
+		ct::RendererMaterialBase* (*getInstance)(UINT32))
 	{
-		BuiltinResources& br = BuiltinResources::instance();
+		Lock lock(getMutex());
+
+		metaData->getInstance = getInstance;
+		metaData->shaderPath = shaderPath;
 
-		// Note: Ideally I want to avoid loading all materials, and instead just load those that are used. 
 		Vector<RendererMaterialData>& materials = getMaterials();
-		Vector<SPtr<ct::Shader>> shaders;
-		for (auto& material : materials)
+		materials.push_back({ metaData, shaderPath });
+	}
+
+	void RendererMaterialManager::loadShader(ct::RendererMaterialMetaData& metaData)
+	{
+		// Note: Resources cannot be deserialized on the core thread as that creates sim thread objects, so the load is
+		// performed by a worker thread while the core thread waits for it
+		HShader shader = BuiltinResources::instance().getShader(metaData.shaderPath, true);
+		shader.blockUntilLoaded();
+
+		if (!shader.isLoaded())
+		{
+			LOGERR("Unable to load renderer material shader: " + metaData.shaderPath.toString());
+			return;
+		}
+
+		// The worker queued initialization of the shader's core objects, but the core thread won't get to it before the
+		// command that requested the material completes, so initialize them right away
+		SPtr<ct::Shader> coreShader = shader->getCore();
+		coreShader->_initializeIfScheduled();
+
+		for (auto& technique : coreShader->getTechniques())
+		{
+			technique->_initializeIfScheduled();
+
+			for (UINT32 i = 0; i < technique->getNumPasses(); i++)
+				technique->getPass(i)->_initializeIfScheduled();
+		}
+
+		for (auto& entry : coreShader->getTextureParams())
 		{
-			HShader shader = br.getShader(material.shaderPath);
-			if (shader.isLoaded())
-				shaders.push_back(shader->getCore());
-			else
-				shaders.push_back(nullptr);
+			if (entry.second.defaultValueIdx == (UINT32)-1)
+				continue;
+
+			SPtr<ct::Texture> texture = coreShader->getDefaultTexture(entry.second.defaultValueIdx);
+			if (texture != nullptr)
+				texture->_initializeIfScheduled();
 		}
 
-		gCoreThread().queueCommand(std::bind(&RendererMaterialManager::initOnCore, shaders), CTQF_InternalQueue);
+		for (auto& entry : coreShader->getSamplerParams())
+		{
+			if (entry.second.defaultValueIdx == (UINT32)-1)
+				continue;
+
+			SPtr<ct::SamplerState> samplerState = coreShader->getDefaultSampler(entry.second.defaultValueIdx);
+			if (samplerState != nullptr)
+				samplerState->_initializeIfScheduled();
+		}
+
+		metaData.shader = coreShader;
+
+#if BS_PROFILING_ENABLED
+		const String& filename = metaData.shaderPath.getFilename(false);
+		metaData.profilerSampleName = ProfilerString("RM: ") + ProfilerString(filename.data(), filename.size());
+#endif
 	}
 
-	RendererMaterialManager::~RendererMaterialManager()
+	void RendererMaterialManager::_initVariations(ct::RendererMaterialMetaData& metaData)
 	{
-		gCoreThread().queueCommand(std::bind(&RendererMaterialManager::destroyOnCore));
+		if (metaData.variationsInitialized)
+			return;
+
+		if (metaData.shader == nullptr)
+		{
+			loadShader(metaData);
+
+			if (metaData.shader == nullptr)
+				return;
+		}
+
+		// Note: Making the assumption here that all the techniques are generated due to shader variations
+		Vector<SPtr<ct::Technique>> techniques = metaData.shader->getCompatibleTechniques();
+		metaData.instances.resize(techniques.size(), nullptr);
+		metaData.used.resize(techniques.size(), false);
+
+		for(auto& entry : techniques)
+			metaData.variations.add(entry->getVariation());
+
+		metaData.variationsInitialized = true;
 	}
 
-	void RendererMaterialManager::_registerMaterial(ct::RendererMaterialMetaData* metaData, const char* shaderPath)
+	void RendererMaterialManager::warmUp(const Vector<RendererMaterialVariation>& variations)
 	{
-		Lock lock(getMutex());
-
-		Vector<RendererMaterialData>& materials = getMaterials();
-		materials.push_back({ metaData, shaderPath });
+		gCoreThread().queueCommand(std::bind(&RendererMaterialManager::warmUpOnCore, variations), CTQF_InternalQueue);
 	}
 
-	void RendererMaterialManager::initOnCore(const Vector<SPtr<ct::Shader>>& shaders)
+	void RendererMaterialManager::warmUpOnCore(const Vector<RendererMaterialVariation>& variations)
 	{
 		Lock lock(getMutex());
 
 		Vector<RendererMaterialData>& materials = getMaterials();
-		for (UINT32 i = 0; i < materials.size(); i++)
+		for (auto& entry : variations)
 		{
-			materials[i].metaData->shaderPath = materials[i].shaderPath;
-			materials[i].metaData->shader = shaders[i];
+			for (auto& material : materials)
+			{
+				ct::RendererMaterialMetaData& metaData = *material.metaData;
+				if (material.shaderPath != entry.shaderPath)
+					continue;
 
-			// Note: Making the assumption here that all the techniques are generated due to shader variations
-			Vector<SPtr<ct::Technique>> techniques = shaders[i]->getCompatibleTechniques();
-			materials[i].metaData->instances.resize(techniques.size());
+				_initVariations(metaData);
+				if (!metaData.variationsInitialized)
+					break;
 
-			for(auto& entry : techniques)
-				materials[i].metaData->variations.add(entry->getVariation());
+				UINT32 varIdx = metaData.variations.find(entry.variation);
+				if (varIdx != (UINT32)-1)
+					metaData.getInstance(varIdx);
 
-#if BS_PROFILING_ENABLED
-			const String& filename = materials[i].shaderPath.getFilename(false);
-			materials[i].metaData->profilerSampleName = ProfilerString("RM: ") + 
-				ProfilerString(filename.data(), filename.size());
-#endif
+				break;
+			}
 		}
 	}
 
+	Vector<RendererMaterialVariation> RendererMaterialManager::getUsedVariations()
+	{
+		Lock lock(getMutex());
+
+		Vector<RendererMaterialVariation> output;
+		Vector<RendererMaterialData>& materials = getMaterials();
+		for (auto& material : materials)
+		{
+			ct::RendererMaterialMetaData& metaData = *material.metaData;
+			for (UINT32 i = 0; i < (UINT32)metaData.used.size(); i++)
+			{
+				if (metaData.used[i])
+					output.push_back({ material.shaderPath, metaData.variations.get(i) });
+			}
+		}
+
+		return output;
+	}
+
 	ShaderDefines RendererMaterialManager::_getDefines(const Path& shaderPath)
 	{
 		ShaderDefines output;
@@ -96,6 +187,9 @@ namespace bs
 			}
 
 			materials[i].metaData->instances.clear();
+			materials[i].metaData->used.clear();
+			materials[i].metaData->variations = ShaderVariations();
+			materials[i].metaData->variationsInitialized = false;
 		}
 	}
 
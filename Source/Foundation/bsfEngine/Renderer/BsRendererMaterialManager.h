@@ -4,6 +4,7 @@
 
 #include "BsPrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Material/BsShaderVariation.h"
 
 namespace bs
 {
@@ -17,7 +18,22 @@ namespace bs
 		struct RendererMaterialMetaData;
 	}
 
-	/**	Initializes and handles all renderer materials. */
+	/** Identifies a single variation of a renderer material. */
+	struct RendererMaterialVariation
+	{
+		/** Path to the built-in shader used by the material, same as returned by RendererMaterial::getShaderPath(). */
+		Path shaderPath;
+
+		/** Variation of the shader. */
+		ShaderVariation variation;
+	};
+
+	/**
+	 * Initializes and handles all renderer materials. Nothing is loaded on start-up. The shader of a material is loaded
+	 * when any of its variations is first requested through RendererMaterial::get(), and the material and the GPU
+	 * programs of a variation are created when that variation is first requested. Variations known to be needed can be
+	 * created ahead of time by calling warmUp().
+	 */
 	class BS_EXPORT RendererMaterialManager : public Module<RendererMaterialManager>
 	{
 		/**	Information used for initializing a renderer material managed by this module. */	
@@ -28,21 +44,62 @@ namespace bs
 		};
 
 	public:
-		RendererMaterialManager();
+		RendererMaterialManager() = default;
 		~RendererMaterialManager();
 
-		/**	Registers a new material that should be initialized on module start-up. */
-		static void _registerMaterial(ct::RendererMaterialMetaData* metaData, const char* shaderPath);
+		/**
+		 * Registers a new material whose shader should be loaded once the material is first requested.
+		 *
+		 * @param[in]	metaData	Meta-data of the material type.
+		 * @param[in]	shaderPath	Path to the shader used by the material, relative to the built-in shader folder.
+		 * @param[in]	getInstance	Function that returns an instance of a material variation, creating it if needed.
+		 */
+		static void _registerMaterial(ct::RendererMaterialMetaData* metaData, const char* shaderPath,
+			ct::RendererMaterialBase* (*getInstance)(UINT32));
 
 		/** Returns a set of defines to be used when importing the shader. */
 		static ShaderDefines _getDefines(const Path& shaderPath);
+
+		/**
+		 * Queues creation of the provided material variations on the core thread, so their GPU programs are compiled
+		 * before they are first used for rendering. Variations belonging to unknown shaders, or not supported by the
+		 * shader, are ignored.
+		 *
+		 * @param[in]	variations	Variations to create. Usually a list returned by getUsedVariations() in an earlier
+		 *							session.
+		 */
+		void warmUp(const Vector<RendererMaterialVariation>& variations);
+
+		/**
+		 * Returns a list of all material variations that were requested through RendererMaterial::get() since
+		 * start-up. Variations only created by warmUp() are not included.
+		 *
+		 * @note	Core thread only.
+		 */
+		static Vector<RendererMaterialVariation> getUsedVariations();
+
+		/**
+		 * Loads the shader of the material and initializes the list of its variations, if not already initialized.
+		 * Called automatically when a variation is first requested.
+		 *
+		 * @note	Core thread only.
+		 */
+		static void _initVariations(ct::RendererMaterialMetaData& metaData);
 	private:
 		template<class T>
 		friend class RendererMaterial;
 		friend class ct::RendererMaterialBase;
 
-		/**	Initializes all materials on the core thread. */
-		static void initOnCore(const Vector<SPtr<ct::Shader>>& shaders);
+		/**	
+		 * Loads the shader of the material and assigns it to the material's meta-data. Blocks until the shader is
+		 * loaded.
+		 *
+		 * @note	Core thread only.
+		 */
+		static void loadShader(ct::RendererMaterialMetaData& metaData);
+
+		/**	Creates material variations queued by warmUp(), on the core thread. */
+		static void warmUpOnCore(const Vector<RendererMaterialVariation>& variations);
 
 		/**	Destroys all materials on the core thread. */
 		static void destroyOnCore();
@@ -722,12 +722,15 @@ namespace bs
 		return gResources().load<SpriteTexture>(texturePath);
 	}
 
-	HShader BuiltinResources::getShader(const Path& path) const
+	HShader BuiltinResources::getShader(const Path& path, bool async) const
 	{
 		Path programPath = mEngineShaderFolder;
 		programPath.append(path);
 		programPath.setExtension(programPath.getExtension() + ".asset");
 
+		if (async)
+			return gResources().loadAsync<Shader>(programPath);
+
 		return gResources().load<Shader>(programPath);
 	}
 
@@ -117,8 +117,10 @@ namespace bs
 		 * Loads a shader at the specified path.
 		 * 
 		 * @param[in]	path	Path relative to the default shader folder with no file extension.
+		 * @param[in]	async	If true the shader will be loaded on a worker thread and the method will return
+		 *						immediately. Use the returned handle to wait for the load to complete.
 		 */
-		HShader getShader(const Path& path) const;
+		HShader getShader(const Path& path, bool async = false) const;
 
 		/** Returns the default font used by the engine. */
 		HFont getDefaultFont() const { return mFont; }
@@ -264,7 +264,7 @@ namespace bs
 		{
 			UINT32 alignOffset = 16 - (sizeof(MemBlock) & (16 - 1));
 
-			UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc_aligned16(blockSize + sizeof(MemBlock) + alignOffset));
+			UINT8* data = (UINT8*)reinterpret_cast<UINT8*>(bs_alloc_aligned16(blockSize + sizeof(MemBlock) + alignOffset, MemoryCategory::FrameAlloc));
 			newBlock = new (data) MemBlock(blockSize);
 			data += sizeof(MemBlock) + alignOffset;
 			newBlock->mData = data;
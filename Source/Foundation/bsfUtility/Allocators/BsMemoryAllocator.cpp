@@ -1,9 +1,284 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Debug/BsDebug.h"
 
 namespace bs
 {
 	UINT64 BS_THREADLOCAL MemoryCounter::Allocs = 0;
 	UINT64 BS_THREADLOCAL MemoryCounter::Frees = 0;
-}
\ No newline at end of file
+
+	namespace
+	{
+		constexpr UINT32 NUM_CATEGORIES = (UINT32)MemoryCategory::Count;
+
+		/** Number of tracked operations after which a thread merges its local counters into the global ones. */
+		constexpr UINT32 FLUSH_OPERATION_COUNT = 256;
+
+		/** Change in live bytes of a single category after which a thread merges its local counters. */
+		constexpr INT64 FLUSH_BYTE_THRESHOLD = 64 * 1024;
+
+		/** Number of individual leaks listed by MemoryCounter::reportLeaks(). */
+		constexpr UINT32 MAX_REPORTED_LEAKS = 16;
+
+		const char* CATEGORY_NAMES[] =
+		{
+			"General", "Mesh", "Texture", "Animation", "GUI", "FrameAlloc", "PoolAlloc"
+		};
+
+		static_assert(sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]) == NUM_CATEGORIES,
+			"Category names must match the MemoryCategory enum.");
+
+		/** Totals of a single category, shared between all threads. */
+		struct GlobalCategoryCounters
+		{
+			std::atomic<INT64> liveBytes { 0 };
+			std::atomic<INT64> peakBytes { 0 };
+			std::atomic<UINT64> totalAllocatedBytes { 0 };
+			std::atomic<UINT64> numAllocs { 0 };
+			std::atomic<UINT64> numFrees { 0 };
+		};
+
+		/** Changes to a single category made by a thread, that haven't yet been merged into the global totals. */
+		struct LocalCategoryCounters
+		{
+			INT64 liveBytes;
+			UINT64 totalAllocatedBytes;
+			UINT32 numAllocs;
+			UINT32 numFrees;
+		};
+
+		struct LocalCounters
+		{
+			LocalCategoryCounters categories[NUM_CATEGORIES];
+			UINT32 numOperations;
+		};
+
+		GlobalCategoryCounters gCounters[NUM_CATEGORIES];
+
+		// Plain thread local data, so tracking never triggers thread_local initialization
+		BS_THREADLOCAL LocalCounters tLocalCounters;
+		BS_THREADLOCAL bool tLocalCountersRegistered = false;
+
+		/** Merges the calling thread's counters into the global ones. */
+		void flushLocalCounters()
+		{
+			LocalCounters& local = tLocalCounters;
+			for(UINT32 i = 0; i < NUM_CATEGORIES; i++)
+			{
+				LocalCategoryCounters& localCategory = local.categories[i];
+				if(localCategory.numAllocs == 0 && localCategory.numFrees == 0)
+					continue;
+
+				GlobalCategoryCounters& global = gCounters[i];
+
+				const INT64 liveBytes = global.liveBytes.fetch_add(localCategory.liveBytes) + localCategory.liveBytes;
+				INT64 peakBytes = global.peakBytes.load(std::memory_order_relaxed);
+				while(liveBytes > peakBytes && !global.peakBytes.compare_exchange_weak(peakBytes, liveBytes))
+				{ }
+
+				global.totalAllocatedBytes.fetch_add(localCategory.totalAllocatedBytes, std::memory_order_relaxed);
+				global.numAllocs.fetch_add(localCategory.numAllocs, std::memory_order_relaxed);
+				global.numFrees.fetch_add(localCategory.numFrees, std::memory_order_relaxed);
+
+				localCategory = LocalCategoryCounters();
+			}
+
+			local.numOperations = 0;
+		}
+
+		/** Merges counters of a thread that is exiting. */
+		struct LocalCountersOwner
+		{
+			~LocalCountersOwner()
+			{
+				flushLocalCounters();
+			}
+		};
+
+		thread_local LocalCountersOwner tLocalCountersOwner;
+
+		/** Applies a change to the calling thread's counters, and merges them with the global ones if needed. */
+		void recordOperation(MemoryCategory category, INT64 bytes, bool isAlloc)
+		{
+			LocalCounters& local = tLocalCounters;
+			LocalCategoryCounters& localCategory = local.categories[(UINT32)category];
+
+			if(isAlloc)
+			{
+				localCategory.liveBytes += bytes;
+				localCategory.totalAllocatedBytes += (UINT64)bytes;
+				localCategory.numAllocs++;
+			}
+			else
+			{
+				localCategory.liveBytes -= bytes;
+				localCategory.numFrees++;
+			}
+
+			local.numOperations++;
+			if(local.numOperations < FLUSH_OPERATION_COUNT && localCategory.liveBytes < FLUSH_BYTE_THRESHOLD &&
+				localCategory.liveBytes > -FLUSH_BYTE_THRESHOLD)
+				return;
+
+			if(!tLocalCountersRegistered)
+			{
+				// Touching the thread_local object registers its destructor, which flushes the counters on thread exit
+				(void)&tLocalCountersOwner;
+				tLocalCountersRegistered = true;
+			}
+
+			flushLocalCounters();
+		}
+
+		/************************************************************************/
+		/* 								LEAK TRACKING		                   	*/
+		/************************************************************************/
+
+		/** Information about a single allocation made while leak tracking was enabled. */
+		struct AllocationRecord
+		{
+			UINT64 size;
+			UINT64 sequenceIdx;
+			MemoryCategory category;
+		};
+
+		typedef UnorderedMap<void*, AllocationRecord, std::hash<void*>, std::equal_to<void*>,
+			StdAlloc<std::pair<void* const, AllocationRecord>, ProfilerAlloc>> AllocationRecordMap;
+
+		std::atomic<bool> gLeakTrackingEnabled { false };
+		Mutex gLeakTrackingMutex;
+		AllocationRecordMap* gAllocationRecords = nullptr;
+		UINT64 gNextSequenceIdx = 0;
+	}
+
+	void MemoryCounter::trackAlloc(void* ptr, UINT64 size, MemoryCategory category)
+	{
+		++Allocs;
+		recordOperation(category, (INT64)size, true);
+
+		if(gLeakTrackingEnabled.load(std::memory_order_relaxed))
+		{
+			Lock lock(gLeakTrackingMutex);
+
+			if(gAllocationRecords != nullptr)
+				(*gAllocationRecords)[ptr] = { size, gNextSequenceIdx++, category };
+		}
+	}
+
+	void MemoryCounter::trackFree(void* ptr, UINT64 size, MemoryCategory category)
+	{
+		++Frees;
+		recordOperation(category, (INT64)size, false);
+
+		if(gLeakTrackingEnabled.load(std::memory_order_relaxed))
+		{
+			Lock lock(gLeakTrackingMutex);
+
+			if(gAllocationRecords != nullptr)
+				gAllocationRecords->erase(ptr);
+		}
+	}
+
+	MemoryCategoryStats MemoryCounter::getCategoryStats(MemoryCategory category)
+	{
+		flushLocalCounters();
+
+		const GlobalCategoryCounters& global = gCounters[(UINT32)category];
+
+		// Frees made on other threads might not be merged yet, so the live byte count can temporarily go below zero
+		MemoryCategoryStats output;
+		output.liveBytes = (UINT64)std::max(global.liveBytes.load(), (INT64)0);
+		output.peakBytes = (UINT64)std::max(global.peakBytes.load(), (INT64)0);
+		output.totalAllocatedBytes = global.totalAllocatedBytes.load();
+		output.numAllocs = global.numAllocs.load();
+		output.numFrees = global.numFrees.load();
+
+		return output;
+	}
+
+	const char* MemoryCounter::getCategoryName(MemoryCategory category)
+	{
+		if(category >= MemoryCategory::Count)
+			return "Unknown";
+
+		return CATEGORY_NAMES[(UINT32)category];
+	}
+
+	void MemoryCounter::setLeakTrackingEnabled(bool enabled)
+	{
+#if !BS_MEMORY_TRACKING
+		if(enabled)
+			LOGWRN("Memory leak reporting is not available, as memory tracking is disabled in this build (see the "
+				"MEMORY_TRACKING build option).");
+#endif
+
+		Lock lock(gLeakTrackingMutex);
+
+		if(enabled && gAllocationRecords == nullptr)
+			gAllocationRecords = bs_new<AllocationRecordMap, ProfilerAlloc>();
+
+		gLeakTrackingEnabled.store(enabled);
+	}
+
+	void MemoryCounter::reportLeaks()
+	{
+		Vector<std::pair<void*, AllocationRecord>> leaks;
+		{
+			Lock lock(gLeakTrackingMutex);
+			gLeakTrackingEnabled.store(false);
+
+			if(gAllocationRecords == nullptr)
+				return;
+
+			// Copy the records so logging can allocate memory freely
+			AllocationRecordMap* records = gAllocationRecords;
+			gAllocationRecords = nullptr;
+
+			leaks.assign(records->begin(), records->end());
+			bs_delete<AllocationRecordMap, ProfilerAlloc>(records);
+		}
+
+		if(leaks.empty())
+			return;
+
+		UINT64 numLeaks[NUM_CATEGORIES] = { 0 };
+		UINT64 leakedBytes[NUM_CATEGORIES] = { 0 };
+		UINT64 totalLeakedBytes = 0;
+		for(auto& entry : leaks)
+		{
+			numLeaks[(UINT32)entry.second.category]++;
+			leakedBytes[(UINT32)entry.second.category] += entry.second.size;
+			totalLeakedBytes += entry.second.size;
+		}
+
+		std::sort(leaks.begin(), leaks.end(),
+			[](const std::pair<void*, AllocationRecord>& a, const std::pair<void*, AllocationRecord>& b)
+		{
+			return a.second.size > b.second.size;
+		});
+
+		StringStream output;
+		output << "Detected " << leaks.size() << " memory leaks, totaling " << totalLeakedBytes << " bytes." << std::endl;
+
+		for(UINT32 i = 0; i < NUM_CATEGORIES; i++)
+		{
+			if(numLeaks[i] == 0)
+				continue;
+
+			output << "\t" << CATEGORY_NAMES[i] << ": " << numLeaks[i] << " allocations, " << leakedBytes[i] <<
+				" bytes." << std::endl;
+		}
+
+		const UINT32 numReported = std::min((UINT32)leaks.size(), MAX_REPORTED_LEAKS);
+		output << "Largest leaks:" << std::endl;
+		for(UINT32 i = 0; i < numReported; i++)
+		{
+			const AllocationRecord& record = leaks[i].second;
+			output << "\t" << leaks[i].first << " - " << record.size << " bytes, category: " <<
+				CATEGORY_NAMES[(UINT32)record.category] << ", allocation #" << record.sequenceIdx << std::endl;
+		}
+
+		gDebug().logWarning(output.str());
+	}
+}
@@ -13,6 +13,8 @@
 #  include <malloc.h>
 #endif
 
+#include "Allocators/BsThreadCachingAlloc.h"
+
 namespace bs
 {
 	class MemoryAllocatorBase;
@@ -96,9 +98,56 @@ namespace bs
 	}
 #endif
 
+	/**
+	 * Categories that allocations made through the general purpose allocator can be tagged with. Memory usage of each
+	 * category is tracked separately by MemoryCounter.
+	 */
+	enum class MemoryCategory : uint32_t
+	{
+		/** Allocations that weren't assigned a more specific category. */
+		General,
+		/** Vertex and index data of meshes. */
+		Mesh,
+		/** Pixel data of textures. */
+		Texture,
+		/** Animation clip evaluation data, skeletons and their poses. */
+		Animation,
+		/** GUI element and sprite render data. */
+		GUI,
+		/** Memory blocks backing frame allocators. */
+		FrameAlloc,
+		/** Memory blocks backing pool allocators. */
+		PoolAlloc,
+		Count // Keep at end
+	};
+
+	/** Information about memory allocated in a particular MemoryCategory. */
+	struct MemoryCategoryStats
+	{
+		/** Number of bytes currently allocated. */
+		uint64_t liveBytes = 0;
+
+		/** Highest value reached by liveBytes. */
+		uint64_t peakBytes = 0;
+
+		/** Total number of bytes allocated since the application started. */
+		uint64_t totalAllocatedBytes = 0;
+
+		/** Total number of allocations made since the application started. */
+		uint64_t numAllocs = 0;
+
+		/** Total number of frees made since the application started. */
+		uint64_t numFrees = 0;
+	};
+
 	/**
 	 * Thread safe class used for storing total number of memory allocations and deallocations, primarily for statistic
 	 * purposes.
+	 *
+	 * Aside from the per-thread allocation counts, it keeps track of memory usage per MemoryCategory, if memory tracking
+	 * is enabled (BS_MEMORY_TRACKING). Each thread accumulates its changes locally and periodically merges them into the
+	 * global totals, so the category statistics might lag slightly behind the actual state on other threads. When
+	 * memory tracking is disabled the category statistics are always zero.
 	 */
 	class MemoryCounter
 	{
@@ -113,6 +162,27 @@ namespace bs
 			return Frees;
 		}
 
+		/**
+		 * Returns memory usage of the specified category, across all threads. Changes made by the calling thread are
+		 * always included.
+		 */
+		static BS_UTILITY_EXPORT MemoryCategoryStats getCategoryStats(MemoryCategory category);
+
+		/** Returns a human readable name of the specified category. */
+		static BS_UTILITY_EXPORT const char* getCategoryName(MemoryCategory category);
+
+		/**
+		 * Enables or disables recording of individual allocations, which allows reportLeaks() to list allocations that
+		 * were never freed. Significantly slows down allocation, and should only be enabled for debugging purposes.
+		 */
+		static BS_UTILITY_EXPORT void setLeakTrackingEnabled(bool enabled);
+
+		/**
+		 * Logs all allocations made while leak tracking was enabled that weren't freed yet, grouped per category, and
+		 * disables leak tracking. Should be called during shutdown, once all systems have been destroyed.
+		 */
+		static BS_UTILITY_EXPORT void reportLeaks();
+
 	private:
 		friend class MemoryAllocatorBase;
 
@@ -120,89 +190,220 @@ namespace bs
 		static BS_UTILITY_EXPORT void incAllocCount() { ++Allocs; }
 		static BS_UTILITY_EXPORT void incFreeCount() { ++Frees; }
 
+		/** Registers a new allocation of @p size bytes at @p ptr, belonging to the specified category. */
+		static BS_UTILITY_EXPORT void trackAlloc(void* ptr, uint64_t size, MemoryCategory category);
+
+		/** Registers that the allocation of @p size bytes at @p ptr, belonging to the specified category, is being freed. */
+		static BS_UTILITY_EXPORT void trackFree(void* ptr, uint64_t size, MemoryCategory category);
+
 		static BS_THREADLOCAL uint64_t Allocs;
 		static BS_THREADLOCAL uint64_t Frees;
 	};
 
+	/** 
+	 * Header stored in front of every allocation made by the general purpose allocator when memory tracking is enabled,
+	 * so the size and category of an allocation are known when it is freed.
+	 */
+	struct alignas(16) MemoryTrackingHeader
+	{
+		/** Number of bytes requested by the allocation. */
+		uint64_t size;
+
+		/** Category the allocation is accounted to. */
+		MemoryCategory category;
+
+		/** Offset from the start of the underlying allocation to the memory returned to the caller, in bytes. */
+		uint32_t offset;
+	};
+
 	/** Base class all memory allocators need to inherit. Provides allocation and free counting. */
 	class MemoryAllocatorBase
 	{
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+
+#if BS_MEMORY_TRACKING
+		/** 
+		 * Writes the tracking header into the allocation at @p base and registers it with MemoryCounter. @p offset must
+		 * be a multiple of the required alignment, and at least the size of the header. Returns the memory to be returned
+		 * to the caller.
+		 */
+		static void* trackAlloc(void* base, size_t bytes, size_t offset, MemoryCategory category)
+		{
+			if(base == nullptr)
+				return nullptr;
+
+			void* ptr = (uint8_t*)base + offset;
+
+			MemoryTrackingHeader* header = (MemoryTrackingHeader*)ptr - 1;
+			header->size = bytes;
+			header->category = category;
+			header->offset = (uint32_t)offset;
+
+			MemoryCounter::trackAlloc(ptr, bytes, category);
+			return ptr;
+		}
+
+		/** Unregisters an allocation made by trackAlloc() and returns the start of the underlying allocation. */
+		static void* trackFree(void* ptr)
+		{
+			const MemoryTrackingHeader* header = (const MemoryTrackingHeader*)ptr - 1;
+			MemoryCounter::trackFree(ptr, header->size, header->category);
+
+			return (uint8_t*)ptr - header->offset;
+		}
+#endif
 	};
 
 	/**
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 *
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default ThreadCachingAlloc is used, or standard malloc/free if it was
+	 *			disabled in the build configuration.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
 	{
 	public:
-		/** Allocates @p bytes bytes. */
-		static void* allocate(size_t bytes)
+		/** 
+		 * Allocates @p bytes bytes. The allocation is accounted to the provided memory category, if memory tracking is
+		 * enabled.
+		 */
+		static void* allocate(size_t bytes, MemoryCategory category = MemoryCategory::General)
 		{
+#if BS_MEMORY_TRACKING
+			const size_t offset = sizeof(MemoryTrackingHeader);
+			return trackAlloc(allocateInternal(bytes + offset), bytes, offset, category);
+#else
 #if BS_PROFILING_ENABLED
 			incAllocCount();
 #endif
 
-			return malloc(bytes);
+			return allocateInternal(bytes);
+#endif
 		}
 
 		/**
 		 * Allocates @p bytes and aligns them to the specified boundary (in bytes). If the aligment is less or equal to
 		 * 16 it is more efficient to use the allocateAligned16() alternative of this method. Alignment must be power of two.
 		 */
-		static void* allocateAligned(size_t bytes, size_t alignment)
+		static void* allocateAligned(size_t bytes, size_t alignment, MemoryCategory category = MemoryCategory::General)
 		{
+#if BS_MEMORY_TRACKING
+			const size_t offset = alignment > sizeof(MemoryTrackingHeader) ? alignment : sizeof(MemoryTrackingHeader);
+			return trackAlloc(allocateAlignedInternal(bytes + offset, alignment), bytes, offset, category);
+#else
 #if BS_PROFILING_ENABLED
 			incAllocCount();
 #endif
 
-			return platformAlignedAlloc(bytes, alignment);
+			return allocateAlignedInternal(bytes, alignment);
+#endif
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
-		static void* allocateAligned16(size_t bytes)
+		static void* allocateAligned16(size_t bytes, MemoryCategory category = MemoryCategory::General)
 		{
+#if BS_MEMORY_TRACKING
+			const size_t offset = sizeof(MemoryTrackingHeader);
+			return trackAlloc(allocateAligned16Internal(bytes + offset), bytes, offset, category);
+#else
 #if BS_PROFILING_ENABLED
 			incAllocCount();
 #endif
 
-			return platformAlignedAlloc16(bytes);
+			return allocateAligned16Internal(bytes);
+#endif
 		}
 
 		/** Frees the memory at the specified location. */
 		static void free(void* ptr)
 		{
-#if BS_PROFILING_ENABLED
+#if BS_MEMORY_TRACKING
+			if(ptr == nullptr)
+				return;
+
+			ptr = trackFree(ptr);
+#elif BS_PROFILING_ENABLED
 			incFreeCount();
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			ThreadCachingAlloc::free(ptr);
+#else
 			::free(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
 		static void freeAligned(void* ptr)
 		{
-#if BS_PROFILING_ENABLED
+#if BS_MEMORY_TRACKING
+			if(ptr == nullptr)
+				return;
+
+			ptr = trackFree(ptr);
+#elif BS_PROFILING_ENABLED
 			incFreeCount();
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			ThreadCachingAlloc::freeAligned(ptr);
+#else
 			platformAlignedFree(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned16() */
 		static void freeAligned16(void* ptr)
 		{
-#if BS_PROFILING_ENABLED
+#if BS_MEMORY_TRACKING
+			if(ptr == nullptr)
+				return;
+
+			ptr = trackFree(ptr);
+#elif BS_PROFILING_ENABLED
 			incFreeCount();
 #endif
 
+#if BS_THREAD_CACHING_ALLOCATOR
+			ThreadCachingAlloc::freeAligned(ptr);
+#else
 			platformAlignedFree16(ptr);
+#endif
+		}
+
+	private:
+		/** Allocates memory using the underlying general purpose allocator. */
+		static void* allocateInternal(size_t bytes)
+		{
+#if BS_THREAD_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocate(bytes);
+#else
+			return malloc(bytes);
+#endif
+		}
+
+		/** Allocates aligned memory using the underlying general purpose allocator. */
+		static void* allocateAlignedInternal(size_t bytes, size_t alignment)
+		{
+#if BS_THREAD_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocateAligned(bytes, alignment);
+#else
+			return platformAlignedAlloc(bytes, alignment);
+#endif
+		}
+
+		/** Allocates 16 byte aligned memory using the underlying general purpose allocator. */
+		static void* allocateAligned16Internal(size_t bytes)
+		{
+#if BS_THREAD_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocateAligned(bytes, 16);
+#else
+			return platformAlignedAlloc16(bytes);
+#endif
 		}
 	};
 
@@ -289,6 +490,12 @@ namespace bs
 		return MemoryAllocator<GenAlloc>::allocate(count);
 	}
 
+	/** Allocates the specified number of bytes, accounted to the provided memory category. */
+	inline void* bs_alloc(size_t count, MemoryCategory category)
+	{
+		return MemoryAllocator<GenAlloc>::allocate(count, category);
+	}
+
 	/** Allocates enough bytes to hold the specified type, but doesn't construct it. */
 	template<class T>
 	inline T* bs_alloc()
@@ -312,6 +519,12 @@ namespace bs
 		return MemoryAllocator<GenAlloc>::allocateAligned16(count);
 	}
 
+	/** Allocates the specified number of bytes aligned to a 16 bytes boundary, accounted to the provided memory category. */
+	inline void* bs_alloc_aligned16(size_t count, MemoryCategory category)
+	{
+		return MemoryAllocator<GenAlloc>::allocateAligned16(count, category);
+	}
+
 	/** Allocates enough bytes to hold an array of @p count elements the specified type, but doesn't construct them. */
 	template<class T>
 	inline T* bs_allocN(size_t count)
@@ -321,9 +534,9 @@ namespace bs
 
 	/** Creates and constructs an array of @p count elements. */
 	template<class T>
-	inline T* bs_newN(size_t count)
+	inline T* bs_newN(size_t count, MemoryCategory category = MemoryCategory::General)
 	{
-		T* ptr = (T*)MemoryAllocator<GenAlloc>::allocate(count * sizeof(T));
+		T* ptr = (T*)MemoryAllocator<GenAlloc>::allocate(count * sizeof(T), category);
 
 		for(size_t i = 0; i < count; ++i)
 			new (&ptr[i]) T;
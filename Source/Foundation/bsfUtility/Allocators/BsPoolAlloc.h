@@ -197,7 +197,7 @@ namespace bs
 				constexpr UINT32 blockDataSize = ActualElemSize * ElemsPerBlock;
 				size_t paddedBlockDataSize = blockDataSize + (Alignment - 1); // Padding for potential alignment correction
 
-				UINT8* data = (UINT8*)bs_alloc(sizeof(MemBlock) + (UINT32)paddedBlockDataSize);
+				UINT8* data = (UINT8*)bs_alloc(sizeof(MemBlock) + (UINT32)paddedBlockDataSize, MemoryCategory::PoolAlloc);
 
 				void* blockData = data + sizeof(MemBlock);
 				blockData = std::align(Alignment, blockDataSize, blockData, paddedBlockDataSize);
@@ -121,11 +121,12 @@ namespace bs
 
 			UINT32* storedSize = (UINT32*)(dataPtr);
 			mTotalAllocBytes -= *storedSize;
+			allocSize += sizeof(UINT32);
 #endif
 
-			if(data > mStaticData && data < (mStaticData + BlockSize))
+			if(dataPtr >= mStaticData && dataPtr < (mStaticData + BlockSize))
 			{
-				if((((UINT8*)data) + allocSize) == (mStaticData + mFreePtr))
+				if((dataPtr + allocSize) == (mStaticData + mFreePtr))
 					mFreePtr -= allocSize;
 			}
 			else
@@ -145,7 +146,7 @@ namespace bs
 			UINT32* storedSize = (UINT32*)(dataPtr);
 			mTotalAllocBytes -= *storedSize;
 #endif
-			if(data < mStaticData || data >= (mStaticData + BlockSize))
+			if(dataPtr < mStaticData || dataPtr >= (mStaticData + BlockSize))
 				mDynamicAlloc.free(dataPtr);
 		}
 
@@ -257,7 +258,7 @@ namespace bs
 		/** Deallocate storage p of deleted elements. */
 		void deallocate(T* p, size_t num) const noexcept
 		{
-			mStaticAlloc->free((UINT8*)p, (UINT32)num);
+			mStaticAlloc->free((UINT8*)p, (UINT32)(num * sizeof(T)));
 		}
 
 		StaticAlloc<BlockSize, FreeAlloc>* mStaticAlloc = nullptr;
@@ -0,0 +1,899 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#if !defined(NOMINMAX) && defined(_MSC_VER)
+		#define NOMINMAX // required to stop windows.h messing up std::min
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace bs
+{
+	namespace
+	{
+		/** Block sizes handled by the allocator. Each is a multiple of 16 bytes, keeping all blocks 16 byte aligned. */
+		constexpr UINT32 SIZE_CLASSES[] =
+		{
+			16, 32, 48, 64, 80, 96, 112, 128,
+			160, 192, 224, 256, 320, 384, 448, 512,
+			640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+			2560, 3072, 3584, 4096
+		};
+
+		constexpr UINT32 NUM_SIZE_CLASSES = sizeof(SIZE_CLASSES) / sizeof(SIZE_CLASSES[0]);
+		constexpr UINT32 SIZE_CLASS_GRANULARITY = 16;
+		constexpr UINT32 NUM_SIZE_CLASS_LOOKUP_ENTRIES = ThreadCachingAlloc::MAX_SMALL_SIZE / SIZE_CLASS_GRANULARITY + 1;
+
+		/** Memory at the start of each span reserved for its header. Also determines the alignment of the first block. */
+		constexpr UINT32 SPAN_HEADER_SIZE = 64;
+
+		/** Number of bytes a thread cache moves to or from the central lists at once, per size class. */
+		constexpr UINT32 BATCH_BYTES = 8192;
+		constexpr UINT32 MIN_BATCH_SIZE = 2;
+		constexpr UINT32 MAX_BATCH_SIZE = 32;
+
+		/** Amount of free memory the page heap retains before applying the release policy, unless changed at runtime. */
+		constexpr size_t DEFAULT_MAX_RETAINED_BYTES = 16 * 1024 * 1024;
+
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+		// Each VirtualAlloc call must be released as a whole, so spans are mapped one by one. Their alignment comes for
+		// free as the allocation granularity on Windows matches the span size.
+		constexpr UINT32 SPANS_PER_MAPPING = 1;
+#else
+		constexpr UINT32 SPANS_PER_MAPPING = 16;
+#endif
+
+		static_assert(SIZE_CLASSES[NUM_SIZE_CLASSES - 1] == ThreadCachingAlloc::MAX_SMALL_SIZE,
+			"Largest size class must match the maximum small allocation size.");
+		static_assert(ThreadCachingAlloc::MAX_SMALL_ALIGNMENT <= SPAN_HEADER_SIZE,
+			"Span header must preserve the maximum supported alignment.");
+
+		/** Maps allocation sizes, in increments of SIZE_CLASS_GRANULARITY, to the smallest size class that fits them. */
+		struct SizeClassLookup
+		{
+			constexpr SizeClassLookup()
+				:classes()
+			{
+				UINT32 sizeClass = 0;
+				for(UINT32 i = 0; i < NUM_SIZE_CLASS_LOOKUP_ENTRIES; i++)
+				{
+					while(SIZE_CLASSES[sizeClass] < i * SIZE_CLASS_GRANULARITY)
+						sizeClass++;
+
+					classes[i] = (UINT8)sizeClass;
+				}
+			}
+
+			UINT8 classes[NUM_SIZE_CLASS_LOOKUP_ENTRIES];
+		};
+
+		constexpr SizeClassLookup gSizeClassLookup;
+
+		/** Returns the smallest size class able to hold @p bytes. Size must not be larger than MAX_SMALL_SIZE. */
+		UINT32 getSizeClass(size_t bytes)
+		{
+			return gSizeClassLookup.classes[(bytes + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY];
+		}
+
+		/** Returns the number of blocks a thread cache fetches from, or returns to, the central list at once. */
+		UINT32 getBatchSize(UINT32 sizeClass)
+		{
+			return std::min(std::max(BATCH_BYTES / SIZE_CLASSES[sizeClass], MIN_BATCH_SIZE), MAX_BATCH_SIZE);
+		}
+
+		/** Free blocks are linked through their first bytes. */
+		void*& nextBlock(void* block)
+		{
+			return *(void**)block;
+		}
+
+		/** Lock that can be constant initialized, so it's usable by allocations made during static initialization. */
+		class AllocLock
+		{
+		public:
+			void lock()
+			{
+				while(mLocked.exchange(true, std::memory_order_acquire))
+				{
+					while(mLocked.load(std::memory_order_relaxed))
+						std::this_thread::yield();
+				}
+			}
+
+			void unlock()
+			{
+				mLocked.store(false, std::memory_order_release);
+			}
+
+		private:
+			std::atomic<bool> mLocked { false };
+		};
+
+		typedef std::lock_guard<AllocLock> AllocLockGuard;
+
+		/** Header stored at the start of every span. */
+		struct SpanHeader
+		{
+			SpanHeader* prev;
+			SpanHeader* next;
+
+			/** Blocks that were returned to this span. */
+			void* freeList;
+
+			UINT32 sizeClass;
+			UINT32 numBlocks;
+
+			/** Number of blocks handed out from this span and not yet returned to it. */
+			UINT32 numAllocated;
+
+			/** Number of blocks ever handed out. Memory past the last carved block was never touched. */
+			UINT32 numCarved;
+
+			/** True if the span is part of its size class' list of spans with free blocks. */
+			bool inCentralList;
+		};
+
+		static_assert(sizeof(SpanHeader) <= SPAN_HEADER_SIZE, "Span header doesn't fit into the reserved space.");
+
+		/** Intrusive doubly linked list of spans. */
+		struct SpanList
+		{
+			void pushFront(SpanHeader* span)
+			{
+				span->prev = nullptr;
+				span->next = first;
+
+				if(first)
+					first->prev = span;
+				else
+					last = span;
+
+				first = span;
+				count++;
+			}
+
+			void remove(SpanHeader* span)
+			{
+				if(span->prev)
+					span->prev->next = span->next;
+				else
+					first = span->next;
+
+				if(span->next)
+					span->next->prev = span->prev;
+				else
+					last = span->prev;
+
+				count--;
+			}
+
+			SpanHeader* popFront()
+			{
+				SpanHeader* span = first;
+				if(span)
+					remove(span);
+
+				return span;
+			}
+
+			SpanHeader* popBack()
+			{
+				SpanHeader* span = last;
+				if(span)
+					remove(span);
+
+				return span;
+			}
+
+			SpanHeader* first = nullptr;
+			SpanHeader* last = nullptr;
+			size_t count = 0;
+		};
+
+		/** Spans of a single size class that have at least one free block. */
+		struct CentralFreeList
+		{
+			AllocLock lock;
+			SpanList spans;
+		};
+
+		/** Spans that aren't assigned to any size class. */
+		struct PageHeap
+		{
+			AllocLock lock;
+			SpanList freeSpans;
+			SpanList decommittedSpans;
+			size_t numUsedSpans = 0;
+			size_t reservedBytes = 0;
+			size_t maxRetainedBytes = DEFAULT_MAX_RETAINED_BYTES;
+			MemoryReleasePolicy releasePolicy = (MemoryReleasePolicy)BS_ALLOCATOR_RELEASE_POLICY;
+		};
+
+		CentralFreeList gCentralFreeLists[NUM_SIZE_CLASSES];
+		PageHeap gPageHeap;
+
+		/************************************************************************/
+		/* 								OS MEMORY		                      	*/
+		/************************************************************************/
+
+		size_t getOSPageSize()
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+
+			return (size_t)info.dwPageSize;
+#else
+			return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+		}
+
+		/** Maps @p size bytes of zeroed, read-write memory aligned to @p alignment. Returns null on failure. */
+		void* osMap(size_t size, size_t alignment)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+			if(ptr && ((uintptr_t)ptr & (alignment - 1)) != 0)
+			{
+				VirtualFree(ptr, 0, MEM_RELEASE);
+				return nullptr;
+			}
+
+			return ptr;
+#else
+			// Over-allocate so an aligned range is guaranteed to exist, then trim the excess on both sides
+			const size_t mapSize = size + alignment;
+			void* mapping = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(mapping == MAP_FAILED)
+				return nullptr;
+
+			const uintptr_t start = (uintptr_t)mapping;
+			const uintptr_t alignedStart = (start + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+			if(alignedStart != start)
+				munmap(mapping, alignedStart - start);
+
+			const size_t tailSize = (start + mapSize) - (alignedStart + size);
+			if(tailSize > 0)
+				munmap((void*)(alignedStart + size), tailSize);
+
+			return (void*)alignedStart;
+#endif
+		}
+
+		/** Returns a range previously mapped with osMap() to the OS. */
+		void osUnmap(void* ptr, size_t size)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+			munmap(ptr, size);
+#endif
+		}
+
+		/** Releases physical memory backing the range, while keeping the address range reserved. */
+		void osDecommit(void* ptr, size_t size)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			VirtualFree(ptr, size, MEM_DECOMMIT);
+#elif BS_PLATFORM == BS_PLATFORM_OSX
+			madvise(ptr, size, MADV_FREE);
+#else
+			madvise(ptr, size, MADV_DONTNEED);
+#endif
+		}
+
+		/** Makes a range previously decommitted with osDecommit() usable again. */
+		void osRecommit(void* ptr, size_t size)
+		{
+#if BS_PLATFORM == BS_PLATFORM_WIN32
+			VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE);
+#else
+			// Pages are faulted back in on first access
+#endif
+		}
+
+		/************************************************************************/
+		/* 								PAGE MAP		                      	*/
+		/************************************************************************/
+
+		// Two level bitmap with a bit for every span sized block of the address space, marking the blocks that are spans
+		// owned by the allocator. This allows free() to recognize memory that was forwarded to the system allocator.
+		constexpr UINT32 ADDRESS_BITS = sizeof(void*) == 8 ? 48 : 32;
+		constexpr UINT32 SPAN_SHIFT = 16;
+		constexpr UINT32 PAGE_MAP_LEAF_BITS = 16;
+		constexpr size_t PAGE_MAP_LEAF_SIZE = (size_t)1 << PAGE_MAP_LEAF_BITS;
+		constexpr size_t PAGE_MAP_ROOT_SIZE = (size_t)1 << (ADDRESS_BITS - SPAN_SHIFT - PAGE_MAP_LEAF_BITS);
+
+		static_assert(((size_t)1 << SPAN_SHIFT) == ThreadCachingAlloc::SPAN_SIZE, "Span shift doesn't match span size.");
+
+		struct PageMapLeaf
+		{
+			std::atomic<UINT64> bits[PAGE_MAP_LEAF_SIZE / 64];
+		};
+
+		std::atomic<PageMapLeaf*> gPageMap[PAGE_MAP_ROOT_SIZE];
+
+		/** Returns true if the address is within a span owned by the allocator. */
+		bool isOwned(const void* ptr)
+		{
+			const UINT64 address = (UINT64)(uintptr_t)ptr;
+			if((address >> ADDRESS_BITS) != 0)
+				return false;
+
+			const UINT64 key = address >> SPAN_SHIFT;
+			const PageMapLeaf* leaf = gPageMap[key >> PAGE_MAP_LEAF_BITS].load(std::memory_order_acquire);
+			if(leaf == nullptr)
+				return false;
+
+			const UINT64 leafIdx = key & (PAGE_MAP_LEAF_SIZE - 1);
+			return (leaf->bits[leafIdx / 64].load(std::memory_order_relaxed) & (1ULL << (leafIdx % 64))) != 0;
+		}
+
+		/** Marks the span at the provided address as owned or not owned by the allocator. Returns false on failure. */
+		bool setOwned(const void* span, bool owned)
+		{
+			const UINT64 address = (UINT64)(uintptr_t)span;
+			if((address >> ADDRESS_BITS) != 0)
+				return false;
+
+			const UINT64 key = address >> SPAN_SHIFT;
+			std::atomic<PageMapLeaf*>& root = gPageMap[key >> PAGE_MAP_LEAF_BITS];
+
+			PageMapLeaf* leaf = root.load(std::memory_order_acquire);
+			if(leaf == nullptr)
+			{
+				PageMapLeaf* newLeaf = (PageMapLeaf*)osMap(sizeof(PageMapLeaf), getOSPageSize());
+				if(newLeaf == nullptr)
+					return false;
+
+				if(root.compare_exchange_strong(leaf, newLeaf, std::memory_order_acq_rel))
+					leaf = newLeaf;
+				else
+					osUnmap(newLeaf, sizeof(PageMapLeaf));
+			}
+
+			const UINT64 leafIdx = key & (PAGE_MAP_LEAF_SIZE - 1);
+			const UINT64 mask = 1ULL << (leafIdx % 64);
+
+			if(owned)
+				leaf->bits[leafIdx / 64].fetch_or(mask, std::memory_order_release);
+			else
+				leaf->bits[leafIdx / 64].fetch_and(~mask, std::memory_order_release);
+
+			return true;
+		}
+
+		/** Returns the header of the span the block belongs to. */
+		SpanHeader* getSpan(const void* block)
+		{
+			return (SpanHeader*)((uintptr_t)block & ~(uintptr_t)(ThreadCachingAlloc::SPAN_SIZE - 1));
+		}
+
+		/************************************************************************/
+		/* 								PAGE HEAP		                      	*/
+		/************************************************************************/
+
+		/** Returns the number of bytes at the start of a span that must stay committed while the span is decommitted. */
+		size_t getSpanHeaderPagesSize()
+		{
+			static const size_t size = std::max(getOSPageSize(), (size_t)SPAN_HEADER_SIZE);
+			return size;
+		}
+
+		/** Returns a span to the OS. Page heap lock must be held. */
+		void releaseSpanToOS(SpanHeader* span)
+		{
+			setOwned(span, false);
+			osUnmap(span, ThreadCachingAlloc::SPAN_SIZE);
+
+			gPageHeap.reservedBytes -= ThreadCachingAlloc::SPAN_SIZE;
+		}
+
+		/**
+		 * Applies the release policy to free spans, until no more than @p maxRetainedBytes of memory is retained. Page heap
+		 * lock must be held.
+		 */
+		void trimFreeSpans(MemoryReleasePolicy policy, size_t maxRetainedBytes)
+		{
+			if(policy == MemoryReleasePolicy::Retain)
+				return;
+
+			const size_t headerPagesSize = getSpanHeaderPagesSize();
+			if(policy == MemoryReleasePolicy::Decommit && headerPagesSize >= ThreadCachingAlloc::SPAN_SIZE)
+				return;
+
+			// Oldest spans are at the back of the list, trim them first
+			while(gPageHeap.freeSpans.count * ThreadCachingAlloc::SPAN_SIZE > maxRetainedBytes)
+			{
+				SpanHeader* span = gPageHeap.freeSpans.popBack();
+
+				if(policy == MemoryReleasePolicy::Decommit)
+				{
+					osDecommit((UINT8*)span + headerPagesSize, ThreadCachingAlloc::SPAN_SIZE - headerPagesSize);
+					gPageHeap.decommittedSpans.pushFront(span);
+				}
+				else
+					releaseSpanToOS(span);
+			}
+
+			// Spans decommitted under a previous policy hold no physical memory, but still count against the address space
+			if(policy == MemoryReleasePolicy::Release)
+			{
+				while(SpanHeader* span = gPageHeap.decommittedSpans.popFront())
+					releaseSpanToOS(span);
+			}
+		}
+
+		/** Finds or maps a span not assigned to any size class. Returns null if out of memory. */
+		SpanHeader* allocateSpan()
+		{
+			AllocLockGuard lock(gPageHeap.lock);
+
+			SpanHeader* span = gPageHeap.freeSpans.popFront();
+			if(span == nullptr)
+			{
+				span = gPageHeap.decommittedSpans.popFront();
+				if(span != nullptr)
+				{
+					const size_t headerPagesSize = getSpanHeaderPagesSize();
+					osRecommit((UINT8*)span + headerPagesSize, ThreadCachingAlloc::SPAN_SIZE - headerPagesSize);
+				}
+			}
+
+			if(span == nullptr)
+			{
+				const size_t mappingSize = SPANS_PER_MAPPING * ThreadCachingAlloc::SPAN_SIZE;
+
+				UINT8* mapping = (UINT8*)osMap(mappingSize, ThreadCachingAlloc::SPAN_SIZE);
+				if(mapping == nullptr)
+					return nullptr;
+
+				for(UINT32 i = 0; i < SPANS_PER_MAPPING; i++)
+				{
+					UINT8* spanAddress = mapping + i * ThreadCachingAlloc::SPAN_SIZE;
+					if(!setOwned(spanAddress, true))
+					{
+						// Address can't be tracked, give up on the entire mapping
+						for(UINT32 j = 0; j < i; j++)
+							setOwned(mapping + j * ThreadCachingAlloc::SPAN_SIZE, false);
+
+						osUnmap(mapping, mappingSize);
+						return nullptr;
+					}
+				}
+
+				gPageHeap.reservedBytes += mappingSize;
+
+				// Keep the first span, the rest goes to the back of the free list so they're only touched once needed
+				for(UINT32 i = 1; i < SPANS_PER_MAPPING; i++)
+				{
+					SpanHeader* freeSpan = (SpanHeader*)(mapping + i * ThreadCachingAlloc::SPAN_SIZE);
+
+					if(gPageHeap.freeSpans.last)
+					{
+						freeSpan->prev = gPageHeap.freeSpans.last;
+						freeSpan->next = nullptr;
+						gPageHeap.freeSpans.last->next = freeSpan;
+						gPageHeap.freeSpans.last = freeSpan;
+						gPageHeap.freeSpans.count++;
+					}
+					else
+						gPageHeap.freeSpans.pushFront(freeSpan);
+				}
+
+				span = (SpanHeader*)mapping;
+			}
+
+			gPageHeap.numUsedSpans++;
+			return span;
+		}
+
+		/** Returns a span that no longer holds any allocations to the page heap. */
+		void freeSpan(SpanHeader* span)
+		{
+			AllocLockGuard lock(gPageHeap.lock);
+
+			gPageHeap.numUsedSpans--;
+			gPageHeap.freeSpans.pushFront(span);
+
+			trimFreeSpans(gPageHeap.releasePolicy, gPageHeap.maxRetainedBytes);
+		}
+
+		/************************************************************************/
+		/* 							CENTRAL FREE LISTS		                   	*/
+		/************************************************************************/
+
+		/**
+		 * Removes up to @p count blocks of the specified size class from the central list, and outputs them as a linked
+		 * list in @p head. Returns the number of blocks removed, which is only less than requested when out of memory.
+		 */
+		UINT32 fetchFromCentral(UINT32 sizeClass, UINT32 count, void*& head)
+		{
+			CentralFreeList& central = gCentralFreeLists[sizeClass];
+			const UINT32 blockSize = SIZE_CLASSES[sizeClass];
+
+			AllocLockGuard lock(central.lock);
+
+			head = nullptr;
+			UINT32 numFetched = 0;
+			while(numFetched < count)
+			{
+				SpanHeader* span = central.spans.first;
+				if(span == nullptr)
+				{
+					span = allocateSpan();
+					if(span == nullptr)
+						break;
+
+					span->freeList = nullptr;
+					span->sizeClass = sizeClass;
+					span->numBlocks = (UINT32)((ThreadCachingAlloc::SPAN_SIZE - SPAN_HEADER_SIZE) / blockSize);
+					span->numAllocated = 0;
+					span->numCarved = 0;
+					span->inCentralList = true;
+
+					central.spans.pushFront(span);
+				}
+
+				while(numFetched < count)
+				{
+					void* block;
+					if(span->freeList != nullptr)
+					{
+						block = span->freeList;
+						span->freeList = nextBlock(block);
+					}
+					else if(span->numCarved < span->numBlocks)
+					{
+						block = (UINT8*)span + SPAN_HEADER_SIZE + span->numCarved * blockSize;
+						span->numCarved++;
+					}
+					else
+						break;
+
+					span->numAllocated++;
+
+					nextBlock(block) = head;
+					head = block;
+					numFetched++;
+				}
+
+				if(span->numAllocated == span->numBlocks)
+				{
+					central.spans.remove(span);
+					span->inCentralList = false;
+				}
+			}
+
+			return numFetched;
+		}
+
+		/** Returns a linked list of blocks of the specified size class back to their spans. */
+		void releaseToCentral(UINT32 sizeClass, void* head)
+		{
+			CentralFreeList& central = gCentralFreeLists[sizeClass];
+			AllocLockGuard lock(central.lock);
+
+			while(head != nullptr)
+			{
+				void* block = head;
+				head = nextBlock(block);
+
+				SpanHeader* span = getSpan(block);
+				nextBlock(block) = span->freeList;
+				span->freeList = block;
+				span->numAllocated--;
+
+				if(span->numAllocated == 0)
+				{
+					if(span->inCentralList)
+						central.spans.remove(span);
+
+					span->inCentralList = false;
+					freeSpan(span);
+				}
+				else if(!span->inCentralList)
+				{
+					central.spans.pushFront(span);
+					span->inCentralList = true;
+				}
+			}
+		}
+
+		/************************************************************************/
+		/* 								THREAD CACHE		                   	*/
+		/************************************************************************/
+
+		struct ThreadCacheList
+		{
+			void* head;
+			UINT32 count;
+		};
+
+		struct ThreadCache
+		{
+			ThreadCacheList lists[NUM_SIZE_CLASSES];
+		};
+
+		/** Returns all blocks in the cache back to the central lists. */
+		void flushCache(ThreadCache* cache)
+		{
+			for(UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+			{
+				ThreadCacheList& list = cache->lists[i];
+				if(list.head == nullptr)
+					continue;
+
+				releaseToCentral(i, list.head);
+
+				list.head = nullptr;
+				list.count = 0;
+			}
+		}
+
+		// Raw thread local pointer keeps the fast path free of thread_local initialization checks
+		BS_THREADLOCAL ThreadCache* tThreadCache = nullptr;
+		BS_THREADLOCAL bool tThreadCacheDestroyed = false;
+
+		/** Flushes and destroys the thread's cache when the thread exits. */
+		struct ThreadCacheOwner
+		{
+			~ThreadCacheOwner()
+			{
+				if(cache == nullptr)
+					return;
+
+				flushCache(cache);
+				::free(cache);
+
+				// Any allocations made by later thread exit handlers go straight to the central lists
+				tThreadCache = nullptr;
+				tThreadCacheDestroyed = true;
+			}
+
+			ThreadCache* cache = nullptr;
+		};
+
+		thread_local ThreadCacheOwner tThreadCacheOwner;
+
+		/** Returns the calling thread's cache, creating it if needed. Returns null if the thread is shutting down. */
+		ThreadCache* getThreadCache()
+		{
+			ThreadCache* cache = tThreadCache;
+			if(cache != nullptr || tThreadCacheDestroyed)
+				return cache;
+
+			cache = (ThreadCache*)::calloc(1, sizeof(ThreadCache));
+			tThreadCacheOwner.cache = cache;
+			tThreadCache = cache;
+
+			return cache;
+		}
+
+		/** Allocates a block of the specified size class. Returns null if out of memory. */
+		void* allocateBlock(UINT32 sizeClass)
+		{
+			ThreadCache* cache = getThreadCache();
+			if(cache == nullptr)
+			{
+				void* block;
+				fetchFromCentral(sizeClass, 1, block);
+
+				return block;
+			}
+
+			ThreadCacheList& list = cache->lists[sizeClass];
+			if(list.head == nullptr)
+			{
+				list.count = fetchFromCentral(sizeClass, getBatchSize(sizeClass), list.head);
+				if(list.head == nullptr)
+					return nullptr;
+			}
+
+			void* block = list.head;
+			list.head = nextBlock(block);
+			list.count--;
+
+			return block;
+		}
+
+		/** Frees a block owned by the allocator. */
+		void freeBlock(void* block)
+		{
+			const UINT32 sizeClass = getSpan(block)->sizeClass;
+
+			ThreadCache* cache = getThreadCache();
+			if(cache == nullptr)
+			{
+				nextBlock(block) = nullptr;
+				releaseToCentral(sizeClass, block);
+
+				return;
+			}
+
+			ThreadCacheList& list = cache->lists[sizeClass];
+			nextBlock(block) = list.head;
+			list.head = block;
+			list.count++;
+
+			// Keep at most two batches cached, hand one back to the central list once that is exceeded
+			const UINT32 batchSize = getBatchSize(sizeClass);
+			if(list.count > batchSize * 2)
+			{
+				void* batchHead = list.head;
+				void* batchTail = batchHead;
+				for(UINT32 i = 1; i < batchSize; i++)
+					batchTail = nextBlock(batchTail);
+
+				list.head = nextBlock(batchTail);
+				list.count -= batchSize;
+
+				nextBlock(batchTail) = nullptr;
+				releaseToCentral(sizeClass, batchHead);
+			}
+		}
+
+		/************************************************************************/
+		/* 							LARGE ALLOCATIONS		                   	*/
+		/************************************************************************/
+
+		/** Value stored in every LargeAllocHeader, used for catching frees of memory not allocated by this allocator. */
+		constexpr size_t LARGE_ALLOC_MAGIC = 0xB5A110C8;
+
+		/** Header stored in front of allocations forwarded to the system allocator. */
+		struct LargeAllocHeader
+		{
+			void* original;
+			size_t size;
+			size_t magic;
+		};
+
+		/** Returns the header of an allocation made by allocateLarge(). */
+		const LargeAllocHeader* getLargeAllocHeader(const void* ptr)
+		{
+			const LargeAllocHeader* header = (const LargeAllocHeader*)ptr - 1;
+
+			// Any pointer not within a span is assumed to be a large allocation, so memory allocated elsewhere (e.g. with
+			// libc malloc) ends up here
+			assert(header->magic == LARGE_ALLOC_MAGIC && "Memory was not allocated by ThreadCachingAlloc.");
+			return header;
+		}
+
+		/** Allocates memory using the system allocator. Alignment must be a power of two, and at least 16 bytes. */
+		void* allocateLarge(size_t bytes, size_t alignment)
+		{
+			void* original = ::malloc(bytes + sizeof(LargeAllocHeader) + alignment - 1);
+			if(original == nullptr)
+				return nullptr;
+
+			const uintptr_t data = ((uintptr_t)original + sizeof(LargeAllocHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+			LargeAllocHeader* header = (LargeAllocHeader*)data - 1;
+			header->original = original;
+			header->size = bytes;
+			header->magic = LARGE_ALLOC_MAGIC;
+
+			return (void*)data;
+		}
+
+		/** Frees memory allocated by allocateLarge(). */
+		void freeLarge(void* ptr)
+		{
+			::free(getLargeAllocHeader(ptr)->original);
+		}
+	}
+
+	void* ThreadCachingAlloc::allocate(size_t bytes)
+	{
+		if(bytes <= MAX_SMALL_SIZE)
+		{
+			void* block = allocateBlock(getSizeClass(bytes));
+			if(block != nullptr)
+				return block;
+		}
+
+		return allocateLarge(bytes, SIZE_CLASS_GRANULARITY);
+	}
+
+	void* ThreadCachingAlloc::allocateAligned(size_t bytes, size_t alignment)
+	{
+		if(alignment <= SIZE_CLASS_GRANULARITY)
+			return allocate(bytes);
+
+		if(alignment <= MAX_SMALL_ALIGNMENT)
+		{
+			// Blocks of a size class that is a multiple of the alignment are always aligned, since spans and their first
+			// block are aligned to MAX_SMALL_ALIGNMENT
+			const size_t alignedBytes = (bytes + alignment - 1) & ~(alignment - 1);
+			if(alignedBytes <= MAX_SMALL_SIZE)
+			{
+				UINT32 sizeClass = getSizeClass(alignedBytes);
+				while((SIZE_CLASSES[sizeClass] & (alignment - 1)) != 0)
+					sizeClass++;
+
+				void* block = allocateBlock(sizeClass);
+				if(block != nullptr)
+					return block;
+			}
+		}
+
+		return allocateLarge(bytes, alignment);
+	}
+
+	void ThreadCachingAlloc::free(void* ptr)
+	{
+		if(ptr == nullptr)
+			return;
+
+		if(isOwned(ptr))
+			freeBlock(ptr);
+		else
+			freeLarge(ptr);
+	}
+
+	void ThreadCachingAlloc::freeAligned(void* ptr)
+	{
+		free(ptr);
+	}
+
+	size_t ThreadCachingAlloc::getAllocationSize(const void* ptr)
+	{
+		if(ptr == nullptr)
+			return 0;
+
+		if(isOwned(ptr))
+			return SIZE_CLASSES[getSpan(ptr)->sizeClass];
+
+		return getLargeAllocHeader(ptr)->size;
+	}
+
+	void ThreadCachingAlloc::flushThreadCache()
+	{
+		ThreadCache* cache = tThreadCache;
+		if(cache != nullptr)
+			flushCache(cache);
+	}
+
+	void ThreadCachingAlloc::releaseFreeMemory()
+	{
+		flushThreadCache();
+
+		AllocLockGuard lock(gPageHeap.lock);
+		while(SpanHeader* span = gPageHeap.freeSpans.popFront())
+			releaseSpanToOS(span);
+
+		while(SpanHeader* span = gPageHeap.decommittedSpans.popFront())
+			releaseSpanToOS(span);
+	}
+
+	void ThreadCachingAlloc::setReleasePolicy(MemoryReleasePolicy policy, size_t maxRetainedBytes)
+	{
+		AllocLockGuard lock(gPageHeap.lock);
+
+		gPageHeap.releasePolicy = policy;
+		gPageHeap.maxRetainedBytes = maxRetainedBytes;
+
+		trimFreeSpans(policy, maxRetainedBytes);
+	}
+
+	ThreadCachingAllocStats ThreadCachingAlloc::getStats()
+	{
+		AllocLockGuard lock(gPageHeap.lock);
+
+		ThreadCachingAllocStats stats;
+		stats.numUsedSpans = gPageHeap.numUsedSpans;
+		stats.numFreeSpans = gPageHeap.freeSpans.count;
+		stats.numDecommittedSpans = gPageHeap.decommittedSpans.count;
+		stats.reservedBytes = gPageHeap.reservedBytes;
+
+		return stats;
+	}
+}
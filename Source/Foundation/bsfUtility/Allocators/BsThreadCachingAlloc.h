@@ -0,0 +1,117 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include <cstddef>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Determines what happens to spans that no longer hold any allocations, once the amount of free memory retained by
+	 * ThreadCachingAlloc exceeds its limit.
+	 */
+	enum class MemoryReleasePolicy
+	{
+		/** Free spans are kept around indefinitely, for fast re-use. */
+		Retain,
+		/**
+		 * Physical memory of free spans is returned to the OS, but their address range is kept reserved so they can be
+		 * re-used without a new mapping.
+		 */
+		Decommit,
+		/** Free spans are returned to the OS in their entirety. */
+		Release
+	};
+
+	/** Information about memory currently managed by ThreadCachingAlloc. */
+	struct ThreadCachingAllocStats
+	{
+		/** Number of spans that are assigned to a size class and hold at least one allocation. */
+		size_t numUsedSpans = 0;
+
+		/** Number of spans that hold no allocations, but are still backed by physical memory. */
+		size_t numFreeSpans = 0;
+
+		/** Number of spans that hold no allocations and whose physical memory has been returned to the OS. */
+		size_t numDecommittedSpans = 0;
+
+		/** Total number of bytes of address space currently mapped from the OS, including decommitted spans. */
+		size_t reservedBytes = 0;
+	};
+
+	/**
+	 * General purpose allocator optimized for small allocations made from many threads.
+	 *
+	 * Allocations up to MAX_SMALL_SIZE bytes are rounded up to one of a fixed set of size classes. Each thread keeps a
+	 * cache of free blocks per size class, so most allocations and frees never need to take a lock. Caches are refilled
+	 * from, and overflow back into, central per-class lists of spans. A span is a SPAN_SIZE aligned block of memory
+	 * mapped from the OS, split into blocks of a single size class. Spans that become completely free are returned to a
+	 * shared page heap, which either retains them, decommits them or releases them to the OS depending on the active
+	 * MemoryReleasePolicy. Larger allocations are forwarded to the system allocator, with a small header that records
+	 * their size.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ThreadCachingAlloc
+	{
+	public:
+		/** Size of a single span, in bytes. Spans are always aligned to their size. */
+		static constexpr size_t SPAN_SIZE = 64 * 1024;
+
+		/** Largest allocation size handled by the size classes. Larger allocations are forwarded to the system. */
+		static constexpr size_t MAX_SMALL_SIZE = 4096;
+
+		/** Largest alignment that can be satisfied by the size classes. Larger alignments are forwarded to the system. */
+		static constexpr size_t MAX_SMALL_ALIGNMENT = 64;
+
+		/** Allocates @p bytes bytes. Returned memory is aligned to at least 16 bytes. */
+		static void* allocate(size_t bytes);
+
+		/** Allocates @p bytes bytes aligned to @p alignment. Alignment must be a power of two. */
+		static void* allocateAligned(size_t bytes, size_t alignment);
+
+		/** Frees memory previously allocated with allocate(). */
+		static void free(void* ptr);
+
+		/** Frees memory previously allocated with allocateAligned(). */
+		static void freeAligned(void* ptr);
+
+		/**
+		 * Returns the number of bytes reserved for an allocation made by this allocator. This is the size of its size
+		 * class for small allocations, or the requested size for larger ones.
+		 */
+		static size_t getAllocationSize(const void* ptr);
+
+		/**
+		 * Returns all blocks cached by the calling thread back to the central lists, making them available to other
+		 * threads. This is done automatically when a thread exits.
+		 */
+		static void flushThreadCache();
+
+		/**
+		 * Flushes the calling thread's cache and returns all free spans to the OS, regardless of the active release
+		 * policy. Useful after large amounts of memory were freed, e.g. when unloading a level.
+		 */
+		static void releaseFreeMemory();
+
+		/**
+		 * Changes what happens to free spans once more than @p maxRetainedBytes of free memory is retained by the
+		 * allocator. The default policy is set by the build system.
+		 */
+		static void setReleasePolicy(MemoryReleasePolicy policy, size_t maxRetainedBytes);
+
+		/** Returns information about the memory currently managed by the allocator. */
+		static ThreadCachingAllocStats getStats();
+	};
+
+	/** @} */
+	/** @} */
+}
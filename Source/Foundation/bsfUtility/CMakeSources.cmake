@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsJobGraph.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -75,6 +76,7 @@ set(BS_UTILITY_SRC_THREADING
 	"bsfUtility/Threading/BsAsyncOp.cpp"
 	"bsfUtility/Threading/BsTaskScheduler.cpp"
 	"bsfUtility/Threading/BsThreadPool.cpp"
+	"bsfUtility/Threading/BsJobGraph.cpp"
 )
 
 set(BS_UTILITY_INC_UTILITY
@@ -93,6 +95,7 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsTimer.h"
 	"bsfUtility/Utility/BsUtil.h"
 	"bsfUtility/Utility/BsFlags.h"
+	"bsfUtility/Utility/BsSmallVector.h"
 	"bsfUtility/Utility/BsCompression.h"
 	"bsfUtility/Utility/BsTriangulation.h"
 	"bsfUtility/Utility/BsNonCopyable.h"
@@ -100,12 +103,14 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsOctree.h"
 	"bsfUtility/Utility/BsDataBlob.h"
 	"bsfUtility/Utility/BsLookupTable.h"
+	"bsfUtility/Utility/BsRadixSort.h"
 )
 
 set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -135,6 +140,7 @@ set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsGroupAlloc.h"
 	"bsfUtility/Allocators/BsFreeAlloc.h"
 	"bsfUtility/Allocators/BsPoolAlloc.h"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.h"
 )
 
 set(BS_UTILITY_INC_THIRDPARTY
@@ -165,6 +171,8 @@ set(BS_UTILITY_SRC_MATH
 	"bsfUtility/Math/BsVector4.cpp"
 	"bsfUtility/Math/BsBounds.cpp"
 	"bsfUtility/Math/BsConvexVolume.cpp"
+	"bsfUtility/Math/BsCullingBounds.cpp"
+	"bsfUtility/Math/BsOcclusionBuffer.cpp"
 	"bsfUtility/Math/BsTorus.cpp"
 	"bsfUtility/Math/BsRect3.cpp"
 	"bsfUtility/Math/BsRect2.cpp"
@@ -214,6 +222,8 @@ set(BS_UTILITY_INC_MATH
 	"bsfUtility/Math/BsVector4I.h"
 	"bsfUtility/Math/BsBounds.h"
 	"bsfUtility/Math/BsConvexVolume.h"
+	"bsfUtility/Math/BsCullingBounds.h"
+	"bsfUtility/Math/BsOcclusionBuffer.h"
 	"bsfUtility/Math/BsTorus.h"
 	"bsfUtility/Math/BsLineSegment3.h"
 	"bsfUtility/Math/BsRect3.h"
@@ -10,13 +10,11 @@
 namespace bs
 {
 	ConvexVolume::ConvexVolume(const Vector<Plane>& planes)
-		:mPlanes(planes)
+		:mPlanes(planes.begin(), planes.end())
 	{ }
 
 	ConvexVolume::ConvexVolume(const Matrix4& projectionMatrix, bool useNearPlane)
 	{
-		mPlanes.reserve(6);
-
 		const Matrix4& proj = projectionMatrix;
 
 		// Left
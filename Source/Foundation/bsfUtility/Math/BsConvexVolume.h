@@ -26,9 +26,20 @@ namespace bs
 	class BS_UTILITY_EXPORT ConvexVolume
 	{
 	public:
+		/** 
+		 * Number of planes stored without a heap allocation. Large enough for a frustum, or a frustum extruded along a
+		 * direction (e.g. a light volume).
+		 */
+		static constexpr UINT32 NUM_INLINE_PLANES = 9;
+
 		ConvexVolume() = default;
 		ConvexVolume(const Vector<Plane>& planes);
 
+		template<UINT32 N>
+		ConvexVolume(const SmallVector<Plane, N>& planes)
+			:mPlanes(planes.begin(), planes.end())
+		{ }
+
 		/** Creates frustum planes from the provided projection matrix. */
 		ConvexVolume(const Matrix4& projectionMatrix, bool useNearPlane = true);
 
@@ -54,13 +65,13 @@ namespace bs
 		bool contains(const Vector3& p, float expand = 0.0f) const;
 
 		/** Returns the internal set of planes that represent the volume. */
-		Vector<Plane> getPlanes() const { return mPlanes; }
+		const SmallVector<Plane, NUM_INLINE_PLANES>& getPlanes() const { return mPlanes; }
 
 		/** Returns the specified plane that represents the volume. */
 		const Plane& getPlane(FrustumPlane whichPlane) const;
 
 	private:
-		Vector<Plane> mPlanes;
+		SmallVector<Plane, NUM_INLINE_PLANES> mPlanes;
 	};
 
 	/** @} */
@@ -0,0 +1,377 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Math/BsCullingBounds.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	namespace
+	{
+		/** Number of objects tested by a single SIMD operation. */
+		constexpr UINT32 SIMD_WIDTH = 4;
+
+		/** Returns a vector with @p value in all lanes. */
+		simd::float32x4 splat(float value)
+		{
+			return simd::load_splat<simd::float32x4>(&value);
+		}
+
+		/** Returns a mask with all lanes set. */
+		simd::mask_float32x4 allLanes()
+		{
+			const simd::float32x4 zero = simd::make_zero();
+			return simd::cmp_eq(zero, zero);
+		}
+
+		/** Plane of a convex volume, with each component replicated across all SIMD lanes. */
+		struct SIMDPlane
+		{
+			simd::float32x4 normalX;
+			simd::float32x4 normalY;
+			simd::float32x4 normalZ;
+			simd::float32x4 absNormalX;
+			simd::float32x4 absNormalY;
+			simd::float32x4 absNormalZ;
+			simd::float32x4 d;
+		};
+
+		/** Converts the planes of a convex volume into a form usable by the SIMD culling loops. */
+		void getSIMDPlanes(const ConvexVolume& volume, SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES>& output)
+		{
+			const auto& planes = volume.getPlanes();
+			output.resize(planes.size());
+
+			for(UINT32 i = 0; i < (UINT32)planes.size(); i++)
+			{
+				const Plane& plane = planes[i];
+
+				output[i].normalX = splat(plane.normal.x);
+				output[i].normalY = splat(plane.normal.y);
+				output[i].normalZ = splat(plane.normal.z);
+				output[i].absNormalX = splat(Math::abs(plane.normal.x));
+				output[i].absNormalY = splat(Math::abs(plane.normal.y));
+				output[i].absNormalZ = splat(Math::abs(plane.normal.z));
+				output[i].d = splat(plane.d);
+			}
+		}
+
+		/**
+		 * Tests a group of spheres against all planes of a volume. Returns a mask with lanes set for spheres that
+		 * intersect the volume.
+		 */
+		simd::mask_float32x4 testSpheres(const float* x, const float* y, const float* z, const float* radius,
+			const SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES>& planes)
+		{
+			const simd::float32x4 sphereX = simd::load_u<simd::float32x4>(x);
+			const simd::float32x4 sphereY = simd::load_u<simd::float32x4>(y);
+			const simd::float32x4 sphereZ = simd::load_u<simd::float32x4>(z);
+			const simd::float32x4 negRadius = simd::neg(simd::load_u<simd::float32x4>(radius));
+
+			simd::mask_float32x4 visible = allLanes();
+			for(auto& plane : planes)
+			{
+				simd::float32x4 dist = simd::mul(sphereX, plane.normalX);
+				dist = simd::add(dist, simd::mul(sphereY, plane.normalY));
+				dist = simd::add(dist, simd::mul(sphereZ, plane.normalZ));
+				dist = simd::sub(dist, plane.d);
+
+				visible = simd::bit_and(visible, simd::cmp_ge(dist, negRadius));
+			}
+
+			return visible;
+		}
+
+		/**
+		 * Tests a group of boxes against all planes of a volume. Returns @p visible with lanes cleared for boxes that
+		 * don't intersect the volume.
+		 */
+		simd::mask_float32x4 testBoxes(const float* x, const float* y, const float* z, const float* extentX,
+			const float* extentY, const float* extentZ,
+			const SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES>& planes, simd::mask_float32x4 visible)
+		{
+			const simd::float32x4 boxX = simd::load_u<simd::float32x4>(x);
+			const simd::float32x4 boxY = simd::load_u<simd::float32x4>(y);
+			const simd::float32x4 boxZ = simd::load_u<simd::float32x4>(z);
+			const simd::float32x4 boxExtentX = simd::load_u<simd::float32x4>(extentX);
+			const simd::float32x4 boxExtentY = simd::load_u<simd::float32x4>(extentY);
+			const simd::float32x4 boxExtentZ = simd::load_u<simd::float32x4>(extentZ);
+
+			for(auto& plane : planes)
+			{
+				simd::float32x4 dist = simd::mul(boxX, plane.normalX);
+				dist = simd::add(dist, simd::mul(boxY, plane.normalY));
+				dist = simd::add(dist, simd::mul(boxZ, plane.normalZ));
+				dist = simd::sub(dist, plane.d);
+
+				simd::float32x4 effectiveRadius = simd::mul(boxExtentX, plane.absNormalX);
+				effectiveRadius = simd::add(effectiveRadius, simd::mul(boxExtentY, plane.absNormalY));
+				effectiveRadius = simd::add(effectiveRadius, simd::mul(boxExtentZ, plane.absNormalZ));
+
+				visible = simd::bit_and(visible, simd::cmp_ge(dist, simd::neg(effectiveRadius)));
+			}
+
+			return visible;
+		}
+
+		/** Converts a SIMD mask into a bitmask, with the first lane in the least significant bit. */
+		UINT32 getLaneBits(const simd::mask_float32x4& mask)
+		{
+			const simd::uint32x4 laneBits = simd::make_uint(1, 2, 4, 8);
+			const simd::uint32x4 zero = simd::make_zero();
+
+			return simd::reduce_or(simd::blend(laneBits, zero, mask));
+		}
+
+		/** Returns a bitmask with a bit set for every object in the group starting at @p start that isn't padding. */
+		UINT32 getValidLaneBits(UINT32 start, UINT32 numObjects)
+		{
+			const UINT32 numValid = std::min(numObjects - start, SIMD_WIDTH);
+			return (1U << numValid) - 1;
+		}
+
+		/** Writes the results of a group starting at @p start into the mask. Groups never straddle a word boundary. */
+		void writeLaneBits(UINT32 start, UINT32 bits, CullingMask& output)
+		{
+			output.getWords()[start >> 5] |= bits << (start & 31);
+		}
+	}
+
+	UINT32 CullingBounds::add(const Bounds& bounds, UINT64 layer)
+	{
+		const UINT32 idx = mNumObjects++;
+		resizeArrays();
+
+		update(idx, bounds, layer);
+		return idx;
+	}
+
+	void CullingBounds::update(UINT32 idx, const Bounds& bounds, UINT64 layer)
+	{
+		write(idx, bounds);
+		mLayers[idx] = layer;
+	}
+
+	void CullingBounds::update(UINT32 idx, const Bounds& bounds)
+	{
+		write(idx, bounds);
+	}
+
+	void CullingBounds::remove(UINT32 idx)
+	{
+		assert(idx < mNumObjects);
+
+		const UINT32 lastIdx = mNumObjects - 1;
+		if(idx != lastIdx)
+		{
+			mSphereX[idx] = mSphereX[lastIdx];
+			mSphereY[idx] = mSphereY[lastIdx];
+			mSphereZ[idx] = mSphereZ[lastIdx];
+			mSphereRadius[idx] = mSphereRadius[lastIdx];
+
+			mBoxX[idx] = mBoxX[lastIdx];
+			mBoxY[idx] = mBoxY[lastIdx];
+			mBoxZ[idx] = mBoxZ[lastIdx];
+			mBoxExtentX[idx] = mBoxExtentX[lastIdx];
+			mBoxExtentY[idx] = mBoxExtentY[lastIdx];
+			mBoxExtentZ[idx] = mBoxExtentZ[lastIdx];
+
+			mLayers[idx] = mLayers[lastIdx];
+		}
+
+		mNumObjects--;
+		resizeArrays();
+	}
+
+	void CullingBounds::clear()
+	{
+		mNumObjects = 0;
+		resizeArrays();
+	}
+
+	void CullingBounds::cull(const ConvexVolume& volume, UINT64 layers, CullingMask& output) const
+	{
+		assert(output.size() == mNumObjects);
+
+		SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES> planes;
+		getSIMDPlanes(volume, planes);
+
+		for(UINT32 i = 0; i < mNumObjects; i += SIMD_WIDTH)
+		{
+			// Layers are tested first, as they're cheap and often exclude entire groups
+			UINT32 layerBits = 0;
+			for(UINT32 j = 0; j < SIMD_WIDTH; j++)
+			{
+				if((mLayers[i + j] & layers) != 0)
+					layerBits |= 1 << j;
+			}
+
+			layerBits &= getValidLaneBits(i, mNumObjects);
+			if(layerBits == 0)
+				continue;
+
+			simd::mask_float32x4 visible =
+				testSpheres(&mSphereX[i], &mSphereY[i], &mSphereZ[i], &mSphereRadius[i], planes);
+			if(!simd::test_bits_any(simd::bit_cast<simd::uint32x4>(visible)))
+				continue;
+
+			// More precise box test, for objects that passed the sphere test
+			visible = testBoxes(&mBoxX[i], &mBoxY[i], &mBoxZ[i], &mBoxExtentX[i], &mBoxExtentY[i], &mBoxExtentZ[i],
+				planes, visible);
+
+			const UINT32 bits = getLaneBits(visible) & layerBits;
+			if(bits != 0)
+				writeLaneBits(i, bits, output);
+		}
+	}
+
+	void CullingBounds::cullSpheres(const ConvexVolume& volume, CullingMask& output) const
+	{
+		assert(output.size() == mNumObjects);
+
+		SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES> planes;
+		getSIMDPlanes(volume, planes);
+
+		for(UINT32 i = 0; i < mNumObjects; i += SIMD_WIDTH)
+		{
+			const simd::mask_float32x4 visible =
+				testSpheres(&mSphereX[i], &mSphereY[i], &mSphereZ[i], &mSphereRadius[i], planes);
+
+			const UINT32 bits = getLaneBits(visible) & getValidLaneBits(i, mNumObjects);
+			if(bits != 0)
+				writeLaneBits(i, bits, output);
+		}
+	}
+
+	void CullingBounds::cull(const ConvexVolume& volume, UINT64 layers, const UINT32* indices, UINT32 count,
+		CullingMask& output) const
+	{
+		assert(output.size() == mNumObjects);
+
+		SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES> planes;
+		getSIMDPlanes(volume, planes);
+
+		for(UINT32 i = 0; i < count; i += SIMD_WIDTH)
+		{
+			// Gather the objects into a contiguous group. Unused lanes are left zero-sized and masked out below.
+			GatherGroup group;
+			UINT32 layerBits = 0;
+
+			const UINT32 numLanes = std::min(count - i, SIMD_WIDTH);
+			for(UINT32 j = 0; j < numLanes; j++)
+			{
+				const UINT32 idx = indices[i + j];
+				assert(idx < mNumObjects);
+
+				gather(idx, j, group);
+				if((mLayers[idx] & layers) != 0)
+					layerBits |= 1 << j;
+			}
+
+			if(layerBits == 0)
+				continue;
+
+			simd::mask_float32x4 visible =
+				testSpheres(group.sphereX, group.sphereY, group.sphereZ, group.sphereRadius, planes);
+			if(!simd::test_bits_any(simd::bit_cast<simd::uint32x4>(visible)))
+				continue;
+
+			visible = testBoxes(group.boxX, group.boxY, group.boxZ, group.boxExtentX, group.boxExtentY,
+				group.boxExtentZ, planes, visible);
+
+			const UINT32 bits = getLaneBits(visible) & layerBits;
+			for(UINT32 j = 0; j < numLanes; j++)
+			{
+				if((bits & (1 << j)) != 0)
+					output.set(indices[i + j]);
+			}
+		}
+	}
+
+	void CullingBounds::cullSpheres(const ConvexVolume& volume, const UINT32* indices, UINT32 count,
+		CullingMask& output) const
+	{
+		assert(output.size() == mNumObjects);
+
+		SmallVector<SIMDPlane, ConvexVolume::NUM_INLINE_PLANES> planes;
+		getSIMDPlanes(volume, planes);
+
+		for(UINT32 i = 0; i < count; i += SIMD_WIDTH)
+		{
+			GatherGroup group;
+
+			const UINT32 numLanes = std::min(count - i, SIMD_WIDTH);
+			for(UINT32 j = 0; j < numLanes; j++)
+			{
+				assert(indices[i + j] < mNumObjects);
+				gather(indices[i + j], j, group);
+			}
+
+			const simd::mask_float32x4 visible =
+				testSpheres(group.sphereX, group.sphereY, group.sphereZ, group.sphereRadius, planes);
+
+			const UINT32 bits = getLaneBits(visible) & ((1U << numLanes) - 1);
+			for(UINT32 j = 0; j < numLanes; j++)
+			{
+				if((bits & (1 << j)) != 0)
+					output.set(indices[i + j]);
+			}
+		}
+	}
+
+	void CullingBounds::gather(UINT32 idx, UINT32 lane, GatherGroup& group) const
+	{
+		group.sphereX[lane] = mSphereX[idx];
+		group.sphereY[lane] = mSphereY[idx];
+		group.sphereZ[lane] = mSphereZ[idx];
+		group.sphereRadius[lane] = mSphereRadius[idx];
+
+		group.boxX[lane] = mBoxX[idx];
+		group.boxY[lane] = mBoxY[idx];
+		group.boxZ[lane] = mBoxZ[idx];
+		group.boxExtentX[lane] = mBoxExtentX[idx];
+		group.boxExtentY[lane] = mBoxExtentY[idx];
+		group.boxExtentZ[lane] = mBoxExtentZ[idx];
+	}
+
+	void CullingBounds::write(UINT32 idx, const Bounds& bounds)
+	{
+		assert(idx < mNumObjects);
+
+		const Sphere& sphere = bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+		mSphereX[idx] = sphereCenter.x;
+		mSphereY[idx] = sphereCenter.y;
+		mSphereZ[idx] = sphereCenter.z;
+		mSphereRadius[idx] = sphere.getRadius();
+
+		const AABox& box = bounds.getBox();
+		const Vector3 boxCenter = box.getCenter();
+		const Vector3 boxExtents = box.getHalfSize();
+		mBoxX[idx] = boxCenter.x;
+		mBoxY[idx] = boxCenter.y;
+		mBoxZ[idx] = boxCenter.z;
+		mBoxExtentX[idx] = Math::abs(boxExtents.x);
+		mBoxExtentY[idx] = Math::abs(boxExtents.y);
+		mBoxExtentZ[idx] = Math::abs(boxExtents.z);
+	}
+
+	void CullingBounds::resizeArrays()
+	{
+		// Padding ensures full SIMD groups can always be loaded. Padded entries are never reported as visible.
+		const size_t paddedSize = Math::divideAndRoundUp(mNumObjects, SIMD_WIDTH) * SIMD_WIDTH;
+
+		mSphereX.resize(paddedSize, 0.0f);
+		mSphereY.resize(paddedSize, 0.0f);
+		mSphereZ.resize(paddedSize, 0.0f);
+		mSphereRadius.resize(paddedSize, 0.0f);
+
+		mBoxX.resize(paddedSize, 0.0f);
+		mBoxY.resize(paddedSize, 0.0f);
+		mBoxZ.resize(paddedSize, 0.0f);
+		mBoxExtentX.resize(paddedSize, 0.0f);
+		mBoxExtentY.resize(paddedSize, 0.0f);
+		mBoxExtentZ.resize(paddedSize, 0.0f);
+
+		mLayers.resize(paddedSize, 0);
+	}
+}
@@ -0,0 +1,198 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsMath.h"
+#include "Math/BsBounds.h"
+#include "Math/BsConvexVolume.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/** Compact array of bits, one per object, used for storing the results of culling. */
+	class CullingMask
+	{
+	public:
+		/** Resizes the mask so it can hold @p count bits and clears all of them. */
+		void reset(UINT32 count)
+		{
+			mNumBits = count;
+			mWords.assign(Math::divideAndRoundUp(count, 32U), 0);
+		}
+
+		/** Returns the value of the bit at the specified index. */
+		bool operator[](UINT32 idx) const
+		{
+			assert(idx < mNumBits);
+			return (mWords[idx >> 5] & (1U << (idx & 31))) != 0;
+		}
+
+		/** Sets the bit at the specified index. */
+		void set(UINT32 idx)
+		{
+			assert(idx < mNumBits);
+			mWords[idx >> 5] |= 1U << (idx & 31);
+		}
+
+		/** Clears the bit at the specified index. */
+		void unset(UINT32 idx)
+		{
+			assert(idx < mNumBits);
+			mWords[idx >> 5] &= ~(1U << (idx & 31));
+		}
+
+		/** Sets all bits that are set in @p other. Both masks must be of the same size. */
+		void merge(const CullingMask& other)
+		{
+			assert(mNumBits == other.mNumBits);
+
+			for(UINT32 i = 0; i < (UINT32)mWords.size(); i++)
+				mWords[i] |= other.mWords[i];
+		}
+
+		/** Calls @p func with the index of every set bit, in increasing order. */
+		template<class F>
+		void forEachSet(F func) const
+		{
+			for(UINT32 i = 0; i < (UINT32)mWords.size(); i++)
+			{
+				UINT32 word = mWords[i];
+				while(word != 0)
+				{
+					func((i << 5) + Bitwise::leastSignificantBit(word));
+					word &= word - 1;
+				}
+			}
+		}
+
+		/** Returns the number of bits in the mask. */
+		UINT32 size() const { return mNumBits; }
+
+		/** Returns the bits packed into 32-bit words, lowest index in the least significant bit of the first word. */
+		UINT32* getWords() { return mWords.data(); }
+
+		/** @copydoc getWords() */
+		const UINT32* getWords() const { return mWords.data(); }
+
+	private:
+		Vector<UINT32> mWords;
+		UINT32 mNumBits = 0;
+	};
+
+	/**
+	 * Bounds of a set of objects, stored in structure-of-arrays layout so that multiple objects can be culled at once
+	 * using SIMD instructions. Each object is represented by a bounding sphere, a bounding box and a layer mask.
+	 */
+	class BS_UTILITY_EXPORT CullingBounds
+	{
+	public:
+		/** Appends a new object and returns its index. */
+		UINT32 add(const Bounds& bounds, UINT64 layer = (UINT64)-1);
+
+		/** Updates the bounds and the layer mask of the object at the specified index. */
+		void update(UINT32 idx, const Bounds& bounds, UINT64 layer);
+
+		/** Updates the bounds of the object at the specified index. */
+		void update(UINT32 idx, const Bounds& bounds);
+
+		/**
+		 * Removes the object at the specified index by moving the last object in its place. Matches the way the renderer
+		 * removes objects from its other per-object arrays.
+		 */
+		void remove(UINT32 idx);
+
+		/** Removes all objects. */
+		void clear();
+
+		/** Returns the number of objects. */
+		UINT32 size() const { return mNumObjects; }
+
+		/**
+		 * Tests all objects against the provided volume and sets the bit of each object that intersects it. An object is
+		 * considered intersecting if both its sphere and its box intersect the volume, and its layer mask shares at least
+		 * one bit with @p layers. Bits of objects that don't intersect the volume are left unchanged.
+		 *
+		 * @param[in]	volume		Volume to test the objects against.
+		 * @param[in]	layers		Layer mask to test the object layers against.
+		 * @param[out]	output		Mask that receives the results. Must have been reset to the number of objects.
+		 */
+		void cull(const ConvexVolume& volume, UINT64 layers, CullingMask& output) const;
+
+		/**
+		 * Tests all objects against the provided volume using only their bounding spheres, and sets the bit of each
+		 * object that intersects it. Layers are ignored. Bits of objects that don't intersect the volume are left
+		 * unchanged.
+		 */
+		void cullSpheres(const ConvexVolume& volume, CullingMask& output) const;
+
+		/**
+		 * Same as cull(const ConvexVolume&, UINT64, CullingMask&), except that only the objects with the provided
+		 * indices are tested. Useful for testing the candidates returned by a coarse spatial query (e.g. an octree)
+		 * in bulk.
+		 *
+		 * @param[in]	volume		Volume to test the objects against.
+		 * @param[in]	layers		Layer mask to test the object layers against.
+		 * @param[in]	indices		Indices of the objects to test.
+		 * @param[in]	count		Number of entries in @p indices.
+		 * @param[out]	output		Mask that receives the results. Must have been reset to the number of objects.
+		 */
+		void cull(const ConvexVolume& volume, UINT64 layers, const UINT32* indices, UINT32 count,
+			CullingMask& output) const;
+
+		/**
+		 * Same as cullSpheres(const ConvexVolume&, CullingMask&), except that only the objects with the provided
+		 * indices are tested.
+		 */
+		void cullSpheres(const ConvexVolume& volume, const UINT32* indices, UINT32 count, CullingMask& output) const;
+
+	private:
+		/** Bounds of a group of arbitrary objects, copied into contiguous storage so they can be tested together. */
+		struct GatherGroup
+		{
+			float sphereX[4] = { };
+			float sphereY[4] = { };
+			float sphereZ[4] = { };
+			float sphereRadius[4] = { };
+
+			float boxX[4] = { };
+			float boxY[4] = { };
+			float boxZ[4] = { };
+			float boxExtentX[4] = { };
+			float boxExtentY[4] = { };
+			float boxExtentZ[4] = { };
+		};
+
+		/** Copies the bounds of the object at index @p idx into the specified lane of @p group. */
+		void gather(UINT32 idx, UINT32 lane, GatherGroup& group) const;
+
+		/** Writes the bounds of an object into the arrays. */
+		void write(UINT32 idx, const Bounds& bounds);
+
+		/** Resizes the arrays to fit the current number of objects, padded to the SIMD width. */
+		void resizeArrays();
+
+		// Sphere
+		Vector<float> mSphereX;
+		Vector<float> mSphereY;
+		Vector<float> mSphereZ;
+		Vector<float> mSphereRadius;
+
+		// Box
+		Vector<float> mBoxX;
+		Vector<float> mBoxY;
+		Vector<float> mBoxZ;
+		Vector<float> mBoxExtentX;
+		Vector<float> mBoxExtentY;
+		Vector<float> mBoxExtentZ;
+
+		Vector<UINT64> mLayers;
+		UINT32 mNumObjects = 0;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,387 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Math/BsOcclusionBuffer.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	namespace
+	{
+		/** Number of pixels processed by a single SIMD operation. */
+		constexpr UINT32 SIMD_WIDTH = 4;
+
+		/** Vertices with w lower than this are considered to be behind the viewer. */
+		constexpr float MIN_W = 1e-5f;
+
+		/**
+		 * Triangles with vertices further than this many viewport sizes outside of the viewport are ignored, as the
+		 * precision of their edge functions can no longer be relied upon.
+		 */
+		constexpr float GUARD_BAND_SCALE = 4.0f;
+
+		/** Returns a vector with @p value in all lanes. */
+		simd::float32x4 splat(float value)
+		{
+			return simd::load_splat<simd::float32x4>(&value);
+		}
+
+		/** Checks if any lane of the mask is set. */
+		bool anySet(const simd::mask_float32x4& mask)
+		{
+			return simd::test_bits_any(simd::bit_cast<simd::uint32x4>(mask));
+		}
+
+		/** Offsets from the first pixel in a SIMD group to the centers of all pixels in the group. */
+		simd::float32x4 getPixelCenterOffsets()
+		{
+			return simd::make_float(0.5f, 1.5f, 2.5f, 3.5f);
+		}
+	}
+
+	void OcclusionBuffer::begin(UINT32 width, UINT32 height, const Matrix4& viewProj, float minDepth)
+	{
+		mViewProj = viewProj;
+		mMinDepth = minDepth;
+
+		mWidth = width;
+		mHeight = height;
+		mNumTilesX = Math::divideAndRoundUp(width, TILE_WIDTH);
+		mNumTilesY = Math::divideAndRoundUp(height, TILE_HEIGHT);
+		mStride = mNumTilesX * TILE_WIDTH;
+
+		const UINT32 numTiles = mNumTilesX * mNumTilesY;
+		const UINT32 numRows = mNumTilesY * TILE_HEIGHT;
+		mDepth.resize(mStride * numRows);
+
+		// Padding outside of the viewport is treated as closer than anything, so it never affects the per-tile maximums
+		for(UINT32 y = 0; y < numRows; y++)
+		{
+			float* row = &mDepth[y * mStride];
+			if(y < height)
+			{
+				std::fill(row, row + width, std::numeric_limits<float>::max());
+				std::fill(row + width, row + mStride, -std::numeric_limits<float>::max());
+			}
+			else
+				std::fill(row, row + mStride, -std::numeric_limits<float>::max());
+		}
+
+		mTileMaxDepth.assign(numTiles, std::numeric_limits<float>::max());
+
+		mTileTriangles.resize(numTiles);
+		for(auto& entry : mTileTriangles)
+			entry.clear();
+
+		mTriangles.clear();
+	}
+
+	void OcclusionBuffer::addOccluder(const Matrix4& world, const Vector3* vertices, UINT32 numVertices,
+		const UINT32* indices, UINT32 numIndices)
+	{
+		const Matrix4 worldViewProj = mViewProj * world;
+
+		mClipVertices.resize(numVertices);
+		for(UINT32 i = 0; i < numVertices; i++)
+			mClipVertices[i] = worldViewProj.multiply(Vector4(vertices[i], 1.0f));
+
+		const float width = (float)mWidth;
+		const float height = (float)mHeight;
+		const float guardBandX = width * GUARD_BAND_SCALE;
+		const float guardBandY = height * GUARD_BAND_SCALE;
+
+		for(UINT32 i = 0; i + 2 < numIndices; i += 3)
+		{
+			float x[3];
+			float y[3];
+			float depth[3];
+
+			bool valid = true;
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				assert(indices[i + j] < numVertices);
+				const Vector4& clipPos = mClipVertices[indices[i + j]];
+
+				// Ignore triangles crossing the near plane instead of clipping them, as it keeps the results conservative
+				if(clipPos.w < MIN_W || clipPos.z < mMinDepth * clipPos.w)
+				{
+					valid = false;
+					break;
+				}
+
+				const float invW = 1.0f / clipPos.w;
+				x[j] = (clipPos.x * invW * 0.5f + 0.5f) * width;
+				y[j] = (clipPos.y * invW * 0.5f + 0.5f) * height;
+				depth[j] = clipPos.z * invW;
+
+				if(x[j] < -guardBandX || x[j] > width + guardBandX || y[j] < -guardBandY || y[j] > height + guardBandY)
+				{
+					valid = false;
+					break;
+				}
+			}
+
+			if(!valid)
+				continue;
+
+			// Make all triangles counter-clockwise, so the edge functions are positive on the inside
+			float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+			if(area < 0.0f)
+			{
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+				std::swap(depth[1], depth[2]);
+				area = -area;
+			}
+
+			if(area < 1e-6f)
+				continue;
+
+			// Covered pixel range, only including pixels whose centers might be inside the triangle
+			const float minX = std::min(x[0], std::min(x[1], x[2]));
+			const float maxX = std::max(x[0], std::max(x[1], x[2]));
+			const float minY = std::min(y[0], std::min(y[1], y[2]));
+			const float maxY = std::max(y[0], std::max(y[1], y[2]));
+
+			Triangle triangle;
+			triangle.minX = std::max((INT32)std::ceil(minX - 0.5f), 0);
+			triangle.maxX = std::min((INT32)std::floor(maxX - 0.5f), (INT32)mWidth - 1);
+			triangle.minY = std::max((INT32)std::ceil(minY - 0.5f), 0);
+			triangle.maxY = std::min((INT32)std::floor(maxY - 0.5f), (INT32)mHeight - 1);
+
+			if(triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+				continue;
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const UINT32 next = (j + 1) % 3;
+
+				triangle.edgeA[j] = y[j] - y[next];
+				triangle.edgeB[j] = x[next] - x[j];
+				triangle.edgeC[j] = -(triangle.edgeA[j] * x[j] + triangle.edgeB[j] * y[j]);
+			}
+
+			// Barycentric weight of a vertex is the edge function of the opposite edge, divided by the area
+			const float invArea = 1.0f / area;
+			triangle.depthA = (depth[0] * triangle.edgeA[1] + depth[1] * triangle.edgeA[2] + depth[2] * triangle.edgeA[0])
+				* invArea;
+			triangle.depthB = (depth[0] * triangle.edgeB[1] + depth[1] * triangle.edgeB[2] + depth[2] * triangle.edgeB[0])
+				* invArea;
+			triangle.depthC = (depth[0] * triangle.edgeC[1] + depth[1] * triangle.edgeC[2] + depth[2] * triangle.edgeC[0])
+				* invArea;
+
+			const UINT32 triangleIdx = (UINT32)mTriangles.size();
+			mTriangles.push_back(triangle);
+
+			// Bin into all overlapping tiles
+			const UINT32 minTileX = (UINT32)triangle.minX / TILE_WIDTH;
+			const UINT32 maxTileX = (UINT32)triangle.maxX / TILE_WIDTH;
+			const UINT32 minTileY = (UINT32)triangle.minY / TILE_HEIGHT;
+			const UINT32 maxTileY = (UINT32)triangle.maxY / TILE_HEIGHT;
+
+			for(UINT32 tileY = minTileY; tileY <= maxTileY; tileY++)
+			{
+				for(UINT32 tileX = minTileX; tileX <= maxTileX; tileX++)
+					mTileTriangles[tileY * mNumTilesX + tileX].push_back(triangleIdx);
+			}
+		}
+	}
+
+	void OcclusionBuffer::rasterize()
+	{
+		const UINT32 numTiles = mNumTilesX * mNumTilesY;
+
+		// Tiles write to separate parts of the buffer, and can therefore be processed in parallel
+		if(TaskScheduler::isStarted())
+		{
+			TaskScheduler::instance().parallelFor(0, numTiles, 0, [this](UINT32 tileIdx) { rasterizeTile(tileIdx); });
+		}
+		else
+		{
+			for(UINT32 i = 0; i < numTiles; i++)
+				rasterizeTile(i);
+		}
+	}
+
+	void OcclusionBuffer::rasterizeTile(UINT32 tileIdx)
+	{
+		const Vector<UINT32>& triangles = mTileTriangles[tileIdx];
+		if(triangles.empty())
+			return;
+
+		const INT32 tileMinX = (INT32)((tileIdx % mNumTilesX) * TILE_WIDTH);
+		const INT32 tileMinY = (INT32)((tileIdx / mNumTilesX) * TILE_HEIGHT);
+		const INT32 tileMaxX = tileMinX + TILE_WIDTH - 1;
+		const INT32 tileMaxY = tileMinY + TILE_HEIGHT - 1;
+
+		const simd::float32x4 pixelCenterOffsets = getPixelCenterOffsets();
+		const simd::float32x4 zero = simd::make_zero();
+
+		for(auto& triangleIdx : triangles)
+		{
+			const Triangle& triangle = mTriangles[triangleIdx];
+
+			// Start at a SIMD group boundary, lanes outside of the triangle are masked out by the edge functions
+			const INT32 minX = std::max(triangle.minX, tileMinX) & ~(INT32)(SIMD_WIDTH - 1);
+			const INT32 maxX = std::min(triangle.maxX, tileMaxX);
+			const INT32 minY = std::max(triangle.minY, tileMinY);
+			const INT32 maxY = std::min(triangle.maxY, tileMaxY);
+
+			const simd::float32x4 edgeA0 = splat(triangle.edgeA[0]);
+			const simd::float32x4 edgeA1 = splat(triangle.edgeA[1]);
+			const simd::float32x4 edgeA2 = splat(triangle.edgeA[2]);
+			const simd::float32x4 depthA = splat(triangle.depthA);
+
+			for(INT32 y = minY; y <= maxY; y++)
+			{
+				const float pixelY = (float)y + 0.5f;
+				const simd::float32x4 rowEdge0 = splat(triangle.edgeB[0] * pixelY + triangle.edgeC[0]);
+				const simd::float32x4 rowEdge1 = splat(triangle.edgeB[1] * pixelY + triangle.edgeC[1]);
+				const simd::float32x4 rowEdge2 = splat(triangle.edgeB[2] * pixelY + triangle.edgeC[2]);
+				const simd::float32x4 rowDepth = splat(triangle.depthB * pixelY + triangle.depthC);
+
+				float* row = &mDepth[y * mStride];
+				for(INT32 x = minX; x <= maxX; x += SIMD_WIDTH)
+				{
+					const simd::float32x4 pixelX = simd::add(splat((float)x), pixelCenterOffsets);
+
+					const simd::float32x4 edge0 = simd::add(simd::mul(edgeA0, pixelX), rowEdge0);
+					const simd::float32x4 edge1 = simd::add(simd::mul(edgeA1, pixelX), rowEdge1);
+					const simd::float32x4 edge2 = simd::add(simd::mul(edgeA2, pixelX), rowEdge2);
+
+					simd::mask_float32x4 coverage = simd::cmp_ge(edge0, zero);
+					coverage = simd::bit_and(coverage, simd::cmp_ge(edge1, zero));
+					coverage = simd::bit_and(coverage, simd::cmp_ge(edge2, zero));
+
+					if(!anySet(coverage))
+						continue;
+
+					const simd::float32x4 depth = simd::add(simd::mul(depthA, pixelX), rowDepth);
+					const simd::float32x4 oldDepth = simd::load_u<simd::float32x4>(row + x);
+					const simd::float32x4 newDepth = simd::min(oldDepth, depth);
+
+					simd::store_u(row + x, simd::blend(newDepth, oldDepth, coverage));
+				}
+			}
+		}
+
+		// Keep track of the furthest depth in the tile, so occlusion tests can skip fully covered tiles
+		simd::float32x4 maxDepth = splat(-std::numeric_limits<float>::max());
+		for(INT32 y = tileMinY; y <= tileMaxY; y++)
+		{
+			const float* row = &mDepth[y * mStride];
+			for(INT32 x = tileMinX; x <= tileMaxX; x += SIMD_WIDTH)
+				maxDepth = simd::max(maxDepth, simd::load_u<simd::float32x4>(row + x));
+		}
+
+		mTileMaxDepth[tileIdx] = simd::reduce_max(maxDepth);
+	}
+
+	bool OcclusionBuffer::isOccluded(const AABox& box) const
+	{
+		const Vector3& boxMin = box.getMin();
+		const Vector3& boxMax = box.getMax();
+
+		// Transform all eight corners, four at a time
+		const simd::float32x4 cornerX = simd::make_float(boxMin.x, boxMax.x, boxMin.x, boxMax.x);
+		const simd::float32x4 cornerY = simd::make_float(boxMin.y, boxMin.y, boxMax.y, boxMax.y);
+		const simd::float32x4 minDepth = splat(mMinDepth);
+		const simd::float32x4 minW = splat(MIN_W);
+
+		simd::float32x4 screenMinX = splat(std::numeric_limits<float>::max());
+		simd::float32x4 screenMinY = splat(std::numeric_limits<float>::max());
+		simd::float32x4 screenMaxX = splat(-std::numeric_limits<float>::max());
+		simd::float32x4 screenMaxY = splat(-std::numeric_limits<float>::max());
+		simd::float32x4 nearestDepth = splat(std::numeric_limits<float>::max());
+
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			const simd::float32x4 cornerZ = splat(i == 0 ? boxMin.z : boxMax.z);
+
+			simd::float32x4 clip[4];
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				clip[j] = simd::mul(cornerX, splat(mViewProj[j][0]));
+				clip[j] = simd::add(clip[j], simd::mul(cornerY, splat(mViewProj[j][1])));
+				clip[j] = simd::add(clip[j], simd::mul(cornerZ, splat(mViewProj[j][2])));
+				clip[j] = simd::add(clip[j], splat(mViewProj[j][3]));
+			}
+
+			// Boxes crossing the near plane can't be reliably projected
+			simd::mask_float32x4 invalid = simd::cmp_lt(clip[3], minW);
+			invalid = simd::bit_or(invalid, simd::cmp_lt(clip[2], simd::mul(minDepth, clip[3])));
+
+			if(anySet(invalid))
+				return false;
+
+			const simd::float32x4 ndcX = simd::div(clip[0], clip[3]);
+			const simd::float32x4 ndcY = simd::div(clip[1], clip[3]);
+			const simd::float32x4 ndcZ = simd::div(clip[2], clip[3]);
+
+			screenMinX = simd::min(screenMinX, ndcX);
+			screenMinY = simd::min(screenMinY, ndcY);
+			screenMaxX = simd::max(screenMaxX, ndcX);
+			screenMaxY = simd::max(screenMaxY, ndcY);
+			nearestDepth = simd::min(nearestDepth, ndcZ);
+		}
+
+		const float width = (float)mWidth;
+		const float height = (float)mHeight;
+
+		const float minX = (simd::reduce_min(screenMinX) * 0.5f + 0.5f) * width;
+		const float maxX = (simd::reduce_max(screenMaxX) * 0.5f + 0.5f) * width;
+		const float minY = (simd::reduce_min(screenMinY) * 0.5f + 0.5f) * height;
+		const float maxY = (simd::reduce_max(screenMaxY) * 0.5f + 0.5f) * height;
+		const float boxDepth = simd::reduce_min(nearestDepth);
+
+		if(maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+			return false;
+
+		// Every pixel the box touches, even partially. Clamped before conversion, as boxes near the edge of the view
+		// can project far outside the representable integer range.
+		const INT32 pixelMinX = (INT32)std::max(minX, 0.0f);
+		const INT32 pixelMaxX = (INT32)std::min(maxX, width - 1.0f);
+		const INT32 pixelMinY = (INT32)std::max(minY, 0.0f);
+		const INT32 pixelMaxY = (INT32)std::min(maxY, height - 1.0f);
+
+		const simd::float32x4 boxDepthVec = splat(boxDepth);
+		const simd::float32x4 laneOffsets = simd::make_float(0.0f, 1.0f, 2.0f, 3.0f);
+		const simd::float32x4 rangeMinX = splat((float)pixelMinX);
+		const simd::float32x4 rangeMaxX = splat((float)pixelMaxX);
+
+		for(UINT32 tileY = pixelMinY / TILE_HEIGHT; tileY <= pixelMaxY / TILE_HEIGHT; tileY++)
+		{
+			for(UINT32 tileX = pixelMinX / TILE_WIDTH; tileX <= pixelMaxX / TILE_WIDTH; tileX++)
+			{
+				// Entire tile is covered by occluders closer than the box
+				if(mTileMaxDepth[tileY * mNumTilesX + tileX] < boxDepth)
+					continue;
+
+				const INT32 groupMinX = std::max((INT32)(tileX * TILE_WIDTH), pixelMinX) & ~(INT32)(SIMD_WIDTH - 1);
+				const INT32 testMaxX = std::min((INT32)((tileX + 1) * TILE_WIDTH) - 1, pixelMaxX);
+				const INT32 testMinY = std::max((INT32)(tileY * TILE_HEIGHT), pixelMinY);
+				const INT32 testMaxY = std::min((INT32)((tileY + 1) * TILE_HEIGHT) - 1, pixelMaxY);
+
+				for(INT32 y = testMinY; y <= testMaxY; y++)
+				{
+					const float* row = &mDepth[y * mStride];
+					for(INT32 x = groupMinX; x <= testMaxX; x += SIMD_WIDTH)
+					{
+						const simd::float32x4 pixelX = simd::add(splat((float)x), laneOffsets);
+
+						simd::mask_float32x4 visible = simd::cmp_ge(pixelX, rangeMinX);
+						visible = simd::bit_and(visible, simd::cmp_le(pixelX, rangeMaxX));
+						visible = simd::bit_and(visible,
+							simd::cmp_le(boxDepthVec, simd::load_u<simd::float32x4>(row + x)));
+
+						if(anySet(visible))
+							return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+}
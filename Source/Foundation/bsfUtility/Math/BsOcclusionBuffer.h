@@ -0,0 +1,129 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup Math
+	 *  @{
+	 */
+
+	/**
+	 * Low resolution depth buffer rasterized on the CPU, used for determining if objects are hidden behind other objects
+	 * (occluders). Occluder triangles are rasterized four pixels at a time using SIMD instructions, with a coverage mask
+	 * determining which of the pixels are written to. The buffer is split into tiles that are rasterized in parallel.
+	 *
+	 * Usage: call begin(), add occluders using addOccluder(), call rasterize() and then test any number of bounding boxes
+	 * using isOccluded().
+	 *
+	 * Depth is stored as clip space z divided by w, with smaller values being closer to the viewer. The results are
+	 * conservative in that triangles that can't be rasterized reliably (e.g. crossing the near plane) are ignored, and
+	 * boxes that can't be tested reliably are reported as not occluded.
+	 */
+	class BS_UTILITY_EXPORT OcclusionBuffer
+	{
+	public:
+		/** Width of a single tile, in pixels. Must be a multiple of four. */
+		static constexpr UINT32 TILE_WIDTH = 32;
+
+		/** Height of a single tile, in pixels. */
+		static constexpr UINT32 TILE_HEIGHT = 16;
+
+		/**
+		 * Resizes the buffer if needed, clears its contents and removes all occluders.
+		 *
+		 * @param[in]	width		Width of the buffer in pixels.
+		 * @param[in]	height		Height of the buffer in pixels.
+		 * @param[in]	viewProj	Matrix transforming from world space to clip space.
+		 * @param[in]	minDepth	Depth of the near plane after division by w. This is 0 or -1 depending on the render
+		 *							API conventions used by @p viewProj. Anything closer than the near plane is
+		 *							considered to be behind the viewer.
+		 */
+		void begin(UINT32 width, UINT32 height, const Matrix4& viewProj, float minDepth);
+
+		/**
+		 * Registers an occluder mesh that will be rasterized on the next call to rasterize(). Occluders are treated as
+		 * double sided.
+		 *
+		 * @param[in]	world		Matrix transforming the occluder vertices from local to world space.
+		 * @param[in]	vertices	Vertex positions, in local space.
+		 * @param[in]	numVertices	Number of entries in the @p vertices array.
+		 * @param[in]	indices		Vertex indices, three per triangle.
+		 * @param[in]	numIndices	Number of entries in the @p indices array.
+		 */
+		void addOccluder(const Matrix4& world, const Vector3* vertices, UINT32 numVertices, const UINT32* indices,
+			UINT32 numIndices);
+
+		/**
+		 * Rasterizes all occluders registered since the last call to begin(). Tiles are rasterized in parallel using the
+		 * TaskScheduler, if it has been started.
+		 */
+		void rasterize();
+
+		/**
+		 * Checks if a box is fully hidden behind the rasterized occluders. Boxes that are outside of the viewport or that
+		 * cross the near plane are never considered occluded.
+		 *
+		 * @param[in]	box		Box in world space.
+		 * @return				True if every pixel the box projects to contains an occluder closer than the box.
+		 */
+		bool isOccluded(const AABox& box) const;
+
+		/** Returns the depth stored at the specified pixel. Pixel (0, 0) corresponds to the bottom left of the view. */
+		float getDepth(UINT32 x, UINT32 y) const { return mDepth[y * mStride + x]; }
+
+		/** Returns the width of the buffer, in pixels. */
+		UINT32 getWidth() const { return mWidth; }
+
+		/** Returns the height of the buffer, in pixels. */
+		UINT32 getHeight() const { return mHeight; }
+
+		/** Returns the number of triangles that were queued for rasterization since the last call to begin(). */
+		UINT32 getNumTriangles() const { return (UINT32)mTriangles.size(); }
+
+	private:
+		/** Triangle in screen space, prepared for rasterization. */
+		struct Triangle
+		{
+			// Edge functions in form a * x + b * y + c, positive on the inner side of the edge
+			float edgeA[3];
+			float edgeB[3];
+			float edgeC[3];
+
+			// Depth plane in form a * x + b * y + c
+			float depthA;
+			float depthB;
+			float depthC;
+
+			// Covered pixel range, inclusive
+			INT32 minX;
+			INT32 minY;
+			INT32 maxX;
+			INT32 maxY;
+		};
+
+		/** Rasterizes all triangles overlapping the tile with the specified index. */
+		void rasterizeTile(UINT32 tileIdx);
+
+		Matrix4 mViewProj = Matrix4::IDENTITY;
+		float mMinDepth = 0.0f;
+
+		UINT32 mWidth = 0;
+		UINT32 mHeight = 0;
+		UINT32 mStride = 0;
+		UINT32 mNumTilesX = 0;
+		UINT32 mNumTilesY = 0;
+
+		Vector<float> mDepth;
+		Vector<float> mTileMaxDepth;
+		Vector<Triangle> mTriangles;
+		Vector<Vector<UINT32>> mTileTriangles;
+		Vector<Vector4> mClipVertices;
+	};
+
+	/** @} */
+}
@@ -201,6 +201,16 @@
 
 #endif
 
+// Per-category memory accounting performed by the general purpose allocator (see MemoryCounter). Controlled by the
+// MEMORY_TRACKING build option: 0 - Debug builds only, 1 - Always, 2 - Never
+#if BS_MEMORY_TRACKING_OPTION == 1
+#	define BS_MEMORY_TRACKING 1
+#elif BS_MEMORY_TRACKING_OPTION == 2
+#	define BS_MEMORY_TRACKING 0
+#else
+#	define BS_MEMORY_TRACKING BS_DEBUG_MODE
+#endif
+
 #if BS_DEBUG_MODE
 #define BS_DEBUG_ONLY(x) x
 #define BS_ASSERT(x) assert(x)
@@ -290,6 +300,7 @@
 
 // Commonly used standard headers
 #include "Prerequisites/BsStdHeaders.h"
+#include "Utility/BsSmallVector.h"
 
 // Forward declarations
 #include "Prerequisites/BsFwdDeclUtil.h"
@@ -4,6 +4,13 @@
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
 #include "Utility/BsBitfield.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Threading/BsJobGraph.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+#include "Math/BsCullingBounds.h"
+#include "Math/BsRandom.h"
+#include "Utility/BsRadixSort.h"
+#include "Math/BsOcclusionBuffer.h"
 
 namespace bs
 {
@@ -43,16 +50,30 @@ namespace bs
 	{
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
 		add(fileSystemTests);
+
+		ThreadPool::startUp<TThreadPool<>>(4);
+		TaskScheduler::startUp();
 	}
 
 	void UtilityTestSuite::shutDown()
 	{
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
 	}
 
 	UtilityTestSuite::UtilityTestSuite()
 	{
 		BS_ADD_TEST(UtilityTestSuite::testOctree);
 		BS_ADD_TEST(UtilityTestSuite::testBitfield)
+		BS_ADD_TEST(UtilityTestSuite::testTaskScheduler)
+		BS_ADD_TEST(UtilityTestSuite::testJobGraph)
+		BS_ADD_TEST(UtilityTestSuite::testSmallVector)
+		BS_ADD_TEST(UtilityTestSuite::testSmallString)
+		BS_ADD_TEST(UtilityTestSuite::testThreadCachingAlloc)
+		BS_ADD_TEST(UtilityTestSuite::testMemoryCategories)
+		BS_ADD_TEST(UtilityTestSuite::testCullingBounds)
+		BS_ADD_TEST(UtilityTestSuite::testRadixSort)
+		BS_ADD_TEST(UtilityTestSuite::testOcclusionBuffer)
 	}
 
 	void UtilityTestSuite::testBitfield()
@@ -216,8 +237,583 @@ namespace bs
 			elemIdx++;
 		}
 
+		// Convex volume queries, using a frustum-like volume with slanted planes
+		Vector<Plane> planes =
+		{
+			Plane(Vector3(1.0f, 0.0f, 0.0f), -300.0f),
+			Plane(Vector3(-1.0f, 0.0f, 0.0f), -200.0f),
+			Plane(Vector3(0.0f, 1.0f, 0.0f), -250.0f),
+			Plane(Vector3(0.0f, -1.0f, 0.0f), -150.0f),
+			Plane(Vector3::normalize(Vector3(0.2f, 0.1f, 1.0f)), -100.0f),
+			Plane(Vector3::normalize(Vector3(0.0f, -0.3f, -1.0f)), -400.0f)
+		};
+
+		ConvexVolume queryVolume(planes);
+		auto testVolumeQuery = [&octree, &octreeData, &queryVolume]()
+		{
+			Vector<bool> found(octreeData.elements.size(), false);
+
+			bool allIntersect = true;
+			DebugOctree::ConvexVolumeIntersectIterator volumeIter(octree, queryVolume);
+			while(volumeIter.moveNext())
+			{
+				UINT32 element = volumeIter.getElement();
+				found[element] = true;
+
+				allIntersect &= queryVolume.intersects(octreeData.elements[element].box);
+			}
+
+			bool allFound = true;
+			for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i++)
+			{
+				if(queryVolume.intersects(octreeData.elements[i].box))
+					allFound &= found[i];
+			}
+
+			return allIntersect && allFound;
+		};
+
+		BS_TEST_ASSERT(testVolumeQuery());
+
+		// Move elements around, including outside of the tree bounds, and ensure queries still find them
+		for(UINT32 i = 0; i < (UINT32)octreeData.elements.size(); i += 7)
+		{
+			DebugOctreeElem& elem = octreeData.elements[i];
+
+			Vector3 offset(
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 400.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 400.0f,
+				((rand() / (float)RAND_MAX) * 2.0f - 1.0f) * 400.0f
+			);
+
+			if((i % 5) == 0)
+				offset *= 0.01f;
+
+			elem.box = AABox(elem.box.getMin() + offset, elem.box.getMax() + offset);
+			octree.updateElement(elem.octreeId, i);
+		}
+
+		BS_TEST_ASSERT(testVolumeQuery());
+
 		// Ensure nothing goes wrong during element removal
 		for(auto& entry : octreeData.elements)
 			octree.removeElement(entry.octreeId);
 	}
+
+	void UtilityTestSuite::testTaskScheduler()
+	{
+		// Many small tasks, waited on from a non-worker thread
+		static constexpr UINT32 NUM_TASKS = 1000;
+		std::atomic<UINT32> numExecuted{0};
+
+		Vector<SPtr<Task>> tasks;
+		for(UINT32 i = 0; i < NUM_TASKS; i++)
+		{
+			SPtr<Task> task = Task::create("Test", [&numExecuted]() { numExecuted++; }, (TaskPriority)(98 + i % 5));
+			TaskScheduler::instance().addTask(task);
+			tasks.push_back(task);
+		}
+
+		for(auto& entry : tasks)
+			entry->wait();
+
+		BS_TEST_ASSERT(numExecuted == NUM_TASKS);
+
+		// Dependency chain must execute in order
+		Vector<UINT32> order;
+		SPtr<Task> first = Task::create("First", [&order]() { BS_THREAD_SLEEP(5); order.push_back(0); });
+		SPtr<Task> second = Task::create("Second", [&order]() { order.push_back(1); }, TaskPriority::High, first);
+		SPtr<Task> third = Task::create("Third", [&order]() { order.push_back(2); }, TaskPriority::VeryHigh, second);
+
+		TaskScheduler::instance().addTask(third);
+		TaskScheduler::instance().addTask(second);
+		TaskScheduler::instance().addTask(first);
+		third->wait();
+
+		BS_TEST_ASSERT(order.size() == 3 && order[0] == 0 && order[1] == 1 && order[2] == 2);
+
+		// Canceling a task cancels its dependents
+		SPtr<Task> blocker = Task::create("Blocker", []() { BS_THREAD_SLEEP(5); });
+		SPtr<Task> canceled = Task::create("Canceled", []() { }, TaskPriority::Normal, blocker);
+		SPtr<Task> dependent = Task::create("Dependent", []() { }, TaskPriority::Normal, canceled);
+
+		TaskScheduler::instance().addTask(blocker);
+		TaskScheduler::instance().addTask(canceled);
+		TaskScheduler::instance().addTask(dependent);
+		canceled->cancel();
+		blocker->wait();
+		dependent->wait();
+
+		BS_TEST_ASSERT(blocker->isComplete());
+		BS_TEST_ASSERT(dependent->isCanceled());
+
+		// Task groups, including nested groups queued from worker threads
+		std::atomic<UINT32> numGroupItems{0};
+		const auto groupWorker = [&numGroupItems](UINT32 idx)
+		{
+			SPtr<TaskGroup> nested = TaskGroup::create("Nested", [&numGroupItems](UINT32) { numGroupItems++; }, 8);
+			TaskScheduler::instance().addTaskGroup(nested);
+			nested->wait();
+		};
+
+		SPtr<TaskGroup> group = TaskGroup::create("Group", groupWorker, 64);
+		TaskScheduler::instance().addTaskGroup(group);
+		group->wait();
+
+		BS_TEST_ASSERT(group->isComplete());
+		BS_TEST_ASSERT(numGroupItems == 64 * 8);
+
+		// Parallel for, with both fixed and automatic grain size
+		static constexpr UINT32 NUM_ITEMS = 100000;
+		Vector<UINT32> items(NUM_ITEMS, 0);
+
+		TaskScheduler::instance().parallelFor(0, NUM_ITEMS, 0, [&items](UINT32 idx) { items[idx] += idx; });
+		TaskScheduler::instance().parallelFor(0, NUM_ITEMS, 1000, [&items](UINT32 idx) { items[idx] += 1; });
+
+		bool allProcessed = true;
+		for(UINT32 i = 0; i < NUM_ITEMS; i++)
+			allProcessed &= items[i] == i + 1;
+
+		BS_TEST_ASSERT(allProcessed);
+
+		// Parallel reduce
+		const UINT64 sum = TaskScheduler::instance().parallelReduce(0, NUM_ITEMS, 0, (UINT64)0, 
+			[](UINT32 idx) { return (UINT64)idx; }, [](UINT64 a, UINT64 b) { return a + b; });
+
+		BS_TEST_ASSERT(sum == ((UINT64)NUM_ITEMS * (NUM_ITEMS - 1)) / 2);
+
+		const UINT64 emptySum = TaskScheduler::instance().parallelReduce(5, 5, 0, (UINT64)0, 
+			[](UINT32 idx) { return (UINT64)idx; }, [](UINT64 a, UINT64 b) { return a + b; });
+
+		BS_TEST_ASSERT(emptySum == 0);
+	}
+
+	void UtilityTestSuite::testJobGraph()
+	{
+		const ThreadId callingThreadId = BS_THREAD_CURRENT_ID;
+
+		UINT32 valueA = 0;
+		UINT32 valueB = 0;
+		UINT32 sum = 0;
+		bool ranOnCallingThread = false;
+
+		JOB_DESC writeA;
+		writeA.name = "WriteA";
+		writeA.worker = [&valueA]() { BS_THREAD_SLEEP(2); valueA = 5; };
+		writeA.writes = { "A" };
+		writeA.callingThreadOnly = false;
+
+		JOB_DESC writeB;
+		writeB.name = "WriteB";
+		writeB.worker = [&valueB]() { valueB = 7; };
+		writeB.writes = { "B" };
+		writeB.callingThreadOnly = false;
+
+		JOB_DESC readAB;
+		readAB.name = "ReadAB";
+		readAB.worker = [&]() 
+		{ 
+			sum = valueA + valueB; 
+			ranOnCallingThread = BS_THREAD_CURRENT_ID == callingThreadId;
+		};
+		readAB.reads = { "A", "B" };
+		readAB.writes = { "Sum" };
+
+		// Must not run before ReadAB reads the value, even though it was added later
+		JOB_DESC overwriteA;
+		overwriteA.name = "OverwriteA";
+		overwriteA.worker = [&valueA]() { valueA = 100; };
+		overwriteA.writes = { "A" };
+		overwriteA.callingThreadOnly = false;
+
+		JobGraph graph;
+		graph.addJob(writeA);
+		graph.addJob(writeB);
+		const UINT32 readIdx = graph.addJob(readAB);
+		const UINT32 overwriteIdx = graph.addJob(overwriteA);
+
+		BS_TEST_ASSERT(graph.getDependencies(0).empty());
+		BS_TEST_ASSERT(graph.getDependencies(1).empty());
+		BS_TEST_ASSERT(graph.getDependencies(readIdx).size() == 2);
+		BS_TEST_ASSERT(graph.getDependencies(overwriteIdx).size() == 2);
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			valueA = valueB = sum = 0;
+			graph.execute();
+
+			BS_TEST_ASSERT(sum == 12);
+			BS_TEST_ASSERT(valueA == 100);
+			BS_TEST_ASSERT(ranOnCallingThread);
+		}
+
+		const JobGraphTimeline& timeline = graph.getLastTimeline();
+		BS_TEST_ASSERT(timeline.entries.size() == 4);
+		BS_TEST_ASSERT(timeline.entries[0].criticalPath);
+		BS_TEST_ASSERT(!timeline.entries[1].criticalPath);
+		BS_TEST_ASSERT(timeline.entries[readIdx].startUs >= timeline.entries[0].endUs);
+		BS_TEST_ASSERT(timeline.criticalPathUs <= timeline.totalUs);
+
+		graph.clear();
+	}
+
+	void UtilityTestSuite::testSmallVector()
+	{
+		SmallVector<String, 4> vec;
+		BS_TEST_ASSERT(vec.empty() && vec.capacity() == 4);
+
+		// Fill the internal storage
+		for(UINT32 i = 0; i < 4; i++)
+			vec.push_back(toString(i));
+
+		const String* internalData = vec.data();
+		BS_TEST_ASSERT(vec.size() == 4 && vec.capacity() == 4);
+
+		// Spill onto the heap
+		vec.emplace_back("4");
+		vec.push_back(vec[0]);
+		BS_TEST_ASSERT(vec.data() != internalData);
+		BS_TEST_ASSERT(vec.size() == 6 && vec.back() == "0");
+
+		vec.insert(vec.begin() + 1, "X");
+		BS_TEST_ASSERT(vec[1] == "X" && vec[2] == "1" && vec.size() == 7);
+
+		vec.erase(vec.begin(), vec.begin() + 2);
+		BS_TEST_ASSERT(vec.front() == "1" && vec.size() == 5);
+
+		SmallVector<String, 4> copy = vec;
+		BS_TEST_ASSERT(copy == vec);
+
+		SmallVector<String, 4> moved = std::move(vec);
+		BS_TEST_ASSERT(moved == copy && vec.empty() && vec.capacity() == 4);
+
+		moved.resize(2);
+		BS_TEST_ASSERT(moved.size() == 2 && moved[1] == "2");
+
+		// Move from internal storage must move the individual elements
+		SmallVector<String, 4> small = { "a", "b" };
+		SmallVector<String, 4> smallMoved = std::move(small);
+		BS_TEST_ASSERT(small.empty() && smallMoved.size() == 2 && smallMoved[1] == "b");
+
+		smallMoved.swap(moved);
+		BS_TEST_ASSERT(moved[0] == "a" && smallMoved[0] == "1");
+	}
+
+	void UtilityTestSuite::testSmallString()
+	{
+		SmallString<8> str("abc");
+		BS_TEST_ASSERT(str.size() == 3 && str == "abc");
+
+		// Fill the internal storage
+		const char* internalData = str.c_str();
+		str.append("defgh");
+		BS_TEST_ASSERT(str.c_str() == internalData && str.size() == 8);
+
+		// Spill onto the heap
+		str += 'i';
+		str.append(String("jkl"));
+		BS_TEST_ASSERT(str.c_str() != internalData);
+		BS_TEST_ASSERT(str.size() == 12 && strlen(str.c_str()) == 12);
+		BS_TEST_ASSERT(str == "abcdefghijkl");
+		BS_TEST_ASSERT(str.toString() == String("abcdefghijkl"));
+
+		SmallString<4> other("abcdefghijkl");
+		BS_TEST_ASSERT(str == other && !(str < other));
+
+		str.clear();
+		BS_TEST_ASSERT(str.empty() && str == "" && str != other);
+	}
+
+	void UtilityTestSuite::testThreadCachingAlloc()
+	{
+		// Every size up to the largest size class, plus a few forwarded to the system allocator
+		Vector<UINT8*> allocations;
+		for(UINT32 i = 0; i <= 4200; i += 7)
+		{
+			UINT8* data = (UINT8*)ThreadCachingAlloc::allocate(i);
+			BS_TEST_ASSERT(data != nullptr);
+			BS_TEST_ASSERT(((uintptr_t)data & 15) == 0);
+
+			memset(data, (int)(i & 0xFF), i);
+			allocations.push_back(data);
+		}
+
+		for(UINT32 i = 0; i < (UINT32)allocations.size(); i++)
+		{
+			const UINT32 size = i * 7;
+			if(size > 0)
+				BS_TEST_ASSERT(allocations[i][size - 1] == (UINT8)(size & 0xFF));
+
+			ThreadCachingAlloc::free(allocations[i]);
+		}
+
+		allocations.clear();
+
+		// Aligned allocations
+		for(UINT32 alignment = 16; alignment <= 256; alignment *= 2)
+		{
+			void* data = ThreadCachingAlloc::allocateAligned(100, alignment);
+			BS_TEST_ASSERT(((uintptr_t)data & (alignment - 1)) == 0);
+
+			ThreadCachingAlloc::freeAligned(data);
+		}
+
+		// Memory allocated on worker threads and freed on this one
+		constexpr UINT32 NUM_TASKS = 8;
+		constexpr UINT32 NUM_ALLOCS_PER_TASK = 2000;
+
+		Vector<void*> workerAllocations(NUM_TASKS * NUM_ALLOCS_PER_TASK);
+		TaskScheduler::instance().parallelFor(0, NUM_TASKS, 1, [&workerAllocations](UINT32 task)
+		{
+			for(UINT32 i = 0; i < NUM_ALLOCS_PER_TASK; i++)
+			{
+				const size_t size = 16 + (i % 64) * 16;
+
+				void* data = ThreadCachingAlloc::allocate(size);
+				memset(data, 0xAB, size);
+
+				workerAllocations[task * NUM_ALLOCS_PER_TASK + i] = data;
+			}
+		});
+
+		BS_TEST_ASSERT(ThreadCachingAlloc::getStats().numUsedSpans > 0);
+
+		for(auto& entry : workerAllocations)
+			ThreadCachingAlloc::free(entry);
+
+		// Once all free memory is released, no unused spans should remain
+		ThreadCachingAlloc::releaseFreeMemory();
+
+		const ThreadCachingAllocStats stats = ThreadCachingAlloc::getStats();
+		BS_TEST_ASSERT(stats.numFreeSpans == 0);
+		BS_TEST_ASSERT(stats.numDecommittedSpans == 0);
+		BS_TEST_ASSERT(stats.reservedBytes == stats.numUsedSpans * ThreadCachingAlloc::SPAN_SIZE);
+	}
+
+	void UtilityTestSuite::testMemoryCategories()
+	{
+#if BS_MEMORY_TRACKING
+		const MemoryCategoryStats before = MemoryCounter::getCategoryStats(MemoryCategory::Animation);
+
+		void* small = bs_alloc(100, MemoryCategory::Animation);
+		void* large = bs_alloc(100000, MemoryCategory::Animation);
+		void* aligned = bs_alloc_aligned16(48, MemoryCategory::Animation);
+		UINT32* array = bs_newN<UINT32>(10, MemoryCategory::Animation);
+
+		BS_TEST_ASSERT(((uintptr_t)aligned & 15) == 0);
+
+		MemoryCategoryStats stats = MemoryCounter::getCategoryStats(MemoryCategory::Animation);
+		BS_TEST_ASSERT(stats.numAllocs == before.numAllocs + 4);
+		BS_TEST_ASSERT(stats.liveBytes == before.liveBytes + 100000 + 100 + 48 + 10 * sizeof(UINT32));
+		BS_TEST_ASSERT(stats.peakBytes >= stats.liveBytes);
+
+		// Category is recorded with the allocation, so it doesn't need to be provided when freeing
+		bs_deleteN(array, 10);
+		bs_free_aligned16(aligned);
+		bs_free(large);
+		bs_free(small);
+
+		stats = MemoryCounter::getCategoryStats(MemoryCategory::Animation);
+		BS_TEST_ASSERT(stats.numFrees == before.numFrees + 4);
+		BS_TEST_ASSERT(stats.liveBytes == before.liveBytes);
+		BS_TEST_ASSERT(stats.totalAllocatedBytes >= stats.peakBytes);
+#endif
+
+		BS_TEST_ASSERT(String(MemoryCounter::getCategoryName(MemoryCategory::Animation)) == "Animation");
+	}
+
+	void UtilityTestSuite::testCullingBounds()
+	{
+		// Results must match the scalar ConvexVolume tests
+		const ConvexVolume frustum(Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 100.0f));
+
+		Random random(42);
+		Vector<Bounds> bounds;
+		Vector<UINT64> layers;
+
+		CullingBounds cullingBounds;
+		for(UINT32 i = 0; i < 1003; i++)
+		{
+			const Vector3 center(random.getSNorm() * 120.0f, random.getSNorm() * 120.0f, random.getSNorm() * 120.0f);
+			const Vector3 extents(random.getUNorm() * 5.0f, random.getUNorm() * 5.0f, random.getUNorm() * 5.0f);
+
+			const AABox box(center - extents, center + extents);
+			bounds.push_back(Bounds(box, Sphere(center, extents.length())));
+			layers.push_back(1ULL << (i % 3));
+
+			BS_TEST_ASSERT(cullingBounds.add(bounds.back(), layers.back()) == i);
+		}
+
+		// Remove a few objects the same way the renderer does
+		for(UINT32 idx : { 5U, 500U, 1000U })
+		{
+			bounds[idx] = bounds.back();
+			bounds.pop_back();
+
+			layers[idx] = layers.back();
+			layers.pop_back();
+
+			cullingBounds.remove(idx);
+		}
+
+		const UINT32 numObjects = (UINT32)bounds.size();
+		BS_TEST_ASSERT(cullingBounds.size() == numObjects);
+
+		const UINT64 cullLayers = 0x3;
+		CullingMask mask;
+		mask.reset(numObjects);
+		cullingBounds.cull(frustum, cullLayers, mask);
+
+		CullingMask sphereMask;
+		sphereMask.reset(numObjects);
+		cullingBounds.cullSpheres(frustum, sphereMask);
+
+		UINT32 numVisible = 0;
+		for(UINT32 i = 0; i < numObjects; i++)
+		{
+			const bool sphereVisible = frustum.intersects(bounds[i].getSphere());
+			const bool visible = (layers[i] & cullLayers) != 0 && sphereVisible && frustum.intersects(bounds[i].getBox());
+
+			BS_TEST_ASSERT(mask[i] == visible);
+			BS_TEST_ASSERT(sphereMask[i] == sphereVisible);
+
+			if(visible)
+				numVisible++;
+		}
+
+		BS_TEST_ASSERT(numVisible > 0 && numVisible < numObjects);
+
+		UINT32 numIterated = 0;
+		bool iteratedOnlyVisible = true;
+		mask.forEachSet([&mask, &numIterated, &iteratedOnlyVisible](UINT32 idx)
+		{
+			iteratedOnlyVisible &= mask[idx];
+			numIterated++;
+		});
+
+		BS_TEST_ASSERT(iteratedOnlyVisible);
+		BS_TEST_ASSERT(numIterated == numVisible);
+
+		// Testing a subset of objects, in arbitrary order and with a partial last group, must only set their bits
+		Vector<UINT32> indices;
+		for(UINT32 i = numObjects; i > 0; i -= 3)
+		{
+			indices.push_back(i - 1);
+			if(i < 3)
+				break;
+		}
+
+		CullingMask indexedMask;
+		indexedMask.reset(numObjects);
+		cullingBounds.cull(frustum, cullLayers, indices.data(), (UINT32)indices.size(), indexedMask);
+
+		CullingMask indexedSphereMask;
+		indexedSphereMask.reset(numObjects);
+		cullingBounds.cullSpheres(frustum, indices.data(), (UINT32)indices.size(), indexedSphereMask);
+
+		for(UINT32 i = 0; i < numObjects; i++)
+		{
+			const bool tested = (numObjects - 1 - i) % 3 == 0;
+
+			BS_TEST_ASSERT(indexedMask[i] == (tested && mask[i]));
+			BS_TEST_ASSERT(indexedSphereMask[i] == (tested && sphereMask[i]));
+		}
+	}
+
+	void UtilityTestSuite::testRadixSort()
+	{
+		static constexpr UINT32 COUNT = 5000;
+
+		Random random(1234);
+
+		// Keys vary only in a few digits and contain many duplicates, to test digit skipping and stability
+		Vector<UINT64> keys(COUNT);
+		Vector<UINT32> values(COUNT);
+		for(UINT32 i = 0; i < COUNT; i++)
+		{
+			const UINT64 high = random.getRange(0, 7);
+			const UINT64 low = random.getRange(0, 300);
+
+			keys[i] = (high << 56) | (low << 8);
+			values[i] = i;
+		}
+
+		Vector<std::pair<UINT64, UINT32>> expected(COUNT);
+		for(UINT32 i = 0; i < COUNT; i++)
+			expected[i] = std::make_pair(keys[i], values[i]);
+
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const std::pair<UINT64, UINT32>& a, const std::pair<UINT64, UINT32>& b) { return a.first < b.first; });
+
+		Vector<UINT64> tempKeys(COUNT);
+		Vector<UINT32> tempValues(COUNT);
+		RadixSort::sort(keys.data(), values.data(), COUNT, tempKeys.data(), tempValues.data());
+
+		bool matches = true;
+		for(UINT32 i = 0; i < COUNT; i++)
+			matches &= keys[i] == expected[i].first && values[i] == expected[i].second;
+
+		BS_TEST_ASSERT(matches);
+
+		// Full range keys
+		for(UINT32 i = 0; i < COUNT; i++)
+		{
+			keys[i] = ((UINT64)random.get() << 32) | random.get();
+			values[i] = i;
+		}
+
+		RadixSort::sort(keys.data(), values.data(), COUNT, tempKeys.data(), tempValues.data());
+		BS_TEST_ASSERT(std::is_sorted(keys.begin(), keys.end()));
+	}
+
+	void UtilityTestSuite::testOcclusionBuffer()
+	{
+		// OpenGL style projection, looking down the negative Z axis
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.1f, 100.0f);
+
+		// Quad at distance 10, covering the central half of the view
+		const Vector3 quadVertices[] =
+		{
+			Vector3(-5.0f, -5.0f, -10.0f), Vector3(5.0f, -5.0f, -10.0f),
+			Vector3(5.0f, 5.0f, -10.0f), Vector3(-5.0f, 5.0f, -10.0f)
+		};
+
+		const UINT32 quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+		OcclusionBuffer buffer;
+		buffer.begin(100, 70, proj, -1.0f);
+		buffer.addOccluder(Matrix4::IDENTITY, quadVertices, 4, quadIndices, 6);
+
+		// Same quad moved so it crosses the near plane, must be ignored
+		buffer.addOccluder(Matrix4::translation(Vector3(0.0f, 0.0f, 10.0f)), quadVertices, 4, quadIndices, 6);
+		BS_TEST_ASSERT(buffer.getNumTriangles() == 2);
+
+		buffer.rasterize();
+
+		const Vector4 clipCenter = proj.multiply(Vector4(0.0f, 0.0f, -10.0f, 1.0f));
+		const float quadDepth = clipCenter.z / clipCenter.w;
+		BS_TEST_ASSERT(Math::approxEquals(buffer.getDepth(50, 35), quadDepth, 0.0001f));
+		BS_TEST_ASSERT(buffer.getDepth(2, 2) == std::numeric_limits<float>::max());
+
+		// Behind the quad
+		BS_TEST_ASSERT(buffer.isOccluded(AABox(Vector3(-1.0f, -1.0f, -30.0f), Vector3(1.0f, 1.0f, -20.0f))));
+
+		// In front of the quad
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(-1.0f, -1.0f, -6.0f), Vector3(1.0f, 1.0f, -5.0f))));
+
+		// Intersecting the quad
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(-1.0f, -1.0f, -12.0f), Vector3(1.0f, 1.0f, -8.0f))));
+
+		// Behind the quad, but extending past its edge
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(3.0f, -1.0f, -21.0f), Vector3(15.0f, 1.0f, -20.0f))));
+
+		// Crossing the near plane
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f))));
+
+		// Outside of the view
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(100.0f, -1.0f, -21.0f), Vector3(101.0f, 1.0f, -20.0f))));
+
+		// Projects far past the integer range on both sides
+		BS_TEST_ASSERT(!buffer.isOccluded(AABox(Vector3(-1e9f, -1e9f, -30.0f), Vector3(1e9f, 1e9f, -20.0f))));
+	}
 }
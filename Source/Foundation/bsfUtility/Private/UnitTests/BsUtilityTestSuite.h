@@ -16,5 +16,14 @@ namespace bs
 	private:
 		void testBitfield();
 		void testOctree();
+		void testTaskScheduler();
+		void testJobGraph();
+		void testSmallVector();
+		void testSmallString();
+		void testThreadCachingAlloc();
+		void testMemoryCategories();
+		void testCullingBounds();
+		void testRadixSort();
+		void testOcclusionBuffer();
 	};
 }
@@ -23,10 +23,10 @@
 
 namespace bs
 {
-	bool unix_pathExists(const String& path)
+	bool unix_pathExists(const char* path)
 	{
 		struct stat st_buf;
-		if (stat(path.c_str(), &st_buf) == 0)
+		if (stat(path, &st_buf) == 0)
 			return true;
 		else
 			if (errno == ENOENT)    // No such file or directory
@@ -38,9 +38,9 @@ namespace bs
 			}
 	}
 
-	bool unix_stat(const String& path, struct stat *st_buf)
+	bool unix_stat(const char* path, struct stat *st_buf)
 	{
-		if (stat(path.c_str(), st_buf) != 0)
+		if (stat(path, st_buf) != 0)
 		{
 			HANDLE_PATH_ERROR(path, errno);
 			return false;
@@ -48,7 +48,7 @@ namespace bs
 		return true;
 	}
 
-	bool unix_isFile(const String& path)
+	bool unix_isFile(const char* path)
 	{
 		struct stat st_buf;
 		if (unix_stat(path, &st_buf))
@@ -57,7 +57,7 @@ namespace bs
 		return false;
 	}
 
-	bool unix_isDirectory(const String& path)
+	bool unix_isDirectory(const char* path)
 	{
 		struct stat st_buf;
 		if (unix_stat(path, &st_buf))
@@ -68,7 +68,7 @@ namespace bs
 
 	bool unix_createDirectory(const String& path)
 	{
-		if (unix_pathExists(path) && unix_isDirectory(path))
+		if (unix_pathExists(path.c_str()) && unix_isDirectory(path.c_str()))
 			return false;
 
 		if (mkdir(path.c_str(), 0755))
@@ -80,10 +80,20 @@ namespace bs
 		return true;
 	}
 
+	/** Writes the path of the entry named @p name in the directory at @p dirPath into @p output. */
+	template<UINT32 N>
+	void unix_getEntryPath(const String& dirPath, const String& name, SmallString<N>& output)
+	{
+		output.clear();
+		output.append(dirPath);
+		output.push_back('/');
+		output.append(name);
+	}
+
 	void FileSystem::removeFile(const Path& path)
 	{
 		String pathStr = path.toString();
-		if (unix_isDirectory(pathStr))
+		if (unix_isDirectory(pathStr.c_str()))
 		{
 			if (rmdir(pathStr.c_str()))
 				HANDLE_PATH_ERROR(pathStr, errno);
@@ -167,19 +177,19 @@ namespace bs
 
 	bool FileSystem::exists(const Path& path)
 	{
-		return unix_pathExists(path.toString());
+		return unix_pathExists(path.toString().c_str());
 	}
 
 	bool FileSystem::isFile(const Path& path)
 	{
 		String pathStr = path.toString();
-		return unix_pathExists(pathStr) && unix_isFile(pathStr);
+		return unix_pathExists(pathStr.c_str()) && unix_isFile(pathStr.c_str());
 	}
 
 	bool FileSystem::isDirectory(const Path& path)
 	{
 		String pathStr = path.toString();
-		return unix_pathExists(pathStr) && unix_isDirectory(pathStr);
+		return unix_pathExists(pathStr.c_str()) && unix_isDirectory(pathStr.c_str());
 	}
 
 	void FileSystem::createDir(const Path& path)
@@ -205,7 +215,7 @@ namespace bs
 	{
 		const String pathStr = dirPath.toString();
 
-		if (unix_isFile(pathStr))
+		if (unix_isFile(pathStr.c_str()))
 			return;
 
 		DIR *dp = opendir(pathStr.c_str());
@@ -215,13 +225,17 @@ namespace bs
 			return;
 		}
 
+		// Reused for all the entries, so that building the full path of an entry doesn't allocate
+		SmallString<256> entryPath;
+
 		struct dirent *ep;
 		while ( (ep = readdir(dp)) )
 		{
 			const String filename(ep->d_name);
 			if (filename != "." && filename != "..")
 			{
-				if (unix_isDirectory(pathStr + "/" + filename))
+				unix_getEntryPath(pathStr, filename, entryPath);
+				if (unix_isDirectory(entryPath.c_str()))
 					directories.push_back(dirPath + (filename + "/"));
 				else
 					files.push_back(dirPath + filename);
@@ -258,7 +272,7 @@ namespace bs
 	{
 		String pathStr = dirPath.toString();
 
-		if (unix_isFile(pathStr))
+		if (unix_isFile(pathStr.c_str()))
 			return false;
 
 		DIR* dirHandle = opendir(pathStr.c_str());
@@ -268,6 +282,8 @@ namespace bs
 			return false;
 		}
 
+		SmallString<256> entryPath;
+
 		dirent* entry;
 		while((entry = readdir(dirHandle)))
 		{
@@ -276,7 +292,8 @@ namespace bs
 				continue;
 
 			Path fullPath = dirPath;
-			if (unix_isDirectory(pathStr + "/" + filename))
+			unix_getEntryPath(pathStr, filename, entryPath);
+			if (unix_isDirectory(entryPath.c_str()))
 			{
 				Path childDir = fullPath.append(filename + "/");
 				if (dirCallback != nullptr)
@@ -27,7 +27,7 @@ namespace bs
 			alloc.clear();
 		}
 
-		std::function<void*(UINT32)> allocator = &MemoryAllocator<GenAlloc>::allocate;
+		std::function<void*(UINT32)> allocator = [](UINT32 size) { return bs_alloc(size); };
 
 		MemorySerializer ms;
 		UINT32 dataSize = 0;
@@ -184,7 +184,7 @@ namespace bs
 		// be better to modify encoding process so it outputs the intermediate format directly (similar to how decoding works). 
 		// This also means that once you have an intermediate format you cannot use it to encode to binary. 
 
-		std::function<void*(UINT32)> allocator = &MemoryAllocator<GenAlloc>::allocate;
+		std::function<void*(UINT32)> allocator = [](UINT32 size) { return bs_alloc(size); };
 
 		MemorySerializer ms;
 		UINT32 dataLength = 0;
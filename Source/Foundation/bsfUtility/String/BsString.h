@@ -4,6 +4,7 @@
 
 #include "Allocators/BsMemoryAllocator.h"
 #include "Math/BsRadian.h"
+#include "Utility/BsSmallVector.h"
 
 #include <string>
 
@@ -45,9 +46,131 @@ namespace bs
 	/** Wide string stream used for primarily for constructing UTF-32 strings. */
 	using U32StringStream = BasicStringStream<char32_t>;
 
-	/** Equivalent to String, except it avoids any dynamic allocations until the number of elements exceeds @p Count. */
-	template <int Count> 
-	using SmallString = std::basic_string <char, std::char_traits<char>, StdAlloc<char>>; // TODO: Currently equivalent to String, need to implement the allocator
+	/**
+	 * Narrow string with a subset of the String interface, that avoids any dynamic allocations until the number of
+	 * characters exceeds @p N. Useful for short temporary strings.
+	 */
+	template <UINT32 N>
+	class SmallString
+	{
+	public:
+		typedef char* iterator;
+		typedef const char* const_iterator;
+
+		SmallString()
+		{
+			mChars.push_back('\0');
+		}
+
+		SmallString(const char* str)
+			:SmallString(str, strlen(str))
+		{ }
+
+		SmallString(const char* str, size_t length)
+		{
+			mChars.reserve(length + 1);
+			mChars.assign(str, str + length);
+			mChars.push_back('\0');
+		}
+
+		SmallString(const String& str)
+			:SmallString(str.data(), str.size())
+		{ }
+
+		/** Returns a null-terminated array of characters in the string. */
+		const char* c_str() const { return mChars.data(); }
+
+		/** @copydoc c_str */
+		const char* data() const { return mChars.data(); }
+
+		/** Returns the number of characters in the string. */
+		size_t size() const { return mChars.size() - 1; }
+
+		/** @copydoc size */
+		size_t length() const { return mChars.size() - 1; }
+
+		/** Returns true if the string contains no characters. */
+		bool empty() const { return mChars.size() == 1; }
+
+		/** Removes all characters from the string. */
+		void clear()
+		{
+			mChars.clear();
+			mChars.push_back('\0');
+		}
+
+		/** Ensures the string can hold at least @p length characters without allocating more memory. */
+		void reserve(size_t length) { mChars.reserve(length + 1); }
+
+		char& operator[](size_t idx) { assert(idx < size()); return mChars[idx]; }
+		char operator[](size_t idx) const { assert(idx < size()); return mChars[idx]; }
+
+		iterator begin() { return mChars.begin(); }
+		const_iterator begin() const { return mChars.begin(); }
+		iterator end() { return mChars.end() - 1; }
+		const_iterator end() const { return mChars.end() - 1; }
+
+		/** Appends @p length characters from @p str to the end of the string. */
+		SmallString& append(const char* str, size_t length)
+		{
+			mChars.pop_back();
+			mChars.insert(mChars.end(), str, str + length);
+			mChars.push_back('\0');
+
+			return *this;
+		}
+
+		/** Appends a null-terminated string to the end of the string. */
+		SmallString& append(const char* str) { return append(str, strlen(str)); }
+
+		/** Appends the provided string to the end of the string. */
+		SmallString& append(const String& str) { return append(str.data(), str.size()); }
+
+		/** Appends the provided string to the end of the string. */
+		template <UINT32 M>
+		SmallString& append(const SmallString<M>& str) { return append(str.data(), str.size()); }
+
+		/** Appends a single character to the end of the string. */
+		void push_back(char c)
+		{
+			mChars.back() = c;
+			mChars.push_back('\0');
+		}
+
+		SmallString& operator+=(char c) { push_back(c); return *this; }
+		SmallString& operator+=(const char* str) { return append(str); }
+		SmallString& operator+=(const String& str) { return append(str); }
+
+		template <UINT32 M>
+		SmallString& operator+=(const SmallString<M>& str) { return append(str); }
+
+		/** Converts the string into a String. */
+		String toString() const { return String(data(), size()); }
+
+		bool operator==(const char* str) const { return strcmp(c_str(), str) == 0; }
+		bool operator==(const String& str) const
+		{
+			return size() == str.size() && memcmp(data(), str.data(), size()) == 0;
+		}
+
+		bool operator!=(const char* str) const { return !(*this == str); }
+		bool operator!=(const String& str) const { return !(*this == str); }
+
+		template <UINT32 M>
+		bool operator==(const SmallString<M>& str) const
+		{
+			return size() == str.size() && memcmp(data(), str.data(), size()) == 0;
+		}
+
+		template <UINT32 M>
+		bool operator!=(const SmallString<M>& str) const { return !(*this == str); }
+
+		template <UINT32 M>
+		bool operator<(const SmallString<M>& str) const { return strcmp(c_str(), str.c_str()) < 0; }
+
+	private:
+		SmallVector<char, N + 1> mChars;
+	};
 
 	/** @} */
 }
@@ -797,7 +920,7 @@ namespace bs
 		enum { id = 20 }; enum { hasDynamicSize = 1 };
 
 		static void toMemory(const String& data, char* memory)
-		{ 
+		{
 			UINT32 size = getDynamicSize(data);
 
 			memcpy(memory, &size, sizeof(UINT32));
@@ -807,7 +930,7 @@ namespace bs
 		}
 
 		static UINT32 fromMemory(String& data, char* memory)
-		{ 
+		{
 			UINT32 size;
 			memcpy(&size, memory, sizeof(UINT32)); 
 			memory += sizeof(UINT32);
@@ -824,7 +947,7 @@ namespace bs
 		}
 
 		static UINT32 getDynamicSize(const String& data)	
-		{ 
+		{
 			UINT64 dataSize = data.size() * sizeof(String::value_type) + sizeof(UINT32);
 
 #if BS_DEBUG_MODE
@@ -848,7 +971,7 @@ namespace bs
 		enum { id = TID_WString }; enum { hasDynamicSize = 1 };
 
 		static void toMemory(const WString& data, char* memory)
-		{ 
+		{
 			UINT32 size = getDynamicSize(data);
 
 			memcpy(memory, &size, sizeof(UINT32));
@@ -858,7 +981,7 @@ namespace bs
 		}
 
 		static UINT32 fromMemory(WString& data, char* memory)
-		{ 
+		{
 			UINT32 size;
 			memcpy(&size, memory, sizeof(UINT32)); 
 			memory += sizeof(UINT32);
@@ -878,7 +1001,7 @@ namespace bs
 		}
 
 		static UINT32 getDynamicSize(const WString& data)	
-		{ 
+		{
 			UINT64 dataSize = data.size() * sizeof(WString::value_type) + sizeof(UINT32);
 
 #if BS_DEBUG_MODE
@@ -0,0 +1,234 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Threading/BsJobGraph.h"
+#include "Threading/BsTaskScheduler.h"
+
+using namespace std::chrono;
+
+namespace bs
+{
+	JobGraph::~JobGraph()
+	{
+		clear();
+	}
+
+	UINT32 JobGraph::addJob(const JOB_DESC& desc)
+	{
+		Job* job = bs_new<Job>();
+		job->desc = desc;
+
+		mJobs.push_back(job);
+		mIsDirty = true;
+
+		return (UINT32)mJobs.size() - 1;
+	}
+
+	void JobGraph::clear()
+	{
+		for(auto& entry : mJobs)
+			bs_delete(entry);
+
+		mJobs.clear();
+		mIsDirty = false;
+	}
+
+	const Vector<UINT32>& JobGraph::getDependencies(UINT32 jobIdx)
+	{
+		build();
+
+		return mJobs[jobIdx]->dependencies;
+	}
+
+	void JobGraph::build()
+	{
+		if(!mIsDirty)
+			return;
+
+		const UINT32 numJobs = (UINT32)mJobs.size();
+		for(UINT32 i = 0; i < numJobs; i++)
+		{
+			Job* job = mJobs[i];
+			job->dependencies.clear();
+			job->dependents.clear();
+
+			if(!job->desc.callingThreadOnly && job->task == nullptr)
+				job->task = Task::create(job->desc.name, [this, i]() { run(i); });
+		}
+
+		// Each job depends on all the earlier jobs it has a read-after-write, write-after-write or write-after-read
+		// hazard with. This ensures the results are the same as if the jobs were executed in order.
+		for(UINT32 i = 0; i < numJobs; i++)
+		{
+			Job* job = mJobs[i];
+			for(UINT32 j = 0; j < i; j++)
+			{
+				Job* prevJob = mJobs[j];
+
+				const bool hasHazard = 
+					overlaps(prevJob->desc.writes, job->desc.reads) ||
+					overlaps(prevJob->desc.writes, job->desc.writes) ||
+					overlaps(prevJob->desc.reads, job->desc.writes);
+
+				if(!hasHazard)
+					continue;
+
+				job->dependencies.push_back(j);
+				prevJob->dependents.push_back(i);
+			}
+		}
+
+		mIsDirty = false;
+	}
+
+	void JobGraph::execute()
+	{
+		build();
+
+		const UINT32 numJobs = (UINT32)mJobs.size();
+		if(numJobs == 0)
+			return;
+
+		mTimeline.entries.resize(numJobs);
+		for(UINT32 i = 0; i < numJobs; i++)
+		{
+			mTimeline.entries[i] = JobTimelineEntry();
+			mTimeline.entries[i].name = mJobs[i]->desc.name;
+
+			mJobs[i]->numRemainingDependencies = (UINT32)mJobs[i]->dependencies.size();
+		}
+
+		mNumRemainingJobs = numJobs;
+		mCallingThreadId = BS_THREAD_CURRENT_ID;
+		mStartTime = high_resolution_clock::now();
+
+		for(UINT32 i = 0; i < numJobs; i++)
+		{
+			if(mJobs[i]->dependencies.empty())
+				schedule(i);
+		}
+
+		// Execute jobs that need to run on this thread as they become ready, until everything completes. While waiting
+		// for them, help out with the queued jobs and other tasks.
+		const auto isReady = [this]()
+		{
+			Lock lock(mMutex);
+			return !mReadyCallingThreadJobs.empty() || mNumRemainingJobs == 0;
+		};
+
+		while(true)
+		{
+			TaskScheduler::instance().waitUntil(isReady);
+
+			UINT32 jobIdx;
+			{
+				Lock lock(mMutex);
+
+				if(mReadyCallingThreadJobs.empty())
+					break;
+
+				jobIdx = mReadyCallingThreadJobs.front();
+				mReadyCallingThreadJobs.erase(mReadyCallingThreadJobs.begin());
+			}
+
+			run(jobIdx);
+		}
+
+		// Make sure the scheduler is done with the tasks, so they can be re-queued next time
+		for(auto& entry : mJobs)
+		{
+			if(entry->task != nullptr)
+				entry->task->wait();
+		}
+
+		mTimeline.totalUs = (UINT64)duration_cast<microseconds>(high_resolution_clock::now() - mStartTime).count();
+		calculateCriticalPath();
+	}
+
+	void JobGraph::schedule(UINT32 jobIdx)
+	{
+		Job* job = mJobs[jobIdx];
+		if(job->desc.callingThreadOnly)
+		{
+			Lock lock(mMutex);
+			mReadyCallingThreadJobs.push_back(jobIdx);
+		}
+		else
+			TaskScheduler::instance().addTask(job->task);
+	}
+
+	void JobGraph::run(UINT32 jobIdx)
+	{
+		Job* job = mJobs[jobIdx];
+		JobTimelineEntry& timelineEntry = mTimeline.entries[jobIdx];
+
+		timelineEntry.callingThread = BS_THREAD_CURRENT_ID == mCallingThreadId;
+		timelineEntry.startUs = (UINT64)duration_cast<microseconds>(high_resolution_clock::now() - mStartTime).count();
+
+		if(job->desc.worker)
+			job->desc.worker();
+
+		timelineEntry.endUs = (UINT64)duration_cast<microseconds>(high_resolution_clock::now() - mStartTime).count();
+
+		for(auto& dependentIdx : job->dependents)
+		{
+			if(--mJobs[dependentIdx]->numRemainingDependencies == 0)
+				schedule(dependentIdx);
+		}
+
+		Lock lock(mMutex);
+		mNumRemainingJobs--;
+	}
+
+	void JobGraph::calculateCriticalPath()
+	{
+		// Jobs are always added after their dependencies, so a single pass in order is enough to find the longest path
+		// ending at each job
+		const UINT32 numJobs = (UINT32)mJobs.size();
+
+		Vector<UINT64> pathLength(numJobs, 0);
+		Vector<UINT32> pathPrev(numJobs, (UINT32)-1);
+
+		UINT32 lastJobIdx = 0;
+		for(UINT32 i = 0; i < numJobs; i++)
+		{
+			UINT64 longestDependency = 0;
+			for(auto& dependencyIdx : mJobs[i]->dependencies)
+			{
+				if(pathLength[dependencyIdx] >= longestDependency)
+				{
+					longestDependency = pathLength[dependencyIdx];
+					pathPrev[i] = dependencyIdx;
+				}
+			}
+
+			const JobTimelineEntry& entry = mTimeline.entries[i];
+			pathLength[i] = longestDependency + (entry.endUs - entry.startUs);
+
+			if(pathLength[i] >= pathLength[lastJobIdx])
+				lastJobIdx = i;
+		}
+
+		mTimeline.criticalPathUs = pathLength[lastJobIdx];
+
+		UINT32 curJobIdx = lastJobIdx;
+		while(curJobIdx != (UINT32)-1)
+		{
+			mTimeline.entries[curJobIdx].criticalPath = true;
+			curJobIdx = pathPrev[curJobIdx];
+		}
+	}
+
+	bool JobGraph::overlaps(const Vector<StringID>& a, const Vector<StringID>& b)
+	{
+		for(auto& entryA : a)
+		{
+			for(auto& entryB : b)
+			{
+				if(entryA == entryB)
+					return true;
+			}
+		}
+
+		return false;
+	}
+}
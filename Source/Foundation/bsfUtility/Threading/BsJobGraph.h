@@ -0,0 +1,138 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "String/BsStringID.h"
+
+namespace bs
+{
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	/** Describes a single job in a JobGraph. */
+	struct JOB_DESC
+	{
+		/** Name used for identifying the job in the timeline. */
+		String name;
+
+		/** Method that performs the work of the job. */
+		std::function<void()> worker;
+
+		/** Identifiers of data the job reads from. */
+		Vector<StringID> reads;
+
+		/** Identifiers of data the job writes to. */
+		Vector<StringID> writes;
+
+		/** 
+		 * If true the job will always execute on the thread calling JobGraph::execute(). Otherwise the job may execute
+		 * on any worker thread of the TaskScheduler.
+		 */
+		bool callingThreadOnly = true;
+	};
+
+	/** Information about a single job executed by a JobGraph. */
+	struct JobTimelineEntry
+	{
+		String name;
+		UINT64 startUs = 0; /**< Time at which the job started, in microseconds since the start of execution. */
+		UINT64 endUs = 0; /**< Time at which the job ended, in microseconds since the start of execution. */
+		bool callingThread = false; /**< True if the job executed on the thread that called JobGraph::execute(). */
+		bool criticalPath = false; /**< True if the job is a part of the critical path of the execution. */
+	};
+
+	/** Information about timing of all the jobs during the last JobGraph execution. */
+	struct JobGraphTimeline
+	{
+		/** One entry per job, in order the jobs were added to the graph. */
+		Vector<JobTimelineEntry> entries;
+
+		/** Total time in microseconds it took to execute all the jobs. */
+		UINT64 totalUs = 0;
+
+		/** 
+		 * Sum of job durations along the longest dependency chain, in microseconds. This is the minimum time the execution
+		 * could have taken, regardless of the number of available threads.
+		 */
+		UINT64 criticalPathUs = 0;
+	};
+
+	/**
+	 * Executes a set of jobs with dependencies between them, running independent jobs in parallel. Dependencies are
+	 * determined from the data each job declares it reads or writes: a job depends on every job added before it that
+	 * writes data it accesses, or reads data it writes. Therefore executing the graph always yields the same result as
+	 * executing the jobs sequentially in the order they were added.
+	 *
+	 * @note	Jobs that are not restricted to the calling thread are executed through the TaskScheduler.
+	 */
+	class BS_UTILITY_EXPORT JobGraph
+	{
+	public:
+		JobGraph() = default;
+		~JobGraph();
+
+		/** Adds a new job to the graph and returns its index. */
+		UINT32 addJob(const JOB_DESC& desc);
+
+		/** Removes all jobs from the graph. Timeline from the last execution remains available. */
+		void clear();
+
+		/** 
+		 * Executes all the jobs in the graph, respecting their dependencies. Blocks until all the jobs complete. Jobs that
+		 * must execute on the calling thread are executed while waiting, and the calling thread helps the TaskScheduler
+		 * execute queued tasks in between them.
+		 */
+		void execute();
+
+		/** Returns the number of jobs in the graph. */
+		UINT32 getNumJobs() const { return (UINT32)mJobs.size(); }
+
+		/** Returns the indices of jobs that the job with the specified index directly depends on. */
+		const Vector<UINT32>& getDependencies(UINT32 jobIdx);
+
+		/** Returns the timing information from the last call to execute(). */
+		const JobGraphTimeline& getLastTimeline() const { return mTimeline; }
+
+	private:
+		/** Information about a single job in the graph. */
+		struct Job
+		{
+			JOB_DESC desc;
+			Vector<UINT32> dependencies;
+			Vector<UINT32> dependents;
+			SPtr<Task> task;
+			std::atomic<UINT32> numRemainingDependencies{0};
+		};
+
+		/** Calculates dependencies between jobs, if the jobs have changed since the last time. */
+		void build();
+
+		/** Queues a job whose dependencies have all been completed. */
+		void schedule(UINT32 jobIdx);
+
+		/** Executes the job, records its timing and schedules any dependent jobs that became ready. */
+		void run(UINT32 jobIdx);
+
+		/** Calculates the critical path of the last execution and marks the relevant timeline entries. */
+		void calculateCriticalPath();
+
+		/** Checks if the two lists contain at least one common element. */
+		static bool overlaps(const Vector<StringID>& a, const Vector<StringID>& b);
+
+		Vector<Job*> mJobs;
+		bool mIsDirty = false;
+
+		Vector<UINT32> mReadyCallingThreadJobs;
+		UINT32 mNumRemainingJobs = 0;
+		ThreadId mCallingThreadId;
+		std::chrono::high_resolution_clock::time_point mStartTime;
+
+		JobGraphTimeline mTimeline;
+
+		Mutex mMutex;
+	};
+
+	/** @} */
+}
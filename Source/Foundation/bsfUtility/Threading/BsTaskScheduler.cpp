@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Math/BsMath.h"
+#include <chrono>
 
 namespace bs
 {
@@ -65,211 +67,616 @@ namespace bs
 			mParent->waitUntilComplete(this);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare)
-	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+	/** Duration a single chunk of parallelFor() work should take when the chunk size is determined automatically. */
+	static constexpr UINT64 TARGET_CHUNK_DURATION_NS = 20000;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
-	}
+	/** Maximum size of the first chunks executed by parallelFor(), before the cost of an index is known. */
+	static constexpr UINT32 MAX_INITIAL_CHUNK_SIZE = 64;
 
-	TaskScheduler::~TaskScheduler()
+	/** Shared state of a single parallelFor() invocation. */
+	struct ParallelForJob
 	{
-		// Wait until all tasks complete
+		ParallelForJob(UINT32 begin, UINT32 end, UINT32 grainSize, UINT32 numParticipants, 
+			const std::function<void(UINT32, UINT32, UINT32)>* worker)
+			: end(end), grainSize(grainSize), numParticipants(numParticipants), worker(worker), next(begin)
+			, numRemaining(end - begin)
+		{ }
+
+		/** 
+		 * Claims the next chunk to process. Returns false if there are no more chunks left. The size of the chunk is
+		 * either the fixed grain size, or estimated from the measured cost per index.
+		 */
+		bool claim(UINT32& chunkBegin, UINT32& chunkEnd)
+		{
+			UINT32 chunkSize = grainSize;
+			if(chunkSize == 0)
+			{
+				const UINT32 current = next.load(std::memory_order_relaxed);
+				if(current >= end)
+					return false;
+
+				// Keep enough chunks around so the work remains balanced near the end of the range
+				const UINT32 maxChunkSize = std::max(1U, (end - current) / (numParticipants * 2));
+
+				const UINT64 costPerIdx = costPerIdxPs.load(std::memory_order_relaxed);
+				if(costPerIdx == 0)
+					chunkSize = std::min(maxChunkSize, MAX_INITIAL_CHUNK_SIZE);
+				else
+				{
+					const UINT64 optimalSize = (TARGET_CHUNK_DURATION_NS * 1000) / costPerIdx;
+					chunkSize = (UINT32)Math::clamp(optimalSize, (UINT64)1, (UINT64)maxChunkSize);
+				}
+			}
+
+			chunkBegin = next.fetch_add(chunkSize);
+			if(chunkBegin >= end)
+				return false;
+
+			chunkEnd = std::min(end, chunkBegin + chunkSize);
+			return true;
+		}
+
+		/** 
+		 * Executes chunks until there are none left to claim. Returns true if the calling thread completed the last
+		 * chunk of the job.
+		 */
+		bool execute(UINT32 participantIdx)
 		{
-			Lock activeTaskLock(mReadyMutex);
+			using namespace std::chrono;
 
-			while (mActiveTasks.size() > 0)
+			bool completed = false;
+
+			UINT32 chunkBegin, chunkEnd;
+			while(claim(chunkBegin, chunkEnd))
 			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+				const auto startTime = high_resolution_clock::now();
+				(*worker)(chunkBegin, chunkEnd, participantIdx);
+
+				const UINT32 chunkSize = chunkEnd - chunkBegin;
+				if(grainSize == 0)
+				{
+					const UINT64 elapsedNs = (UINT64)duration_cast<nanoseconds>(high_resolution_clock::now() - startTime).count();
+					const UINT64 measuredCost = std::max((UINT64)1, (elapsedNs * 1000) / chunkSize);
+					const UINT64 prevCost = costPerIdxPs.load(std::memory_order_relaxed);
 
-				task->wait();
-				activeTaskLock.lock();
+					costPerIdxPs.store(prevCost == 0 ? measuredCost : (prevCost + measuredCost) / 2, 
+						std::memory_order_relaxed);
+				}
+
+				if(numRemaining.fetch_sub(chunkSize) == chunkSize)
+					completed = true;
 			}
+
+			return completed;
+		}
+
+		const UINT32 end;
+		const UINT32 grainSize;
+		const UINT32 numParticipants;
+		const std::function<void(UINT32, UINT32, UINT32)>* worker;
+
+		std::atomic<UINT32> next;
+		std::atomic<UINT32> numRemaining;
+		std::atomic<UINT64> costPerIdxPs{0};
+	};
+
+	constexpr UINT32 TaskScheduler::NUM_PRIORITY_LANES;
+	constexpr UINT32 TaskScheduler::MAX_WORKER_THREADS;
+
+	BS_THREADLOCAL TaskScheduler::Worker* TaskScheduler::sCurrentWorker = nullptr;
+
+	void TaskScheduler::TaskQueue::push(SPtr<Task> task, UINT32 lane)
+	{
+		ScopedSpinLock spinLock(lock);
+
+		lanes[lane].push_back(std::move(task));
+		numQueued++;
+	}
+
+	SPtr<Task> TaskScheduler::TaskQueue::pop(UINT32 lane, bool fromBack)
+	{
+		// Early out without touching the lock, most queues will be empty most of the time
+		if(numQueued.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		ScopedSpinLock spinLock(lock);
+
+		Deque<SPtr<Task>>& tasks = lanes[lane];
+		if(tasks.empty())
+			return nullptr;
+
+		SPtr<Task> task;
+		if(fromBack)
+		{
+			task = std::move(tasks.back());
+			tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(tasks.front());
+			tasks.pop_front();
 		}
 
-		// Start shutdown of the main queue worker and wait until it exits
+		numQueued--;
+		return task;
+	}
+
+	TaskScheduler::TaskScheduler()
+	{
+		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		// Signal the workers to exit as soon as they finish their current task. Done under the spawn mutex so no new
+		// workers can get spawned afterwards.
+		Worker* workers[MAX_WORKER_THREADS];
+		UINT32 numThreads;
 		{
-			Lock lock(mReadyMutex);
+			Lock spawnLock(mSpawnMutex);
+			{
+				Lock lock(mSleepMutex);
+				mShutdown = true;
+			}
 
-			mShutdown = true;
+			numThreads = mNumWorkerThreads;
+			for(UINT32 i = 0; i < numThreads; i++)
+				workers[i] = mWorkers[i];
 		}
 
-		mTaskReadyCond.notify_one();
+		mTaskReadyCond.notify_all();
+		mWorkerParkedCond.notify_all();
+		mTaskCompleteCond.notify_all();
+
+		// Wait until all the workers exit. Note: Spawn mutex must not be held here, as workers finishing their last 
+		// task might still try to spawn new workers.
+		for(UINT32 i = 0; i < numThreads; i++)
+			workers[i]->thread.blockUntilComplete();
 
-		mTaskSchedulerThread.blockUntilComplete();
+		Lock spawnLock(mSpawnMutex);
+		for(UINT32 i = 0; i < numThreads; i++)
+		{
+			bs_delete(mWorkers[i]);
+			mWorkers[i] = nullptr;
+		}
+
+		mNumWorkerThreads = 0;
 	}
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
 		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mCheckTasks = true;
-		mTaskQueue.insert(std::move(task));
+		{
+			ScopedSpinLock lock(task->mDependentsLock);
+			task->mDependentsReleased = false;
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		if(deferUntilDependencyComplete(task))
+			return;
+
+		queueTask(std::move(task));
+		notifyTaskQueued(1);
 	}
 
 	void TaskScheduler::addTaskGroup(const SPtr<TaskGroup>& taskGroup)
 	{
-		Lock lock(mReadyMutex);
+		taskGroup->mParent = this;
+
+		// Rather than creating a task per item, create one task per worker, each processing items until none are left
+		const UINT32 numTasks = std::min(taskGroup->mCount, std::max(1U, (UINT32)mMaxActiveTasks));
 
-		for(UINT32 i = 0; i < taskGroup->mCount; i++)
+		UINT32 numQueued = 0;
+		for(UINT32 i = 0; i < numTasks; i++)
 		{
-			const auto worker = [i, taskGroup] 
+			const auto worker = [taskGroup] 
 			{ 
-				taskGroup->mTaskWorker(i); 
-				--taskGroup->mNumRemainingTasks;
+				UINT32 idx;
+				while((idx = taskGroup->mNextTaskIdx++) < taskGroup->mCount)
+				{
+					taskGroup->mTaskWorker(idx); 
+					--taskGroup->mNumRemainingTasks;
+				}
 			};
 
 			SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
 			task->mParent = this;
 			task->mTaskId = mNextTaskId++;
-			task->mState.store(0); // Reset state in case the task is getting re-queued
 
-			mCheckTasks = true;
-			mTaskQueue.insert(std::move(task));
-		}
+			if(deferUntilDependencyComplete(task))
+				continue;
 
-		taskGroup->mParent = this;
+			queueTask(std::move(task));
+			numQueued++;
+		}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		if(numQueued > 0)
+			notifyTaskQueued(numQueued);
 	}
 
 	void TaskScheduler::addWorker()
 	{
-		Lock lock(mReadyMutex);
+		{
+			Lock lock(mSleepMutex);
+			mMaxActiveTasks++;
+		}
 
-		mMaxActiveTasks++;
+		// A spot freed up, un-park a worker if one is parked, or spawn a new one if there is work waiting
+		mWorkerParkedCond.notify_all();
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		UINT32 numQueued = mSharedQueue.numQueued;
+		UINT32 numThreads = mNumWorkerThreads;
+		for(UINT32 i = 0; i < numThreads; i++)
+			numQueued += mWorkers[i]->queue.numQueued;
+
+		if(numQueued > 0)
+			spawnWorkers(1);
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
+		{
+			Lock lock(mSleepMutex);
 
-		if(mMaxActiveTasks > 0)
-			mMaxActiveTasks--;
+			if(mMaxActiveTasks > 0)
+				mMaxActiveTasks--;
+		}
+
+		// Make sure sleeping workers over the limit move to the parked state
+		mTaskReadyCond.notify_all();
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::spawnWorkers(UINT32 count)
 	{
-		while(true)
+		Lock lock(mSpawnMutex);
+
+		if(mShutdown)
+			return;
+
+		UINT32 numThreads = mNumWorkerThreads;
+		const UINT32 maxThreads = std::min((UINT32)mMaxActiveTasks, MAX_WORKER_THREADS);
+		while(count > 0 && numThreads < maxThreads)
 		{
-			Lock lock(mReadyMutex);
+			Worker* worker = bs_new<Worker>();
+			worker->owner = this;
+			worker->index = numThreads;
 
-			while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
-				mTaskReadyCond.wait(lock);
+			mWorkers[numThreads] = worker;
+			mNumWorkerThreads = ++numThreads;
 
-			mCheckTasks = false;
+			worker->thread = ThreadPool::instance().run("TaskWorker", [this, worker]() { runWorker(worker); });
+			count--;
+		}
+	}
+
+	void TaskScheduler::runWorker(Worker* worker)
+	{
+		sCurrentWorker = worker;
+
+		while(true)
+		{
+			// Park the worker while there are more workers than allowed simultaneous tasks
+			if(worker->index >= mMaxActiveTasks)
+			{
+				Lock lock(mSleepMutex);
+
+				while(worker->index >= mMaxActiveTasks && !mShutdown)
+					mWorkerParkedCond.wait(lock);
+			}
 
 			if(mShutdown)
 				break;
 
-			for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+			const UINT64 generation = mGeneration;
+
+			SPtr<Task> task = findTask(worker);
+			if(task != nullptr)
 			{
-				if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
-					break;	
+				runTask(std::move(task));
+				continue;
+			}
 
-				SPtr<Task> curTask = *iter;
+			// Nothing to do, sleep until something gets queued
+			Lock lock(mSleepMutex);
 
-				if(curTask->isCanceled())
-				{
-					iter = mTaskQueue.erase(iter);
-					continue;
-				}
+			mNumSleepingWorkers++;
+			while(generation == mGeneration && worker->index < mMaxActiveTasks && !mShutdown)
+				mTaskReadyCond.wait(lock);
+			mNumSleepingWorkers--;
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-				{
-					++iter;
-					continue;
-				}
+			// If we are about to park, pass on any wake-up we might have consumed to another worker
+			if(worker->index >= mMaxActiveTasks && generation != mGeneration)
+				mTaskReadyCond.notify_one();
+		}
+
+		sCurrentWorker = nullptr;
+	}
 
-				iter = mTaskQueue.erase(iter);
+	SPtr<Task> TaskScheduler::findTask(Worker* worker)
+	{
+		const UINT32 numThreads = mNumWorkerThreads;
+		const UINT32 stealStart = worker != nullptr ? worker->index + 1 : (UINT32)mGeneration;
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+		for(UINT32 lane = 0; lane < NUM_PRIORITY_LANES; lane++)
+		{
+			SPtr<Task> task;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+			// Prefer own tasks, most recent first as they are likely still in cache
+			if(worker != nullptr)
+			{
+				task = worker->queue.pop(lane, true);
+				if(task != nullptr)
+					return task;
+			}
+
+			task = mSharedQueue.pop(lane, false);
+			if(task != nullptr)
+				return task;
+
+			// Steal the oldest task from another worker
+			for(UINT32 i = 0; i < numThreads; i++)
+			{
+				Worker* victim = mWorkers[(stealStart + i) % numThreads];
+				if(victim == worker)
+					continue;
+
+				task = victim->queue.pop(lane, false);
+				if(task != nullptr)
+					return task;
 			}
 		}
+
+		return nullptr;
+	}
+
+	bool TaskScheduler::runOneTask()
+	{
+		Worker* worker = sCurrentWorker;
+		if(worker != nullptr && worker->owner != this)
+			worker = nullptr;
+
+		SPtr<Task> task = findTask(worker);
+		if(task == nullptr)
+			return false;
+
+		runTask(std::move(task));
+		return true;
 	}
 
 	void TaskScheduler::runTask(SPtr<Task> task)
 	{
+		UINT32 expectedState = 0;
+		if(!task->mState.compare_exchange_strong(expectedState, 1))
+		{
+			// Task was canceled while it was queued
+			releaseDependents(task.get(), true);
+			notifyTaskComplete();
+
+			return;
+		}
+
+		mNumActiveTasks++;
 		task->mTaskWorker();
+		mNumActiveTasks--;
+
+		releaseDependents(task.get(), false);
+		notifyTaskComplete();
+	}
+
+	void TaskScheduler::queueTask(SPtr<Task> task)
+	{
+		const UINT32 lane = getLaneIdx(task->mPriority);
+
+		Worker* worker = sCurrentWorker;
+		if(worker != nullptr && worker->owner == this)
+			worker->queue.push(std::move(task), lane);
+		else
+			mSharedQueue.push(std::move(task), lane);
+	}
+
+	bool TaskScheduler::deferUntilDependencyComplete(const SPtr<Task>& task)
+	{
+		Task* dependency = task->mTaskDependency.get();
+		if(dependency == nullptr)
+			return false;
+
+		ScopedSpinLock lock(dependency->mDependentsLock);
 
+		if(!dependency->mDependentsReleased)
 		{
-			Lock lock(mReadyMutex);
+			dependency->mDependents.push_back(task);
+			return true;
+		}
 
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+		// Dependency was canceled, so is this task
+		if(dependency->isCanceled())
+		{
+			task->mState.store(3);
+			return true;
 		}
 
+		return false;
+	}
+
+	void TaskScheduler::releaseDependents(Task* task, bool cancel)
+	{
+		Vector<SPtr<Task>> dependents;
 		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			ScopedSpinLock lock(task->mDependentsLock);
 
-			mTaskCompleteCond.notify_all();
+			if(!cancel)
+				task->mState.store(2);
+
+			task->mDependentsReleased = true;
+			std::swap(dependents, task->mDependents);
 		}
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
+		if(dependents.empty())
+			return;
+
+		if(cancel)
 		{
-			Lock lock(mReadyMutex);
+			for(auto& entry : dependents)
+			{
+				entry->mState.store(3);
+				releaseDependents(entry.get(), true);
+			}
+		}
+		else
+		{
+			for(auto& entry : dependents)
+				queueTask(std::move(entry));
 
-			mCheckTasks = true;
-			mTaskReadyCond.notify_one();
+			notifyTaskQueued((UINT32)dependents.size());
 		}
 	}
 
-	void TaskScheduler::waitUntilComplete(const Task* task)
+	void TaskScheduler::notifyTaskQueued(UINT32 count)
 	{
-		if(task->isCanceled())
-			return;
+		mGeneration++;
 
+		if(mNumSleepingWorkers > 0)
 		{
-			Lock lock(mCompleteMutex);
+			Lock lock(mSleepMutex);
 
-			while(!task->isComplete())
-			{
-				addWorker();
-				mTaskCompleteCond.wait(lock);
-				removeWorker();
-			}
+			if(count > 1)
+				mTaskReadyCond.notify_all();
+			else
+				mTaskReadyCond.notify_one();
+		}
+		else if(mNumWorkerThreads < std::min((UINT32)mMaxActiveTasks, MAX_WORKER_THREADS))
+			spawnWorkers(count);
+
+		// Threads blocked in wait() can help with the new tasks
+		if(mNumWaiters > 0)
+		{
+			Lock lock(mSleepMutex);
+			mTaskCompleteCond.notify_all();
 		}
 	}
 
-	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
+	void TaskScheduler::notifyTaskComplete()
 	{
-		Lock lock(mCompleteMutex);
+		mGeneration++;
 
-		while (taskGroup->mNumRemainingTasks > 0)
+		if(mNumWaiters > 0)
 		{
-			addWorker();
+			Lock lock(mSleepMutex);
+			mTaskCompleteCond.notify_all();
+		}
+	}
+
+	void TaskScheduler::waitForProgress(UINT64 generation, const std::function<bool()>& isDone, bool stopOnShutdown)
+	{
+		Lock lock(mSleepMutex);
+
+		mNumWaiters++;
+		while(generation == mGeneration && !isDone() && !(stopOnShutdown && mShutdown))
 			mTaskCompleteCond.wait(lock);
-			removeWorker();
+		mNumWaiters--;
+	}
+
+	void TaskScheduler::waitUntil(const std::function<bool()>& isDone)
+	{
+		while(!isDone())
+		{
+			const UINT64 generation = mGeneration;
+
+			// Help out with queued work instead of idling
+			if(runOneTask())
+				continue;
+
+			// Workers are exiting, so the remaining work might never get executed
+			if(mShutdown)
+				break;
+
+			waitForProgress(generation, isDone);
 		}
 	}
 
-	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
+	void TaskScheduler::waitUntilComplete(const Task* task)
 	{
-		// If one tasks priority is higher, that one goes first
-		if(lhs->mPriority > rhs->mPriority)
-			return true;
+		waitUntil([task]() { return task->isComplete() || task->isCanceled(); });
+	}
+
+	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
+	{
+		waitUntil([taskGroup]() { return taskGroup->mNumRemainingTasks == 0; });
+	}
+
+	void TaskScheduler::parallelForInternal(UINT32 begin, UINT32 end, UINT32 grainSize, 
+		const std::function<void(UINT32, UINT32, UINT32)>& worker, UINT32 maxHelpers, TaskPriority priority)
+	{
+		if(begin >= end)
+			return;
+
+		const UINT32 count = end - begin;
+
+		UINT32 numHelpers = std::min(maxHelpers, count - 1);
+		if(grainSize > 0)
+			numHelpers = std::min(numHelpers, Math::divideAndRoundUp(count, grainSize) - 1);
 
-		// Otherwise we go by smaller id, as that task was queued earlier than the other
-		return lhs->mTaskId < rhs->mTaskId;
+		// Not worth involving other threads
+		if(numHelpers == 0)
+		{
+			worker(begin, end, 0);
+			return;
+		}
+
+		// Note: Helpers only touch the worker method while there are unclaimed chunks, which means the caller is still
+		// waiting and the method is still alive. The job itself may outlive the call, so it needs to be shared.
+		SPtr<ParallelForJob> job = bs_shared_ptr_new<ParallelForJob>(begin, end, grainSize, numHelpers + 1, &worker);
+
+		Vector<SPtr<Task>> helpers;
+		helpers.reserve(numHelpers);
+
+		for(UINT32 i = 0; i < numHelpers; i++)
+		{
+			const UINT32 participantIdx = i + 1;
+			const auto helperWorker = [this, job, participantIdx]()
+			{
+				if(job->execute(participantIdx))
+					notifyTaskComplete();
+			};
+
+			SPtr<Task> task = Task::create("ParallelFor", helperWorker, priority);
+			task->mParent = this;
+			task->mTaskId = mNextTaskId++;
+
+			helpers.push_back(task);
+			queueTask(std::move(task));
+		}
+
+		notifyTaskQueued(numHelpers);
+
+		// Participate in the work ourselves, then help out with other tasks until the helpers finish
+		job->execute(0);
+
+		const auto isDone = [&job]() { return job->numRemaining == 0; };
+		while(!isDone())
+		{
+			const UINT64 generation = mGeneration;
+
+			if(runOneTask())
+				continue;
+
+			// All chunks are claimed at this point, and the workers executing the remaining ones finish them even during
+			// shutdown. Those chunks reference the worker method, so keep waiting for them rather than bailing out.
+			waitForProgress(generation, isDone, false);
+		}
+
+		// Helpers that haven't started yet have nothing left to do
+		for(auto& entry : helpers)
+			entry->cancel();
+	}
+
+	UINT32 TaskScheduler::getLaneIdx(TaskPriority priority)
+	{
+		const UINT32 lane = (UINT32)TaskPriority::VeryHigh - (UINT32)priority;
+		return std::min(lane, NUM_PRIORITY_LANES - 1);
 	}
 }
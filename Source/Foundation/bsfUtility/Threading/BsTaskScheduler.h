@@ -57,7 +57,8 @@ namespace bs
 		/**
 		 * Blocks the current thread until the task has completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	While waiting the calling thread helps execute other queued tasks, so that the blocking threads core
+		 *			can be utilized.
 		 */
 		void wait();
 
@@ -75,6 +76,11 @@ namespace bs
 		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent = nullptr;
+
+		/** Tasks that were queued while this task was still pending, and are waiting on it to complete. */
+		Vector<SPtr<Task>> mDependents;
+		bool mDependentsReleased = false;
+		SpinLock mDependentsLock;
 	};
 
 	/**
@@ -110,7 +116,8 @@ namespace bs
 		/**
 		 * Blocks the current thread until all tasks in the group have completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	While waiting the calling thread helps execute other queued tasks, so that the blocking threads core
+		 *			can be utilized.
 		 */
 		void wait();
 
@@ -123,6 +130,7 @@ namespace bs
 		std::function<void(UINT32)> mTaskWorker;
 		SPtr<Task> mTaskDependency;
 		std::atomic<UINT32> mNumRemainingTasks{mCount};
+		std::atomic<UINT32> mNextTaskIdx{0};
 
 		TaskScheduler* mParent = nullptr;
 	};
@@ -134,12 +142,13 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * Each worker thread keeps its own queue of tasks, split into one lane per TaskPriority. Tasks queued from a worker
+	 * thread go into that worker's queue, while tasks queued from any other thread go into a shared queue. Idle workers
+	 * steal tasks from other workers' queues. Higher priority lanes are always drained before lower priority ones, but
+	 * within a lane tasks are not guaranteed to execute in the exact order they were queued.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will allow as many active workers as there are logical CPU cores. You may add or
+	 * remove workers using addWorker()/removeWorker() methods.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
@@ -161,37 +170,196 @@ namespace bs
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/**
+		 * Blocks the calling thread until @p isDone returns true, executing queued tasks while it waits. The condition is
+		 * re-checked whenever a task is queued or completes, so it should only depend on state that is changed by tasks.
+		 * Also returns once the scheduler starts shutting down and there is no more work left to help with.
+		 */
+		void waitUntil(const std::function<bool()>& isDone);
+
+		/**
+		 * Calls @p worker for every index in range [@p begin, @p end). The range is split into chunks which are executed in
+		 * parallel by the worker threads and the calling thread. Blocks until all the indices have been processed.
+		 *
+		 * @param[in]	begin		First index to process.
+		 * @param[in]	end			Index one past the last index to process.
+		 * @param[in]	grainSize	Number of indices in a single chunk. If zero the chunk size is determined automatically,
+		 *							from the measured cost of the chunks that were already executed.
+		 * @param[in]	worker		Callable with signature void(UINT32) that processes a single index. Will be called
+		 *							from multiple threads at once.
+		 * @param[in]	priority	(optional) Priority of the tasks used for executing the chunks on worker threads.
+		 */
+		template<class Fn>
+		void parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, Fn worker, 
+			TaskPriority priority = TaskPriority::Normal)
+		{
+			const std::function<void(UINT32, UINT32, UINT32)> rangeWorker = 
+				[&worker](UINT32 rangeBegin, UINT32 rangeEnd, UINT32 participantIdx)
+			{
+				for(UINT32 i = rangeBegin; i < rangeEnd; i++)
+					worker(i);
+			};
+
+			parallelForInternal(begin, end, grainSize, rangeWorker, getNumWorkers(), priority);
+		}
+
+		/**
+		 * Calls @p worker for every index in range [@p begin, @p end) in parallel, same as parallelFor(), and combines the
+		 * values it returns using @p join.
+		 *
+		 * @param[in]	begin		First index to process.
+		 * @param[in]	end			Index one past the last index to process.
+		 * @param[in]	grainSize	Number of indices in a single chunk. If zero the chunk size is determined automatically.
+		 * @param[in]	identity	Value that when joined with any other value returns that other value.
+		 * @param[in]	worker		Callable with signature T(UINT32) that processes a single index. Will be called from
+		 *							multiple threads at once.
+		 * @param[in]	join		Callable with signature T(const T&, const T&) that combines two values. Must be 
+		 *							associative and commutative, as the order in which values are joined is not defined.
+		 * @param[in]	priority	(optional) Priority of the tasks used for executing the chunks on worker threads.
+		 * @return					Result of joining the values returned for all the indices, or @p identity if the range
+		 *							is empty.
+		 */
+		template<class T, class Fn, class JoinFn>
+		T parallelReduce(UINT32 begin, UINT32 end, UINT32 grainSize, const T& identity, Fn worker, JoinFn join,
+			TaskPriority priority = TaskPriority::Normal)
+		{
+			// One partial result per participating thread, so that threads never write to the same value
+			struct Partial { T value; };
+
+			const UINT32 maxHelpers = getNumWorkers();
+			Vector<Partial> partials(maxHelpers + 1, Partial{ identity });
+
+			const std::function<void(UINT32, UINT32, UINT32)> rangeWorker = 
+				[&worker, &join, &identity, &partials](UINT32 rangeBegin, UINT32 rangeEnd, UINT32 participantIdx)
+			{
+				T value = identity;
+				for(UINT32 i = rangeBegin; i < rangeEnd; i++)
+					value = join(value, worker(i));
+
+				partials[participantIdx].value = join(partials[participantIdx].value, value);
+			};
+
+			parallelForInternal(begin, end, grainSize, rangeWorker, maxHelpers, priority);
+
+			T output = identity;
+			for(auto& entry : partials)
+				output = join(output, entry.value);
+
+			return output;
+		}
 	protected:
 		friend class Task;
 		friend class TaskGroup;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Number of distinct priority lanes, one for each value of TaskPriority. */
+		static constexpr UINT32 NUM_PRIORITY_LANES = (UINT32)TaskPriority::VeryHigh - (UINT32)TaskPriority::VeryLow + 1;
+
+		/** Maximum number of worker threads the scheduler will ever spawn. */
+		static constexpr UINT32 MAX_WORKER_THREADS = 64;
+
+		/** Queue of tasks split into priority lanes, with lane 0 containing the highest priority tasks. */
+		struct TaskQueue
+		{
+			SpinLock lock;
+			Deque<SPtr<Task>> lanes[NUM_PRIORITY_LANES];
+			std::atomic<UINT32> numQueued{0};
+
+			/** Pushes a new task to the back of the specified lane. */
+			void push(SPtr<Task> task, UINT32 lane);
+
+			/** Removes a task from the front or the back of the specified lane. Returns null if the lane is empty. */
+			SPtr<Task> pop(UINT32 lane, bool fromBack);
+		};
+
+		/** Information about a single worker thread owned by the scheduler. */
+		struct Worker
+		{
+			TaskScheduler* owner = nullptr;
+			UINT32 index = 0;
+			TaskQueue queue;
+			HThread thread;
+		};
+
+		/** Spawns up to @p count new worker threads, as long as the number of threads is below the active task limit. */
+		void spawnWorkers(UINT32 count);
+
+		/** Main loop of a worker thread. Executes tasks until the scheduler is shut down. */
+		void runWorker(Worker* worker);
 
-		/**	Worker method that runs a single task. */
+		/**
+		 * Finds the next task to execute, by searching (in order of priority lanes) the queue of the provided worker,
+		 * the shared queue, and finally the queues of other workers. @p worker can be null if the calling thread is not
+		 * a worker thread.
+		 */
+		SPtr<Task> findTask(Worker* worker);
+
+		/** Attempts to find and execute a single queued task on the calling thread. Returns true if a task was executed. */
+		bool runOneTask();
+
+		/**	Executes the provided task on the calling thread and notifies any dependent tasks and waiters. */
 		void runTask(SPtr<Task> task);
 
+		/** Pushes the task into the worker's queue if called from a worker thread, or in the shared queue otherwise. */
+		void queueTask(SPtr<Task> task);
+
+		/**
+		 * Registers the task as a dependent of its dependency, if the dependency hasn't yet completed. Returns false if 
+		 * the task is ready to be queued immediately.
+		 */
+		bool deferUntilDependencyComplete(const SPtr<Task>& task);
+
+		/** Releases all tasks waiting on the provided task. They are queued, or canceled if @p cancel is true. */
+		void releaseDependents(Task* task, bool cancel);
+
+		/** Wakes up sleeping worker threads and waiters after @p count new tasks were queued. */
+		void notifyTaskQueued(UINT32 count);
+
+		/** Wakes up waiters after a task was completed. */
+		void notifyTaskComplete();
+
+		/**
+		 * Blocks the calling thread until either a new task is queued, or a task completes, or until the provided
+		 * condition is true. @p generation should be the value of mGeneration read before the calling thread last
+		 * searched for work. If @p stopOnShutdown is true the method also returns once the scheduler starts shutting down.
+		 */
+		void waitForProgress(UINT64 generation, const std::function<bool()>& isDone, bool stopOnShutdown = true);
+
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
 
 		/**	Blocks the calling thread until all the tasks in the provided task group have completed. */
 		void waitUntilComplete(const TaskGroup* taskGroup);
 
-		/**	Method used for sorting tasks. */
-		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
-
-		HThread mTaskSchedulerThread;
-		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks = 0;
-		UINT32 mNextTaskId = 0;
-		bool mShutdown = false;
-		bool mCheckTasks = false;
-
-		Mutex mReadyMutex;
-		Mutex mCompleteMutex;
+		/**
+		 * Splits the range [@p begin, @p end) into chunks and executes them using the calling thread and at most
+		 * @p maxHelpers worker threads. @p worker receives the chunk range and the index of the participating thread,
+		 * which is zero for the calling thread and in range [1, @p maxHelpers] for the helpers.
+		 */
+		void parallelForInternal(UINT32 begin, UINT32 end, UINT32 grainSize, 
+			const std::function<void(UINT32, UINT32, UINT32)>& worker, UINT32 maxHelpers, TaskPriority priority);
+
+		/** Maps a task priority to an index of a priority lane. */
+		static UINT32 getLaneIdx(TaskPriority priority);
+
+		TaskQueue mSharedQueue;
+		Worker* mWorkers[MAX_WORKER_THREADS] = { };
+		std::atomic<UINT32> mNumWorkerThreads{0};
+		std::atomic<UINT32> mMaxActiveTasks{0};
+		std::atomic<UINT32> mNextTaskId{0};
+		std::atomic<UINT32> mNumActiveTasks{0};
+		std::atomic<UINT64> mGeneration{0};
+		std::atomic<UINT32> mNumSleepingWorkers{0};
+		std::atomic<UINT32> mNumWaiters{0};
+		std::atomic<bool> mShutdown{false};
+
+		Mutex mSleepMutex;
+		Mutex mSpawnMutex;
 		Signal mTaskReadyCond;
 		Signal mTaskCompleteCond;
+		Signal mWorkerParkedCond;
+
+		static BS_THREADLOCAL Worker* sCurrentWorker;
 	};
 
 	/** @} */
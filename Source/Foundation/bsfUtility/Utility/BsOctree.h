@@ -6,6 +6,7 @@
 #include "Math/BsMath.h"
 #include "Math/BsVector4I.h"
 #include "Math/BsSIMD.h"
+#include "Math/BsConvexVolume.h"
 #include "Allocators/BsPoolAlloc.h"
 
 namespace bs
@@ -250,7 +251,11 @@ namespace bs
 				auto positiveCenter = simd::add(nodeCenter, childOffset);
 				auto positiveDiff = simd::sub(positiveCenter, queryCenter);
 
-				auto diff = simd::min(negativeDiff, positiveDiff);
+				// Distance to the center of the closest child. Absolute values ensure bounds outside of this node never
+				// report as contained, which can happen for the root node.
+				simd::float32x4 negativeDist = simd::abs(negativeDiff);
+				simd::float32x4 positiveDist = simd::abs(positiveDiff);
+				auto diff = simd::min(negativeDist, positiveDist);
 
 				auto queryExtents = simd::load<simd::float32x4>(&bounds.extents);
 				auto childExtent = simd::load_splat<simd::float32x4>(&mChildExtent);
@@ -280,6 +285,22 @@ namespace bs
 				return output;
 			}
 
+			/** Checks if the node fully contains the provided bounds. */
+			bool contains(const simd::AABox& bounds) const
+			{
+				auto queryCenter = simd::load<simd::float32x4>(&bounds.center);
+				auto queryExtents = simd::load<simd::float32x4>(&bounds.extents);
+
+				auto nodeCenter = simd::load<simd::float32x4>(&mBounds.center);
+				auto nodeExtents = simd::load<simd::float32x4>(&mBounds.extents);
+
+				simd::float32x4 dist = simd::abs(simd::sub(queryCenter, nodeCenter));
+				simd::float32x4 queryMax = simd::add(dist, queryExtents);
+				simd::mask_float32x4 mask = simd::cmp_gt(queryMax, nodeExtents);
+
+				return simd::test_bits_any(simd::bit_cast<simd::uint32x4>(mask)) == false;
+			}
+
 			/** Returns a range of child nodes that intersect the provided bounds. */
 			NodeChildRange findIntersectingChildren(const simd::AABox& bounds) const
 			{
@@ -556,6 +577,125 @@ namespace bs
 			simd::AABox mBounds;
 		};
 
+		/** 
+		 * Iterator that iterates over all elements intersecting the specified convex volume, such as a camera frustum.
+		 * Nodes outside of the volume are skipped along with all of their children, and elements in nodes fully inside
+		 * the volume are returned without being tested individually.
+		 */
+		class ConvexVolumeIntersectIterator
+		{
+		public:
+			/** 
+			 * Constructs an iterator that iterates over all elements in the specified tree that intersect the specified 
+			 * volume. 
+			 */
+			ConvexVolumeIntersectIterator(const Octree& tree, const ConvexVolume& volume)
+				:mNodeIter(tree), mRoot(&tree.mRoot), mPlanes(volume.getPlanes())
+			{ }
+
+			/** 
+			 * Returns the contents of the current element. moveNext() must be called at least once and it must return true
+			 * prior to attempting to access this data.
+			 */
+			const ElemType& getElement() const
+			{
+				return mElemIter.getCurrentElem();
+			}
+
+			/** 
+			 * Returns the bounds of the current element. moveNext() must be called at least once and it must return true
+			 * prior to attempting to access this data.
+			 */
+			const simd::AABox& getElementBounds() const
+			{
+				return mElemIter.getCurrentBounds();
+			}
+
+			/** 
+			 * Moves to the next intersecting element. Iterator starts at a position before the first element, therefore
+			 * this method must be called at least once before attempting to access the current element data. If the method
+			 * returns false it means iterator end has been reached and attempting to access data will result in an error.
+			 */
+			bool moveNext()
+			{
+				while(true)
+				{
+					// First check elements of the current node (if any)
+					while (mElemIter.moveNext())
+					{
+						if (mNodeInside || test(mElemIter.getCurrentBounds()) != TestResult::Outside)
+							return true;
+					}
+
+					// No more elements in this node, move to the next one
+					if(!mNodeIter.moveNext())
+						return false; // No more nodes to check
+
+					const HNode& nodeRef = mNodeIter.getCurrent();
+
+					// Root node can contain elements outside of its bounds, so it must always be searched
+					TestResult result = TestResult::Intersects;
+					if(nodeRef.getNode() != mRoot)
+					{
+						result = test(nodeRef.getBounds().getBounds());
+						if(result == TestResult::Outside)
+							continue;
+					}
+
+					mNodeInside = result == TestResult::Inside;
+					mElemIter = ElementIterator(nodeRef.getNode());
+
+					for(UINT32 i = 0; i < 8; i++)
+					{
+						if(nodeRef.getNode()->hasChild(i))
+							mNodeIter.pushChild(i);
+					}
+				}
+
+				return false;
+			}
+
+		private:
+			/** Possible results when testing bounds against the volume. */
+			enum class TestResult
+			{
+				Outside,
+				Intersects,
+				Inside
+			};
+
+			/** Tests the provided bounds against the volume planes. */
+			TestResult test(const simd::AABox& bounds) const
+			{
+				TestResult result = TestResult::Inside;
+				for(auto& plane : mPlanes)
+				{
+					const Vector3& normal = plane.normal;
+
+					float dist = bounds.center.x * normal.x + bounds.center.y * normal.y + bounds.center.z * normal.z;
+					dist -= plane.d;
+
+					float effectiveRadius = bounds.extents.x * Math::abs(normal.x);
+					effectiveRadius += bounds.extents.y * Math::abs(normal.y);
+					effectiveRadius += bounds.extents.z * Math::abs(normal.z);
+
+					if(dist < -effectiveRadius)
+						return TestResult::Outside;
+
+					if(dist < effectiveRadius)
+						result = TestResult::Intersects;
+				}
+
+				return result;
+			}
+
+			NodeIterator mNodeIter;
+			ElementIterator mElemIter;
+			const Node* mRoot;
+			SmallVector<Plane, ConvexVolume::NUM_INLINE_PLANES> mPlanes;
+			bool mNodeInside = false;
+		};
+
 		/** 
 		 * Constructs an octree with the specified bounds. 
 		 * 
@@ -582,6 +722,36 @@ namespace bs
 			addElementToNode(elem, &mRoot, mRootBounds);
 		}
 
+		/** 
+		 * Updates an element already in the octree, after its bounds have changed or when the stored value needs to be
+		 * replaced. If the element still belongs to the same node it is updated in place, otherwise it is moved to a new
+		 * node.
+		 */
+		void updateElement(const OctreeElementId& elemId, const ElemType& elem)
+		{
+			Node* node = (Node*)elemId.node;
+			simd::AABox elemBounds = Options::getBounds(elem, mContext);
+
+			// Root node holds elements that don't fit anywhere else, including those outside of the tree bounds
+			NodeBounds nodeBounds = getNodeBounds(node);
+			bool fitsNode = node == &mRoot || nodeBounds.contains(elemBounds);
+			if(fitsNode && (node->mIsLeaf || nodeBounds.findContainingChild(elemBounds).empty))
+			{
+				ElementGroup* elemGroup;
+				ElementBoundGroup* boundGroup;
+				UINT32 groupIdx = node->mapToGroup(elemId.elementIdx, &elemGroup, &boundGroup);
+
+				elemGroup->v[groupIdx] = elem;
+				boundGroup->v[groupIdx] = elemBounds;
+
+				Options::setElementId(elem, elemId, mContext);
+				return;
+			}
+
+			removeElement(elemId);
+			addElement(elem);
+		}
+
 		/** Removes an existing element from the octree. */
 		void removeElement(const OctreeElementId& elemId)
 		{
@@ -608,7 +778,7 @@ namespace bs
 				bs_frame_mark();
 				{
 					FrameStack<Node*> todo;
-					todo.push(node);
+					todo.push(nodeToCollapse);
 
 					while(!todo.empty())
 					{
@@ -623,7 +793,7 @@ namespace bs
 
 								ElementIterator elemIter(childNode);
 								while(elemIter.moveNext())
-									pushElement(node, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
+									pushElement(nodeToCollapse, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
 
 								todo.push(childNode);
 							}
@@ -632,17 +802,17 @@ namespace bs
 				}
 				bs_frame_clear();
 				
-				node->mIsLeaf = true;
+				nodeToCollapse->mIsLeaf = true;
 
 				// Recursively delete all child nodes
 				for (UINT32 i = 0; i < 8; i++)
 				{
-					if(node->mChildren[i])
+					if(nodeToCollapse->mChildren[i])
 					{
-						destroyNode(node->mChildren[i]);
+						destroyNode(nodeToCollapse->mChildren[i]);
 
-						mNodeAlloc.destruct(node->mChildren[i]);
-						node->mChildren[i] = nullptr;
+						mNodeAlloc.destruct(nodeToCollapse->mChildren[i]);
+						nodeToCollapse->mChildren[i] = nullptr;
 					}
 				}
 			}
@@ -709,6 +879,33 @@ namespace bs
 			}
 		}
 
+		/** Calculates the bounds of the provided node, by walking the path from the root node. */
+		NodeBounds getNodeBounds(const Node* node) const
+		{
+			HChildNode path[Options::MaxDepth + 1];
+			UINT32 depth = 0;
+
+			for(const Node* curNode = node; curNode->mParent != nullptr; curNode = curNode->mParent)
+			{
+				assert(depth <= Options::MaxDepth);
+
+				for(UINT32 i = 0; i < 8; i++)
+				{
+					if(curNode->mParent->mChildren[i] == curNode)
+					{
+						path[depth++] = HChildNode(i);
+						break;
+					}
+				}
+			}
+
+			NodeBounds output = mRootBounds;
+			while(depth > 0)
+				output = output.getChild(path[--depth]);
+
+			return output;
+		}
+
 		/** Cleans up memory used by the provided node. Should be called instead of the node destructor. */
 		void destroyNode(Node* node)
 		{
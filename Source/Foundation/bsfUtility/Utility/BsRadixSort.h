@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/** Sorts integer keys in linear time by processing them one digit at a time. */
+	class RadixSort
+	{
+	public:
+		/**
+		 * Sorts a set of 64-bit keys in ascending order, along with a value associated with each key. Uses a least
+		 * significant digit radix sort with 8-bit digits. The sort is stable, meaning entries with equal keys retain their
+		 * relative order. Digits that are the same for all keys are skipped, so keys with only a few varying bits sort
+		 * faster.
+		 *
+		 * @param[in, out]	keys		Keys to sort.
+		 * @param[in, out]	values		Values to reorder along with the keys.
+		 * @param[in]		count		Number of entries in the @p keys and @p values arrays.
+		 * @param[in]		tempKeys	Scratch buffer with room for at least @p count keys.
+		 * @param[in]		tempValues	Scratch buffer with room for at least @p count values.
+		 */
+		template<class T>
+		static void sort(UINT64* keys, T* values, UINT32 count, UINT64* tempKeys, T* tempValues)
+		{
+			static constexpr UINT32 DIGIT_BITS = 8;
+			static constexpr UINT32 NUM_BUCKETS = 1 << DIGIT_BITS;
+			static constexpr UINT32 NUM_DIGITS = 64 / DIGIT_BITS;
+
+			if(count < 2)
+				return;
+
+			// Count occurrences of every digit value, for all digits at once
+			UINT32 histograms[NUM_DIGITS][NUM_BUCKETS];
+			memset(histograms, 0, sizeof(histograms));
+
+			for(UINT32 i = 0; i < count; i++)
+			{
+				UINT64 key = keys[i];
+				for(UINT32 j = 0; j < NUM_DIGITS; j++)
+				{
+					histograms[j][key & (NUM_BUCKETS - 1)]++;
+					key >>= DIGIT_BITS;
+				}
+			}
+
+			UINT64* srcKeys = keys;
+			UINT64* dstKeys = tempKeys;
+			T* srcValues = values;
+			T* dstValues = tempValues;
+
+			for(UINT32 i = 0; i < NUM_DIGITS; i++)
+			{
+				const UINT32 shift = i * DIGIT_BITS;
+				UINT32* histogram = histograms[i];
+
+				// All keys share this digit, order would remain the same
+				if(histogram[(srcKeys[0] >> shift) & (NUM_BUCKETS - 1)] == count)
+					continue;
+
+				// Convert counts into output offsets
+				UINT32 offset = 0;
+				for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+				{
+					const UINT32 bucketSize = histogram[j];
+					histogram[j] = offset;
+					offset += bucketSize;
+				}
+
+				for(UINT32 j = 0; j < count; j++)
+				{
+					const UINT32 dstIdx = histogram[(srcKeys[j] >> shift) & (NUM_BUCKETS - 1)]++;
+
+					dstKeys[dstIdx] = srcKeys[j];
+					dstValues[dstIdx] = srcValues[j];
+				}
+
+				std::swap(srcKeys, dstKeys);
+				std::swap(srcValues, dstValues);
+			}
+
+			// Results ended up in the scratch buffers
+			if(srcKeys != keys)
+			{
+				std::copy(srcKeys, srcKeys + count, keys);
+				std::copy(srcValues, srcValues + count, values);
+			}
+		}
+	};
+
+	/** @} */
+}
@@ -0,0 +1,425 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Dynamically sizeable array, with an interface equivalent to Vector. It contains internal storage for @p N elements,
+	 * and will only allocate memory on the heap once the number of elements exceeds @p N. Useful for temporary containers
+	 * that usually hold only a few elements.
+	 *
+	 * @note	Unlike with Vector, moving the container moves the individual elements if they are stored internally, so
+	 *			iterators and references are invalidated.
+	 */
+	template <typename T, UINT32 N>
+	class SmallVector final
+	{
+		static_assert(N > 0, "Internal storage of a SmallVector must be able to hold at least one element.");
+
+	public:
+		typedef T value_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		SmallVector() = default;
+
+		/** Constructs the container with @p count default constructed elements. */
+		explicit SmallVector(size_t count)
+		{
+			resize(count);
+		}
+
+		/** Constructs the container with @p count copies of @p value. */
+		SmallVector(size_t count, const T& value)
+		{
+			resize(count, value);
+		}
+
+		SmallVector(std::initializer_list<T> list)
+		{
+			append(list.begin(), list.end());
+		}
+
+		/** Constructs the container from elements in the range [@p first, @p last). */
+		template<class I, typename = typename std::iterator_traits<I>::iterator_category>
+		SmallVector(I first, I last)
+		{
+			append(first, last);
+		}
+
+		SmallVector(const SmallVector& other)
+		{
+			append(other.begin(), other.end());
+		}
+
+		SmallVector(SmallVector&& other)
+		{
+			moveFrom(std::move(other));
+		}
+
+		~SmallVector()
+		{
+			clear();
+
+			if(!isUsingInternalStorage())
+				bs_free(mElements);
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if(this != &other)
+				assign(other.begin(), other.end());
+
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other)
+		{
+			if(this != &other)
+			{
+				clear();
+				moveFrom(std::move(other));
+			}
+
+			return *this;
+		}
+
+		SmallVector& operator=(std::initializer_list<T> list)
+		{
+			assign(list.begin(), list.end());
+			return *this;
+		}
+
+		/** Replaces the contents of the container with elements in the range [@p first, @p last). */
+		template<class I>
+		void assign(I first, I last)
+		{
+			clear();
+			append(first, last);
+		}
+
+		T& operator[](size_t idx)
+		{
+			assert(idx < mSize);
+			return mElements[idx];
+		}
+
+		const T& operator[](size_t idx) const
+		{
+			assert(idx < mSize);
+			return mElements[idx];
+		}
+
+		T& front() { assert(mSize > 0); return mElements[0]; }
+		const T& front() const { assert(mSize > 0); return mElements[0]; }
+		T& back() { assert(mSize > 0); return mElements[mSize - 1]; }
+		const T& back() const { assert(mSize > 0); return mElements[mSize - 1]; }
+
+		T* data() { return mElements; }
+		const T* data() const { return mElements; }
+
+		iterator begin() { return mElements; }
+		const_iterator begin() const { return mElements; }
+		const_iterator cbegin() const { return mElements; }
+		iterator end() { return mElements + mSize; }
+		const_iterator end() const { return mElements + mSize; }
+		const_iterator cend() const { return mElements + mSize; }
+
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+		/** Returns true if the container holds no elements. */
+		bool empty() const { return mSize == 0; }
+
+		/** Returns the number of elements in the container. */
+		size_t size() const { return mSize; }
+
+		/** Returns the number of elements the container can hold without allocating more memory. */
+		size_t capacity() const { return mCapacity; }
+
+		/** Appends a copy of the element to the end of the container. */
+		void push_back(const T& element)
+		{
+			if(mSize == mCapacity)
+			{
+				// Element might be a part of this container, so make a copy before reallocating
+				T copy(element);
+				grow(mSize + 1);
+				new (&mElements[mSize]) T(std::move(copy));
+			}
+			else
+				new (&mElements[mSize]) T(element);
+
+			mSize++;
+		}
+
+		/** Moves the element to the end of the container. */
+		void push_back(T&& element)
+		{
+			emplace_back(std::move(element));
+		}
+
+		/** Constructs a new element at the end of the container, using the provided constructor arguments. */
+		template<class ...Args>
+		T& emplace_back(Args&&... args)
+		{
+			if(mSize == mCapacity)
+			{
+				T element(std::forward<Args>(args)...);
+				grow(mSize + 1);
+				new (&mElements[mSize]) T(std::move(element));
+			}
+			else
+				new (&mElements[mSize]) T(std::forward<Args>(args)...);
+
+			return mElements[mSize++];
+		}
+
+		/** Removes the last element of the container. */
+		void pop_back()
+		{
+			assert(mSize > 0);
+
+			mSize--;
+			mElements[mSize].~T();
+		}
+
+		/** Inserts a copy of the element before @p pos. Returns an iterator to the inserted element. */
+		iterator insert(const_iterator pos, const T& element)
+		{
+			T copy(element);
+			return insert(pos, std::move(copy));
+		}
+
+		/** Moves the element into the container, before @p pos. Returns an iterator to the inserted element. */
+		iterator insert(const_iterator pos, T&& element)
+		{
+			const size_t idx = pos - begin();
+			assert(idx <= mSize);
+
+			if(mSize == mCapacity)
+				grow(mSize + 1);
+
+			if(idx == mSize)
+				new (&mElements[mSize]) T(std::move(element));
+			else
+			{
+				new (&mElements[mSize]) T(std::move(mElements[mSize - 1]));
+				std::move_backward(mElements + idx, mElements + mSize - 1, mElements + mSize);
+				mElements[idx] = std::move(element);
+			}
+
+			mSize++;
+			return mElements + idx;
+		}
+
+		/**
+		 * Inserts elements in the range [@p first, @p last) before @p pos. The range must not be a part of this container.
+		 * Returns an iterator to the first inserted element.
+		 */
+		template<class I, typename = typename std::iterator_traits<I>::iterator_category>
+		iterator insert(const_iterator pos, I first, I last)
+		{
+			const size_t idx = pos - begin();
+			const size_t oldSize = mSize;
+
+			append(first, last);
+			std::rotate(mElements + idx, mElements + oldSize, mElements + mSize);
+
+			return mElements + idx;
+		}
+
+		/** Removes the element at @p pos. Returns an iterator to the element following the removed one. */
+		iterator erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		/** Removes elements in the range [@p first, @p last). Returns an iterator to the element following the range. */
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			iterator start = mElements + (first - begin());
+			iterator newEnd = std::move(mElements + (last - begin()), end(), start);
+
+			for(iterator iter = newEnd; iter != end(); ++iter)
+				iter->~T();
+
+			mSize = (UINT32)(newEnd - begin());
+			return start;
+		}
+
+		/** Removes all elements from the container. Does not release any allocated memory. */
+		void clear()
+		{
+			for(UINT32 i = 0; i < mSize; i++)
+				mElements[i].~T();
+
+			mSize = 0;
+		}
+
+		/** Changes the number of elements in the container. New elements are default constructed. */
+		void resize(size_t size)
+		{
+			if(size > mCapacity)
+				grow(size);
+
+			for(size_t i = mSize; i < size; i++)
+				new (&mElements[i]) T();
+
+			for(size_t i = size; i < mSize; i++)
+				mElements[i].~T();
+
+			mSize = (UINT32)size;
+		}
+
+		/** Changes the number of elements in the container. New elements are copies of @p value. */
+		void resize(size_t size, const T& value)
+		{
+			if(size > mCapacity)
+			{
+				T copy(value);
+				grow(size);
+
+				for(size_t i = mSize; i < size; i++)
+					new (&mElements[i]) T(copy);
+			}
+			else
+			{
+				for(size_t i = mSize; i < size; i++)
+					new (&mElements[i]) T(value);
+			}
+
+			for(size_t i = size; i < mSize; i++)
+				mElements[i].~T();
+
+			mSize = (UINT32)size;
+		}
+
+		/** Ensures the container can hold at least @p capacity elements without allocating more memory. */
+		void reserve(size_t capacity)
+		{
+			if(capacity > mCapacity)
+				grow(capacity);
+		}
+
+		/** Swaps the contents of two containers. */
+		void swap(SmallVector& other)
+		{
+			SmallVector temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+		bool operator==(const SmallVector& other) const
+		{
+			return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+		}
+
+		bool operator!=(const SmallVector& other) const
+		{
+			return !(*this == other);
+		}
+
+		bool operator<(const SmallVector& other) const
+		{
+			return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+		}
+
+	private:
+		/** Returns true if the elements are stored within the internal buffer. */
+		bool isUsingInternalStorage() const { return mElements == (T*)mStorage; }
+
+		/** Appends elements in the range [@p first, @p last) to the end of the container. */
+		template<class I>
+		void append(I first, I last)
+		{
+			appendInternal(first, last, typename std::iterator_traits<I>::iterator_category());
+		}
+
+		template<class I>
+		void appendInternal(I first, I last, std::forward_iterator_tag)
+		{
+			const size_t count = (size_t)std::distance(first, last);
+			reserve(mSize + count);
+
+			for(; first != last; ++first)
+				new (&mElements[mSize++]) T(*first);
+		}
+
+		template<class I>
+		void appendInternal(I first, I last, std::input_iterator_tag)
+		{
+			for(; first != last; ++first)
+				emplace_back(*first);
+		}
+
+		/** Grows the capacity so it can hold at least @p minCapacity elements, moving the elements to the heap. */
+		void grow(size_t minCapacity)
+		{
+			const UINT32 newCapacity = (UINT32)std::max(minCapacity, (size_t)mCapacity * 2);
+			T* newElements = (T*)bs_alloc(newCapacity * sizeof(T));
+
+			for(UINT32 i = 0; i < mSize; i++)
+			{
+				new (&newElements[i]) T(std::move(mElements[i]));
+				mElements[i].~T();
+			}
+
+			if(!isUsingInternalStorage())
+				bs_free(mElements);
+
+			mElements = newElements;
+			mCapacity = newCapacity;
+		}
+
+		/** Moves the elements from @p other into this container. This container must be empty. */
+		void moveFrom(SmallVector&& other)
+		{
+			if(!other.isUsingInternalStorage())
+			{
+				if(!isUsingInternalStorage())
+					bs_free(mElements);
+
+				mElements = other.mElements;
+				mSize = other.mSize;
+				mCapacity = other.mCapacity;
+
+				other.mElements = (T*)other.mStorage;
+				other.mSize = 0;
+				other.mCapacity = N;
+			}
+			else
+			{
+				reserve(other.mSize);
+
+				for(UINT32 i = 0; i < other.mSize; i++)
+					new (&mElements[i]) T(std::move(other.mElements[i]));
+
+				mSize = other.mSize;
+				other.clear();
+			}
+		}
+
+		alignas(T) UINT8 mStorage[N * sizeof(T)];
+		T* mElements = (T*)mStorage;
+		UINT32 mSize = 0;
+		UINT32 mCapacity = N;
+	};
+
+	/** @} */
+}
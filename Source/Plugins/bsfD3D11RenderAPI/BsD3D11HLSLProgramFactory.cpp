@@ -140,13 +140,7 @@ namespace bs { namespace ct
 			break;
 		}
 
-		UINT compileFlags = 0;
-#if defined(BS_DEBUG_MODE)
-		compileFlags |= D3DCOMPILE_DEBUG;
-		compileFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-		compileFlags |= D3DCOMPILE_PACK_MATRIX_ROW_MAJOR;
+		const UINT compileFlags = getCompilerFlags();
 
 		ID3DBlob* microcode = nullptr;
 		ID3DBlob* messages = nullptr;
@@ -200,6 +194,8 @@ namespace bs { namespace ct
 
 		SPtr<GpuProgramBytecode> bytecode = bs_shared_ptr_new<GpuProgramBytecode>();
 		bytecode->compilerId = DIRECTX_COMPILER_ID;
+		bytecode->compilerVersion = D3D_COMPILER_VERSION;
+		bytecode->compilerFlags = compileFlags;
 		bytecode->messages = compileMessage;
 
 		if (FAILED(hr))
@@ -227,4 +223,26 @@ namespace bs { namespace ct
 		SAFE_RELEASE(microcode);
 		return bytecode;
 	}
+
+	String D3D11HLSLProgramFactory::getCompilerId() const
+	{
+		return DIRECTX_COMPILER_ID;
+	}
+
+	UINT32 D3D11HLSLProgramFactory::getCompilerVersion() const
+	{
+		return D3D_COMPILER_VERSION;
+	}
+
+	UINT32 D3D11HLSLProgramFactory::getCompilerFlags() const
+	{
+		UINT32 compileFlags = 0;
+#if defined(BS_DEBUG_MODE)
+		compileFlags |= D3DCOMPILE_DEBUG;
+		compileFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+
+		compileFlags |= D3DCOMPILE_PACK_MATRIX_ROW_MAJOR;
+		return compileFlags;
+	}
 }}
@@ -26,6 +26,15 @@ namespace bs { namespace ct
 
 		/** @copydoc GpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC&) */
 		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) override;
+
+		/** @copydoc GpuProgramFactory::getCompilerId */
+		String getCompilerId() const override;
+
+		/** @copydoc GpuProgramFactory::getCompilerVersion */
+		UINT32 getCompilerVersion() const override;
+
+		/** @copydoc GpuProgramFactory::getCompilerFlags */
+		UINT32 getCompilerFlags() const override;
 	protected:
 		static const String LANGUAGE_NAME;
 	};
@@ -8,21 +8,45 @@
 
 namespace bs
 {
+	/** 
+	 * Header stored in front of every allocation made by FMOD. The general purpose allocator has no realloc, so the
+	 * size is needed to know how many bytes to copy on reallocation. Sized to keep the returned memory 16 byte aligned.
+	 */
+	struct alignas(16) FMODAllocHeader
+	{
+		unsigned int size;
+	};
+
 	void* F_CALLBACK FMODAlloc(unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
 	{
-		return bs_alloc(size);
+		auto header = (FMODAllocHeader*)bs_alloc(sizeof(FMODAllocHeader) + size);
+		header->size = size;
+
+		return header + 1;
 	}
 
-	void* F_CALLBACK FMODRealloc(void *ptr, unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
+	void F_CALLBACK FMODFree(void *ptr, FMOD_MEMORY_TYPE type, const char *sourcestr)
 	{
-		// Note: Not using Banshee's allocators, but have no easy alternative to implement realloc manually.
-		// This is okay to use in combination with general purpose bs_alloc/bs_free since they internally use malloc/free.
-		return realloc(ptr, size);
+		if (ptr == nullptr)
+			return;
+
+		bs_free((FMODAllocHeader*)ptr - 1);
 	}
 
-	void F_CALLBACK FMODFree(void *ptr, FMOD_MEMORY_TYPE type, const char *sourcestr)
+	void* F_CALLBACK FMODRealloc(void *ptr, unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
 	{
-		bs_free(ptr);
+		// Note: Memory must come from the same allocator as the one used by FMODAlloc/FMODFree, so libc realloc() 
+		// cannot be used here
+		void* newPtr = FMODAlloc(size, type, sourcestr);
+		if (ptr != nullptr)
+		{
+			const unsigned int oldSize = ((FMODAllocHeader*)ptr - 1)->size;
+			memcpy(newPtr, ptr, std::min(oldSize, size));
+
+			FMODFree(ptr, type, sourcestr);
+		}
+
+		return newPtr;
 	}
 
 	float F_CALLBACK FMOD3DRolloff(FMOD_CHANNELCONTROL* channelControl, float distance)
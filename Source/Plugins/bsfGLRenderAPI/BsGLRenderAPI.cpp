@@ -891,13 +891,22 @@ namespace bs { namespace ct
 						}
 						else
 						{
-							const GLGpuParamBlockBuffer* glParamBlockBuffer = static_cast<const GLGpuParamBlockBuffer*>(buffer.get());
+							// Buffer contents might be sub-allocated from a larger buffer
+							const GLGpuParamBlockBuffer* glParamBlockBuffer = 
+								static_cast<const GLGpuParamBlockBuffer*>(buffer->_getStorage());
 
 							UINT32 unit = getUniformUnit(binding - 1);
 							glUniformBlockBinding(glProgram, binding - 1, unit);
 							BS_CHECK_GL_ERROR();
 
-							glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId());
+							if (glParamBlockBuffer != buffer.get())
+							{
+								glBindBufferRange(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId(), 
+									buffer->_getStorageOffset(), buffer->getSize());
+							}
+							else
+								glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId());
+
 							BS_CHECK_GL_ERROR();
 						}
 					}
@@ -2631,6 +2640,12 @@ namespace bs { namespace ct
 
 		caps.setNumCombinedGpuParamBlockBuffers(static_cast<UINT16>(combinedUniformBlockUnits));
 
+		GLint uniformBufferOffsetAlignment;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+		BS_CHECK_GL_ERROR();
+
+		caps.setParamBlockOffsetAlignment(static_cast<UINT32>(uniformBufferOffsetAlignment));
+
 		caps.setNumMultiRenderTargets(8);
 	}
 
@@ -0,0 +1,41 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullCommandBuffer.h"
+
+namespace bs { namespace ct
+{
+	NullCommandBuffer::NullCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary)
+		: CommandBuffer(type, deviceIdx, queueIdx, secondary)
+	{
+		if (deviceIdx != 0)
+			BS_EXCEPT(InvalidParametersException, "Only a single device supported on the null render API.");
+	}
+
+	void NullCommandBuffer::appendSecondary(const SPtr<NullCommandBuffer>& secondaryBuffer)
+	{
+#if BS_DEBUG_MODE
+		if (!secondaryBuffer->mIsSecondary)
+		{
+			LOGERR("Cannot append a command buffer that is not secondary.");
+			return;
+		}
+
+		if (mIsSecondary)
+		{
+			LOGERR("Cannot append a buffer to a secondary command buffer.");
+			return;
+		}
+#endif
+
+		mStats += secondaryBuffer->mStats;
+	}
+
+	void NullCommandBuffer::clear()
+	{
+		mStats = NullRenderAPIStats();
+
+		mGraphicsPipeline = nullptr;
+		mComputePipeline = nullptr;
+		mRenderTarget = nullptr;
+	}
+}}
@@ -0,0 +1,49 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsCommandBuffer.h"
+#include "Math/BsRect2.h"
+#include "BsNullRenderAPI.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**
+	 * Command buffer implementation for the null render API. Commands are not stored, instead the buffer only keeps
+	 * track of the currently bound state and counts the operations recorded in it.
+	 */
+	class NullCommandBuffer : public CommandBuffer
+	{
+	public:
+		/** Appends the statistics of the secondary buffer into this command buffer. */
+		void appendSecondary(const SPtr<NullCommandBuffer>& secondaryBuffer);
+
+		/** Resets the statistics and releases any state bound to the command buffer. */
+		void clear();
+
+		/** Returns the operations recorded in this command buffer since it was last cleared. */
+		NullRenderAPIStats& getStats() { return mStats; }
+
+	private:
+		friend class NullCommandBufferManager;
+		friend class NullRenderAPI;
+
+		NullCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary);
+
+		NullRenderAPIStats mStats;
+
+		SPtr<GraphicsPipelineState> mGraphicsPipeline;
+		SPtr<ComputePipelineState> mComputePipeline;
+		SPtr<RenderTarget> mRenderTarget;
+		DrawOperationType mActiveDrawOp = DOT_TRIANGLE_LIST;
+		Rect2 mViewport = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+		UINT32 mStencilRef = 0;
+	};
+
+	/** @} */
+}}
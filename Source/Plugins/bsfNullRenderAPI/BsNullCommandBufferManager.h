@@ -0,0 +1,28 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsCommandBufferManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** 
+	 * Handles creation of null render API command buffers. See CommandBuffer. 
+	 *
+	 * @note Core thread only.
+	 */
+	class NullCommandBufferManager : public CommandBufferManager
+	{
+	public:
+		/** @copydoc CommandBufferManager::createInternal() */
+		SPtr<CommandBuffer> createInternal(GpuQueueType type, UINT32 deviceIdx = 0, UINT32 queueIdx = 0,
+			bool secondary = false) override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,35 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuBuffer.h"
+#include "BsNullHardwareBuffer.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullGpuBuffer::NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: GpuBuffer(desc, deviceMask)
+	{ }
+
+	NullGpuBuffer::NullGpuBuffer(const GPU_BUFFER_DESC& desc, SPtr<HardwareBuffer> underlyingBuffer)
+		: GpuBuffer(desc, std::move(underlyingBuffer))
+	{ }
+
+	NullGpuBuffer::~NullGpuBuffer()
+	{ 
+		if(mBuffer && !mExternalBuffer)
+			bs_pool_delete(static_cast<NullHardwareBuffer*>(mBuffer));
+	}
+
+	void NullGpuBuffer::initialize()
+	{
+		const GpuBufferProperties& props = getProperties();
+
+		// Create a new buffer if not wrapping an external one
+		if(!mBuffer)
+			mBuffer = bs_pool_new<NullHardwareBuffer>(props.getUsage(), props.getElementCount(), props.getElementSize());
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuBuffer);
+
+		GpuBuffer::initialize();
+	}
+}}
@@ -0,0 +1,31 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**	Null render API implementation of a generic GPU buffer, storing its contents in system memory. */
+	class NullGpuBuffer : public GpuBuffer
+	{
+	public:
+		~NullGpuBuffer();
+
+	protected:
+		friend class NullHardwareBufferManager;
+
+		NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+		NullGpuBuffer(const GPU_BUFFER_DESC& desc, SPtr<HardwareBuffer> underlyingBuffer);
+
+		/** @copydoc GpuBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,23 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuParamBlockBuffer.h"
+#include "BsNullHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	NullGpuParamBlockBuffer::NullGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+		:GpuParamBlockBuffer(size, usage, deviceMask)
+	{ }
+
+	NullGpuParamBlockBuffer::~NullGpuParamBlockBuffer()
+	{
+		if (mBuffer != nullptr)
+			bs_pool_delete(static_cast<NullHardwareBuffer*>(mBuffer));
+	}
+
+	void NullGpuParamBlockBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mUsage, 1, mSize);
+		GpuParamBlockBuffer::initialize();
+	}
+}}
@@ -0,0 +1,27 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**	Null render API implementation of a parameter block buffer, storing its contents in system memory. */
+	class NullGpuParamBlockBuffer : public GpuParamBlockBuffer
+	{
+	public:
+		NullGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
+		~NullGpuParamBlockBuffer();
+
+	protected:
+		/** @copydoc GpuParamBlockBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,66 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuProgram.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullGpuProgram::NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+		: GpuProgram(desc, deviceMask)
+	{ }
+
+	NullGpuProgram::~NullGpuProgram()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuProgram);
+	}
+
+	void NullGpuProgram::initialize()
+	{
+		if(mBytecode != nullptr)
+		{
+			mCompileMessages = mBytecode->messages;
+
+			if(mBytecode->paramDesc != nullptr)
+				mParametersDesc = mBytecode->paramDesc;
+
+			if(mType == GPT_VERTEX_PROGRAM)
+				mInputDeclaration = HardwareBufferManager::instance().createVertexDeclaration(mBytecode->vertexInput);
+		}
+
+		mIsCompiled = true;
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuProgram);
+
+		GpuProgram::initialize();
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullGpuProgram> gpuProg = bs_shared_ptr<NullGpuProgram>(new (bs_alloc<NullGpuProgram>())
+			NullGpuProgram(desc, deviceMask));
+		gpuProg->_setThisPtr(gpuProg);
+
+		return gpuProg;
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(GpuProgramType type, GpuDeviceFlags deviceMask)
+	{
+		GPU_PROGRAM_DESC desc;
+		desc.type = type;
+
+		return create(desc, deviceMask);
+	}
+
+	SPtr<GpuProgramBytecode> NullGpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC& desc)
+	{
+		SPtr<GpuProgramBytecode> bytecode = bs_shared_ptr_new<GpuProgramBytecode>();
+		bytecode->compilerId = "NullRenderAPI";
+		bytecode->paramDesc = bs_shared_ptr_new<GpuParamDesc>();
+		bytecode->messages = "GPU programs are not compiled by the null render API.";
+
+		return bytecode;
+	}
+}}
@@ -0,0 +1,48 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuProgram.h"
+#include "Managers/BsGpuProgramManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**
+	 * GPU program used by the null render API. The program source is never compiled. Parameter and vertex input
+	 * information is taken from the program bytecode if one was provided, otherwise the program has no parameters.
+	 */
+	class NullGpuProgram : public GpuProgram
+	{
+	public:
+		~NullGpuProgram();
+
+	protected:
+		friend class NullGpuProgramFactory;
+
+		NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask);
+
+		/** @copydoc GpuProgram::initialize */
+		void initialize() override;
+	};
+
+	/**	Handles creation of GPU programs for the null render API, regardless of the program language. */
+	class NullGpuProgramFactory : public GpuProgramFactory
+	{
+	public:
+		/** @copydoc GpuProgramFactory::create(const GPU_PROGRAM_DESC&, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc GpuProgramFactory::create(GpuProgramType, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(GpuProgramType type, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc GpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC&) */
+		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) override;
+	};
+
+	/** @} */
+}}
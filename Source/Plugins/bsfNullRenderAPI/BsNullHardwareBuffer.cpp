@@ -0,0 +1,77 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullHardwareBuffer.h"
+#include "BsNullRenderAPI.h"
+
+namespace bs { namespace ct
+{
+	NullHardwareBuffer::NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize)
+		: HardwareBuffer(elementCount * elementSize, usage, GDF_DEFAULT)
+	{
+		mData = (UINT8*)bs_alloc(mSize);
+	}
+
+	NullHardwareBuffer::~NullHardwareBuffer()
+	{
+		bs_free(mData);
+	}
+
+	void* NullHardwareBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			stats.numBufferReads++;
+			stats.numBytesRead += length;
+		}
+
+		if (options != GBL_READ_ONLY)
+		{
+			stats.numBufferWrites++;
+			stats.numBytesWritten += length;
+		}
+
+		return mData + offset;
+	}
+
+	void NullHardwareBuffer::unmap()
+	{
+		// Do nothing, data is always resident in system memory
+	}
+
+	void NullHardwareBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		assert(offset + length <= mSize);
+		memcpy(dest, mData + offset, length);
+
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numBufferReads++;
+		stats.numBytesRead += length;
+	}
+
+	void NullHardwareBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags,
+		UINT32 queueIdx)
+	{
+		assert(offset + length <= mSize);
+		memcpy(mData + offset, source, length);
+
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numBufferWrites++;
+		stats.numBytesWritten += length;
+	}
+
+	void NullHardwareBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+		bool discardWholeBuffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullHardwareBuffer& nullSrcBuffer = static_cast<NullHardwareBuffer&>(srcBuffer);
+
+		assert(srcOffset + length <= nullSrcBuffer.mSize);
+		assert(dstOffset + length <= mSize);
+		memcpy(mData + dstOffset, nullSrcBuffer.mData + srcOffset, length);
+
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numBufferWrites++;
+		stats.numBytesWritten += length;
+	}
+}}
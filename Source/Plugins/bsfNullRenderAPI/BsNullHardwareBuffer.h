@@ -0,0 +1,49 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsHardwareBuffer.h"
+#include "Allocators/BsPoolAlloc.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** Hardware buffer backed by system memory. Used as the storage of all buffer types in the null render API. */
+	class NullHardwareBuffer : public HardwareBuffer
+	{
+	public:
+		NullHardwareBuffer(GpuBufferUsage usage, UINT32 elementCount, UINT32 elementSize);
+		~NullHardwareBuffer();
+
+		/** @copydoc HardwareBuffer::readData */
+		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override;
+
+		/** @copydoc HardwareBuffer::writeData */
+		void writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags = BWT_NORMAL,
+			UINT32 queueIdx = 0) override;
+
+		/** @copydoc HardwareBuffer::copyData */
+		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+			bool discardWholeBuffer = false, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+	protected:
+		/** @copydoc HardwareBuffer::map */
+		void* map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx) override;
+
+		/** @copydoc HardwareBuffer::unmap */
+		void unmap() override;
+
+		UINT8* mData = nullptr;
+	};
+
+	/** @} */
+}}
+
+namespace bs
+{
+	IMPLEMENT_GLOBAL_POOL(ct::NullHardwareBuffer, 32)
+}
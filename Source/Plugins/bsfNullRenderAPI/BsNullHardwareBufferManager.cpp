@@ -0,0 +1,62 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullVertexBuffer.h"
+#include "BsNullIndexBuffer.h"
+#include "BsNullGpuBuffer.h"
+#include "BsNullGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	SPtr<VertexBuffer> NullHardwareBufferManager::createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc, 
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullVertexBuffer> ret = bs_shared_ptr_new<NullVertexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<IndexBuffer> NullHardwareBufferManager::createIndexBufferInternal(const INDEX_BUFFER_DESC& desc, 
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullIndexBuffer> ret = bs_shared_ptr_new<NullIndexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<GpuParamBlockBuffer> NullHardwareBufferManager::createGpuParamBlockBufferInternal(UINT32 size, 
+		GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+	{
+		NullGpuParamBlockBuffer* paramBlockBuffer = 
+			new (bs_alloc<NullGpuParamBlockBuffer>()) NullGpuParamBlockBuffer(size, usage, deviceMask);
+
+		SPtr<GpuParamBlockBuffer> paramBlockBufferPtr = bs_shared_ptr<NullGpuParamBlockBuffer>(paramBlockBuffer);
+		paramBlockBufferPtr->_setThisPtr(paramBlockBufferPtr);
+
+		return paramBlockBufferPtr;
+	}
+
+	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		NullGpuBuffer* buffer = new (bs_alloc<NullGpuBuffer>()) NullGpuBuffer(desc, deviceMask);
+
+		SPtr<NullGpuBuffer> bufferPtr = bs_shared_ptr<NullGpuBuffer>(buffer);
+		bufferPtr->_setThisPtr(bufferPtr);
+
+		return bufferPtr;
+	}
+
+	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+		SPtr<HardwareBuffer> underlyingBuffer)
+	{
+		NullGpuBuffer* buffer = new (bs_alloc<NullGpuBuffer>()) NullGpuBuffer(desc, std::move(underlyingBuffer));
+
+		SPtr<NullGpuBuffer> bufferPtr = bs_shared_ptr<NullGpuBuffer>(buffer);
+		bufferPtr->_setThisPtr(bufferPtr);
+
+		return bufferPtr;
+	}
+}}
\ No newline at end of file
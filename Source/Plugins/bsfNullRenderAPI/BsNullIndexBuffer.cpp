@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullIndexBuffer.h"
+#include "BsNullHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	static void deleteBuffer(HardwareBuffer* buffer)
+	{
+		bs_pool_delete(static_cast<NullHardwareBuffer*>(buffer));
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const INDEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: IndexBuffer(desc, deviceMask)
+	{ }
+
+	void NullIndexBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mUsage, 1, mSize);
+		mBufferDeleter = &deleteBuffer;
+
+		IndexBuffer::initialize();
+	}
+}}
@@ -0,0 +1,26 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsIndexBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**	Null render API implementation of an index buffer, storing its contents in system memory. */
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(const INDEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+
+	protected: 
+		/** @copydoc IndexBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,25 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup Null bsfNullRenderAPI
+ *	Render API that performs no rendering, used for running the framework without a GPU and for measuring CPU-side
+ *	rendering costs.
+ */
+
+/** @} */
+
+namespace bs { namespace ct
+{
+	class NullRenderAPI;
+	class NullCommandBuffer;
+	class NullHardwareBuffer;
+	class NullGpuProgramFactory;
+	class NullRenderWindow;
+}}
@@ -0,0 +1,83 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsQueryManager.h"
+#include "RenderAPI/BsEventQuery.h"
+#include "RenderAPI/BsTimerQuery.h"
+#include "RenderAPI/BsOcclusionQuery.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** Event query for the null render API. Is ready as soon as it is issued. */
+	class NullEventQuery : public EventQuery
+	{
+	public:
+		NullEventQuery(UINT32 deviceIdx) { }
+
+		/** @copydoc EventQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override { setActive(true); }
+
+		/** @copydoc EventQuery::isReady */
+		bool isReady() const override { return true; }
+	};
+
+	/** Timer query for the null render API. Is ready as soon as it ends and always reports zero elapsed time. */
+	class NullTimerQuery : public TimerQuery
+	{
+	public:
+		NullTimerQuery(UINT32 deviceIdx) { mActive = false; }
+
+		/** @copydoc TimerQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override { setActive(true); }
+
+		/** @copydoc TimerQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override { }
+
+		/** @copydoc TimerQuery::isReady */
+		bool isReady() const override { return true; }
+
+		/** @copydoc TimerQuery::getTimeMs */
+		float getTimeMs() override { return 0.0f; }
+	};
+
+	/** Occlusion query for the null render API. Is ready as soon as it ends and always reports no visible samples. */
+	class NullOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		NullOcclusionQuery(bool binary, UINT32 deviceIdx) : OcclusionQuery(binary) { }
+
+		/** @copydoc OcclusionQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override { setActive(true); }
+
+		/** @copydoc OcclusionQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override { }
+
+		/** @copydoc OcclusionQuery::isReady */
+		bool isReady() const override { return true; }
+
+		/** @copydoc OcclusionQuery::getNumSamples */
+		UINT32 getNumSamples() override { return 0; }
+	};
+
+	/**	Handles creation of null render API queries. */
+	class NullQueryManager : public QueryManager
+	{
+	public:
+		/** @copydoc QueryManager::createEventQuery */
+		SPtr<EventQuery> createEventQuery(UINT32 deviceIdx = 0) const override;
+
+		/** @copydoc QueryManager::createTimerQuery */
+		SPtr<TimerQuery> createTimerQuery(UINT32 deviceIdx = 0) const override;
+
+		/** @copydoc QueryManager::createOcclusionQuery */
+		SPtr<OcclusionQuery> createOcclusionQuery(bool binary, UINT32 deviceIdx = 0) const override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,512 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderAPI.h"
+#include "BsNullCommandBuffer.h"
+#include "BsNullCommandBufferManager.h"
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullTextureManager.h"
+#include "BsNullRenderWindowManager.h"
+#include "BsNullGpuProgram.h"
+#include "BsNullQueryManager.h"
+#include "BsNullVideoModeInfo.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsGpuPipelineParamInfo.h"
+#include "RenderAPI/BsRenderTarget.h"
+#include "Managers/BsGpuProgramManager.h"
+#include "Managers/BsRenderStateManager.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Profiling/BsRenderStats.h"
+#include "Utility/BsPlatformUtility.h"
+#include "Math/BsMath.h"
+
+namespace bs { namespace ct
+{
+	NullRenderAPIStats& NullRenderAPIStats::operator+=(const NullRenderAPIStats& other)
+	{
+		numDrawCalls += other.numDrawCalls;
+		numIndexedDrawCalls += other.numIndexedDrawCalls;
+		numInstances += other.numInstances;
+		numVertices += other.numVertices;
+		numPrimitives += other.numPrimitives;
+		numComputeCalls += other.numComputeCalls;
+
+		numPipelineStateChanges += other.numPipelineStateChanges;
+		numGpuParamBinds += other.numGpuParamBinds;
+		numVertexBufferBinds += other.numVertexBufferBinds;
+		numIndexBufferBinds += other.numIndexBufferBinds;
+		numVertexDeclarationBinds += other.numVertexDeclarationBinds;
+		numViewportChanges += other.numViewportChanges;
+		numScissorChanges += other.numScissorChanges;
+		numRenderTargetChanges += other.numRenderTargetChanges;
+		numClears += other.numClears;
+		numPresents += other.numPresents;
+		numCommandBufferSubmits += other.numCommandBufferSubmits;
+
+		numBufferWrites += other.numBufferWrites;
+		numBufferReads += other.numBufferReads;
+		numTextureWrites += other.numTextureWrites;
+		numTextureReads += other.numTextureReads;
+		numBytesWritten += other.numBytesWritten;
+		numBytesRead += other.numBytesRead;
+
+		return *this;
+	}
+
+	const StringID& NullRenderAPI::getName() const
+	{
+		static StringID strName("NullRenderAPI");
+		return strName;
+	}
+
+	void NullRenderAPI::initialize()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mVideoModeInfo = bs_shared_ptr_new<NullVideoModeInfo>();
+
+		GPUInfo gpuInfo;
+		gpuInfo.numGPUs = 1;
+		gpuInfo.names[0] = "Null device";
+
+		PlatformUtility::_setGPUInfo(gpuInfo);
+
+		CommandBufferManager::startUp<NullCommandBufferManager>();
+
+		bs::TextureManager::startUp<bs::NullTextureManager>();
+		TextureManager::startUp<NullTextureManager>();
+
+		bs::HardwareBufferManager::startUp();
+		HardwareBufferManager::startUp<NullHardwareBufferManager>();
+
+		bs::RenderWindowManager::startUp<bs::NullRenderWindowManager>(this);
+		RenderWindowManager::startUp();
+
+		RenderStateManager::startUp();
+
+		mNumDevices = 1;
+		mCurrentCapabilities = bs_newN<RenderAPICapabilities>(mNumDevices);
+		initCapabilities(mCurrentCapabilities[0]);
+
+		// Accept programs in any language so that techniques written for any of the real backends can be used
+		mProgramFactory = bs_new<NullGpuProgramFactory>();
+		for(auto& language : { "hlsl", "glsl", "glsl4_1", "vksl" })
+			GpuProgramManager::instance().addFactory(language, mProgramFactory);
+
+		mMainCommandBuffer = std::static_pointer_cast<NullCommandBuffer>(CommandBuffer::create(GQT_GRAPHICS));
+
+		RenderAPI::initialize();
+	}
+
+	void NullRenderAPI::initializeWithWindow(const SPtr<RenderWindow>& primaryWindow)
+	{
+		mPrimaryWindow = primaryWindow.get();
+
+		QueryManager::startUp<NullQueryManager>();
+
+		RenderAPI::initializeWithWindow(primaryWindow);
+	}
+
+	void NullRenderAPI::destroyCore()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		QueryManager::shutDown();
+
+		for(auto& language : { "hlsl", "glsl", "glsl4_1", "vksl" })
+			GpuProgramManager::instance().removeFactory(language);
+
+		if(mProgramFactory != nullptr)
+		{
+			bs_delete(mProgramFactory);
+			mProgramFactory = nullptr;
+		}
+
+		mMainCommandBuffer = nullptr;
+		mPrimaryWindow = nullptr;
+		mActiveRenderTarget = nullptr;
+
+		RenderStateManager::shutDown();
+		RenderWindowManager::shutDown();
+		bs::RenderWindowManager::shutDown();
+		HardwareBufferManager::shutDown();
+		bs::HardwareBufferManager::shutDown();
+		TextureManager::shutDown();
+		bs::TextureManager::shutDown();
+		CommandBufferManager::shutDown();
+
+		RenderAPI::destroyCore();
+	}
+
+	void NullRenderAPI::setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mGraphicsPipeline = pipelineState;
+		cb->mStats.numPipelineStateChanges++;
+
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mComputePipeline = pipelineState;
+		cb->mStats.numPipelineStateChanges++;
+
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numGpuParamBinds++;
+
+		// Upload param blocks like a GPU backend would, so their writes get counted
+		SPtr<GpuPipelineParamInfoBase> paramInfo = gpuParams->getParamInfo();
+		UINT32 numParamBlocks = paramInfo->getNumElements(GpuPipelineParamInfoBase::ParamType::ParamBlock);
+		for(UINT32 i = 0; i < numParamBlocks; i++)
+		{
+			UINT32 set, slot;
+			paramInfo->getBinding(GpuPipelineParamInfoBase::ParamType::ParamBlock, i, set, slot);
+
+			SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(set, slot);
+			if(buffer != nullptr)
+				buffer->flushToGPU();
+		}
+
+		BS_INC_RENDER_STAT(NumGpuParamBinds);
+	}
+
+	void NullRenderAPI::setViewport(const Rect2& vp, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mViewport = vp;
+		cb->mStats.numViewportChanges++;
+	}
+
+	void NullRenderAPI::setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numVertexBufferBinds++;
+
+		BS_INC_RENDER_STAT(NumVertexBufferBinds);
+	}
+
+	void NullRenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numIndexBufferBinds++;
+
+		BS_INC_RENDER_STAT(NumIndexBufferBinds);
+	}
+
+	void NullRenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numVertexDeclarationBinds++;
+	}
+
+	void NullRenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mActiveDrawOp = op;
+	}
+
+	void NullRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		const UINT32 numInstances = std::max(instanceCount, 1U);
+		const UINT32 primCount = vertexCountToPrimCount(cb->mActiveDrawOp, vertexCount);
+
+		cb->mStats.numDrawCalls++;
+		cb->mStats.numInstances += numInstances;
+		cb->mStats.numVertices += (UINT64)vertexCount * numInstances;
+		cb->mStats.numPrimitives += (UINT64)primCount * numInstances;
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount * numInstances);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount * numInstances);
+	}
+
+	void NullRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+
+		const UINT32 numInstances = std::max(instanceCount, 1U);
+		const UINT32 primCount = vertexCountToPrimCount(cb->mActiveDrawOp, indexCount);
+
+		cb->mStats.numDrawCalls++;
+		cb->mStats.numIndexedDrawCalls++;
+		cb->mStats.numInstances += numInstances;
+		cb->mStats.numVertices += (UINT64)vertexCount * numInstances;
+		cb->mStats.numPrimitives += (UINT64)primCount * numInstances;
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount * numInstances);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount * numInstances);
+	}
+
+	void NullRenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numComputeCalls++;
+
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
+	void NullRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numScissorChanges++;
+	}
+
+	void NullRenderAPI::setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStencilRef = value;
+	}
+
+	void NullRenderAPI::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numClears++;
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mStats.numClears++;
+
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags,
+		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mRenderTarget = target;
+		cb->mStats.numRenderTargetChanges++;
+
+		if(commandBuffer == nullptr)
+			mActiveRenderTarget = target;
+
+		BS_INC_RENDER_STAT(NumRenderTargetChanges);
+	}
+
+	void NullRenderAPI::swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+		target->swapBuffers();
+
+		mMainCommandBuffer->mStats.numPresents++;
+		BS_INC_RENDER_STAT(NumPresents);
+
+		if(target.get() == mPrimaryWindow)
+			endFrame();
+	}
+
+	void NullRenderAPI::addCommands(const SPtr<CommandBuffer>& commandBuffer, const SPtr<CommandBuffer>& secondary)
+	{
+		SPtr<NullCommandBuffer> cb = std::static_pointer_cast<NullCommandBuffer>(commandBuffer);
+		SPtr<NullCommandBuffer> secondaryCb = std::static_pointer_cast<NullCommandBuffer>(secondary);
+
+		cb->appendSecondary(secondaryCb);
+	}
+
+	void NullRenderAPI::submitCommandBuffer(const SPtr<CommandBuffer>& commandBuffer, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		// Commands on the main command buffer have already been counted when issued
+		SPtr<NullCommandBuffer> cb = std::static_pointer_cast<NullCommandBuffer>(commandBuffer);
+		if (cb == nullptr || cb == mMainCommandBuffer)
+			return;
+
+		NullRenderAPIStats& stats = mMainCommandBuffer->mStats;
+		stats += cb->mStats;
+		stats.numCommandBufferSubmits++;
+
+		cb->clear();
+	}
+
+	const NullRenderAPIStats& NullRenderAPI::getFrameStats() const
+	{
+		return mMainCommandBuffer->mStats;
+	}
+
+	void NullRenderAPI::endFrame()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mLastFrameStats = mMainCommandBuffer->mStats;
+		mMainCommandBuffer->mStats = NullRenderAPIStats();
+	}
+
+	NullRenderAPIStats& NullRenderAPI::_getImmediateStats()
+	{
+		return mMainCommandBuffer->mStats;
+	}
+
+	NullCommandBuffer* NullRenderAPI::getCB(const SPtr<CommandBuffer>& buffer) const
+	{
+		if (buffer == nullptr)
+			return mMainCommandBuffer.get();
+
+		assert(buffer->getType() == GQT_GRAPHICS || buffer->getType() == GQT_COMPUTE);
+		return static_cast<NullCommandBuffer*>(buffer.get());
+	}
+
+	void NullRenderAPI::initCapabilities(RenderAPICapabilities& caps) const
+	{
+		caps.setDriverVersion(DriverVersion());
+		caps.setDeviceName("Null device");
+		caps.setRenderAPIName(getName());
+		caps.setVendor(GPU_UNKNOWN);
+
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_BC);
+		caps.setCapability(RSC_GEOMETRY_PROGRAM);
+		caps.setCapability(RSC_TESSELLATION_PROGRAM);
+		caps.setCapability(RSC_COMPUTE_PROGRAM);
+
+		caps.addShaderProfile("hlsl");
+		caps.setMaxBoundVertexBuffers(32);
+		caps.setNumMultiRenderTargets(BS_MAX_MULTIPLE_RENDER_TARGETS);
+
+		const GpuProgramType programTypes[] = { GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM,
+			GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM, GPT_COMPUTE_PROGRAM };
+
+		for(auto& type : programTypes)
+		{
+			caps.setNumTextureUnits(type, 128);
+			caps.setNumGpuParamBlockBuffers(type, 14);
+		}
+
+		caps.setNumLoadStoreTextureUnits(GPT_FRAGMENT_PROGRAM, 8);
+		caps.setNumLoadStoreTextureUnits(GPT_COMPUTE_PROGRAM, 8);
+
+		const UINT32 numProgramTypes = sizeof(programTypes) / sizeof(programTypes[0]);
+		caps.setNumCombinedTextureUnits(128 * numProgramTypes);
+		caps.setNumCombinedGpuParamBlockBuffers(14 * numProgramTypes);
+		caps.setParamBlockOffsetAlignment(256);
+		caps.setNumCombinedLoadStoreTextureUnits(16);
+	}
+
+	void NullRenderAPI::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
+	{
+		dest = matrix;
+
+		// Convert depth range from [-1,+1] to [0,1]
+		dest[2][0] = (dest[2][0] + dest[3][0]) / 2;
+		dest[2][1] = (dest[2][1] + dest[3][1]) / 2;
+		dest[2][2] = (dest[2][2] + dest[3][2]) / 2;
+		dest[2][3] = (dest[2][3] + dest[3][3]) / 2;
+	}
+
+	const RenderAPIInfo& NullRenderAPI::getAPIInfo() const
+	{
+		RenderAPIFeatures featureFlags =
+			RenderAPIFeatureFlag::MultiThreadedCB |
+			RenderAPIFeatureFlag::TextureViews |
+			RenderAPIFeatureFlag::Compute |
+			RenderAPIFeatureFlag::LoadStore |
+			RenderAPIFeatureFlag::RenderTargetLayers;
+
+		static RenderAPIInfo info(0.0f, 0.0f, 0.0f, 1.0f, VET_COLOR_ABGR, featureFlags);
+
+		return info;
+	}
+
+	GpuParamBlockDesc NullRenderAPI::generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params)
+	{
+		// Uses the same layout as DirectX 11, so it matches any program reflection that was generated for HLSL
+		GpuParamBlockDesc block;
+		block.blockSize = 0;
+		block.isShareable = true;
+		block.name = name;
+		block.slot = 0;
+		block.set = 0;
+
+		for (auto& param : params)
+		{
+			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[param.type];
+
+			if (param.arraySize > 1)
+			{
+				// Arrays perform no packing and their elements are always padded and aligned to four component vectors
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+				else
+					size = Math::divideAndRoundUp(typeInfo.size, 16U) * 4;
+
+				block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				// Last array element isn't rounded up to four component vectors unless it's a struct
+				if(param.type != GPDT_STRUCT)
+				{
+					block.blockSize += size * (param.arraySize - 1);
+					block.blockSize += typeInfo.size / 4;
+				}
+				else
+					block.blockSize += param.arraySize * size;
+			}
+			else
+			{
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+				{
+					// Structs are always aligned and rounded up to 4 component vectors
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+					block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+				}
+				else
+				{
+					size = typeInfo.baseTypeSize * (typeInfo.numRows * typeInfo.numColumns) / 4;
+
+					// Pack everything as tightly as possible as long as the data doesn't cross 16 byte boundary
+					UINT32 alignOffset = block.blockSize % 4;
+					if (alignOffset != 0 && size > (4 - alignOffset))
+					{
+						UINT32 padding = (4 - alignOffset);
+						block.blockSize += padding;
+					}
+				}
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				block.blockSize += size;
+			}
+
+			param.paramBlockSlot = 0;
+			param.paramBlockSet = 0;
+		}
+
+		// Constant buffer size must always be a multiple of 16
+		if (block.blockSize % 4 != 0)
+			block.blockSize += (4 - (block.blockSize % 4));
+
+		return block;
+	}
+}}
@@ -0,0 +1,206 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsRenderAPI.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** Counts of operations issued to the null render API. */
+	struct NullRenderAPIStats
+	{
+		UINT32 numDrawCalls = 0;
+		UINT32 numIndexedDrawCalls = 0;
+		UINT32 numInstances = 0;
+		UINT64 numVertices = 0;
+		UINT64 numPrimitives = 0;
+		UINT32 numComputeCalls = 0;
+
+		UINT32 numPipelineStateChanges = 0;
+		UINT32 numGpuParamBinds = 0;
+		UINT32 numVertexBufferBinds = 0;
+		UINT32 numIndexBufferBinds = 0;
+		UINT32 numVertexDeclarationBinds = 0;
+		UINT32 numViewportChanges = 0;
+		UINT32 numScissorChanges = 0;
+		UINT32 numRenderTargetChanges = 0;
+		UINT32 numClears = 0;
+		UINT32 numPresents = 0;
+		UINT32 numCommandBufferSubmits = 0;
+
+		UINT32 numBufferWrites = 0;
+		UINT32 numBufferReads = 0;
+		UINT32 numTextureWrites = 0;
+		UINT32 numTextureReads = 0;
+		UINT64 numBytesWritten = 0;
+		UINT64 numBytesRead = 0;
+
+		/** Adds counts from another set of statistics to this one. */
+		NullRenderAPIStats& operator+=(const NullRenderAPIStats& other);
+	};
+
+	/**
+	 * Render API that doesn't communicate with a GPU. All rendering commands are no-ops that only perform bookkeeping,
+	 * which allows full frames to be executed headless in order to measure the CPU cost of the renderer. Every operation
+	 * is counted, and the counts can be retrieved per-frame through getFrameStats() and getLastFrameStats().
+	 *
+	 * A frame ends when the buffers of the primary render window are swapped.
+	 *
+	 * GPU programs are not compiled. If a program is created with bytecode containing reflection information, that
+	 * information is used for its parameters. Otherwise the program reports no parameters.
+	 */
+	class NullRenderAPI : public RenderAPI
+	{
+	public:
+		NullRenderAPI() = default;
+		~NullRenderAPI() = default;
+
+		/** @copydoc RenderAPI::getName */
+		const StringID& getName() const override;
+
+		/** @copydoc RenderAPI::setGraphicsPipeline */
+		void setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setComputePipeline */
+		void setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setGpuParams */
+		void setGpuParams(const SPtr<GpuParams>& gpuParams,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::clearRenderTarget */
+		void clearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0,
+			UINT8 targetMask = 0xFF, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::clearViewport */
+		void clearViewport(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f, UINT16 stencil = 0,
+			UINT8 targetMask = 0xFF, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setRenderTarget */
+		void setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags,
+			RenderSurfaceMask loadMask = RT_NONE, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setViewport */
+		void setViewport(const Rect2& area, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setScissorRect */
+		void setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setStencilRef */
+		void setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setVertexBuffers */
+		void setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setIndexBuffer */
+		void setIndexBuffer(const SPtr<IndexBuffer>& buffer,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setVertexDeclaration */
+		void setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::setDrawOperation */
+		void setDrawOperation(DrawOperationType op,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::draw */
+		void draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::drawIndexed */
+		void drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+			UINT32 instanceCount = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::dispatchCompute */
+		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::swapBuffers() */
+		void swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask = 0xFFFFFFFF) override;
+
+		/** @copydoc RenderAPI::addCommands() */
+		void addCommands(const SPtr<CommandBuffer>& commandBuffer, const SPtr<CommandBuffer>& secondary) override;
+
+		/** @copydoc RenderAPI::submitCommandBuffer() */
+		void submitCommandBuffer(const SPtr<CommandBuffer>& commandBuffer, UINT32 syncMask = 0xFFFFFFFF) override;
+
+		/** @copydoc RenderAPI::convertProjectionMatrix */
+		void convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest) override;
+
+		/** @copydoc RenderAPI::getAPIInfo */
+		const RenderAPIInfo& getAPIInfo() const override;
+
+		/** @copydoc RenderAPI::generateParamBlockDesc() */
+		GpuParamBlockDesc generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params) override;
+
+		/**
+		 * Returns the operations counted since the end of the last frame. Operations recorded in command buffers are only
+		 * counted once the buffer is submitted.
+		 *
+		 * @note	Core thread only.
+		 */
+		const NullRenderAPIStats& getFrameStats() const;
+
+		/**
+		 * Returns the operations counted during the last completed frame.
+		 *
+		 * @note	Core thread only.
+		 */
+		const NullRenderAPIStats& getLastFrameStats() const { return mLastFrameStats; }
+
+		/**
+		 * Ends the current frame, making its statistics available through getLastFrameStats() and resetting the
+		 * statistics returned by getFrameStats(). Called automatically when the primary window is presented.
+		 *
+		 * @note	Core thread only.
+		 */
+		void endFrame();
+
+		/************************************************************************/
+		/* 				Internal use by null backend only						*/
+		/************************************************************************/
+
+		/**
+		 * Returns the statistics that operations executed immediately on the core thread, like buffer writes, should be
+		 * counted in.
+		 */
+		NullRenderAPIStats& _getImmediateStats();
+
+	protected:
+		friend class NullRenderAPIFactory;
+
+		/** @copydoc RenderAPI::initialize */
+		void initialize() override;
+
+		/** @copydoc RenderAPI::initializeWithWindow */
+		void initializeWithWindow(const SPtr<RenderWindow>& primaryWindow) override;
+
+		/** @copydoc RenderAPI::destroyCore */
+		void destroyCore() override;
+
+		/** Returns the provided command buffer, or the main command buffer if none is provided. */
+		NullCommandBuffer* getCB(const SPtr<CommandBuffer>& buffer) const;
+
+		/** Creates and populates a set of render system capabilities describing which functionality is available. */
+		void initCapabilities(RenderAPICapabilities& caps) const;
+
+	private:
+		SPtr<NullCommandBuffer> mMainCommandBuffer;
+		NullGpuProgramFactory* mProgramFactory = nullptr;
+		RenderTarget* mPrimaryWindow = nullptr;
+
+		NullRenderAPIStats mLastFrameStats;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,47 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsRenderAPIFactory.h"
+#include "Managers/BsRenderAPIManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** Handles creation of the null render API. */
+	class NullRenderAPIFactory : public RenderAPIFactory
+	{
+	public:
+		static constexpr const char* SystemName = "bsfNullRenderAPI";
+
+		/** @copydoc RenderAPIFactory::create */
+		void create() override;
+
+		/** @copydoc RenderAPIFactory::name */
+		const char* name() const override { return SystemName; }
+
+	private:
+		/**	Registers the factory with the render system manager when constructed. */
+		class InitOnStart
+		{
+		public:
+			InitOnStart()
+			{
+				static SPtr<RenderAPIFactory> newFactory;
+				if(newFactory == nullptr)
+				{
+					newFactory = bs_shared_ptr_new<NullRenderAPIFactory>();
+					RenderAPIManager::instance().registerFactory(newFactory);
+				}
+			}
+		};
+
+		static InitOnStart initOnStart; // Makes sure factory is registered on library load
+	};
+
+	/** @} */
+}}
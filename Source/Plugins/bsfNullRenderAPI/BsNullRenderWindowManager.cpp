@@ -0,0 +1,21 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderWindowManager.h"
+#include "BsNullRenderAPI.h"
+#include "BsNullRenderWindow.h"
+
+namespace bs
+{
+	NullRenderWindowManager::NullRenderWindowManager(ct::NullRenderAPI* renderSystem)
+		:mRenderSystem(renderSystem)
+	{
+		assert(mRenderSystem != nullptr);
+	}
+
+	SPtr<RenderWindow> NullRenderWindowManager::createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId, 
+		const SPtr<RenderWindow>& parentWindow)
+	{
+		NullRenderWindow* renderWindow = new (bs_alloc<NullRenderWindow>()) NullRenderWindow(desc, windowId);
+		return bs_core_ptr<NullRenderWindow>(renderWindow);
+	}
+}
@@ -0,0 +1,30 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsRenderWindowManager.h"
+
+namespace bs
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** @copydoc RenderWindowManager */
+	class NullRenderWindowManager : public RenderWindowManager
+	{
+	public:
+		NullRenderWindowManager(ct::NullRenderAPI* renderSystem);
+
+	protected:
+		/** @copydoc RenderWindowManager::createImpl */
+		SPtr<RenderWindow> createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId, 
+			const SPtr<RenderWindow>& parentWindow) override;
+
+	private:
+		ct::NullRenderAPI* mRenderSystem;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,90 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTexture.h"
+#include "BsNullRenderAPI.h"
+#include "Image/BsPixelUtil.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullTexture::NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask)
+		: Texture(desc, initialData, deviceMask)
+	{ }
+
+	NullTexture::~NullTexture()
+	{
+		if(mLockedData != nullptr)
+			bs_free(mLockedData);
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Texture);
+	}
+
+	void NullTexture::initialize()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Texture);
+		Texture::initialize();
+	}
+
+	PixelData NullTexture::lockImpl(GpuLockOptions options, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+		UINT32 mipWidth = std::max(1u, mProperties.getWidth() >> mipLevel);
+		UINT32 mipHeight = std::max(1u, mProperties.getHeight() >> mipLevel);
+		UINT32 mipDepth = std::max(1u, mProperties.getDepth() >> mipLevel);
+
+		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mProperties.getFormat());
+
+		// Contents aren't stored, so provide a zeroed scratch area that lives until the texture is unlocked
+		const UINT32 size = lockedArea.getSize();
+		mLockedData = (UINT8*)bs_alloc(size);
+		memset(mLockedData, 0, size);
+
+		lockedArea.setExternalBuffer(mLockedData);
+
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			stats.numTextureReads++;
+			stats.numBytesRead += size;
+		}
+
+		if (options != GBL_READ_ONLY)
+		{
+			stats.numTextureWrites++;
+			stats.numBytesWritten += size;
+		}
+
+		return lockedArea;
+	}
+
+	void NullTexture::unlockImpl()
+	{
+		bs_free(mLockedData);
+		mLockedData = nullptr;
+	}
+
+	void NullTexture::copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numTextureWrites++;
+	}
+
+	void NullTexture::readDataImpl(PixelData& dest, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		if(dest.getData() != nullptr)
+			memset(dest.getData(), 0, dest.getSize());
+
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numTextureReads++;
+		stats.numBytesRead += dest.getSize();
+	}
+
+	void NullTexture::writeDataImpl(const PixelData& src, UINT32 mipLevel, UINT32 face, bool discardWholeBuffer,
+		UINT32 queueIdx)
+	{
+		NullRenderAPIStats& stats = static_cast<NullRenderAPI&>(RenderAPI::instance())._getImmediateStats();
+		stats.numTextureWrites++;
+		stats.numBytesWritten += src.getSize();
+	}
+}}
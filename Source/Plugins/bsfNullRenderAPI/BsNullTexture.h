@@ -0,0 +1,54 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Image/BsTexture.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**
+	 * Null render API implementation of a texture. Texture contents are not stored, writes are only counted and reads
+	 * return zeroed data.
+	 */
+	class NullTexture : public Texture
+	{
+	public:
+		~NullTexture();
+
+	protected:
+		friend class NullTextureManager;
+
+		NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask);
+
+		/** @copydoc Texture::initialize */
+		void initialize() override;
+
+		/** @copydoc Texture::lockImpl */
+		PixelData lockImpl(GpuLockOptions options, UINT32 mipLevel = 0, UINT32 face = 0, UINT32 deviceIdx = 0,
+						   UINT32 queueIdx = 0) override;
+
+		/** @copydoc Texture::unlockImpl */
+		void unlockImpl() override;
+
+		/** @copydoc Texture::copyImpl */
+		void copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc, 
+			const SPtr<CommandBuffer>& commandBuffer) override;
+
+		/** @copydoc Texture::readDataImpl */
+		void readDataImpl(PixelData& dest, UINT32 mipLevel = 0, UINT32 face = 0, UINT32 deviceIdx = 0,
+						  UINT32 queueIdx = 0) override;
+
+		/** @copydoc Texture::writeDataImpl */
+		void writeDataImpl(const PixelData& src, UINT32 mipLevel = 0, UINT32 face = 0, bool discardWholeBuffer = false,
+						   UINT32 queueIdx = 0) override;
+
+		UINT8* mLockedData = nullptr;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,43 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsTextureManager.h"
+
+namespace bs
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**	Handles creation of null render API textures. */
+	class NullTextureManager : public TextureManager
+	{
+	public:
+		/** @copydoc TextureManager::getNativeFormat */
+		PixelFormat getNativeFormat(TextureType ttype, PixelFormat format, int usage, bool hwGamma) override;
+
+	protected:		
+		/** @copydoc TextureManager::createRenderTextureImpl */
+		SPtr<RenderTexture> createRenderTextureImpl(const RENDER_TEXTURE_DESC& desc) override;
+	};
+
+	namespace ct
+	{
+	/**	Handles creation of null render API textures. */
+	class NullTextureManager : public TextureManager
+	{
+	protected:
+		/** @copydoc TextureManager::createTextureInternal */
+		SPtr<Texture> createTextureInternal(const TEXTURE_DESC& desc, 
+			const SPtr<PixelData>& initialData = nullptr, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc TextureManager::createRenderTextureInternal */
+		SPtr<RenderTexture> createRenderTextureInternal(const RENDER_TEXTURE_DESC& desc, 
+			UINT32 deviceIdx = 0) override;
+	};
+	}
+
+	/** @} */
+}
@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullVertexBuffer.h"
+#include "BsNullHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	static void deleteBuffer(HardwareBuffer* buffer)
+	{
+		bs_pool_delete(static_cast<NullHardwareBuffer*>(buffer));
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const VERTEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: VertexBuffer(desc, deviceMask)
+	{ }
+
+	void NullVertexBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mUsage, 1, mSize);
+		mBufferDeleter = &deleteBuffer;
+
+		VertexBuffer::initialize();
+	}
+}}
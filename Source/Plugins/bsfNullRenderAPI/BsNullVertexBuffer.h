@@ -0,0 +1,26 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsVertexBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/**	Null render API implementation of a vertex buffer, storing its contents in system memory. */
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(const VERTEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+
+	protected: 
+		/** @copydoc VertexBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
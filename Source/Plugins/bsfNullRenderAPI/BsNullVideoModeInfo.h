@@ -0,0 +1,29 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsVideoModeInfo.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Null
+	 *  @{
+	 */
+
+	/** @copydoc VideoOutputInfo */
+	class NullVideoOutputInfo : public VideoOutputInfo
+	{
+	public:
+		NullVideoOutputInfo();
+	};
+
+	/** Reports a single virtual output with a single 1920x1080 video mode. */
+	class NullVideoModeInfo : public VideoModeInfo
+	{
+	public:
+		NullVideoModeInfo();
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,50 @@
+set(BS_NULLRENDERAPI_INC_NOFILTER
+	"BsNullCommandBuffer.h"
+	"BsNullCommandBufferManager.h"
+	"BsNullGpuBuffer.h"
+	"BsNullGpuParamBlockBuffer.h"
+	"BsNullGpuProgram.h"
+	"BsNullHardwareBuffer.h"
+	"BsNullHardwareBufferManager.h"
+	"BsNullIndexBuffer.h"
+	"BsNullPrerequisites.h"
+	"BsNullQueryManager.h"
+	"BsNullRenderAPI.h"
+	"BsNullRenderAPIFactory.h"
+	"BsNullRenderTexture.h"
+	"BsNullRenderWindow.h"
+	"BsNullRenderWindowManager.h"
+	"BsNullTexture.h"
+	"BsNullTextureManager.h"
+	"BsNullVertexBuffer.h"
+	"BsNullVideoModeInfo.h"
+)
+
+set(BS_NULLRENDERAPI_SRC_NOFILTER
+	"BsNullCommandBuffer.cpp"
+	"BsNullCommandBufferManager.cpp"
+	"BsNullGpuBuffer.cpp"
+	"BsNullGpuParamBlockBuffer.cpp"
+	"BsNullGpuProgram.cpp"
+	"BsNullHardwareBuffer.cpp"
+	"BsNullHardwareBufferManager.cpp"
+	"BsNullIndexBuffer.cpp"
+	"BsNullPlugin.cpp"
+	"BsNullQueryManager.cpp"
+	"BsNullRenderAPI.cpp"
+	"BsNullRenderAPIFactory.cpp"
+	"BsNullRenderTexture.cpp"
+	"BsNullRenderWindow.cpp"
+	"BsNullRenderWindowManager.cpp"
+	"BsNullTexture.cpp"
+	"BsNullTextureManager.cpp"
+	"BsNullVertexBuffer.cpp"
+	"BsNullVideoModeInfo.cpp"
+)
+
+source_group("" FILES ${BS_NULLRENDERAPI_INC_NOFILTER} ${BS_NULLRENDERAPI_SRC_NOFILTER})
+
+set(BS_NULLRENDERAPI_SRC
+	${BS_NULLRENDERAPI_INC_NOFILTER}
+	${BS_NULLRENDERAPI_SRC_NOFILTER}
+)
@@ -348,6 +348,9 @@ namespace bs { namespace ct
 		// are actually modified after sync
 		mScene->refreshSamplerOverrides();
 
+		// Occluder geometry is shared per mesh, and only needs to be re-extracted if the mesh contents were modified
+		mScene->refreshOccluderGeometry();
+
 		// Update global per-frame hardware buffers
 		mScene->setParamFrameParams(timings.time);
 
@@ -380,7 +383,7 @@ namespace bs { namespace ct
 		// Gather all views
 		for (auto& rtInfo : sceneInfo.renderTargets)
 		{
-			Vector<RendererView*> views;
+			SmallVector<RendererView*, 4> views;
 			SPtr<RenderTarget> target = rtInfo.target;
 			const Vector<Camera*>& cameras = rtInfo.cameras;
 
@@ -416,16 +419,16 @@ namespace bs { namespace ct
 		shadowRenderer.renderShadowMaps(*mScene, viewGroup, frameInfo);
 
 		// Update various buffers required by each renderable
-		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
-		for (UINT32 i = 0; i < numRenderables; i++)
+		visibility.renderables.forEachSet([this, &frameInfo](UINT32 i)
 		{
-			if (!visibility.renderables[i])
-				continue;
-
 			mScene->prepareRenderable(i, frameInfo);
-		}
+		});
 
+		// Instanced parameters are only created for elements that end up batched
 		UINT32 numViews = viewGroup.getNumViews();
+		for (UINT32 i = 0; i < numViews; i++)
+			mScene->prepareInstancedElements(*viewGroup.getView(i)->getOpaqueQueue(false));
+
 		for (UINT32 i = 0; i < numViews; i++)
 		{
 			RendererView* view = viewGroup.getView(i);
@@ -673,6 +676,8 @@ namespace bs { namespace ct
 		viewDesc.projTransform = projTransform;
 		viewDesc.projType = PT_PERSPECTIVE;
 
+		viewDesc.occlusionCulling = mCoreOptions->occlusionCulling;
+		viewDesc.instancing = mCoreOptions->instancing;
 		viewDesc.stateReduction = mCoreOptions->stateReductionMode;
 		viewDesc.sceneCamera = nullptr;
 
@@ -730,10 +735,10 @@ namespace bs { namespace ct
 			viewDesc.viewTransform = Matrix4(viewRotationMat) * viewOffsetMat;
 
 			// Calculate world frustum for culling
-			const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
+			const auto& frustumPlanes = localFrustum.getPlanes();
 			Matrix4 worldMatrix = viewDesc.viewTransform.transpose();
 
-			Vector<Plane> worldPlanes(frustumPlanes.size());
+			SmallVector<Plane, 6> worldPlanes(frustumPlanes.size());
 			UINT32 j = 0;
 			for (auto& plane : frustumPlanes)
 			{
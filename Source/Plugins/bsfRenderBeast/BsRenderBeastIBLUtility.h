@@ -124,7 +124,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SH_ORDER", shOrder)
 			});
 
@@ -177,7 +177,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SH_ORDER", shOrder)
 			});
 
@@ -43,6 +43,27 @@ namespace bs { namespace ct
 		 * shadows far away, but will never increase the resolution past the provided value.
 		 */
 		UINT32 shadowMapSize = 2048;
+
+		/**
+		 * Determines if objects hidden behind occluders should be culled. Occluders are rasterized on the CPU into a low
+		 * resolution depth buffer, against which the bounds of all other objects are tested. Only renderables marked as
+		 * occluders are rasterized, so this has no effect unless some are present in the scene. Disabled by default.
+		 */
+		bool occlusionCulling = false;
+
+		/**
+		 * Determines if opaque objects using the same mesh and material should be rendered together using instanced draw
+		 * calls, instead of being drawn one by one. Only applies to static (non-animated) objects rendered using the
+		 * deferred pipeline, whose shaders support the INSTANCED variation. Most effective when used together with
+		 * StateReduction::Material. Disabled by default.
+		 */
+		bool instancing = false;
+
+		/**
+		 * If enabled, each view records how the transient render targets used during rendering were assigned to pooled
+		 * GPU textures. The map is available from RenderCompositor::getMemoryMap(). Has a small CPU cost.
+		 */
+		bool recordCompositorMemoryMap = false;
 	};
 
 	/** @} */
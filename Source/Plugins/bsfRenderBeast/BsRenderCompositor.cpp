@@ -6,6 +6,7 @@
 #include "Renderer/BsCamera.h"
 #include "Renderer/BsRendererUtility.h"
 #include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsGpuParamBlockAllocator.h"
 #include "Utility/BsBitwise.h"
 #include "Mesh/BsMesh.h"
 #include "Material/BsGpuParamsSet.h"
@@ -144,6 +145,8 @@ namespace bs { namespace ct
 
 		bs_frame_mark();
 		{
+			planTransientTargets(inputs.view);
+
 			FrameVector<const NodeInfo*> activeNodes;
 
 			UINT32 idx = 0;
@@ -151,6 +154,13 @@ namespace bs { namespace ct
 			{
 				inputs.inputNodes = entry.inputs;
 
+				inputs.transientTargets.clear();
+				for (UINT32 i = mTransientTargetOffsets[idx]; i < mTransientTargetOffsets[idx + 1]; i++)
+				{
+					const TransientTarget& target = mTransientTargets[i];
+					inputs.transientTargets.push_back(mTransientAllocations[target.allocationIdx].texture);
+				}
+
 #if BS_PROFILING_ENABLED
 				const ProfilerString sampleName = ProfilerString("RC: ") + entry.nodeType->id.c_str();
 				BS_GPU_PROFILE_BEGIN(sampleName);
@@ -178,11 +188,122 @@ namespace bs { namespace ct
 
 				idx++;
 			}
+
+			if (!mNodeInfos.empty())
+				mNodeInfos.back().node->clear();
 		}
 		bs_frame_clear();
 
-		if (!mNodeInfos.empty())
-			mNodeInfos.back().node->clear();
+		inputs.transientTargets.clear();
+
+		// Return the textures to the pool so other views can use them, but keep the references so the textures aren't
+		// destroyed before the next frame
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+		for (auto& entry : mTransientAllocations)
+			resPool.release(entry.texture);
+
+		if (inputs.options.recordCompositorMemoryMap)
+			buildMemoryMap();
+	}
+
+	void RenderCompositor::planTransientTargets(const RendererView& view) const
+	{
+		// Textures retrieved during the previous frame are free in the pool, keep them alive until the new textures are
+		// retrieved so the pool can hand them out again
+		FrameVector<SPtr<PooledRenderTexture>> prevTextures;
+		for (auto& entry : mTransientAllocations)
+			prevTextures.push_back(entry.texture);
+
+		mTransientTargets.clear();
+		mTransientTargetOffsets.clear();
+		mTransientAllocations.clear();
+
+		const UINT32 numNodes = (UINT32)mNodeInfos.size();
+		for (UINT32 i = 0; i < numNodes; i++)
+		{
+			const NodeInfo& nodeInfo = mNodeInfos[i];
+			mTransientTargetOffsets.push_back((UINT32)mTransientTargets.size());
+
+			// The final node isn't used by any other node, and is cleared once all the nodes execute
+			UINT32 lastUseIdx = nodeInfo.lastUseIdx;
+			if (lastUseIdx == (UINT32)-1)
+				lastUseIdx = numNodes - 1;
+
+			SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> descs = nodeInfo.nodeType->getTransientTargets(view);
+			for (auto& desc : descs)
+			{
+				// Targets are visited in the order of their first use, so any matching allocation whose last target was
+				// already used by a previous node can be shared
+				UINT32 allocationIdx = (UINT32)-1;
+				for (UINT32 j = 0; j < (UINT32)mTransientAllocations.size(); j++)
+				{
+					TransientAllocation& allocation = mTransientAllocations[j];
+					if (allocation.lastUseIdx < i && allocation.desc == desc)
+					{
+						allocation.lastUseIdx = lastUseIdx;
+						allocationIdx = j;
+						break;
+					}
+				}
+
+				if (allocationIdx == (UINT32)-1)
+				{
+					allocationIdx = (UINT32)mTransientAllocations.size();
+					mTransientAllocations.push_back({ desc, lastUseIdx, nullptr });
+				}
+
+				mTransientTargets.push_back({ desc, i, lastUseIdx, allocationIdx });
+			}
+		}
+
+		mTransientTargetOffsets.push_back((UINT32)mTransientTargets.size());
+
+		// Retrieve all the textures before any node executes, so that textures retrieved by the nodes themselves can't
+		// be assigned one of the textures planned for a later target
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+		for (auto& entry : mTransientAllocations)
+			entry.texture = resPool.get(entry.desc);
+	}
+
+	void RenderCompositor::buildMemoryMap() const
+	{
+		mMemoryMap = RenderCompositorMemoryMap();
+
+		for (auto& entry : mNodeInfos)
+			mMemoryMap.nodes.push_back(entry.nodeType->id);
+
+		for (auto& entry : mTransientAllocations)
+		{
+			UINT64 memorySize = GpuResourcePool::getMemorySize(entry.desc);
+
+			mMemoryMap.allocationSizes.push_back(memorySize);
+			mMemoryMap.allocatedMemory += memorySize;
+		}
+
+		for (auto& entry : mTransientTargets)
+		{
+			RenderCompositorResourceInfo info;
+			info.nodeId = mNodeInfos[entry.firstUseIdx].nodeType->id;
+			info.allocationIdx = entry.allocationIdx;
+			info.memorySize = mMemoryMap.allocationSizes[entry.allocationIdx];
+			info.firstUseIdx = entry.firstUseIdx;
+			info.lastUseIdx = entry.lastUseIdx;
+
+			mMemoryMap.resources.push_back(info);
+			mMemoryMap.requestedMemory += info.memorySize;
+		}
+
+		for (UINT32 i = 0; i < (UINT32)mNodeInfos.size(); i++)
+		{
+			UINT64 usedMemory = 0;
+			for (auto& entry : mMemoryMap.resources)
+			{
+				if (entry.firstUseIdx <= i && entry.lastUseIdx >= i)
+					usedMemory += entry.memorySize;
+			}
+
+			mMemoryMap.peakMemory = std::max(mMemoryMap.peakMemory, usedMemory);
+		}
 	}
 
 	void RenderCompositor::clear()
@@ -191,26 +312,20 @@ namespace bs { namespace ct
 			bs_delete(entry.node);
 
 		mNodeInfos.clear();
+		mTransientTargets.clear();
+		mTransientTargetOffsets.clear();
+		mTransientAllocations.clear();
 		mIsValid = false;
 	}
 
 	void RCNodeSceneDepth::render(const RenderCompositorNodeInputs& inputs)
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		const RendererViewProperties& viewProps = inputs.view.getProperties();
-
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
-		UINT32 numSamples = viewProps.numSamples;
-
-		depthTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL,
-			numSamples, false));
+		depthTex = inputs.transientTargets[0];
 	}
 
 	void RCNodeSceneDepth::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		resPool.release(depthTex);
+		depthTex = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeSceneDepth::getDependencies(const RendererView& view)
@@ -218,23 +333,26 @@ namespace bs { namespace ct
 		return {};
 	}
 
-	void RCNodeGBuffer::render(const RenderCompositorNodeInputs& inputs)
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeSceneDepth::getTransientTargets(const RendererView& view)
 	{
-		// Allocate necessary textures & targets
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		const RendererViewProperties& viewProps = inputs.view.getProperties();
+		const RendererViewProperties& viewProps = view.getProperties();
 
 		UINT32 width = viewProps.viewRect.width;
 		UINT32 height = viewProps.viewRect.height;
 		UINT32 numSamples = viewProps.numSamples;
 
-		// Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
-		albedoTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-			numSamples, true));
-		normalTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGB10A2, width, height, TU_RENDERTARGET,
-			numSamples, false));
-		roughMetalTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RG16F, width, height, TU_RENDERTARGET,
-			numSamples, false)); // Note: Metal doesn't need 16-bit float
+		return { POOLED_RENDER_TEXTURE_DESC::create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL, numSamples,
+			false) };
+	}
+
+	void RCNodeGBuffer::render(const RenderCompositorNodeInputs& inputs)
+	{
+		// Retrieve necessary textures & targets
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		albedoTex = inputs.transientTargets[0];
+		normalTex = inputs.transientTargets[1];
+		roughMetalTex = inputs.transientTargets[2];
 
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[0]);
 		SPtr<PooledRenderTexture> sceneDepthTex = sceneDepthNode->depthTex;
@@ -284,7 +402,7 @@ namespace bs { namespace ct
 				continue;
 
 			RendererRenderable* rendererRenderable = inputs.scene.renderables[i];
-			rendererRenderable->updatePerCallBuffer(viewProps.viewProjTransform);
+			rendererRenderable->updatePerCallBuffer(viewProps.viewProjTransform, *inputs.scene.paramBlockAllocator);
 
 			for (auto& element : inputs.scene.renderables[i]->elements)
 			{
@@ -298,6 +416,9 @@ namespace bs { namespace ct
 			}
 		}
 
+		// Upload per-object and per-call data of all prepared objects at once
+		inputs.scene.paramBlockAllocator->flush();
+
 		Camera* sceneCamera = inputs.view.getSceneCamera();
 
 		// Trigger prepare callbacks
@@ -331,16 +452,40 @@ namespace bs { namespace ct
 		}
 
 		// Render all visible opaque elements that use the deferred pipeline
-		const Vector<RenderQueueElement>& opaqueElements = inputs.view.getOpaqueQueue(false)->getSortedElements();
+		const SPtr<RenderQueue>& opaqueQueue = inputs.view.getOpaqueQueue(false);
+		mInstanceBuffer.update(*opaqueQueue);
+
+		bool prevInstanced = false;
+		const Vector<RenderQueueElement>& opaqueElements = opaqueQueue->getSortedElements();
 		for (auto iter = opaqueElements.begin(); iter != opaqueElements.end(); ++iter)
 		{
 			const RenderableElement* renderElem = static_cast<const RenderableElement*>(iter->renderElem);
 
 			SPtr<Material> material = renderElem->material;
 
-			if (iter->applyPass)
+			// Instanced draw calls use a different technique, so the pass must be re-applied when switching
+			const bool instanced = iter->numInstances > 1;
+			if (instanced)
+			{
+				if (iter->applyPass || !prevInstanced)
+					gRendererUtility().setPass(material, iter->passIdx, renderElem->instancedTechniqueIdx);
+
+				SPtr<GpuParams> gpuParams = renderElem->instancedParams->getGpuParams(iter->passIdx);
+				gpuParams->setParamBlockBuffer(gPerCameraParamID, inputs.view.getPerViewBuffer());
+				mInstanceBuffer.bind(*iter, *gpuParams);
+
+				gRendererUtility().setPassParams(renderElem->instancedParams, iter->passIdx);
+				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh, iter->numInstances);
+
+				prevInstanced = true;
+				continue;
+			}
+
+			if (iter->applyPass || prevInstanced)
 				gRendererUtility().setPass(material, iter->passIdx, renderElem->techniqueIdx);
 
+			prevInstanced = false;
+
 			gRendererUtility().setPassParams(renderElem->params, iter->passIdx);
 
 			if(renderElem->morphVertexDeclaration == nullptr)
@@ -366,11 +511,9 @@ namespace bs { namespace ct
 
 	void RCNodeGBuffer::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		resPool.release(albedoTex);
-		resPool.release(normalTex);
-		resPool.release(roughMetalTex);
+		albedoTex = nullptr;
+		normalTex = nullptr;
+		roughMetalTex = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeGBuffer::getDependencies(const RendererView& view)
@@ -378,33 +521,32 @@ namespace bs { namespace ct
 		return { RCNodeSceneDepth::getNodeId() };
 	}
 
-	void RCNodeSceneColor::render(const RenderCompositorNodeInputs& inputs)
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeGBuffer::getTransientTargets(const RendererView& view)
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		const RendererViewProperties& viewProps = inputs.view.getProperties();
+		const RendererViewProperties& viewProps = view.getProperties();
 
 		UINT32 width = viewProps.viewRect.width;
 		UINT32 height = viewProps.viewRect.height;
 		UINT32 numSamples = viewProps.numSamples;
 
-		UINT32 usageFlags = TU_RENDERTARGET;
-
-		bool tiledDeferredSupported = inputs.featureSet != RenderBeastFeatureSet::DesktopMacOS;
-		if(tiledDeferredSupported)
-			usageFlags |= TU_LOADSTORE;
+		// Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
+		// Note: Metal doesn't need 16-bit float
+		return {
+			POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA8, width, height, TU_RENDERTARGET, numSamples, true),
+			POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGB10A2, width, height, TU_RENDERTARGET, numSamples, false),
+			POOLED_RENDER_TEXTURE_DESC::create2D(PF_RG16F, width, height, TU_RENDERTARGET, numSamples, false)
+		};
+	}
 
-		// Note: Consider customizable HDR format via options? e.g. smaller PF_FLOAT_R11G11B10 or larger 32-bit format
-		sceneColorTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, usageFlags, 
-			numSamples, false));
+	void RCNodeSceneColor::render(const RenderCompositorNodeInputs& inputs)
+	{
+		sceneColorTex = inputs.transientTargets[0];
 
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[0]);
 		SPtr<PooledRenderTexture> sceneDepthTex = sceneDepthNode->depthTex;
 
-		if (tiledDeferredSupported && viewProps.numSamples > 1)
-		{
-			sceneColorTexArray = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA32F, width, height, 
-				TU_LOADSTORE, 1, false, viewProps.numSamples));
-		}
+		if (inputs.transientTargets.size() > 1)
+			sceneColorTexArray = inputs.transientTargets[1];
 		else
 			sceneColorTexArray = nullptr;
 
@@ -436,11 +578,8 @@ namespace bs { namespace ct
 
 	void RCNodeSceneColor::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		resPool.release(sceneColorTex);
-
-		if (sceneColorTexArray != nullptr)
-			resPool.release(sceneColorTexArray);
+		sceneColorTex = nullptr;
+		sceneColorTexArray = nullptr;
 	}
 
 	void RCNodeSceneColor::resolveMSAA()
@@ -460,6 +599,34 @@ namespace bs { namespace ct
 		return { RCNodeSceneDepth::getNodeId() };
 	}
 
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeSceneColor::getTransientTargets(const RendererView& view)
+	{
+		const RendererViewProperties& viewProps = view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+		UINT32 numSamples = viewProps.numSamples;
+
+		UINT32 usageFlags = TU_RENDERTARGET;
+
+		bool tiledDeferredSupported = gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::DesktopMacOS;
+		if(tiledDeferredSupported)
+			usageFlags |= TU_LOADSTORE;
+
+		// Note: Consider customizable HDR format via options? e.g. smaller PF_FLOAT_R11G11B10 or larger 32-bit format
+		SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> targets;
+		targets.push_back(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, usageFlags, numSamples, 
+			false));
+
+		if (tiledDeferredSupported && numSamples > 1)
+		{
+			targets.push_back(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA32F, width, height, TU_LOADSTORE, 1, false, 
+				numSamples));
+		}
+
+		return targets;
+	}
+
 	void RCNodeMSAACoverage::render(const RenderCompositorNodeInputs& inputs)
 	{
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
@@ -470,12 +637,7 @@ namespace bs { namespace ct
 			return;
 		}
 
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
-
-		output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width, height, TU_RENDERTARGET));
+		output = inputs.transientTargets[0];
 
 		RCNodeGBuffer* gbufferNode = static_cast<RCNodeGBuffer*>(inputs.inputNodes[0]);
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[1]);
@@ -501,11 +663,7 @@ namespace bs { namespace ct
 
 	void RCNodeMSAACoverage::clear()
 	{
-		if(output)
-		{
-			GpuResourcePool& resPool = GpuResourcePool::instance();
-			resPool.release(output);
-		}
+		output = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeMSAACoverage::getDependencies(const RendererView& view)
@@ -513,6 +671,18 @@ namespace bs { namespace ct
 		return { RCNodeGBuffer::getNodeId(), RCNodeSceneDepth::getNodeId() };
 	}
 
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeMSAACoverage::getTransientTargets(const RendererView& view)
+	{
+		const RendererViewProperties& viewProps = view.getProperties();
+		if(viewProps.numSamples <= 1)
+			return {};
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		return { POOLED_RENDER_TEXTURE_DESC::create2D(PF_R8, width, height, TU_RENDERTARGET) };
+	}
+
 	void RCNodeLightAccumulation::render(const RenderCompositorNodeInputs& inputs)
 	{
 		bool supportsTiledDeferred = gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::DesktopMacOS;
@@ -528,19 +698,17 @@ namespace bs { namespace ct
 			return;
 		}
 
-		GpuResourcePool& resPool = GpuResourcePool::instance();
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
 
 		RCNodeSceneDepth* depthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[0]);
 
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
 		UINT32 numSamples = viewProps.numSamples;
 
+		lightAccumulationTex = inputs.transientTargets[0];
+
 		if (numSamples > 1)
 		{
-			lightAccumulationTexArray = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, 
-				TU_LOADSTORE, 1, false, numSamples));
+			lightAccumulationTexArray = inputs.transientTargets[1];
 
 			for(UINT32 i = 0; i < numSamples ; i++)
 			{
@@ -556,9 +724,6 @@ namespace bs { namespace ct
 		else
 			lightAccumulationTexArray = nullptr;
 
-		lightAccumulationTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width,
-			height, TU_LOADSTORE | TU_RENDERTARGET, numSamples, false));
-
 		bool rebuildRT;
 		if (renderTarget != nullptr)
 		{
@@ -598,17 +763,11 @@ namespace bs { namespace ct
 
 	void RCNodeLightAccumulation::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		if(mOwnsTexture)
-			resPool.release(lightAccumulationTex);
-		else
-		{
-			lightAccumulationTex = nullptr;
-			renderTarget = nullptr;
-		}
+		lightAccumulationTex = nullptr;
+		lightAccumulationTexArray = nullptr;
 
-		if(lightAccumulationTexArray)
-			resPool.release(lightAccumulationTexArray);
+		if(!mOwnsTexture)
+			renderTarget = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeLightAccumulation::getDependencies(const RendererView& view)
@@ -624,6 +783,32 @@ namespace bs { namespace ct
 		return deps;
 	}
 
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeLightAccumulation::getTransientTargets(const RendererView& view)
+	{
+		// Scene color is used directly if tiled deferred is not supported
+		bool supportsTiledDeferred = gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::DesktopMacOS;
+		if(!supportsTiledDeferred)
+			return {};
+
+		const RendererViewProperties& viewProps = view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+		UINT32 numSamples = viewProps.numSamples;
+
+		SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> targets;
+		targets.push_back(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, 
+			TU_LOADSTORE | TU_RENDERTARGET, numSamples, false));
+
+		if (numSamples > 1)
+		{
+			targets.push_back(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height, TU_LOADSTORE, 1, false, 
+				numSamples));
+		}
+
+		return targets;
+	}
+
 	void RCNodeDeferredDirectLighting::render(const RenderCompositorNodeInputs& inputs)
 	{
 		output = static_cast<RCNodeLightAccumulation*>(inputs.inputNodes[0]);
@@ -941,11 +1126,11 @@ namespace bs { namespace ct
 
 			bool isMSAA = viewProps.numSamples > 1;
 
-			SPtr<PooledRenderTexture> iblRadianceTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width,
-				height, TU_RENDERTARGET, numSamples, false));
+			mIBLRadianceTex = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, width, height,
+				TU_RENDERTARGET, numSamples, false));
 
 			RENDER_TEXTURE_DESC rtDesc;
-			rtDesc.colorSurfaces[0].texture = iblRadianceTex->texture;
+			rtDesc.colorSurfaces[0].texture = mIBLRadianceTex->texture;
 			rtDesc.depthStencilSurface.texture = sceneDepthNode->depthTex->texture;
 
 			SPtr<GpuParamBlockBuffer> perViewBuffer = inputs.view.getPerViewBuffer();
@@ -1020,7 +1205,7 @@ namespace bs { namespace ct
 				rapi.setRenderTarget(outputRT, FBT_DEPTH | FBT_STENCIL, RT_COLOR0 | RT_DEPTH_STENCIL);
 
 				DeferredIBLFinalizeMat* mat = DeferredIBLFinalizeMat::getVariation(isMSAA, true);
-				mat->bind(gbuffer, perViewBuffer, iblRadianceTex->texture, RendererTextures::preintegratedEnvGF,
+				mat->bind(gbuffer, perViewBuffer, mIBLRadianceTex->texture, RendererTextures::preintegratedEnvGF,
 					reflProbeParams.buffer);
 
 				gRendererUtility().drawScreenQuad();
@@ -1029,8 +1214,8 @@ namespace bs { namespace ct
 				if (isMSAA)
 				{
 					DeferredIBLFinalizeMat* msaaMat = DeferredIBLFinalizeMat::getVariation(true, false);
-					msaaMat->bind(gbuffer, perViewBuffer, iblRadianceTex->texture, RendererTextures::preintegratedEnvGF,
-						reflProbeParams.buffer);
+					msaaMat->bind(gbuffer, perViewBuffer, mIBLRadianceTex->texture, 
+						RendererTextures::preintegratedEnvGF, reflProbeParams.buffer);
 
 					gRendererUtility().drawScreenQuad();
 				}
@@ -1044,6 +1229,12 @@ namespace bs { namespace ct
 	void RCNodeDeferredIndirectSpecularLighting::clear()
 	{
 		output = nullptr;
+
+		if(mIBLRadianceTex)
+		{
+			GpuResourcePool& resPool = GpuResourcePool::instance();
+			resPool.release(mIBLRadianceTex);
+		}
 	}
 
 	SmallVector<StringID, 4> RCNodeDeferredIndirectSpecularLighting::getDependencies(const RendererView& view)
@@ -1309,10 +1500,7 @@ namespace bs { namespace ct
 					data.simulationData->updateSortIndices(refPoint);
 				};
 
-				SPtr<TaskGroup> sortTask = TaskGroup::create("ParticleSort", worker, (UINT32)systemsToSort.size());
-
-				TaskScheduler::instance().addTaskGroup(sortTask);
-				sortTask->wait();
+				TaskScheduler::instance().parallelFor(0, (UINT32)systemsToSort.size(), 1, worker);
 			}
 			bs_frame_clear();
 
@@ -1926,17 +2114,12 @@ namespace bs { namespace ct
 
 	void RCNodeResolvedSceneDepth::render(const RenderCompositorNodeInputs& inputs)
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
 		RCNodeSceneDepth* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[0]);
 
 		if (viewProps.numSamples > 1)
 		{
-			UINT32 width = viewProps.viewRect.width;
-			UINT32 height = viewProps.viewRect.height;
-
-			output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_D32_S8X24, width, height, 
-				TU_DEPTHSTENCIL, 1, false)); 
+			output = inputs.transientTargets[0];
 
 			RenderAPI& rapi = RenderAPI::instance();
 			rapi.setRenderTarget(output->renderTexture);
@@ -1954,13 +2137,7 @@ namespace bs { namespace ct
 
 	void RCNodeResolvedSceneDepth::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-
-		if (!mPassThrough)
-			resPool.release(output);
-		else
-			output = nullptr;
-
+		output = nullptr;
 		mPassThrough = false;
 	}
 
@@ -1970,25 +2147,30 @@ namespace bs { namespace ct
 		return { RCNodeSceneDepth::getNodeId(), RCNodeGBuffer::getNodeId() };
 	}
 
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeResolvedSceneDepth::getTransientTargets(const RendererView& view)
+	{
+		// Scene depth is used directly if it isn't multisampled
+		const RendererViewProperties& viewProps = view.getProperties();
+		if (viewProps.numSamples <= 1)
+			return {};
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		return { POOLED_RENDER_TEXTURE_DESC::create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL, 1, false) };
+	}
+
 	void RCNodeHiZ::render(const RenderCompositorNodeInputs& inputs)
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
 		const RendererViewProperties& viewProps = inputs.view.getProperties();
 
 		RCNodeResolvedSceneDepth* resolvedSceneDepth = static_cast<RCNodeResolvedSceneDepth*>(inputs.inputNodes[0]);
 
-		UINT32 width = viewProps.viewRect.width;
-		UINT32 height = viewProps.viewRect.height;
+		output = inputs.transientTargets[0];
 
-		UINT32 size = Bitwise::nextPow2(std::max(width, height));
-		UINT32 numMips = PixelUtil::getMaxMipmaps(size, size, 1, PF_R32F);
-		size = 1 << numMips;
-
-		// Note: Use the 32-bit buffer here as 16-bit causes too much banding (most of the scene gets assigned 4-5 different
-		// depth values). 
-		//  - When I add UNORM 16-bit format I should be able to switch to that
-		output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R32F, size, size, TU_RENDERTARGET, 1, false, 1, 
-			numMips));
+		const TextureProperties& hiZProps = output->texture->getProperties();
+		UINT32 size = hiZProps.getWidth();
+		UINT32 numMips = hiZProps.getNumMipmaps();
 
 		Rect2 srcRect = viewProps.nrmViewRect;
 
@@ -2051,8 +2233,7 @@ namespace bs { namespace ct
 
 	void RCNodeHiZ::clear()
 	{
-		GpuResourcePool& resPool = GpuResourcePool::instance();
-		resPool.release(output);
+		output = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeHiZ::getDependencies(const RendererView& view)
@@ -2063,6 +2244,23 @@ namespace bs { namespace ct
 		return { RCNodeResolvedSceneDepth::getNodeId(), RCNodeGBuffer::getNodeId() };
 	}
 
+	SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> RCNodeHiZ::getTransientTargets(const RendererView& view)
+	{
+		const RendererViewProperties& viewProps = view.getProperties();
+
+		UINT32 width = viewProps.viewRect.width;
+		UINT32 height = viewProps.viewRect.height;
+
+		UINT32 size = Bitwise::nextPow2(std::max(width, height));
+		UINT32 numMips = PixelUtil::getMaxMipmaps(size, size, 1, PF_R32F);
+		size = 1 << numMips;
+
+		// Note: Use the 32-bit buffer here as 16-bit causes too much banding (most of the scene gets assigned 4-5 different
+		// depth values). 
+		//  - When I add UNORM 16-bit format I should be able to switch to that
+		return { POOLED_RENDER_TEXTURE_DESC::create2D(PF_R32F, size, size, TU_RENDERTARGET, 1, false, 1, numMips) };
+	}
+
 	void RCNodeSSAO::render(const RenderCompositorNodeInputs& inputs)
 	{
 		/** Maximum valid depth range within samples in a sample set. In meters. */
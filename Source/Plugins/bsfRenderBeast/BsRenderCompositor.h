@@ -3,6 +3,8 @@
 #pragma once
 
 #include "BsRenderBeastPrerequisites.h"
+#include "BsRendererRenderable.h"
+#include "Renderer/BsGpuResourcePool.h"
 
 namespace bs 
 { 
@@ -43,6 +45,59 @@ namespace ct
 		SmallVector<RendererExtension*, 4> extOverlay;
 
 		SmallVector<RenderCompositorNode*, 4> inputNodes;
+
+		/** 
+		 * Pooled textures assigned to the transient targets declared by the node's getTransientTargets() method, in the
+		 * same order.
+		 */
+		SmallVector<SPtr<PooledRenderTexture>, 4> transientTargets;
+	};
+
+	/** Describes a single transient render target declared by a render compositor node. */
+	struct RenderCompositorResourceInfo
+	{
+		/** Identifier of the node that writes to the target. */
+		StringID nodeId;
+
+		/**
+		 * Index of the allocation the target was assigned, in RenderCompositorMemoryMap::allocationSizes. Targets with
+		 * the same allocation share the same GPU memory, at different times.
+		 */
+		UINT32 allocationIdx;
+
+		/** Approximate amount of GPU memory used by the target, in bytes. */
+		UINT64 memorySize;
+
+		/** Index of the node that writes to the target, in order of execution. */
+		UINT32 firstUseIdx;
+
+		/** Index of the last node that reads from the target, in order of execution. */
+		UINT32 lastUseIdx;
+	};
+
+	/** 
+	 * Describes how transient render targets used by the nodes of a render compositor are assigned to pooled GPU 
+	 * textures. The plan is made before any node executes.
+	 */
+	struct RenderCompositorMemoryMap
+	{
+		/** Identifiers of all executed nodes, in order of execution. */
+		Vector<StringID> nodes;
+
+		/** All transient targets, in order of their first use. */
+		Vector<RenderCompositorResourceInfo> resources;
+
+		/** Approximate size of each pooled texture shared by one or multiple targets, in bytes. */
+		Vector<UINT64> allocationSizes;
+
+		/** Sum of the memory of all targets, i.e. the memory that would be needed if none were shared. */
+		UINT64 requestedMemory = 0;
+
+		/** Memory used by the pooled textures the targets were assigned. */
+		UINT64 allocatedMemory = 0;
+
+		/** Maximum amount of memory used by targets whose lifetimes overlap, at any point during execution. */
+		UINT64 peakMemory = 0;
 	};
 
 	/** 
@@ -51,12 +106,21 @@ namespace ct
 	 * 
 	 * @note	Implementations must provide a getNodeId() and getDependencies() static method, which are expected to
 	 *			return a unique name for the implemented node, as well as a set of nodes it depends on.
+	 *			Implementations may also provide a getTransientTargets() static method, if they write to render
+	 *			targets that are only needed until the last dependant node executes.
 	 */
 	class RenderCompositorNode
 	{
 	public:
 		virtual ~RenderCompositorNode() { }
 
+		/** 
+		 * Returns descriptors of the render targets the node writes to, and that must stay alive until the last node
+		 * depending on this node executes. The compositor provides the textures for those targets through
+		 * RenderCompositorNodeInputs::transientTargets. The node must not return those textures to the pool itself.
+		 */
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view) { return {}; }
+
 	protected:
 		friend class RenderCompositor;
 
@@ -90,6 +154,23 @@ namespace ct
 			SmallVector<RenderCompositorNode*, 4> inputs;
 		};
 
+		/** Transient render target declared by a node, along with its lifetime. */
+		struct TransientTarget
+		{
+			POOLED_RENDER_TEXTURE_DESC desc;
+			UINT32 firstUseIdx;
+			UINT32 lastUseIdx;
+			UINT32 allocationIdx;
+		};
+
+		/** Pooled texture shared by one or multiple transient targets whose lifetimes don't overlap. */
+		struct TransientAllocation
+		{
+			POOLED_RENDER_TEXTURE_DESC desc;
+			UINT32 lastUseIdx;
+			SPtr<PooledRenderTexture> texture;
+		};
+
 	public:
 		~RenderCompositor();
 
@@ -107,13 +188,34 @@ namespace ct
 		/** Performs rendering using the current render node hierarchy. This is expected to be called once per frame. */
 		void execute(RenderCompositorNodeInputs& inputs) const;
 
+		/**
+		 * Returns the memory map of the transient targets planned during the last call to execute(). Only recorded if 
+		 * RenderBeastOptions::recordCompositorMemoryMap is enabled.
+		 */
+		const RenderCompositorMemoryMap& getMemoryMap() const { return mMemoryMap; }
+
 	private:
 		/** Clears the render node hierarchy. */
 		void clear();
 
+		/** 
+		 * Determines the lifetimes of the transient targets declared by all nodes, assigns targets whose lifetimes
+		 * don't overlap to shared allocations and retrieves a pooled texture for each allocation. Must be called before
+		 * any of the nodes execute, within a frame allocator block.
+		 */
+		void planTransientTargets(const RendererView& view) const;
+
+		/** Generates the memory map from the transient target plan made by planTransientTargets(). */
+		void buildMemoryMap() const;
+
 		Vector<NodeInfo> mNodeInfos;
 		bool mIsValid = false;
 
+		mutable Vector<TransientTarget> mTransientTargets;
+		mutable Vector<UINT32> mTransientTargetOffsets;
+		mutable Vector<TransientAllocation> mTransientAllocations;
+		mutable RenderCompositorMemoryMap mMemoryMap;
+
 		/************************************************************************/
 		/* 							NODE TYPES	                     			*/
 		/************************************************************************/
@@ -129,6 +231,9 @@ namespace ct
 			/** Returns identifier for all the dependencies of a node of this type. */
 			virtual SmallVector<StringID, 4> getDependencies(const RendererView& view) const = 0;
 
+			/** Returns descriptors of the transient render targets a node of this type writes to. */
+			virtual SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view) const = 0;
+
 			StringID id;
 		};
 		
@@ -149,6 +254,12 @@ namespace ct
 			{
 				return T::getDependencies(view);
 			}
+
+			/** @copydoc NodeType::getTransientTargets() */
+			SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view) const override
+			{
+				return T::getTransientTargets(view);
+			}
 		};
 
 		/** 
@@ -191,6 +302,7 @@ namespace ct
 
 		static StringID getNodeId() { return "SceneDepth"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -215,12 +327,16 @@ namespace ct
 
 		static StringID getNodeId() { return "GBuffer"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+	private:
+		RenderableInstanceBuffer mInstanceBuffer;
 	};
 
 	/** Initializes the scene color texture and/or buffer. Does not perform any rendering. */
@@ -247,6 +363,7 @@ namespace ct
 
 		static StringID getNodeId() { return "SceneColor"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -268,6 +385,7 @@ namespace ct
 
 		static StringID getNodeId() { return "MSAACoverage"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -304,6 +422,7 @@ namespace ct
 
 		static StringID getNodeId() { return "LightAccumulation"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -355,6 +474,8 @@ namespace ct
 
 		/** @copydoc RenderCompositorNode::clear */
 		void clear() override;
+
+		SPtr<PooledRenderTexture> mIBLRadianceTex;
 	};
 
 	/** 
@@ -535,6 +656,7 @@ namespace ct
 
 		static StringID getNodeId() { return "ResolvedSceneDepth"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -553,6 +675,7 @@ namespace ct
 
 		static StringID getNodeId() { return "HiZ"; }
 		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+		static SmallVector<POOLED_RENDER_TEXTURE_DESC, 4> getTransientTargets(const RendererView& view);
 	protected:
 		/** @copydoc RenderCompositorNode::render */
 		void render(const RenderCompositorNodeInputs& inputs) override;
@@ -44,7 +44,7 @@ namespace bs { namespace ct
 	static const ShaderVariation& getParticleShaderVariation()
 	{
 		static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("ORIENT", (UINT32)ORIENT),
 				ShaderVariation::Param("LOCK_Y", LOCK_Y),
 				ShaderVariation::Param("GPU", GPU),
@@ -1,11 +1,23 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsRendererRenderable.h"
+#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsGpuParamBlockAllocator.h"
+#include "Utility/BsBitwise.h"
 
 namespace bs { namespace ct
 {
 	PerObjectParamDef gPerObjectParamDef;
 	PerCallParamDef gPerCallParamDef;
+	PerInstanceBatchParamDef gPerInstanceBatchParamDef;
+
+	const ParamID gPerObjectParamID("PerObject");
+	const ParamID gPerCallParamID("PerCall");
+	const ParamID gPerInstanceBatchParamID("PerInstanceBatch");
 
 	RendererRenderable::RendererRenderable()
 	{
@@ -25,13 +37,126 @@ namespace bs { namespace ct
 		gPerObjectParamDef.gWorldDeterminantSign.set(perObjectParamBuffer, worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f);
 	}
 
-	void RendererRenderable::updatePerCallBuffer(const Matrix4& viewProj, bool flush)
+	void RendererRenderable::updatePerCallBuffer(const Matrix4& viewProj, GpuParamBlockAllocator& allocator)
 	{
 		Matrix4 worldViewProjMatrix = viewProj * renderable->getMatrix();
 
 		gPerCallParamDef.gMatWorldViewProj.set(perCallParamBuffer, worldViewProjMatrix);
+		allocator.allocate(perCallParamBuffer);
+	}
+
+	void OccluderGeometry::update()
+	{
+		vertices.clear();
+		indices.clear();
+		meshDataVersion = mesh->getDataVersion();
+
+		const SPtr<VertexDataDesc>& vertexDesc = meshData->getVertexDesc();
+		if (!vertexDesc->hasElement(VES_POSITION) || vertexDesc->getElementSize(VES_POSITION) < sizeof(Vector3))
+			return;
+
+		const UINT32 numVertices = meshData->getNumVertices();
+		const UINT32 stride = vertexDesc->getVertexStride(0);
+		const UINT8* positions = meshData->getElementData(VES_POSITION);
+
+		vertices.resize(numVertices);
+		for (UINT32 i = 0; i < numVertices; i++)
+			memcpy(&vertices[i], positions + i * stride, sizeof(Vector3));
+
+		const bool use32BitIndices = meshData->getIndexType() == IT_32BIT;
+		const UINT32* indices32 = use32BitIndices ? meshData->getIndices32() : nullptr;
+		const UINT16* indices16 = use32BitIndices ? nullptr : meshData->getIndices16();
+
+		const MeshProperties& meshProps = mesh->getProperties();
+		for (UINT32 i = 0; i < meshProps.getNumSubMeshes(); i++)
+		{
+			const SubMesh& subMesh = meshProps.getSubMesh(i);
+			if (subMesh.drawOp != DOT_TRIANGLE_LIST || subMesh.indexOffset + subMesh.indexCount > meshData->getNumIndices())
+				continue;
+
+			for (UINT32 j = 0; j < subMesh.indexCount; j++)
+			{
+				const UINT32 idx = subMesh.indexOffset + j;
+				indices.push_back(use32BitIndices ? indices32[idx] : indices16[idx]);
+			}
+		}
+
+		if (indices.empty())
+			vertices.clear();
+	}
+
+	void RenderableInstanceBuffer::update(const RenderQueue& queue)
+	{
+		const Vector<const RenderElement*>& elements = queue.getInstancedElements();
+		if (elements.empty())
+			return;
+
+		const UINT32 numInstances = (UINT32)elements.size();
+		mData.resize(numInstances * ENTRIES_PER_INSTANCE);
+
+		for (UINT32 i = 0; i < numInstances; i++)
+		{
+			const RenderableElement* element = static_cast<const RenderableElement*>(elements[i]);
+			const Renderable* renderable = element->renderable->renderable;
+
+			const Matrix4 worldTransform = renderable->getMatrix();
+			const Matrix4 worldNoScaleTransform = renderable->getMatrixNoScale();
+			const float determinantSign = worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f;
+
+			Vector4* dst = &mData[i * ENTRIES_PER_INSTANCE];
+			dst[0] = worldTransform[0];
+			dst[1] = worldTransform[1];
+			dst[2] = worldTransform[2];
+			dst[3] = worldNoScaleTransform[0];
+			dst[4] = worldNoScaleTransform[1];
+			dst[5] = worldNoScaleTransform[2];
+			dst[6] = Vector4(determinantSign, 0.0f, 0.0f, 0.0f);
+		}
+
+		const UINT32 numEntries = (UINT32)mData.size();
+		if (mBuffer == nullptr || mBuffer->getProperties().getElementCount() < numEntries)
+		{
+			GPU_BUFFER_DESC desc;
+			desc.elementCount = Bitwise::nextPow2(numEntries);
+			desc.elementSize = 0;
+			desc.type = GBT_STANDARD;
+			desc.format = BF_32X4F;
+			desc.usage = GBU_DYNAMIC;
+
+			mBuffer = GpuBuffer::create(desc);
+		}
+
+		mBuffer->writeData(0, numEntries * sizeof(Vector4), mData.data(), BWT_DISCARD);
+
+		// Assign a parameter block containing the data offset to each draw call. Multi-pass entries share the same block.
+		mBatchLookup.assign(numInstances, (UINT32)-1);
+
+		UINT32 numBatches = 0;
+		for (auto& entry : queue.getSortedElements())
+		{
+			if (entry.numInstances <= 1 || mBatchLookup[entry.firstInstance] != (UINT32)-1)
+				continue;
+
+			if (numBatches >= (UINT32)mBatchParamBuffers.size())
+				mBatchParamBuffers.push_back(gPerInstanceBatchParamDef.createBuffer());
+
+			const SPtr<GpuParamBlockBuffer>& batchBuffer = mBatchParamBuffers[numBatches];
+			gPerInstanceBatchParamDef.gInstanceOffset.set(batchBuffer, (INT32)entry.firstInstance);
+			batchBuffer->flushToGPU();
+
+			mBatchLookup[entry.firstInstance] = numBatches;
+			numBatches++;
+		}
+	}
+
+	void RenderableInstanceBuffer::bind(const RenderQueueElement& entry, GpuParams& params) const
+	{
+		assert(entry.numInstances > 1 && entry.firstInstance < (UINT32)mBatchLookup.size());
+
+		const UINT32 batchIdx = mBatchLookup[entry.firstInstance];
+		params.setParamBlockBuffer(gPerInstanceBatchParamID, mBatchParamBuffers[batchIdx]);
 
-		if(flush)
-			perCallParamBuffer->flushToGPU();
+		if (params.hasBuffer(GPT_VERTEX_PROGRAM, "gInstanceData"))
+			params.setBuffer(GPT_VERTEX_PROGRAM, "gInstanceData", mBuffer);
 	}
-}}
\ No newline at end of file
+}}
@@ -4,6 +4,7 @@
 
 #include "BsRenderBeastPrerequisites.h"
 #include "Renderer/BsRenderElement.h"
+#include "Renderer/BsRenderQueue.h"
 #include "Renderer/BsRenderable.h"
 #include "Renderer/BsParamBlocks.h"
 #include "Material/BsMaterialParam.h"
@@ -32,7 +33,19 @@ namespace bs { namespace ct
 
 	extern PerCallParamDef gPerCallParamDef;
 
+	BS_PARAM_BLOCK_BEGIN(PerInstanceBatchParamDef)
+		BS_PARAM_BLOCK_ENTRY(INT32, gInstanceOffset)
+	BS_PARAM_BLOCK_END
+
+	extern PerInstanceBatchParamDef gPerInstanceBatchParamDef;
+
+	/** Identifiers used for binding the per-object, per-call and per-instance-batch parameter blocks to GpuParams. */
+	extern const ParamID gPerObjectParamID;
+	extern const ParamID gPerCallParamID;
+	extern const ParamID gPerInstanceBatchParamID;
+
 	struct MaterialSamplerOverrides;
+	struct RendererRenderable;
 
 	/**
 	 * Contains information required for rendering a single Renderable sub-mesh, representing a generic static or animated
@@ -47,6 +60,24 @@ namespace bs { namespace ct
 		 */
 		MaterialSamplerOverrides* samplerOverrides;
 
+		/** Renderable the element is a part of. */
+		const RendererRenderable* renderable = nullptr;
+
+		/** 
+		 * Index of the technique in the material used when rendering the element as a part of an instanced draw call. -1
+		 * if the element cannot be instanced.
+		 */
+		UINT32 instancedTechniqueIdx = (UINT32)-1;
+
+		/**
+		 * GPU parameters used when rendering the element as a part of an instanced draw call. Created the first time
+		 * the element is batched. See RendererScene::prepareInstancedElements().
+		 */
+		SPtr<GpuParamsSet> instancedParams;
+
+		/** Optional overrides for material sampler states, used with @p instancedParams. */
+		MaterialSamplerOverrides* instancedSamplerOverrides = nullptr;
+
 		/** Identifier of the animation running on the renderable's mesh. -1 if no animation. */
 		UINT64 animationId;
 
@@ -108,6 +139,37 @@ namespace bs { namespace ct
 		mutable UINT32 morphShapeVersion;
 	};
 
+	/**
+	 * Geometry used for rasterizing a mesh as an occluder during CPU occlusion culling. Shared by all renderables using
+	 * the same mesh.
+	 */
+	struct OccluderGeometry
+	{
+		/**
+		 * Extracts the triangles from the CPU copy of the mesh data. Clears the geometry if the mesh contains no
+		 * triangle lists.
+		 */
+		void update();
+
+		/** Mesh the geometry is extracted from. */
+		SPtr<Mesh> mesh;
+
+		/** CPU copy of the mesh data. */
+		SPtr<MeshData> meshData;
+
+		/** Local space vertex positions. Empty if the mesh can't be used as an occluder. */
+		Vector<Vector3> vertices;
+
+		/** Triangle list indices into @p vertices. */
+		Vector<UINT32> indices;
+
+		/** Value of Mesh::getDataVersion() at the time the geometry was extracted. */
+		UINT32 meshDataVersion = 0;
+
+		/** Number of renderables using the geometry. */
+		UINT32 refCount = 0;
+	};
+
 	 /** Contains information about a Renderable, used by the Renderer. */
 	struct RendererRenderable
 	{
@@ -120,16 +182,50 @@ namespace bs { namespace ct
 		 * Updates the per-call GPU buffer according to the provided parameters. 
 		 * 
 		 * @param[in]	viewProj	Combined view-projection matrix of the current camera.
-		 * @param[in]	flush		True if the buffer contents should be immediately flushed to the GPU.
+		 * @param[in]	allocator	Allocator to assign the buffer storage from. The buffer gets a new region every call,
+		 *							so draws issued for a previous camera keep their contents.
 		 */
-		void updatePerCallBuffer(const Matrix4& viewProj, bool flush = true);
+		void updatePerCallBuffer(const Matrix4& viewProj, GpuParamBlockAllocator& allocator);
 
 		Renderable* renderable;
 		Vector<RenderableElement> elements;
 
+		/** Geometry used for rasterizing the renderable as an occluder. Null if not an occluder. */
+		OccluderGeometry* occluder = nullptr;
+
 		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
 		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
 	};
 
+	/** 
+	 * Contains per-instance data for renderable elements rendered using instanced draw calls. Data for all instanced draw
+	 * calls in a render queue is stored in a single GPU buffer, in the same order as the queue's instanced elements. Each 
+	 * draw call is provided with the offset to its data through a separate parameter block.
+	 */
+	class RenderableInstanceBuffer
+	{
+	public:
+		/** Number of float4 entries per instance, as expected by the instanced shader variations. */
+		static constexpr UINT32 ENTRIES_PER_INSTANCE = 7;
+
+		/** 
+		 * Writes the data for all instanced draw calls in the provided queue and uploads it to the GPU. Must be called
+		 * after the queue has been sorted, and before any calls to bind() for the queue's elements.
+		 */
+		void update(const RenderQueue& queue);
+
+		/** 
+		 * Binds the instance data for the draw call represented by @p entry to the provided parameters. The entry must
+		 * be a part of the queue last provided to update(), and must have more than one instance.
+		 */
+		void bind(const RenderQueueElement& entry, GpuParams& params) const;
+
+	private:
+		Vector<Vector4> mData;
+		SPtr<GpuBuffer> mBuffer;
+		Vector<SPtr<GpuParamBlockBuffer>> mBatchParamBuffers;
+		Vector<UINT32> mBatchLookup;
+	};
+
 	/** @} */
 }}
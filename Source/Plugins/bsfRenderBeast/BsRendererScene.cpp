@@ -10,6 +10,7 @@
 #include "Mesh/BsMesh.h"
 #include "Material/BsPass.h"
 #include "Material/BsGpuParamsSet.h"
+#include "RenderAPI/BsGpuParamBlockAllocator.h"
 #include "Utility/BsSamplerOverrides.h"
 #include "BsRenderBeastOptions.h"
 #include "BsRenderBeast.h"
@@ -19,15 +20,60 @@
 namespace bs {	namespace ct
 {
 	PerFrameParamDef gPerFrameParamDef;
+	const ParamID gPerFrameParamID("PerFrame");
+
+	simd::AABox SceneOctreeOptions::getBounds(const SceneOctreeElement& elem, void* context)
+	{
+		const SceneInfo* sceneInfo = (const SceneInfo*)context;
+
+		switch(elem.type)
+		{
+		default:
+		case SceneOctreeElementType::Renderable:
+			return simd::AABox(sceneInfo->renderableCullInfos[elem.index].bounds.getBox());
+		case SceneOctreeElementType::RadialLight:
+			return simd::AABox(sceneInfo->radialLightWorldBounds[elem.index]);
+		case SceneOctreeElementType::SpotLight:
+			return simd::AABox(sceneInfo->spotLightWorldBounds[elem.index]);
+		case SceneOctreeElementType::ReflectionProbe:
+			return simd::AABox(sceneInfo->reflProbeWorldBounds[elem.index]);
+		}
+	}
+
+	void SceneOctreeOptions::setElementId(const SceneOctreeElement& elem, const OctreeElementId& id, void* context)
+	{
+		SceneInfo* sceneInfo = (SceneInfo*)context;
+
+		switch(elem.type)
+		{
+		case SceneOctreeElementType::Renderable:
+			sceneInfo->renderableOctreeIds[elem.index] = id;
+			break;
+		case SceneOctreeElementType::RadialLight:
+			sceneInfo->radialLightOctreeIds[elem.index] = id;
+			break;
+		case SceneOctreeElementType::SpotLight:
+			sceneInfo->spotLightOctreeIds[elem.index] = id;
+			break;
+		case SceneOctreeElementType::ReflectionProbe:
+			sceneInfo->reflProbeOctreeIds[elem.index] = id;
+			break;
+		}
+	}
 
 	RendererScene::RendererScene(const SPtr<RenderBeastOptions>& options)
 		:mOptions(options)
 	{
 		mPerFrameParamBuffer = gPerFrameParamDef.createBuffer();
+		mInfo.octree = bs_new<SceneOctree>(Vector3::ZERO, mOctreeExtent, &mInfo);
+		mInfo.paramBlockAllocator = bs_new<GpuParamBlockAllocator>();
 	}
 
 	RendererScene::~RendererScene()
 	{
+		bs_delete(mInfo.paramBlockAllocator);
+		bs_delete(mInfo.octree);
+
 		for (auto& entry : mInfo.renderables)
 			bs_delete(entry);
 
@@ -35,6 +81,7 @@ namespace bs {	namespace ct
 			bs_delete(entry);
 
 		assert(mSamplerOverrides.empty());
+		assert(mOccluders.empty());
 	}
 
 	void RendererScene::registerCamera(Camera* camera)
@@ -139,6 +186,9 @@ namespace bs {	namespace ct
 
 				mInfo.radialLights.push_back(RendererLight(light));
 				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightOctreeIds.push_back(OctreeElementId());
+
+				addToOctree(SceneOctreeElement(SceneOctreeElementType::RadialLight, lightId));
 			}
 			else // Spot
 			{
@@ -147,6 +197,9 @@ namespace bs {	namespace ct
 
 				mInfo.spotLights.push_back(RendererLight(light));
 				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightOctreeIds.push_back(OctreeElementId());
+
+				addToOctree(SceneOctreeElement(SceneOctreeElementType::SpotLight, lightId));
 			}
 		}
 	}
@@ -156,9 +209,17 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
+		{
 			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			updateInOctree(mInfo.radialLightOctreeIds[lightId],
+				SceneOctreeElement(SceneOctreeElementType::RadialLight, lightId));
+		}
 		else if(light->getType() == LightType::Spot)
+		{
 			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			updateInOctree(mInfo.spotLightOctreeIds[lightId],
+				SceneOctreeElement(SceneOctreeElementType::SpotLight, lightId));
+		}
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -186,36 +247,52 @@ namespace bs {	namespace ct
 				Light* lastLight = mInfo.radialLights.back().internal;
 				UINT32 lastLightId = lastLight->getRendererId();
 
+				mInfo.octree->removeElement(mInfo.radialLightOctreeIds[lightId]);
+
 				if (lightId != lastLightId)
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.radialLights[lightId], mInfo.radialLights[lastLightId]);
 					std::swap(mInfo.radialLightWorldBounds[lightId], mInfo.radialLightWorldBounds[lastLightId]);
+					std::swap(mInfo.radialLightOctreeIds[lightId], mInfo.radialLightOctreeIds[lastLightId]);
 
 					lastLight->setRendererId(lightId);
+
+					// Let the octree know the swapped light's index changed
+					mInfo.octree->updateElement(mInfo.radialLightOctreeIds[lightId],
+						SceneOctreeElement(SceneOctreeElementType::RadialLight, lightId));
 				}
 
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
 				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightOctreeIds.erase(mInfo.radialLightOctreeIds.end() - 1);
 			}
 			else // Spot
 			{
 				Light* lastLight = mInfo.spotLights.back().internal;
 				UINT32 lastLightId = lastLight->getRendererId();
 
+				mInfo.octree->removeElement(mInfo.spotLightOctreeIds[lightId]);
+
 				if (lightId != lastLightId)
 				{
 					// Swap current last element with the one we want to erase
 					std::swap(mInfo.spotLights[lightId], mInfo.spotLights[lastLightId]);
 					std::swap(mInfo.spotLightWorldBounds[lightId], mInfo.spotLightWorldBounds[lastLightId]);
+					std::swap(mInfo.spotLightOctreeIds[lightId], mInfo.spotLightOctreeIds[lastLightId]);
 
 					lastLight->setRendererId(lightId);
+
+					// Let the octree know the swapped light's index changed
+					mInfo.octree->updateElement(mInfo.spotLightOctreeIds[lightId],
+						SceneOctreeElement(SceneOctreeElementType::SpotLight, lightId));
 				}
 
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
 				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightOctreeIds.erase(mInfo.spotLightOctreeIds.end() - 1);
 			}
 		}
 	}
@@ -228,10 +305,15 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererRenderable>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullBounds.add(renderable->getBounds(), renderable->getLayer());
+		mInfo.renderableOctreeIds.push_back(OctreeElementId());
+
+		addToOctree(SceneOctreeElement(SceneOctreeElementType::Renderable, renderableId));
 
 		RendererRenderable* rendererRenderable = mInfo.renderables.back();
 		rendererRenderable->renderable = renderable;
 		rendererRenderable->updatePerObjectBuffer();
+		rendererRenderable->occluder = acquireOccluderGeometry(*renderable);
 
 		SPtr<Mesh> mesh = renderable->getMesh();
 		if (mesh != nullptr)
@@ -245,6 +327,7 @@ namespace bs {	namespace ct
 				RenderableElement& renElement = rendererRenderable->elements.back();
 
 				renElement.type = (UINT32)RenderElementType::Renderable;
+				renElement.renderable = rendererRenderable;
 				renElement.mesh = mesh;
 				renElement.subMesh = meshProps.getSubMesh(i);
 				renElement.animType = renderable->getAnimType();
@@ -295,10 +378,10 @@ namespace bs {	namespace ct
 				}
 				else
 				{
-					VAR_LOOKUP[0] = &getVertexInputVariation<false, false>();
-					VAR_LOOKUP[1] = &getVertexInputVariation<true, false>();
-					VAR_LOOKUP[2] = &getVertexInputVariation<false, true>();
-					VAR_LOOKUP[3] = &getVertexInputVariation<true, true>();
+					VAR_LOOKUP[0] = &getDeferredRenderingVariation<false, false, false>();
+					VAR_LOOKUP[1] = &getDeferredRenderingVariation<true, false, false>();
+					VAR_LOOKUP[2] = &getDeferredRenderingVariation<false, true, false>();
+					VAR_LOOKUP[3] = &getDeferredRenderingVariation<true, true, false>();
 				}
 
 				const ShaderVariation* variation = VAR_LOOKUP[(int)animType];
@@ -308,6 +391,21 @@ namespace bs {	namespace ct
 
 				UINT32 techniqueIdx = renElement.material->findTechnique(findDesc);
 
+				// Shaders without instancing support don't have the INSTANCED variation parameter
+				if (techniqueIdx == (UINT32)-1 && !useForwardRendering)
+				{
+					static const ShaderVariation* VERTEX_INPUT_VAR_LOOKUP[4] =
+					{
+						&getVertexInputVariation<false, false>(),
+						&getVertexInputVariation<true, false>(),
+						&getVertexInputVariation<false, true>(),
+						&getVertexInputVariation<true, true>()
+					};
+
+					findDesc.variation = VERTEX_INPUT_VAR_LOOKUP[(int)animType];
+					techniqueIdx = renElement.material->findTechnique(findDesc);
+				}
+
 				if (techniqueIdx == (UINT32)-1)
 					techniqueIdx = renElement.material->getDefaultTechnique();
 
@@ -362,23 +460,21 @@ namespace bs {	namespace ct
 				renElement.material->updateParamsSet(renElement.params, 0.0f, true);
 
 				// Generate or assign sampler state overrides
-				SamplerOverrideKey samplerKey(renElement.material, techniqueIdx);
-				auto iterFind = mSamplerOverrides.find(samplerKey);
-				if (iterFind != mSamplerOverrides.end())
-				{
-					renElement.samplerOverrides = iterFind->second;
-					iterFind->second->refCount++;
-				}
-				else
-				{
-					SPtr<Shader> shader = renElement.material->getShader();
-					MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(shader,
-						renElement.material->_getInternalParams(), renElement.params, mOptions);
+				renElement.samplerOverrides = acquireSamplerOverrides(renElement.material, techniqueIdx, renElement.params);
 
-					mSamplerOverrides[samplerKey] = samplerOverrides;
+				// Static elements using the deferred pipeline can be batched into instanced draw calls, if the shader
+				// supports it. Per-object data is then read from a per-instance buffer instead of the per-object buffer.
+				if (!useForwardRendering && animType == RenderableAnimType::None)
+				{
+					findDesc.variation = &getDeferredRenderingVariation<false, false, true>();
 
-					renElement.samplerOverrides = samplerOverrides;
-					samplerOverrides->refCount++;
+					// Parameters for the instanced technique are created later, once the element actually gets batched
+					const UINT32 instancedTechniqueIdx = renElement.material->findTechnique(findDesc);
+					if (instancedTechniqueIdx != (UINT32)-1 && instancedTechniqueIdx != techniqueIdx)
+					{
+						renElement.instanceable = true;
+						renElement.instancedTechniqueIdx = instancedTechniqueIdx;
+					}
 				}
 			}
 		}
@@ -397,9 +493,9 @@ namespace bs {	namespace ct
 
 			// Note: Perhaps perform buffer validation to ensure expected buffer has the same size and layout as the 
 			// provided buffer, and show a warning otherwise. But this is perhaps better handled on a higher level.
-			gpuParams->setParamBlockBuffer("PerFrame", mPerFrameParamBuffer);
-			gpuParams->setParamBlockBuffer("PerObject", rendererRenderable->perObjectParamBuffer);
-			gpuParams->setParamBlockBuffer("PerCall", rendererRenderable->perCallParamBuffer);
+			gpuParams->setParamBlockBuffer(gPerFrameParamID, mPerFrameParamBuffer);
+			gpuParams->setParamBlockBuffer(gPerObjectParamID, rendererRenderable->perObjectParamBuffer);
+			gpuParams->setParamBlockBuffer(gPerCallParamID, rendererRenderable->perCallParamBuffer);
 
 			gpuParams->getParamInfo()->getBindings(
 				GpuPipelineParamInfoBase::ParamType::ParamBlock,
@@ -467,6 +563,10 @@ namespace bs {	namespace ct
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullBounds.update(renderableId, renderable->getBounds());
+
+		updateInOctree(mInfo.renderableOctreeIds[renderableId],
+			SceneOctreeElement(SceneOctreeElementType::Renderable, renderableId));
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -479,34 +579,42 @@ namespace bs {	namespace ct
 		Vector<RenderableElement>& elements = rendererRenderable->elements;
 		for (auto& element : elements)
 		{
-			SamplerOverrideKey samplerKey(element.material, element.techniqueIdx);
-
-			auto iterFind = mSamplerOverrides.find(samplerKey);
-			assert(iterFind != mSamplerOverrides.end());
+			releaseSamplerOverrides(element.material, element.techniqueIdx);
+			element.samplerOverrides = nullptr;
 
-			MaterialSamplerOverrides* samplerOverrides = iterFind->second;
-			samplerOverrides->refCount--;
-			if (samplerOverrides->refCount == 0)
+			if (element.instancedSamplerOverrides != nullptr)
 			{
-				SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
-				mSamplerOverrides.erase(iterFind);
+				releaseSamplerOverrides(element.material, element.instancedTechniqueIdx);
+				element.instancedSamplerOverrides = nullptr;
 			}
-
-			element.samplerOverrides = nullptr;
 		}
 
+		if (rendererRenderable->occluder != nullptr)
+			releaseOccluderGeometry(rendererRenderable->occluder);
+
+		mInfo.octree->removeElement(mInfo.renderableOctreeIds[renderableId]);
+
 		if (renderableId != lastRenderableId)
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
 			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			std::swap(mInfo.renderableOctreeIds[renderableId], mInfo.renderableOctreeIds[lastRenderableId]);
 
 			lastRenerable->setRendererId(renderableId);
+
+			// Let the octree know the swapped renderable's index changed
+			mInfo.octree->updateElement(mInfo.renderableOctreeIds[renderableId],
+				SceneOctreeElement(SceneOctreeElementType::Renderable, renderableId));
 		}
 
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableOctreeIds.erase(mInfo.renderableOctreeIds.end() - 1);
+
+		// Moves the last element in place of the removed one, same as above
+		mInfo.renderableCullBounds.remove(renderableId);
 
 		bs_delete(rendererRenderable);
 	}
@@ -520,6 +628,9 @@ namespace bs {	namespace ct
 		RendererReflectionProbe& probeInfo = mInfo.reflProbes.back();
 
 		mInfo.reflProbeWorldBounds.push_back(probe->getBounds());
+		mInfo.reflProbeOctreeIds.push_back(OctreeElementId());
+
+		addToOctree(SceneOctreeElement(SceneOctreeElementType::ReflectionProbe, probeId));
 
 		// Find a spot in cubemap array
 		UINT32 numArrayEntries = (UINT32)mInfo.reflProbeCubemapArrayUsedSlots.size();
@@ -553,6 +664,9 @@ namespace bs {	namespace ct
 		UINT32 probeId = probe->getRendererId();
 		mInfo.reflProbeWorldBounds[probeId] = probe->getBounds();
 
+		updateInOctree(mInfo.reflProbeOctreeIds[probeId],
+			SceneOctreeElement(SceneOctreeElementType::ReflectionProbe, probeId));
+
 		if (texture)
 		{
 			RendererReflectionProbe& probeInfo = mInfo.reflProbes[probeId];
@@ -571,18 +685,72 @@ namespace bs {	namespace ct
 		ReflectionProbe* lastProbe = mInfo.reflProbes.back().probe;
 		UINT32 lastProbeId = lastProbe->getRendererId();
 
+		mInfo.octree->removeElement(mInfo.reflProbeOctreeIds[probeId]);
+
 		if (probeId != lastProbeId)
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.reflProbes[probeId], mInfo.reflProbes[lastProbeId]);
 			std::swap(mInfo.reflProbeWorldBounds[probeId], mInfo.reflProbeWorldBounds[lastProbeId]);
+			std::swap(mInfo.reflProbeOctreeIds[probeId], mInfo.reflProbeOctreeIds[lastProbeId]);
 
 			lastProbe->setRendererId(probeId);
+
+			// Let the octree know the swapped probe's index changed
+			mInfo.octree->updateElement(mInfo.reflProbeOctreeIds[probeId],
+				SceneOctreeElement(SceneOctreeElementType::ReflectionProbe, probeId));
 		}
 
 		// Last element is the one we want to erase
 		mInfo.reflProbes.erase(mInfo.reflProbes.end() - 1);
 		mInfo.reflProbeWorldBounds.erase(mInfo.reflProbeWorldBounds.end() - 1);
+		mInfo.reflProbeOctreeIds.erase(mInfo.reflProbeOctreeIds.end() - 1);
+	}
+
+	void RendererScene::addToOctree(const SceneOctreeElement& element)
+	{
+		if(!growOctree(element))
+			mInfo.octree->addElement(element);
+	}
+
+	void RendererScene::updateInOctree(const OctreeElementId& id, const SceneOctreeElement& element)
+	{
+		if(!growOctree(element))
+			mInfo.octree->updateElement(id, element);
+	}
+
+	bool RendererScene::growOctree(const SceneOctreeElement& element)
+	{
+		// Octree root is centered at origin, so find the largest distance from the origin along any axis
+		const simd::AABox bounds = SceneOctreeOptions::getBounds(element, &mInfo);
+
+		float requiredExtent = 0.0f;
+		for(UINT32 i = 0; i < 3; i++)
+			requiredExtent = std::max(requiredExtent, Math::abs(bounds.center[i]) + Math::abs(bounds.extents[i]));
+
+		if(requiredExtent <= mOctreeExtent || mOctreeExtent >= SceneOctreeMaxExtent || !std::isfinite(requiredExtent))
+			return false;
+
+		while(mOctreeExtent < requiredExtent && mOctreeExtent < SceneOctreeMaxExtent)
+			mOctreeExtent *= 2.0f;
+
+		// Re-insert everything. This is expensive, but the extent doubles each time so it happens only a few times.
+		bs_delete(mInfo.octree);
+		mInfo.octree = bs_new<SceneOctree>(Vector3::ZERO, mOctreeExtent, &mInfo);
+
+		for(UINT32 i = 0; i < (UINT32)mInfo.renderables.size(); i++)
+			mInfo.octree->addElement(SceneOctreeElement(SceneOctreeElementType::Renderable, i));
+
+		for(UINT32 i = 0; i < (UINT32)mInfo.radialLights.size(); i++)
+			mInfo.octree->addElement(SceneOctreeElement(SceneOctreeElementType::RadialLight, i));
+
+		for(UINT32 i = 0; i < (UINT32)mInfo.spotLights.size(); i++)
+			mInfo.octree->addElement(SceneOctreeElement(SceneOctreeElementType::SpotLight, i));
+
+		for(UINT32 i = 0; i < (UINT32)mInfo.reflProbes.size(); i++)
+			mInfo.octree->addElement(SceneOctreeElement(SceneOctreeElementType::ReflectionProbe, i));
+
+		return true;
 	}
 
 	void RendererScene::setReflectionProbeArrayIndex(UINT32 probeIdx, UINT32 arrayIdx, bool markAsClean)
@@ -807,7 +975,11 @@ namespace bs {	namespace ct
 		mOptions = options;
 
 		for (auto& entry : mInfo.views)
+		{
 			entry->setStateReductionMode(mOptions->stateReductionMode);
+			entry->setOcclusionCulling(mOptions->occlusionCulling);
+			entry->setInstancing(mOptions->instancing);
+		}
 	}
 
 	RENDERER_VIEW_DESC RendererScene::createViewDesc(Camera* camera) const
@@ -864,6 +1036,8 @@ namespace bs {	namespace ct
 		viewDesc.viewTransform = camera->getViewMatrix();
 		viewDesc.projType = camera->getProjectionType();
 
+		viewDesc.occlusionCulling = mOptions->occlusionCulling;
+		viewDesc.instancing = mOptions->instancing;
 		viewDesc.stateReduction = mOptions->stateReductionMode;
 		viewDesc.sceneCamera = camera;
 
@@ -994,45 +1168,142 @@ namespace bs {	namespace ct
 			{
 				MaterialSamplerOverrides* overrides = element.samplerOverrides;
 				if(overrides != nullptr && overrides->isDirty)
-				{
-					UINT32 numPasses = element.material->getNumPasses();
-					for(UINT32 j = 0; j < numPasses; j++)
-					{
-						SPtr<GpuParams> params = element.params->getGpuParams(j);
+					applySamplerOverrides(*element.params, *overrides);
 
-						const UINT32 numStages = 6;
-						for (UINT32 k = 0; k < numStages; k++)
-						{
-							GpuProgramType type = (GpuProgramType)k;
+				MaterialSamplerOverrides* instancedOverrides = element.instancedSamplerOverrides;
+				if(instancedOverrides != nullptr && instancedOverrides->isDirty)
+					applySamplerOverrides(*element.instancedParams, *instancedOverrides);
+			}
+		}
 
-							SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
-							if (paramDesc == nullptr)
-								continue;
+		for (auto& entry : mSamplerOverrides)
+			entry.second->isDirty = false;
+	}
 
-							for (auto& samplerDesc : paramDesc->samplers)
-							{
-								UINT32 set = samplerDesc.second.set;
-								UINT32 slot = samplerDesc.second.slot;
+	MaterialSamplerOverrides* RendererScene::acquireSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+		const SPtr<GpuParamsSet>& params)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		if (iterFind != mSamplerOverrides.end())
+		{
+			iterFind->second->refCount++;
+			return iterFind->second;
+		}
 
-								UINT32 overrideIndex = overrides->passes[j].stateOverrides[set][slot];
-								if (overrideIndex == (UINT32)-1)
-									continue;
+		SPtr<Shader> shader = material->getShader();
+		MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(shader,
+			material->_getInternalParams(), params, mOptions);
 
-								params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
-							}
-						}
-					}
+		mSamplerOverrides[samplerKey] = samplerOverrides;
+
+		samplerOverrides->refCount++;
+		return samplerOverrides;
+	}
+
+	void RendererScene::releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		assert(iterFind != mSamplerOverrides.end());
+
+		MaterialSamplerOverrides* samplerOverrides = iterFind->second;
+		samplerOverrides->refCount--;
+		if (samplerOverrides->refCount == 0)
+		{
+			SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
+			mSamplerOverrides.erase(iterFind);
+		}
+	}
+
+	OccluderGeometry* RendererScene::acquireOccluderGeometry(const Renderable& renderable)
+	{
+		// Animated geometry doesn't match the CPU copy of the mesh
+		const SPtr<MeshData>& meshData = renderable.getOccluderData();
+		const SPtr<Mesh>& mesh = renderable.getMesh();
+		if (meshData == nullptr || mesh == nullptr || renderable.getAnimType() != RenderableAnimType::None)
+			return nullptr;
+
+		auto iterFind = mOccluders.find(mesh.get());
+		if (iterFind != mOccluders.end())
+		{
+			iterFind->second->refCount++;
+			return iterFind->second;
+		}
+
+		OccluderGeometry* occluder = bs_new<OccluderGeometry>();
+		occluder->mesh = mesh;
+		occluder->meshData = meshData;
+		occluder->update();
+
+		mOccluders[mesh.get()] = occluder;
+
+		occluder->refCount++;
+		return occluder;
+	}
+
+	void RendererScene::releaseOccluderGeometry(OccluderGeometry* occluder)
+	{
+		auto iterFind = mOccluders.find(occluder->mesh.get());
+		assert(iterFind != mOccluders.end() && iterFind->second == occluder);
+
+		occluder->refCount--;
+		if (occluder->refCount == 0)
+		{
+			bs_delete(occluder);
+			mOccluders.erase(iterFind);
+		}
+	}
+
+	void RendererScene::refreshOccluderGeometry()
+	{
+		// CPU copy of the mesh data is written before the GPU copy, so by now it holds the new contents
+		for (auto& entry : mOccluders)
+		{
+			OccluderGeometry* occluder = entry.second;
+			if (occluder->meshDataVersion != occluder->mesh->getDataVersion())
+				occluder->update();
+		}
+	}
+
+	void RendererScene::applySamplerOverrides(GpuParamsSet& params, const MaterialSamplerOverrides& overrides)
+	{
+		UINT32 numPasses = params.getNumPasses();
+		for(UINT32 i = 0; i < numPasses; i++)
+		{
+			SPtr<GpuParams> gpuParams = params.getGpuParams(i);
+
+			const UINT32 numStages = 6;
+			for (UINT32 j = 0; j < numStages; j++)
+			{
+				GpuProgramType type = (GpuProgramType)j;
+
+				SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc(type);
+				if (paramDesc == nullptr)
+					continue;
+
+				for (auto& samplerDesc : paramDesc->samplers)
+				{
+					UINT32 set = samplerDesc.second.set;
+					UINT32 slot = samplerDesc.second.slot;
+
+					UINT32 overrideIndex = overrides.passes[i].stateOverrides[set][slot];
+					if (overrideIndex == (UINT32)-1)
+						continue;
+
+					gpuParams->setSamplerState(set, slot, overrides.overrides[overrideIndex].state);
 				}
 			}
 		}
-
-		for (auto& entry : mSamplerOverrides)
-			entry.second->isDirty = false;
 	}
 
 	void RendererScene::setParamFrameParams(float time)
 	{
 		gPerFrameParamDef.gTime.set(mPerFrameParamBuffer, time);
+
+		// Storage gets rewritten using discard, so any data still in use by the GPU from the last frame stays intact
+		mInfo.paramBlockAllocator->reset();
 	}
 
 	void RendererScene::prepareRenderable(UINT32 idx, const FrameInfo& frameInfo)
@@ -1047,12 +1318,48 @@ namespace bs {	namespace ct
 		// Note: Could this step be moved in notifyRenderableUpdated, so it only triggers when material actually gets
 		// changed? Although it shouldn't matter much because if the internal versions keeping track of dirty params.
 		for (auto& element : mInfo.renderables[idx]->elements)
+		{
 			element.material->updateParamsSet(element.params, element.materialAnimationTime);
+
+			if (element.instancedParams != nullptr)
+				element.material->updateParamsSet(element.instancedParams, element.materialAnimationTime);
+		}
 		
-		mInfo.renderables[idx]->perObjectParamBuffer->flushToGPU();
+		mInfo.paramBlockAllocator->allocate(mInfo.renderables[idx]->perObjectParamBuffer);
 		mInfo.renderableReady[idx] = true;
 	}
 
+	void RendererScene::prepareInstancedElements(const RenderQueue& queue)
+	{
+		for (auto& entry : queue.getSortedElements())
+		{
+			if (entry.numInstances <= 1)
+				continue;
+
+			// Only the first element of a batch is used for binding the instanced technique. The queue only references
+			// the element, so find the scene's own copy in order to modify it.
+			const auto& queuedElement = static_cast<const RenderableElement&>(*entry.renderElem);
+			const UINT32 renderableId = queuedElement.renderable->renderable->getRendererId();
+			RendererRenderable* rendererRenderable = mInfo.renderables[renderableId];
+
+			const UINT32 elementIdx = (UINT32)(&queuedElement - rendererRenderable->elements.data());
+			RenderableElement& element = rendererRenderable->elements[elementIdx];
+
+			if (element.instancedParams != nullptr)
+				continue;
+
+			element.instancedParams = element.material->createParamsSet(element.instancedTechniqueIdx);
+			element.material->updateParamsSet(element.instancedParams, element.materialAnimationTime, true);
+
+			// Per-camera and per-instance buffers are bound when rendering
+			element.instancedParams->getGpuParams()->setParamBlockBuffer(gPerFrameParamID, mPerFrameParamBuffer);
+
+			element.instancedSamplerOverrides = acquireSamplerOverrides(element.material, element.instancedTechniqueIdx,
+				element.instancedParams);
+			applySamplerOverrides(*element.instancedParams, *element.instancedSamplerOverrides);
+		}
+	}
+
 	void RendererScene::updateParticleSystemBounds(const ParticleSimulationData* particleRenderData)
 	{
 		// Note: Avoid updating bounds for deterministic particle systems every frame. Also see if this can be copied
@@ -8,6 +8,7 @@
 #include "BsRendererParticles.h"
 #include "Shading/BsLightProbes.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsOctree.h"
 
 namespace bs 
 { 
@@ -25,6 +26,47 @@ namespace bs
 	// Limited by max number of array elements in texture for DX11 hardware
 	constexpr UINT32 MaxReflectionCubemaps = 2048 / 6;
 
+	// Initial extent of the root node of the scene octree. The octree is rebuilt with a larger extent when an object
+	// outside of it is added, up to the maximum extent. Objects outside the maximum are still handled, but aren't
+	// partitioned.
+	constexpr float SceneOctreeInitialExtent = 4096.0f;
+	constexpr float SceneOctreeMaxExtent = 4096.0f * 1024.0f;
+
+	/** Types of objects stored in the scene octree. */
+	enum class SceneOctreeElementType
+	{
+		Renderable,
+		RadialLight,
+		SpotLight,
+		ReflectionProbe
+	};
+
+	/** Object stored in the scene octree. */
+	struct SceneOctreeElement
+	{
+		SceneOctreeElement() = default;
+		SceneOctreeElement(SceneOctreeElementType type, UINT32 index)
+			:type(type), index(index)
+		{ }
+
+		SceneOctreeElementType type = SceneOctreeElementType::Renderable;
+		UINT32 index = 0; /**< Index of the object in the SceneInfo array for its type. */
+	};
+
+	/** Options for the octree used for spatial queries of scene objects. Octree context must be a SceneInfo object. */
+	struct SceneOctreeOptions
+	{
+		enum { LoosePadding = 8 };
+		enum { MinElementsPerNode = 8 };
+		enum { MaxElementsPerNode = 16 };
+		enum { MaxDepth = 12 };
+
+		static simd::AABox getBounds(const SceneOctreeElement& elem, void* context);
+		static void setElementId(const SceneOctreeElement& elem, const OctreeElementId& id, void* context);
+	};
+
+	typedef Octree<SceneOctreeElement, SceneOctreeOptions> SceneOctree;
+
 	/** Contains most scene objects relevant to the renderer. */
 	struct SceneInfo
 	{
@@ -36,6 +78,8 @@ namespace bs
 		// Renderables
 		Vector<RendererRenderable*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		CullingBounds renderableCullBounds; // Same bounds as in renderableCullInfos, in a layout suitable for SIMD culling
+		Vector<OctreeElementId> renderableOctreeIds;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -43,10 +87,13 @@ namespace bs
 		Vector<RendererLight> spotLights;
 		Vector<Sphere> radialLightWorldBounds;
 		Vector<Sphere> spotLightWorldBounds;
+		Vector<OctreeElementId> radialLightOctreeIds;
+		Vector<OctreeElementId> spotLightOctreeIds;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
 		Vector<Sphere> reflProbeWorldBounds;
+		Vector<OctreeElementId> reflProbeOctreeIds;
 		Vector<bool> reflProbeCubemapArrayUsedSlots;
 		SPtr<Texture> reflProbeCubemapsTex;
 
@@ -60,6 +107,12 @@ namespace bs
 		// Sky
 		Skybox* skybox = nullptr;
 
+		// Spatial structure containing renderables, radial & spot lights and reflection probes
+		SceneOctree* octree = nullptr;
+
+		// Storage that per-object and per-call param blocks of renderables are sub-allocated from, reset every frame
+		GpuParamBlockAllocator* paramBlockAllocator = nullptr;
+
 		// Buffers for various transient data that gets rebuilt every frame
 		//// Rebuilt every frame
 		mutable Vector<bool> renderableReady;
@@ -155,7 +208,13 @@ namespace bs
 		 */
 		void refreshSamplerOverrides(bool force = false);
 
-		/** Updates global per frame parameter buffers with new values. To be called at the start of every frame. */
+		/** Re-extracts the geometry of any occluder whose mesh data was written to since the geometry was extracted. */
+		void refreshOccluderGeometry();
+
+		/** 
+		 * Updates global per frame parameter buffers with new values, and releases param block storage used during the
+		 * previous frame. To be called at the start of every frame. 
+		 */
 		void setParamFrameParams(float time);
 
 		/**
@@ -168,6 +227,13 @@ namespace bs
 		 */
 		void prepareRenderable(UINT32 idx, const FrameInfo& frameInfo);
 
+		/**
+		 * Creates the GPU parameters used for instanced rendering for any element in the queue that was batched into an
+		 * instanced draw call, but doesn't have them yet. Must be called after the queue is sorted, and after
+		 * prepareRenderable() was called for all renderables in the queue.
+		 */
+		void prepareInstancedElements(const RenderQueue& queue);
+
 		/** Updates the bounds for all the particle systems from the provided object. */
 		void updateParticleSystemBounds(const ParticleSimulationData* particleRenderData);
 
@@ -183,11 +249,51 @@ namespace bs
 		 */
 		void updateCameraRenderTargets(Camera* camera, bool remove = false);
 
+		/** 
+		 * Finds or creates sampler state overrides for the specified material technique, and increments their reference
+		 * count.
+		 */
+		MaterialSamplerOverrides* acquireSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+			const SPtr<GpuParamsSet>& params);
+
+		/** 
+		 * Decrements the reference count of sampler state overrides for the specified material technique, destroying them
+		 * if no longer referenced.
+		 */
+		void releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx);
+
+		/**
+		 * Finds or extracts the occluder geometry for the renderable's mesh, and increments its reference count.
+		 * Returns null if the renderable can't be used as an occluder.
+		 */
+		OccluderGeometry* acquireOccluderGeometry(const Renderable& renderable);
+
+		/** Decrements the reference count of occluder geometry, destroying it if no longer referenced. */
+		void releaseOccluderGeometry(OccluderGeometry* occluder);
+
+		/** Assigns the sampler states from @p overrides to all passes in @p params. */
+		static void applySamplerOverrides(GpuParamsSet& params, const MaterialSamplerOverrides& overrides);
+
+		/** Adds a new element to the scene octree, growing the octree if the element lies outside of it. */
+		void addToOctree(const SceneOctreeElement& element);
+
+		/** Updates an element in the scene octree, growing the octree if the element moved outside of it. */
+		void updateInOctree(const OctreeElementId& id, const SceneOctreeElement& element);
+
+		/**
+		 * Checks if the bounds of the provided element fit within the scene octree, and rebuilds the octree with a
+		 * larger extent if they don't. Returns true if the octree was rebuilt, in which case it already contains the
+		 * element.
+		 */
+		bool growOctree(const SceneOctreeElement& element);
+
 		SceneInfo mInfo;
 		SPtr<GpuParamBlockBuffer> mPerFrameParamBuffer;
 		UnorderedMap<SamplerOverrideKey, MaterialSamplerOverrides*> mSamplerOverrides;
+		UnorderedMap<const Mesh*, OccluderGeometry*> mOccluders;
 
 		SPtr<RenderBeastOptions> mOptions;
+		float mOctreeExtent = SceneOctreeInitialExtent;
 	};
 
 	BS_PARAM_BLOCK_BEGIN(PerFrameParamDef)
@@ -196,6 +302,9 @@ namespace bs
 
 	extern PerFrameParamDef gPerFrameParamDef;
 
+	/** Identifier used for binding the per-frame parameter block to GpuParams. */
+	extern const ParamID gPerFrameParamID;
+
 	/** Basic shader that is used when no other is available. */
 	class DefaultMaterial : public RendererMaterial<DefaultMaterial> { RMAT_DEF("Default.bsl"); };
 
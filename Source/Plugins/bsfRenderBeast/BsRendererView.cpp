@@ -10,12 +10,17 @@
 #include "BsRendererLight.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
 	PerCameraParamDef gPerCameraParamDef;
+	const ParamID gPerCameraParamID("PerCamera");
 	SkyboxParamDef gSkyboxParamDef;
 
+	/** Width of the depth buffer used for occlusion culling. Height is derived from the view's aspect ratio. */
+	static constexpr UINT32 OCCLUSION_BUFFER_WIDTH = 256;
+
 	SkyboxMat::SkyboxMat()
 	{
 		if(mParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gSkyTex"))
@@ -48,7 +53,7 @@ namespace bs { namespace ct
 	}
 
 	RendererViewData::RendererViewData()
-		:encodeDepth(false), depthEncodeNear(0.0f), depthEncodeFar(0.0f)
+		:occlusionCulling(false), instancing(false), encodeDepth(false), depthEncodeNear(0.0f), depthEncodeFar(0.0f)
 	{
 		
 	}
@@ -88,6 +93,7 @@ namespace bs { namespace ct
 	{
 		mDeferredOpaqueQueue = bs_shared_ptr_new<RenderQueue>(reductionMode);
 		mForwardOpaqueQueue = bs_shared_ptr_new<RenderQueue>(reductionMode);
+		mDeferredOpaqueQueue->setInstancing(mProperties.instancing);
 
 		StateReduction transparentStateReduction = reductionMode;
 		if (transparentStateReduction == StateReduction::Material)
@@ -96,6 +102,14 @@ namespace bs { namespace ct
 		mTransparentQueue = bs_shared_ptr_new<RenderQueue>(transparentStateReduction);
 	}
 
+	void RendererView::setInstancing(bool enable)
+	{
+		mProperties.instancing = enable;
+
+		// Only the deferred queue is rendered using shaders with instancing support
+		mDeferredOpaqueQueue->setInstancing(enable);
+	}
+
 	void RendererView::setRenderSettings(const SPtr<RenderSettings>& settings)
 	{
 		if (mRenderSettings == nullptr)
@@ -157,26 +171,51 @@ namespace bs { namespace ct
 		mTransparentQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	void RendererView::determineVisible(const SceneInfo& sceneInfo)
 	{
-		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		mVisibility.renderables.reset((UINT32)sceneInfo.renderables.size());
+		mVisibility.radialLights.assign(sceneInfo.radialLights.size(), false);
+		mVisibility.spotLights.assign(sceneInfo.spotLights.size(), false);
+		mVisibility.reflProbes.assign(sceneInfo.reflProbes.size(), false);
 
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
+		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		if(visibility != nullptr)
+		// Don't recursively render reflection probes when generating reflection probe maps
+		const bool findReflProbes = !mProperties.capturingReflections;
+
+		// Octree query tests the bounding boxes. Renderables it finds are collected and tested against the bounding
+		// spheres, boxes and layers in bulk below, while the few lights and probes are tested immediately.
+		mRenderableCandidates.clear();
+
+		SceneOctree::ConvexVolumeIntersectIterator iter(*sceneInfo.octree, worldFrustum);
+		while(iter.moveNext())
 		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
+			const SceneOctreeElement& element = iter.getElement();
+			switch(element.type)
 			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
+			case SceneOctreeElementType::Renderable:
+				mRenderableCandidates.push_back(element.index);
+				break;
+			case SceneOctreeElementType::RadialLight:
+				if (worldFrustum.intersects(sceneInfo.radialLightWorldBounds[element.index]))
+					mVisibility.radialLights[element.index] = true;
+				break;
+			case SceneOctreeElementType::SpotLight:
+				if (worldFrustum.intersects(sceneInfo.spotLightWorldBounds[element.index]))
+					mVisibility.spotLights[element.index] = true;
+				break;
+			case SceneOctreeElementType::ReflectionProbe:
+				if (findReflProbes && worldFrustum.intersects(sceneInfo.reflProbeWorldBounds[element.index]))
+					mVisibility.reflProbes[element.index] = true;
+				break;
 			}
 		}
+
+		sceneInfo.renderableCullBounds.cull(worldFrustum, mProperties.visibleLayers, mRenderableCandidates.data(),
+			(UINT32)mRenderableCandidates.size(), mVisibility.renderables);
 	}
 
 	void RendererView::determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<AABox>& bounds, 
@@ -201,95 +240,54 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
-		LightType lightType, Vector<bool>* visibility)
+	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const
 	{
-		// Special case for directional lights, they're always visible
-		if(lightType == LightType::Directional)
-		{
-			if (visibility)
-				visibility->assign(lights.size(), true);
-
-			return;
-		}
-
-		Vector<bool>* perViewVisibility;
-		if(lightType == LightType::Radial)
-		{
-			mVisibility.radialLights.clear();
-			mVisibility.radialLights.resize(lights.size(), false);
+		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-			perViewVisibility = &mVisibility.radialLights;
-		}
-		else // Spot
+		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
 		{
-			mVisibility.spotLights.clear();
-			mVisibility.spotLights.resize(lights.size(), false);
-
-			perViewVisibility = &mVisibility.spotLights;
+			if (worldFrustum.intersects(bounds[i]))
+				visibility[i] = true;
 		}
+	}
 
-		if (mRenderSettings->overlayOnly)
+	void RendererView::determineOccluded(const SceneInfo& sceneInfo)
+	{
+		if (!mProperties.occlusionCulling || mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(bounds, *perViewVisibility);
+		const Rect2I& viewRect = mProperties.viewRect;
+		if (viewRect.width == 0 || viewRect.height == 0)
+			return;
 
-		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)lights.size(); i++)
-			{
-				bool visible = (*visibility)[i];
+		const UINT32 width = OCCLUSION_BUFFER_WIDTH;
+		const UINT32 height = std::max(1U, (UINT32)Math::roundToInt(width * viewRect.height / (float)viewRect.width));
+		const float minDepth = RenderAPI::instance().getAPIInfo().getMinimumDepthInputValue();
 
-				(*visibility)[i] = visible || (*perViewVisibility)[i];
-			}
-		}
-	}
-
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
-	{
-		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		mOcclusionBuffer.begin(width, height, mProperties.viewProjTransform, minDepth);
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		mVisibility.renderables.forEachSet([this, &sceneInfo](UINT32 i)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
+			const RendererRenderable* renderable = sceneInfo.renderables[i];
+			const OccluderGeometry* occluder = renderable->occluder;
+			if (occluder == nullptr || occluder->indices.empty())
+				return;
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+			mOcclusionBuffer.addOccluder(renderable->renderable->getMatrix(), occluder->vertices.data(),
+				(UINT32)occluder->vertices.size(), occluder->indices.data(), (UINT32)occluder->indices.size());
+		});
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
-	}
+		if (mOcclusionBuffer.getNumTriangles() == 0)
+			return;
 
-	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
-	{
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		mOcclusionBuffer.rasterize();
 
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		// Occluders are tested as well, as they can be hidden by other occluders. Clearing bits during iteration is safe.
+		mVisibility.renderables.forEachSet([this, &sceneInfo](UINT32 i)
 		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
-		}
-	}
-
-	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const
-	{
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
-
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
-		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
-		}
+			if (mOcclusionBuffer.isOccluded(sceneInfo.renderableCullInfos[i].bounds.getBox()))
+				mVisibility.renderables.unset(i);
+		});
 	}
 
 	void RendererView::queueRenderElements(const SceneInfo& sceneInfo)
@@ -298,11 +296,8 @@ namespace bs { namespace ct
 			return;
 
 		// Update per-object param buffers and queue render elements
-		for(UINT32 i = 0; i < (UINT32)sceneInfo.renderables.size(); i++)
+		mVisibility.renderables.forEachSet([this, &sceneInfo](UINT32 i)
 		{
-			if (!mVisibility.renderables[i])
-				continue;
-
 			const AABox& boundingBox = sceneInfo.renderableCullInfos[i].bounds.getBox();
 			const float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
 
@@ -318,7 +313,7 @@ namespace bs { namespace ct
 				else
 					mDeferredOpaqueQueue->add(&renderElem, distanceToCamera);
 			}
-		}
+		});
 
 		// Queue render elements
 		for(UINT32 i = 0; i < (UINT32)sceneInfo.particleSystems.size(); i++)
@@ -594,59 +589,44 @@ namespace bs { namespace ct
 		if (allViewsOverlay)
 			return;
 
-		// Calculate renderable visibility per view
-		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
-		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
-
-		mVisibility.particleSystems.resize(sceneInfo.particleSystems.size(), false);
-		mVisibility.particleSystems.assign(sceneInfo.particleSystems.size(), false);
-
-		for(UINT32 i = 0; i < numViews; i++)
+		// Calculate visibility and generate render queues for each view in parallel. Views only write to their own data.
+		const auto viewWorker = [this, &sceneInfo](UINT32 idx)
 		{
-			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
-			mViews[i]->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemBounds, &mVisibility.particleSystems);
-		}
-		
-		// Generate render queues per camera
-		for(UINT32 i = 0; i < numViews; i++)
-			mViews[i]->queueRenderElements(sceneInfo);
+			RendererView* view = mViews[idx];
 
-		// Calculate light visibility for all views
-		const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
-		mVisibility.radialLights.resize(numRadialLights, false);
-		mVisibility.radialLights.assign(numRadialLights, false);
+			view->determineVisible(sceneInfo);
+			view->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemBounds);
+			view->determineOccluded(sceneInfo);
+			view->queueRenderElements(sceneInfo);
+		};
 
-		const auto numSpotLights = (UINT32)sceneInfo.spotLights.size();
-		mVisibility.spotLights.resize(numSpotLights, false);
-		mVisibility.spotLights.assign(numSpotLights, false);
+		TaskScheduler::instance().parallelFor(0, numViews, 1, viewWorker);
 
-		for (UINT32 i = 0; i < numViews; i++)
-		{
-			if (mViews[i]->getRenderSettings().overlayOnly)
-				continue;
-
-			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, LightType::Radial,
-				&mVisibility.radialLights);
-
-			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot,
-				&mVisibility.spotLights);
-		}
+		// Combine per-view visibility, always in the same view order
+		mVisibility.renderables.reset((UINT32)sceneInfo.renderables.size());
+		mVisibility.radialLights.assign(sceneInfo.radialLights.size(), false);
+		mVisibility.spotLights.assign(sceneInfo.spotLights.size(), false);
+		mVisibility.reflProbes.assign(sceneInfo.reflProbes.size(), false);
+		mVisibility.particleSystems.assign(sceneInfo.particleSystems.size(), false);
 
-		// Calculate refl. probe visibility for all views
-		const auto numProbes = (UINT32)sceneInfo.reflProbes.size();
-		mVisibility.reflProbes.resize(numProbes, false);
-		mVisibility.reflProbes.assign(numProbes, false);
+		const auto mergeFlags = [](const Vector<bool>& viewFlags, Vector<bool>& flags)
+		{
+			for (UINT32 i = 0; i < (UINT32)viewFlags.size(); i++)
+			{
+				if (viewFlags[i])
+					flags[i] = true;
+			}
+		};
 
-		// Note: Per-view visibility for refl. probes currently isn't calculated
 		for (UINT32 i = 0; i < numViews; i++)
 		{
-			const auto& viewProps = mViews[i]->getProperties();
-
-			// Don't recursively render reflection probes when generating reflection probe maps
-			if (viewProps.capturingReflections)
-				continue;
+			const VisibilityInfo& viewVisibility = mViews[i]->getVisibilityMasks();
 
-			mViews[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, mVisibility.reflProbes);
+			mVisibility.renderables.merge(viewVisibility.renderables);
+			mergeFlags(viewVisibility.radialLights, mVisibility.radialLights);
+			mergeFlags(viewVisibility.spotLights, mVisibility.spotLights);
+			mergeFlags(viewVisibility.reflProbes, mVisibility.reflProbes);
+			mergeFlags(viewVisibility.particleSystems, mVisibility.particleSystems);
 		}
 
 		// Organize light and refl. probe visibility infomation in a more GPU friendly manner
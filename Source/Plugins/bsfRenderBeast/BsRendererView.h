@@ -8,6 +8,8 @@
 #include "Renderer/BsRenderSettings.h"
 #include "Math/BsBounds.h"
 #include "Math/BsConvexVolume.h"
+#include "Math/BsCullingBounds.h"
+#include "Math/BsOcclusionBuffer.h"
 #include "Shading/BsLightGrid.h"
 #include "Shading/BsShadowRendering.h"
 #include "BsRendererView.h"
@@ -46,6 +48,9 @@ namespace bs { namespace ct
 
 	extern PerCameraParamDef gPerCameraParamDef;
 
+	/** Identifier used for binding the per-camera parameter block to GpuParams. */
+	extern const ParamID gPerCameraParamID;
+
 	BS_PARAM_BLOCK_BEGIN(SkyboxParamDef)
 		BS_PARAM_BLOCK_ENTRY(Color, gClearColor)
 	BS_PARAM_BLOCK_END
@@ -62,7 +67,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SOLID_COLOR", color)
 			});
 
@@ -115,6 +120,15 @@ namespace bs { namespace ct
 		 */
 		bool capturingReflections : 1;
 
+		/** 
+		 * When enabled, renderables hidden behind occluders are culled on the CPU before being queued for rendering. See
+		 * Renderable::setIsOccluder().
+		 */
+		bool occlusionCulling : 1;
+
+		/** When enabled, compatible opaque renderables are grouped and rendered using instanced draw calls. */
+		bool instancing : 1;
+
 		/** 
 		 * When enabled the alpha channel of the final render target will be populated with an encoded depth value. 
 		 * Parameters @p depthEncodeNear and @p depthEncodeFar control which range of the depth buffer to encode.
@@ -191,7 +205,7 @@ namespace bs { namespace ct
 	/** Information whether certain scene objects are visible in a view, per object type. */
 	struct VisibilityInfo
 	{
-		Vector<bool> renderables;
+		CullingMask renderables;
 		Vector<bool> radialLights;
 		Vector<bool> spotLights;
 		Vector<bool> reflProbes;
@@ -226,6 +240,12 @@ namespace bs { namespace ct
 		/** Sets state reduction mode that determines how do render queues group & sort renderables. */
 		void setStateReductionMode(StateReduction reductionMode);
 
+		/** Enables or disables culling of renderables hidden behind occluders. */
+		void setOcclusionCulling(bool enable) { mProperties.occlusionCulling = enable; }
+
+		/** Enables or disables rendering of compatible renderables using instanced draw calls. */
+		void setInstancing(bool enable);
+
 		/** Updates the internal camera render settings. */
 		void setRenderSettings(const SPtr<RenderSettings>& settings);
 
@@ -266,21 +286,14 @@ namespace bs { namespace ct
 		const RenderCompositor& getCompositor() const { return mCompositor; }
 
 		/**
-		 * Populates view render queues by determining visible renderable objects. 
+		 * Determines visible renderable objects, radial & spot lights and reflection probes by querying the scene octree.
+		 * Only objects in parts of the scene intersecting the view frustum are visited, and the renderables found are
+		 * then culled in bulk using SIMD instructions. Results can be retrieved by calling getVisibilityMasks().
+		 * Reflection probes are not considered visible if the view is capturing reflections.
 		 *
-		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
-		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
-		 *									renderable objects. Must be the same size as the @p renderables array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
-		 *									object. If the bit for an object is already set to true, the method will never
-		 *									change it to false which allows the same bitfield to be provided to multiple
-		 *									renderer views. Must be the same size as the @p renderables array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
+		 * Only modifies data owned by this view, so visibility of multiple views can be determined in parallel.
 		 */
-		void determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void determineVisible(const SceneInfo& sceneInfo);
 
 		/**
 		 * Populates view render queues by determining visible particle systems. 
@@ -300,34 +313,11 @@ namespace bs { namespace ct
 			Vector<bool>* visibility = nullptr);
 
 		/**
-		 * Calculates the visibility masks for all the lights of the provided type.
-		 * 
-		 * @param[in]	lights				A set of lights to determine visibility for.
-		 * @param[in]	bounds				Bounding sphere for each provided light. Must be the same size as the @p lights
-		 *									array.
-		 * @param[in]	type				Type of all the lights in the @p lights array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible light. If the
-		 *									bit for a light is already set to true, the method will never change it to false
-		 *									which allows the same bitfield to be provided to multiple renderer views. Must
-		 *									be the same size as the @p lights array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
-		 */
-		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type, 
-			Vector<bool>* visibility = nullptr);
-
-		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
-		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
-
-		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * Rasterizes the visible occluders into a low resolution depth buffer on the CPU, and removes any renderables
+		 * hidden behind them from the visibility mask calculated by determineVisible(). Does nothing if occlusion culling
+		 * is disabled for the view, or if no occluders are visible. Must be called before queueRenderElements().
 		 */
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void determineOccluded(const SceneInfo& sceneInfo);
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -423,6 +413,8 @@ namespace bs { namespace ct
 
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
 		VisibilityInfo mVisibility;
+		Vector<UINT32> mRenderableCandidates; // Renderables returned by the octree query, before precise culling
+		OcclusionBuffer mOcclusionBuffer;
 		LightGrid mLightGrid;
 		UINT32 mViewIdx;
 	};
@@ -30,7 +30,7 @@ namespace bs { namespace ct
 	
 	void ShadowDepthNormalMat::setPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams)
 	{
-		mParams->setParamBlockBuffer("PerObject", perObjectParams);
+		mParams->setParamBlockBuffer(gPerObjectParamID, perObjectParams);
 
 		RenderAPI::instance().setGpuParams(mParams);
 	}
@@ -66,7 +66,7 @@ namespace bs { namespace ct
 
 	void ShadowDepthNormalNoPSMat::setPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams)
 	{
-		mParams->setParamBlockBuffer("PerObject", perObjectParams);
+		mParams->setParamBlockBuffer(gPerObjectParamID, perObjectParams);
 
 		RenderAPI::instance().setGpuParams(mParams);
 	}
@@ -102,7 +102,7 @@ namespace bs { namespace ct
 	
 	void ShadowDepthDirectionalMat::setPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams)
 	{
-		mParams->setParamBlockBuffer("PerObject", perObjectParams);
+		mParams->setParamBlockBuffer(gPerObjectParamID, perObjectParams);
 		RenderAPI::instance().setGpuParams(mParams);
 	}
 	
@@ -143,7 +143,7 @@ namespace bs { namespace ct
 	void ShadowDepthCubeMat::setPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMasks)
 	{
-		mParams->setParamBlockBuffer("PerObject", perObjectParams);
+		mParams->setParamBlockBuffer(gPerObjectParamID, perObjectParams);
 		mParams->setParamBlockBuffer("ShadowCubeMasks", shadowCubeMasks);
 
 		RenderAPI::instance().setGpuParams(mParams);
@@ -474,12 +474,33 @@ namespace bs { namespace ct
 			{
 				FrameVector<Command> commands[4];
 
+				// Find renderables within the shadow volume
+				CullingMask intersecting;
+				intersecting.reset((UINT32)sceneInfo.renderables.size());
+
+				if(Options::UseSceneOctree)
+				{
+					// Octree finds the candidates, which are then tested against their bounding spheres in bulk
+					FrameVector<UINT32> candidates;
+
+					SceneOctree::ConvexVolumeIntersectIterator iter(*sceneInfo.octree, opt.boundingVolume);
+					while(iter.moveNext())
+					{
+						const SceneOctreeElement& element = iter.getElement();
+						if(element.type == SceneOctreeElementType::Renderable)
+							candidates.push_back(element.index);
+					}
+
+					sceneInfo.renderableCullBounds.cullSpheres(opt.boundingVolume, candidates.data(),
+						(UINT32)candidates.size(), intersecting);
+				}
+				else // Testing multiple bounds at once
+					sceneInfo.renderableCullBounds.cullSpheres(opt.boundingVolume, intersecting);
+
 				// Make a list of relevant renderables and prepare them for rendering
-				for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
+				intersecting.forEachSet([&](UINT32 i)
 				{
 					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-					if (!opt.intersects(bounds))
-						continue;
 
 					scene.prepareRenderable(i, frameInfo);
 
@@ -507,7 +528,7 @@ namespace bs { namespace ct
 
 						commands[arrayIdx].push_back(Command(&element));
 					}
-				}
+				});
 
 				static const ShaderVariation* VAR_LOOKUP[4];
 				VAR_LOOKUP[0] = &getVertexInputVariation<false, false>();
@@ -543,6 +564,9 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering cube (omnidirectional) shadow maps (all faces at once). */
 	struct ShadowRenderQueueCubeOptions
 	{
+		// Shadow volume covers a small part of the scene, so renderables are found using the scene octree
+		static constexpr bool UseSceneOctree = true;
+
 		ShadowRenderQueueCubeOptions(
 			const ConvexVolume (&frustums)[6], 
 			const ConvexVolume& boundingVolume, 
@@ -553,11 +577,6 @@ namespace bs { namespace ct
 			, shadowCubeMatricesBuffer(shadowCubeMatricesBuffer), shadowCubeMasksBuffer(shadowCubeMasksBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
 		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
 		{
 			for (UINT32 j = 0; j < 6; j++)
@@ -592,17 +611,15 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering cube (omnidirectional) shadow maps (one face at a time). */
 	struct ShadowRenderQueueCubeSingleOptions
 	{
+		// Shadow volume covers a small part of the scene, so renderables are found using the scene octree
+		static constexpr bool UseSceneOctree = true;
+
 		ShadowRenderQueueCubeSingleOptions(
 				const ConvexVolume& boundingVolume,
 				const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
 				: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
 		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
 		{
 		}
@@ -629,17 +646,15 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering spot light shadow maps. */
 	struct ShadowRenderQueueSpotOptions
 	{
+		// Shadow volume covers a small part of the scene, so renderables are found using the scene octree
+		static constexpr bool UseSceneOctree = true;
+
 		ShadowRenderQueueSpotOptions(
 			const ConvexVolume& boundingVolume, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
 			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
 		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
 		{
 		}
@@ -666,17 +681,15 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering directional light shadow maps. */
 	struct ShadowRenderQueueDirOptions
 	{
+		// Cascades often cover most of the scene, so testing all renderables in bulk is faster than an octree query
+		static constexpr bool UseSceneOctree = false;
+
 		ShadowRenderQueueDirOptions(
 			const ConvexVolume& boundingVolume, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
 			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
 		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
 		{
 		}
@@ -953,7 +966,7 @@ namespace bs { namespace ct
 			output[i] = invVP.multiply(corner);
 		}
 
-		Vector<Plane> planes(6);
+		SmallVector<Plane, 6> planes(6);
 		planes[FRUSTUM_PLANE_NEAR] = Plane(output[AABox::NEAR_LEFT_BOTTOM], output[AABox::NEAR_RIGHT_BOTTOM], output[AABox::NEAR_RIGHT_TOP]);
 		planes[FRUSTUM_PLANE_FAR] = Plane(output[AABox::FAR_LEFT_BOTTOM], output[AABox::FAR_LEFT_TOP], output[AABox::FAR_RIGHT_TOP]);
 		planes[FRUSTUM_PLANE_LEFT] = Plane(output[AABox::NEAR_LEFT_BOTTOM], output[AABox::NEAR_LEFT_TOP], output[AABox::FAR_LEFT_TOP]);
@@ -1421,10 +1434,10 @@ namespace bs { namespace ct
 		gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, mapInfo.shadowVPTransform);
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
-		const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
+		const auto& frustumPlanes = localFrustum.getPlanes();
 		Matrix4 worldMatrix = view.inverseAffine();
 
-		Vector<Plane> worldPlanes(frustumPlanes.size());
+		SmallVector<Plane, 6> worldPlanes(frustumPlanes.size());
 		UINT32 j = 0;
 		for (auto& plane : frustumPlanes)
 		{
@@ -1537,7 +1550,7 @@ namespace bs { namespace ct
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
 		ConvexVolume frustums[6];
-		Vector<Plane> boundingPlanes;
+		SmallVector<Plane, 6> boundingPlanes;
 		for (UINT32 i = 0; i < 6; i++)
 		{
 			// Calculate view matrix
@@ -1580,11 +1593,11 @@ namespace bs { namespace ct
 			Matrix4 shadowViewProj = adjustedProj * view;
 
 			// Calculate world frustum for culling
-			const Vector<Plane>& frustumPlanes = localFrustum.getPlanes();
+			const auto& frustumPlanes = localFrustum.getPlanes();
 
 			Matrix4 worldMatrix = Matrix4::translation(lightPos) * Matrix4(viewRotationMat);
 
-			Vector<Plane> worldPlanes(frustumPlanes.size());
+			SmallVector<Plane, 6> worldPlanes(frustumPlanes.size());
 			UINT32 j = 0;
 			for (auto& plane : frustumPlanes)
 			{
@@ -1858,7 +1871,7 @@ namespace bs { namespace ct
 		viewPlanes[FRUSTUM_PLANE_BOTTOM] = Plane(frustumVerts[3], frustumVerts[2], frustumVerts[6]);
 
 		//// Add camera's planes facing towards the lights (forming the back of the volume)
-		Vector<Plane> lightVolume;
+		SmallVector<Plane, ConvexVolume::NUM_INLINE_PLANES> lightVolume;
 		for(auto& entry : viewPlanes)
 		{
 			if (entry.normal.dot(lightDir) < 0.0f)
@@ -42,7 +42,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SKINNED", skinned),
 				ShaderVariation::Param("MORPH", morph)
 			});
@@ -78,7 +78,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-					Vector<ShaderVariation::Param>{
+					SmallVector<ShaderVariation::Param, 4>{
 							ShaderVariation::Param("SKINNED", skinned),
 							ShaderVariation::Param("MORPH", morph)
 					});
@@ -114,7 +114,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SKINNED", skinned),
 				ShaderVariation::Param("MORPH", morph)
 			});
@@ -161,7 +161,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SKINNED", skinned),
 				ShaderVariation::Param("MORPH", morph)
 			});
@@ -203,7 +203,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("NEEDS_TRANSFORM", !directional),
 				ShaderVariation::Param("USE_ZFAIL_STENCIL", useZFailStencil)
 			});
@@ -277,7 +277,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SHADOW_QUALITY", quality),
 				ShaderVariation::Param("CASCADING", directional),
 				ShaderVariation::Param("NEEDS_TRANSFORM", !directional),
@@ -330,7 +330,7 @@ namespace bs { namespace ct
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
-			Vector<ShaderVariation::Param>{
+			SmallVector<ShaderVariation::Param, 4>{
 				ShaderVariation::Param("SHADOW_QUALITY", quality),
 				ShaderVariation::Param("VIEWER_INSIDE_VOLUME", inside),
 				ShaderVariation::Param("NEEDS_TRANSFORM", true),
@@ -18,15 +18,29 @@ char* includePush(ParseState* state, const char* filename, int line, int column,
 	memcpy(filenameNoQuote, filename + 1, filenameQuotesLen - 2);
 	filenameNoQuote[filenameQuotesLen - 2] = '\0';
 
-	HShaderInclude include = ShaderManager::instance().findInclude(filenameNoQuote);
+	// Variations of a shader are parsed on multiple threads at once, but include handlers aren't required to be thread
+	// safe, so the lookups are serialized
+	bool foundInclude = false;
+	String includeSource;
+	{
+		static Mutex includeMutex;
+		Lock lock(includeMutex);
+
+		HShaderInclude include = ShaderManager::instance().findInclude(filenameNoQuote);
 
-	if (include != nullptr)
-		include.blockUntilLoaded();
+		if (include != nullptr)
+			include.blockUntilLoaded();
+
+		if (include.isLoaded())
+		{
+			includeSource = include->getString();
+			foundInclude = true;
+		}
+	}
 
 	int filenameLen = (int)strlen(filenameNoQuote);
-	if (include.isLoaded())
+	if (foundInclude)
 	{
-		String includeSource = include->getString();
 
 		*size = (int)includeSource.size() + 2;
 		char* output = (char*)mmalloc(state->memContext, *size);
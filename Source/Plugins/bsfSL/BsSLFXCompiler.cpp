@@ -18,6 +18,7 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -550,7 +551,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry,
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* reflection = nullptr,
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -695,8 +697,8 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (reflection != nullptr)
+			*reflection = std::move(reflectionData);
 
 		return output.str();
 	}
@@ -707,10 +709,10 @@ namespace bs
 		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflection, Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflection, &entryPoints);
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source,
@@ -1666,8 +1668,8 @@ namespace bs
 	{
 		BSLFXCompileResult output;
 
-		// Build a list of different variations and re-parse the source using the relevant defines
-		UnorderedSet<String> includeSet;
+		// Build a list of different variations of all shaders
+		Vector<VariationTechniques> allVariations;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1750,40 +1752,69 @@ namespace bs
 				}
 			}
 
-			// For every variation, re-parse the file with relevant defines
 			for (auto& variation : variations)
 			{
-				UnorderedMap<String, String> globalDefines = defines;
-				UnorderedMap<String, String> variationDefines = variation.getDefines().getAll();
+				VariationTechniques variationTechniques;
+				variationTechniques.name = metaData.name;
+				variationTechniques.variation = variation;
 
-				for (auto& define : variationDefines)
-					globalDefines[define.first] = define.second;
+				allVariations.push_back(variationTechniques);
+			}
+		}
 
-				ParseState* variationParseState = parseStateCreate();
-				output = parseFX(variationParseState, source.c_str(), globalDefines);
+		// For every variation, re-parse the file with relevant defines. Variations are independent so they are parsed
+		// and cross-compiled in parallel, while the resulting techniques are created in the original order, so the output
+		// is the same as if the variations were processed sequentially.
+		const auto parseVariation = [&source, &defines, &allVariations](UINT32 idx)
+		{
+			VariationTechniques& entry = allVariations[idx];
 
-				if (!output.errorMessage.empty())
-					parseStateDelete(variationParseState);
-				else
-				{
-					Vector<String> codeBlocks;
-					RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
-					while (rawCode != nullptr)
-					{
-						while ((INT32)codeBlocks.size() <= rawCode->index)
-							codeBlocks.push_back(String());
+			UnorderedMap<String, String> globalDefines = defines;
+			UnorderedMap<String, String> variationDefines = entry.variation.getDefines().getAll();
 
-						codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
-						rawCode = rawCode->next;
-					}
+			for (auto& define : variationDefines)
+				globalDefines[define.first] = define.second;
+
+			ParseState* variationParseState = parseStateCreate();
+			entry.parseResult = parseFX(variationParseState, source.c_str(), globalDefines);
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, includeSet,
-						shaderDesc);
+			if (!entry.parseResult.errorMessage.empty())
+				parseStateDelete(variationParseState);
+			else
+			{
+				Vector<String> codeBlocks;
+				RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
+				while (rawCode != nullptr)
+				{
+					while ((INT32)codeBlocks.size() <= rawCode->index)
+						codeBlocks.push_back(String());
 
-					if (!output.errorMessage.empty())
-						return output;
+					codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
+					rawCode = rawCode->next;
 				}
+
+				entry.compileResult = parseTechniques(variationParseState, entry.name, codeBlocks, entry.techniques,
+					entry.includes);
 			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, (UINT32)allVariations.size(), 1, parseVariation);
+
+		UnorderedSet<String> includeSet;
+		for (auto& entry : allVariations)
+		{
+			output = entry.parseResult;
+			if (!output.errorMessage.empty())
+				continue;
+
+			output = entry.compileResult;
+			if (!output.errorMessage.empty())
+				return output;
+
+			for (auto& include : entry.includes)
+				includeSet.insert(include);
+
+			createTechniques(entry.techniques, entry.variation, shaderDesc);
 		}
 
 		// Generate a shader from the parsed techniques
@@ -1948,9 +1979,8 @@ namespace bs
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name,
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes,
-		SHADER_DESC& shaderDesc)
+	BSLFXCompileResult BSLFXCompiler::parseTechniques(ParseState* parseState, const String& name,
+		const Vector<String>& codeBlocks, Vector<ShaderData>& techniques, Vector<String>& includes)
 	{
 		BSLFXCompileResult output;
 
@@ -2067,12 +2097,7 @@ namespace bs
 		IncludeLink* includeLink = parseState->includes;
 		while(includeLink != nullptr)
 		{
-			String includeFilename = includeLink->data->filename;
-
-			auto iterFind = std::find(includes.begin(), includes.end(), includeFilename);
-			if (iterFind == includes.end())
-				includes.insert(includeFilename);
-
+			includes.push_back(includeLink->data->filename);
 			includeLink = includeLink->next;
 		}
 
@@ -2128,7 +2153,8 @@ namespace bs
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
 				Vector<GpuProgramType> types;
-				reflectHLSL(glslPassData.code, shaderDesc, types);
+				hlslPassData.reflection = bs_shared_ptr_new<Xsc::Reflection::ReflectionData>();
+				reflectHLSL(glslPassData.code, *hlslPassData.reflection, types);
 
 				UINT32 glslBinding = 0;
 				UINT32 vkslBinding = 0;
@@ -2195,12 +2221,30 @@ namespace bs
 
 		for(auto& entry : shaderData)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
-			if (metaData.isMixin)
-				continue;
+			if (!entry.second.metaData.isMixin)
+				techniques.push_back(entry.second);
+		}
+
+		return output;
+	}
 
+	void BSLFXCompiler::createTechniques(const Vector<ShaderData>& techniques, const ShaderVariation& variation,
+		SHADER_DESC& shaderDesc)
+	{
+		for(auto& entry : techniques)
+		{
+			for (auto& passData : entry.passes)
+			{
+				if (passData.reflection != nullptr)
+					parseParameters(*passData.reflection, shaderDesc);
+			}
+		}
+
+		for(auto& entry : techniques)
+		{
+			const ShaderMetaData& metaData = entry.metaData;
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : entry.passes)
 			{
 				PASS_DESC passDesc;
 				passDesc.blendStateDesc = passData.blendDesc;
@@ -2273,8 +2317,6 @@ namespace bs
 				shaderDesc.techniques.push_back(technique);
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
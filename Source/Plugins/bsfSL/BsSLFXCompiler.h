@@ -8,11 +8,14 @@
 #include "RenderAPI/BsRasterizerState.h"
 #include "RenderAPI/BsDepthStencilState.h"
 #include "RenderAPI/BsBlendState.h"
+#include "Material/BsShaderVariation.h"
 
 extern "C" {
 #include "BsASTFX.h"
 }
 
+namespace Xsc { namespace Reflection { struct ReflectionData; } }
+
 namespace bs
 {
 	/** @addtogroup BansheeSL
@@ -59,6 +62,8 @@ namespace bs
 			String hullCode;
 			String domainCode;
 			String computeCode;
+
+			SPtr<Xsc::Reflection::ReflectionData> reflection; // Reflection of HLSL code, used for generating parameters
 		};
 
 		/** Information about different variations of a single shader. */
@@ -89,6 +94,18 @@ namespace bs
 			Vector<PassData> passes;
 		};
 
+		/** Techniques parsed for a single shader variation, before they are registered with the shader descriptor. */
+		struct VariationTechniques
+		{
+			String name;
+			ShaderVariation variation;
+
+			BSLFXCompileResult parseResult;
+			BSLFXCompileResult compileResult;
+			Vector<ShaderData> techniques;
+			Vector<String> includes;
+		};
+
 		/** Temporary data describing a sub-shader during parsing. */
 		struct SubShaderData
 		{
@@ -269,21 +286,31 @@ namespace bs
 			Vector<String>& includes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Parses the techniques of a single variation and cross-compiles their code for all render backends. Uses AST
+		 * parse state as input, which must be created using the defines of the relevant variation. Does not create any
+		 * objects that need to be initialized on the core thread, and is therefore safe to call from worker threads.
 		 *
 		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
-		 *								parseFX().
+		 *								parseFX(). Deleted by this method.
 		 * @param[in]	name			Name of the shader to generate the variation for.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[out]	includes		Set to append newly found includes to.
+		 * @param[out]	techniques		Techniques parsed for every render backend, in the order they should be created.
+		 * @param[out]	includes		List to append all includes included by the AST to.
+		 * @return						A result object containing an error message if not successful.
+		 */
+		static BSLFXCompileResult parseTechniques(ParseState* parseState, const String& name, 
+			const Vector<String>& codeBlocks, Vector<ShaderData>& techniques, Vector<String>& includes);
+
+		/**
+		 * Creates techniques from a set of techniques previously parsed by parseTechniques() and registers them, along
+		 * with any non-internal parameters, with the shader descriptor.
+		 *
+		 * @param[in]	techniques		Parsed techniques to create.
+		 * @param[in]	variation		Shader variation the techniques were parsed with.
 		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *								registered with.
-		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name, 
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes, 
+		static void createTechniques(const Vector<ShaderData>& techniques, const ShaderVariation& variation, 
 			SHADER_DESC& shaderDesc);
 
 		/**
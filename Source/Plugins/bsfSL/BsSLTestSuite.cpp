@@ -0,0 +1,143 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsTestSuite.h"
+#include "BsSLFXCompiler.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Serialization/BsMemorySerializer.h"
+
+namespace bs
+{
+	/** Runs unit tests for the BSL shader compiler. Requires the engine to be started with a render API plugin. */
+	class SLTestSuite : public TestSuite
+	{
+	public:
+		SLTestSuite();
+
+	private:
+		void testParallelVariationCompile();
+	};
+
+	/** Shader with multiple variations, each registering a different set of parameters. */
+	static const char* VARIATION_TEST_SHADER = R"(
+		shader VariationTest
+		{
+			variations
+			{
+				USE_TEXTURE = { true, false };
+				MODE = { 0, 1, 2 };
+			};
+
+			code
+			{
+				struct VStoFS
+				{
+					float4 position : SV_POSITION;
+					float2 uv0 : TEXCOORD0;
+				};
+
+				struct VertexInput
+				{
+					float2 screenPos : POSITION;
+					float2 uv0 : TEXCOORD0;
+				};
+
+				cbuffer Input
+				{
+					float4 gTint;
+
+					#if MODE == 1
+					float gScale;
+					#elif MODE == 2
+					float2 gOffset;
+					#endif
+				}
+
+				#if USE_TEXTURE
+				SamplerState gInputSamp;
+				Texture2D gInputTex;
+				#endif
+
+				VStoFS vsmain(VertexInput input)
+				{
+					VStoFS output;
+
+					output.position = float4(input.screenPos, 0, 1);
+					output.uv0 = input.uv0;
+
+					return output;
+				}
+
+				float4 fsmain(VStoFS input) : SV_Target0
+				{
+					float2 uv = input.uv0;
+
+					#if MODE == 1
+					uv *= gScale;
+					#elif MODE == 2
+					uv += gOffset;
+					#endif
+
+					#if USE_TEXTURE
+					return gInputTex.Sample(gInputSamp, uv) * gTint;
+					#else
+					return float4(uv, 0, 1) * gTint;
+					#endif
+				}
+			};
+		};
+	)";
+
+	SLTestSuite::SLTestSuite()
+	{
+		BS_ADD_TEST(SLTestSuite::testParallelVariationCompile);
+	}
+
+	void SLTestSuite::testParallelVariationCompile()
+	{
+		const String source = VARIATION_TEST_SHADER;
+		const UnorderedMap<String, String> defines;
+
+		auto compileAndEncode = [this, &source, &defines](UINT32& size)
+		{
+			BSLFXCompileResult result = BSLFXCompiler::compile("VariationTest", source, defines);
+			BS_TEST_ASSERT_MSG(result.shader != nullptr, result.errorMessage);
+
+			size = 0;
+			if (result.shader == nullptr)
+				return (UINT8*)nullptr;
+
+			MemorySerializer serializer;
+			return serializer.encode(result.shader.get(), size);
+		};
+
+		// Compile using the worker threads
+		TaskScheduler& scheduler = TaskScheduler::instance();
+		BS_TEST_ASSERT_MSG(scheduler.getNumWorkers() > 0, "Variations are not compiled in parallel without workers.");
+
+		UINT32 parallelSize = 0;
+		UINT8* parallelData = compileAndEncode(parallelSize);
+
+		// Compile on the calling thread only
+		const UINT32 numWorkers = scheduler.getNumWorkers();
+		for (UINT32 i = 0; i < numWorkers; i++)
+			scheduler.removeWorker();
+
+		UINT32 serialSize = 0;
+		UINT8* serialData = compileAndEncode(serialSize);
+
+		for (UINT32 i = 0; i < numWorkers; i++)
+			scheduler.addWorker();
+
+		BS_TEST_ASSERT(parallelData != nullptr && serialData != nullptr);
+		BS_TEST_ASSERT(parallelSize == serialSize);
+
+		if (parallelData != nullptr && serialData != nullptr && parallelSize == serialSize)
+			BS_TEST_ASSERT(memcmp(parallelData, serialData, parallelSize) == 0);
+
+		if (parallelData != nullptr)
+			bs_free(parallelData);
+
+		if (serialData != nullptr)
+			bs_free(serialData);
+	}
+}
@@ -15,6 +15,7 @@ set(BS_SL_SRC_NOFILTER
 	"BsSLImporter.cpp"
 	"BsSLFXCompiler.cpp"
 	"BsIncludeHandler.cpp"
+	"BsSLTestSuite.cpp"
 	"BSMMAlloc.c"
 	"BsLexerFX.c"
 	"BsParserFX.c"
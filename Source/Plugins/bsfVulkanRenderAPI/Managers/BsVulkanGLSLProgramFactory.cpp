@@ -699,8 +699,9 @@ namespace bs { namespace ct
 		SPtr<GpuProgramBytecode> bytecode = bs_shared_ptr_new<GpuProgramBytecode>();
 		bytecode->compilerId = VULKAN_COMPILER_ID;
 		bytecode->compilerVersion = VULKAN_COMPILER_VERSION;
+		bytecode->compilerFlags = getCompilerFlags();
 
-		EShMessages messages = (EShMessages)((int)EShMsgSpvRules | (int)EShMsgVulkanRules);
+		EShMessages messages = (EShMessages)getCompilerFlags();
 		if (!shader->parse(&resources, 450, false, messages))
 		{
 			bytecode->messages = "Compile error: " + String(shader->getInfoLog());
@@ -744,4 +745,19 @@ cleanup:
 
 		return bytecode;
 	}
+
+	String VulkanGLSLProgramFactory::getCompilerId() const
+	{
+		return VULKAN_COMPILER_ID;
+	}
+
+	UINT32 VulkanGLSLProgramFactory::getCompilerVersion() const
+	{
+		return VULKAN_COMPILER_VERSION;
+	}
+
+	UINT32 VulkanGLSLProgramFactory::getCompilerFlags() const
+	{
+		return (UINT32)EShMsgSpvRules | (UINT32)EShMsgVulkanRules;
+	}
 }}